@@ -0,0 +1,743 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string.h>
+#include <stdio.h>
+#include <sched.h>
+#include <cmath>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "quadratic-equation-solver.h"
+#include "quadratic-equation-batch.h"
+#include "quadratic-equation-dispatch.h"
+#include "quadratic-equation-parallel.h"
+#include "quadratic-equation-mixed.h"
+#include "quadratic-equation-partition.h"
+#include "solution-description.h"
+#include "solution-cache.h"
+#include "equation-sweep.h"
+#include "quadratic-equation-queries.h"
+#include "quadratic-equation-complex.h"
+#include "polynomial-equation-solver.h"
+#include "solution-aggregate.h"
+#include "async-solver.h"
+#include "batch-buffers.h"
+
+// ============================= Input data =============================
+
+struct bench_data {
+    size_t count;
+
+    double* a;
+    double* b;
+    double* c;
+
+    // Outputs of batch solvers
+    solution_status* status;
+    int* number_of_roots;
+    double* root[2];
+    int* error_code;
+
+    // Outputs of single-equation solver, inputs of describe benchmarks
+    equation_solution* solutions;
+
+    // Output of describe benchmarks
+    char* arena;
+    size_t* offsets;
+
+    // Output of interval queries
+    bool* has_root;
+
+    // Imaginary parts of complex roots, real parts go to root
+    double* imaginary[2];
+
+    // Coefficients d and e of cubic and quartic equations, the same for every
+    // distribution, their third and fourth roots go to imaginary
+    double* d;
+    double* e;
+};
+
+static equation_solution_columns solution_columns(bench_data* const data) {
+    return { data->status, data->number_of_roots,
+             { data->root[0], data->root[1] }, data->error_code };
+}
+
+static bool allocate_bench_data(bench_data* const data, const size_t count) {
+    data->count = count;
+
+    data->a = (double*) malloc(count * sizeof(double));
+    data->b = (double*) malloc(count * sizeof(double));
+    data->c = (double*) malloc(count * sizeof(double));
+
+    data->status = (solution_status*) malloc(count * sizeof(solution_status));
+    data->number_of_roots = (int*) malloc(count * sizeof(int));
+    data->root[0] = (double*) malloc(count * sizeof(double));
+    data->root[1] = (double*) malloc(count * sizeof(double));
+    data->error_code = (int*) malloc(count * sizeof(int));
+
+    data->solutions = (equation_solution*) malloc(count * sizeof(equation_solution));
+
+    data->arena = (char*) malloc(description_arena_size(count));
+    data->offsets = (size_t*) malloc((count + 1) * sizeof(size_t));
+
+    data->has_root = (bool*) malloc(count * sizeof(bool));
+
+    data->imaginary[0] = (double*) malloc(count * sizeof(double));
+    data->imaginary[1] = (double*) malloc(count * sizeof(double));
+
+    data->d = (double*) malloc(count * sizeof(double));
+    data->e = (double*) malloc(count * sizeof(double));
+
+    return data->a != NULL && data->b != NULL && data->c != NULL &&
+        data->status != NULL && data->number_of_roots != NULL &&
+        data->root[0] != NULL && data->root[1] != NULL && data->error_code != NULL &&
+        data->solutions != NULL && data->arena != NULL && data->offsets != NULL &&
+        data->has_root != NULL && data->imaginary[0] != NULL && data->imaginary[1] != NULL &&
+        data->d != NULL && data->e != NULL;
+}
+
+static void free_bench_data(bench_data* const data) {
+    void* const buffers[] = {
+        data->a, data->b, data->c, data->status, data->number_of_roots,
+        data->root[0], data->root[1], data->error_code, data->solutions,
+        data->arena, data->offsets, data->has_root, data->imaginary[0], data->imaginary[1],
+        data->d, data->e
+    };
+
+    for (void* buffer: buffers)
+        free(buffer);
+}
+
+// Small deterministic generator, so runs are comparable between releases
+static uint64_t random_state = 0x9e3779b97f4a7c15u;
+
+static uint64_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+static double random_double(const double from, const double to) {
+    return from + (to - from) * (double) (next_random() >> 11) * 0x1.0p-53;
+}
+
+static void fill_uniform(bench_data* const data) {
+    for (size_t i = 0; i < data->count; ++ i) {
+        data->a[i] = random_double(-100.0, 100.0);
+        data->b[i] = random_double(-100.0, 100.0);
+        data->c[i] = random_double(-100.0, 100.0);
+    }
+}
+
+static void fill_mostly_linear(bench_data* const data) {
+    fill_uniform(data);
+
+    // Nine out of ten equations have a == 0 or a within epsilon of it
+    for (size_t i = 0; i < data->count; ++ i)
+        if (next_random() % 10 != 0)
+            data->a[i] = next_random() % 2 == 0 ? 0.0 : random_double(-1e-10, 1e-10);
+}
+
+static void fill_near_zero_discriminant(bench_data* const data) {
+    // a(x - r)^2 with c nudged, so discriminant is tiny, of either sign
+    for (size_t i = 0; i < data->count; ++ i) {
+        const double a = random_double(0.5, 2.0), root = random_double(-10.0, 10.0);
+
+        data->a[i] = a;
+        data->b[i] = -2.0 * a * root;
+        data->c[i] = a * root * root + random_double(-1e-10, 1e-10);
+    }
+}
+
+static void fill_infinite_roots(bench_data* const data) {
+    for (size_t i = 0; i < data->count; ++ i) {
+        data->a[i] = next_random() % 2 == 0 ? 0.0 : random_double(-1e-10, 1e-10);
+        data->b[i] = next_random() % 2 == 0 ? 0.0 : random_double(-1e-10, 1e-10);
+        data->c[i] = next_random() % 2 == 0 ? 0.0 : random_double(-1e-10, 1e-10);
+    }
+}
+
+static void fill_non_finite(bench_data* const data) {
+    fill_uniform(data);
+
+    const double non_finite[] = { NAN, INFINITY, -INFINITY };
+
+    // Every equation has one illegal coefficient
+    for (size_t i = 0; i < data->count; ++ i) {
+        double* const columns[] = { data->a, data->b, data->c };
+        columns[next_random() % 3][i] = non_finite[next_random() % 3];
+    }
+}
+
+struct bench_distribution {
+    const char* name;
+    void (*fill)(bench_data* const data);
+};
+
+static const bench_distribution DISTRIBUTIONS[] = {
+    { "uniform",                fill_uniform                },
+    { "mostly_linear",          fill_mostly_linear          },
+    { "near_zero_discriminant", fill_near_zero_discriminant },
+    { "infinite_roots",         fill_infinite_roots         },
+    { "non_finite",             fill_non_finite             },
+};
+
+// ============================= Benchmarks =============================
+
+static void bench_single(bench_data* const data) {
+    for (size_t i = 0; i < data->count; ++ i)
+        solve_quadratic_equation(data->a[i], data->b[i], data->c[i], data->solutions + i);
+}
+
+static void bench_batch(bench_data* const data) {
+    const equation_solution_columns columns = solution_columns(data);
+    solve_quadratic_equation_batch(data->a, data->b, data->c, data->count, &columns);
+}
+
+static void bench_batch_polished(bench_data* const data) {
+    const equation_solution_columns columns = solution_columns(data);
+    solve_quadratic_equation_batch(data->a, data->b, data->c, data->count, &columns);
+    polish_quadratic_equation_roots_batch(data->a, data->b, data->c, data->count, &columns,
+                                          EQUATION_SOLVER_POLISH_ITERATIONS);
+}
+
+static void bench_parallel(bench_data* const data) {
+    const equation_solution_columns columns = solution_columns(data);
+    solve_quadratic_equation_batch_parallel(NULL, data->a, data->b, data->c,
+                                            data->count, &columns);
+}
+
+static void bench_mixed(bench_data* const data) {
+    const equation_solution_columns columns = solution_columns(data);
+    solve_quadratic_equation_batch_mixed(data->a, data->b, data->c, data->count, &columns,
+                                         MIXED_PRECISION_DEFAULT_TOLERANCE, NULL);
+}
+
+static void bench_partitioned(bench_data* const data) {
+    const equation_solution_columns columns = solution_columns(data);
+    solve_quadratic_equation_batch_partitioned(data->a, data->b, data->c, data->count, &columns);
+}
+
+// Aggregates are kept, so the fold can't be thrown away
+static solution_aggregate bench_aggregate;
+
+static void bench_batch_aggregate(bench_data* const data) {
+    init_solution_aggregate(&bench_aggregate, -100.0, 100.0, 20);
+    aggregate_quadratic_equation_batch(&bench_aggregate, data->a, data->b, data->c, data->count);
+}
+
+static void bench_parallel_aggregate(bench_data* const data) {
+    init_solution_aggregate(&bench_aggregate, -100.0, 100.0, 20);
+    aggregate_quadratic_equation_batch_parallel(NULL, &bench_aggregate, data->a, data->b,
+                                                data->c, data->count);
+}
+
+// Async benchmark models many small requests: the input is submitted in
+// blocks of BENCH_ASYNC_BLOCK equations that the solver thread gathers
+const size_t BENCH_ASYNC_BLOCK = 64;
+
+static async_solver* bench_async_solver = NULL;
+static async_completion_queue* bench_completions = NULL;
+
+static void bench_async(bench_data* const data) {
+    if (bench_async_solver == NULL) {
+        bench_async_solver = create_async_solver(1024, NULL);
+        bench_completions = create_async_completion_queue(1024);
+    }
+
+    const equation_solution_columns columns = solution_columns(data);
+
+    size_t in_flight = 0;
+    for (size_t first = 0; first < data->count;) {
+        const size_t left = data->count - first;
+        const size_t count = left < BENCH_ASYNC_BLOCK ? left : BENCH_ASYNC_BLOCK;
+
+        const equation_solution_columns block = {
+            columns.status + first, columns.number_of_roots + first,
+            { columns.root[0] + first, columns.root[1] + first }, columns.error_code + first
+        };
+
+        if (submit_async_quadratic_equation_batch(bench_async_solver, bench_completions,
+                                                  data->a + first, data->b + first,
+                                                  data->c + first, count, &block, NULL) != 0) {
+            ++ in_flight;
+            first += count;
+            continue;
+        }
+
+        async_completion completions[64];
+        in_flight -= wait_async_completions(bench_completions, completions, 64);
+    }
+
+    while (in_flight > 0) {
+        async_completion completions[64];
+        in_flight -= wait_async_completions(bench_completions, completions, 64);
+    }
+}
+
+// Set by a case that can't run here, it's left out of the results
+static bool is_bench_skipped = false;
+
+// Incremented for every distribution, cases with their own copy of the input refresh it
+static uint64_t bench_input_generation = 0;
+
+// Buffer benchmarks solve the input in batch_buffers of each page mode, on
+// a pool whose workers are pinned and touched the chunks they solve. "parallel"
+// is the same solve on malloc'ed columns
+static solver_thread_pool* bench_pinned_pool = NULL;
+static batch_buffers bench_buffers[NUMBER_OF_BUFFER_PAGE_MODES];
+static uint64_t bench_buffers_generation[NUMBER_OF_BUFFER_PAGE_MODES];
+
+// Main thread is worker 0 of the pinned pool, so it's pinned too while a
+// buffer benchmark runs, and gets its own CPUs back after it
+static cpu_set_t bench_main_affinity;
+static bool is_bench_main_thread_pinned = false;
+
+static void unpin_bench_main_thread(void) {
+    if (!is_bench_main_thread_pinned)
+        return;
+
+    sched_setaffinity(0, sizeof(bench_main_affinity), &bench_main_affinity);
+    is_bench_main_thread_pinned = false;
+}
+
+static void bench_buffers_solve(bench_data* const data, const buffer_page_mode mode) {
+    if (bench_pinned_pool == NULL)
+        bench_pinned_pool = create_solver_thread_pool(0);
+
+    // Done by the warm-up run, measured runs find the thread pinned
+    if (!is_bench_main_thread_pinned &&
+        sched_getaffinity(0, sizeof(bench_main_affinity), &bench_main_affinity) == 0) {
+        pin_solver_thread_pool_workers(bench_pinned_pool);
+        is_bench_main_thread_pinned = true;
+    }
+
+    batch_buffers* const buffers = bench_buffers + mode;
+
+    if (buffers->count != data->count &&
+        init_batch_buffers(buffers, data->count, mode, bench_pinned_pool) != 0) {
+        is_bench_skipped = true;
+        return;
+    }
+
+    if (bench_buffers_generation[mode] != bench_input_generation) {
+        memcpy(buffers->a, data->a, data->count * sizeof(double));
+        memcpy(buffers->b, data->b, data->count * sizeof(double));
+        memcpy(buffers->c, data->c, data->count * sizeof(double));
+
+        bench_buffers_generation[mode] = bench_input_generation;
+    }
+
+    solve_quadratic_equation_batch_parallel(bench_pinned_pool, buffers->a, buffers->b,
+                                            buffers->c, buffers->count, &buffers->solutions);
+}
+
+static void bench_small_pages(bench_data* const data) {
+    bench_buffers_solve(data, SMALL_PAGES);
+}
+
+static void bench_transparent_huge_pages(bench_data* const data) {
+    bench_buffers_solve(data, TRANSPARENT_HUGE_PAGES);
+}
+
+static void bench_explicit_huge_pages(bench_data* const data) {
+    bench_buffers_solve(data, EXPLICIT_HUGE_PAGES);
+}
+
+// Cached benchmarks model hot repeated inputs: they cycle through the first
+// BENCH_HOT_EQUATIONS equations of the input, which all fit into the cache,
+// so after the warm-up run every valid equation is a hit
+const size_t BENCH_HOT_EQUATIONS = 4096;
+
+static solution_cache* bench_cache = NULL;
+static sharded_solution_cache* bench_sharded_cache = NULL;
+
+static void bench_single_cached(bench_data* const data) {
+    if (bench_cache == NULL)
+        bench_cache = create_solution_cache(2 * BENCH_HOT_EQUATIONS);
+
+    const size_t hot = data->count < BENCH_HOT_EQUATIONS ? data->count : BENCH_HOT_EQUATIONS;
+
+    for (size_t i = 0; i < data->count; ++ i) {
+        const size_t j = i % hot;
+        solve_quadratic_equation_cached(bench_cache, data->a[j], data->b[j], data->c[j],
+                                        data->solutions + i);
+    }
+}
+
+static void bench_parallel_cached(bench_data* const data) {
+    if (bench_sharded_cache == NULL)
+        bench_sharded_cache = create_sharded_solution_cache(2 * BENCH_HOT_EQUATIONS, 0);
+
+    const size_t hot = data->count < BENCH_HOT_EQUATIONS ? data->count : BENCH_HOT_EQUATIONS;
+    const equation_solution_columns columns = solution_columns(data);
+
+    for (size_t first = 0; first < data->count; first += hot) {
+        const size_t left = data->count - first;
+        const equation_solution_columns chunk = {
+            columns.status + first, columns.number_of_roots + first,
+            { columns.root[0] + first, columns.root[1] + first }, columns.error_code + first
+        };
+
+        solve_quadratic_equation_batch_parallel_cached(NULL, bench_sharded_cache,
+                                                       data->a, data->b, data->c,
+                                                       left < hot ? left : hot, &chunk);
+    }
+}
+
+// Sweep benchmarks ignore the input distribution: they solve a grid of 16
+// values of a by 16 values of b by count / 256 values of c
+static bool init_bench_sweep(const bench_data* const data, equation_sweep* const sweep) {
+    const coefficient_range a = { 0.5, 0.125, 16 };
+    const coefficient_range b = { -8.0, 1.0, 16 };
+    const coefficient_range c = { -100.0, 0.01, data->count / 256 };
+
+    return init_equation_sweep(sweep, &a, &b, &c) == 0;
+}
+
+static void bench_sweep(bench_data* const data) {
+    equation_sweep sweep;
+    if (!init_bench_sweep(data, &sweep))
+        return;
+
+    const equation_solution_columns columns = solution_columns(data);
+
+    // Every block is written to the start of the columns, like a consumer
+    // that handles one block before asking for the next one would do
+    while (solve_next_sweep_block(&sweep, &columns, SWEEP_BLOCK_SIZE) != 0)
+        continue;
+}
+
+// Same grid, every point solved on its own
+static void bench_sweep_pointwise(bench_data* const data) {
+    equation_sweep sweep;
+    if (!init_bench_sweep(data, &sweep))
+        return;
+
+    for (size_t i = 0; i < sweep.size; ++ i) {
+        double a = 0, b = 0, c = 0;
+        get_sweep_coefficients(&sweep, i, &a, &b, &c);
+        solve_quadratic_equation(a, b, c, data->solutions + i);
+    }
+}
+
+static void bench_count_roots(bench_data* const data) {
+    const root_count_columns counts = { data->status, data->number_of_roots, data->error_code };
+    count_quadratic_equation_roots_batch(data->a, data->b, data->c, data->count, &counts);
+}
+
+static void bench_largest_root(bench_data* const data) {
+    const root_count_columns counts = { data->status, data->number_of_roots, data->error_code };
+    find_quadratic_equation_root_batch(data->a, data->b, data->c, data->count, LARGEST_ROOT,
+                                       &counts, data->root[0]);
+}
+
+static void bench_root_in_interval(bench_data* const data) {
+    has_quadratic_equation_root_in_batch(data->a, data->b, data->c, data->count,
+                                         -1.0, 1.0, data->has_root);
+}
+
+static void bench_batch_complex(bench_data* const data) {
+    const complex_equation_solution_columns columns = {
+        data->status, data->number_of_roots, { data->root[0], data->root[1] },
+        { data->imaginary[0], data->imaginary[1] }, data->error_code
+    };
+
+    solve_quadratic_equation_batch_complex(data->a, data->b, data->c, data->count, &columns);
+}
+
+static void bench_cubic(bench_data* const data) {
+    const cubic_equation_solution_columns columns = {
+        data->status, data->number_of_roots,
+        { data->root[0], data->root[1], data->imaginary[0] }, data->error_code
+    };
+
+    solve_cubic_equation_batch(data->a, data->b, data->c, data->d, data->count, &columns);
+}
+
+static void bench_quartic(bench_data* const data) {
+    const quartic_equation_solution_columns columns = {
+        data->status, data->number_of_roots,
+        { data->root[0], data->root[1], data->imaginary[0], data->imaginary[1] },
+        data->error_code
+    };
+
+    solve_quartic_equation_batch(data->a, data->b, data->c, data->d, data->e, data->count,
+                                 &columns);
+}
+
+static void bench_describe_snprintf(bench_data* const data) {
+    // Roots printed with %lf can be much longer than the fast path's bound
+    char buffer[512];
+
+    for (size_t i = 0; i < data->count; ++ i)
+        describe_equation_solution(data->solutions + i, sizeof(buffer), buffer);
+}
+
+static void bench_describe_fast(bench_data* const data) {
+    for (size_t i = 0; i < data->count; ++ i) {
+        char* const buffer = data->arena + i * (EQUATION_DESCRIPTION_MAX_LENGTH + 1);
+        describe_equation_solution_fast(data->solutions + i, buffer);
+    }
+}
+
+static void bench_describe_batch(bench_data* const data) {
+    const equation_solution_columns columns = solution_columns(data);
+    describe_equation_solutions_batch(&columns, data->count, data->arena, data->offsets);
+}
+
+// Describe benchmarks need solutions of the current input
+static void prepare_solutions(bench_data* const data) {
+    for (size_t i = 0; i < data->count; ++ i) {
+        data->solutions[i] = { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+        solve_quadratic_equation(data->a[i], data->b[i], data->c[i], data->solutions + i);
+    }
+
+    bench_batch(data);
+}
+
+struct bench_case {
+    const char* name;
+    void (*run)(bench_data* const data);
+
+    int tier; // Kernel tier to force, or -1 to keep the active one
+};
+
+static const bench_case CASES[] = {
+    { "single",            bench_single,            -1            },
+    { "batch_scalar",      bench_batch,             SCALAR_KERNEL },
+    { "batch_sse2",        bench_batch,             SSE2_KERNEL   },
+    { "batch_avx2",        bench_batch,             AVX2_KERNEL   },
+    { "batch_avx512",      bench_batch,             AVX512_KERNEL },
+    { "batch_polished",    bench_batch_polished,    -1            },
+    { "parallel",          bench_parallel,          -1            },
+    { "parallel_small_pages", bench_small_pages,    -1            },
+    { "parallel_thp",      bench_transparent_huge_pages, -1       },
+    { "parallel_hugetlb",  bench_explicit_huge_pages, -1          },
+    { "batch_mixed",       bench_mixed,             -1            },
+    { "batch_partitioned", bench_partitioned,       -1            },
+    { "batch_aggregate",   bench_batch_aggregate,   -1            },
+    { "parallel_aggregate", bench_parallel_aggregate, -1           },
+    { "async_blocks",      bench_async,             -1            },
+    { "single_cached",     bench_single_cached,     -1            },
+    { "parallel_cached",   bench_parallel_cached,   -1            },
+    { "sweep",             bench_sweep,             -1            },
+    { "sweep_pointwise",   bench_sweep_pointwise,   -1            },
+    { "count_roots",       bench_count_roots,       -1            },
+    { "largest_root",      bench_largest_root,      -1            },
+    { "root_in_interval",  bench_root_in_interval,  -1            },
+    { "batch_complex",     bench_batch_complex,     -1            },
+    { "batch_cubic",       bench_cubic,             -1            },
+    { "batch_quartic",     bench_quartic,           -1            },
+    { "describe_snprintf", bench_describe_snprintf, -1            },
+    { "describe_fast",     bench_describe_fast,     -1            },
+    { "describe_batch",    bench_describe_batch,    -1            },
+};
+
+// ============================== Driver ================================
+
+struct bench_result {
+    double ns_per_equation;
+    double equations_per_second;
+    double cycles_per_equation; // Negative when there's no cycle counter
+};
+
+static inline uint64_t read_cycle_counter(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static bool has_cycle_counter(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Best of several runs, after one warm-up run
+static bench_result measure(const bench_case* const bench, bench_data* const data,
+                            const int repeats) {
+    bench->run(data);
+
+    double best_seconds = INFINITY;
+    uint64_t best_cycles = UINT64_MAX;
+
+    for (int i = 0; i < repeats; ++ i) {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t start_cycles = read_cycle_counter();
+
+        bench->run(data);
+
+        const uint64_t cycles = read_cycle_counter() - start_cycles;
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (elapsed.count() < best_seconds)
+            best_seconds = elapsed.count();
+
+        if (cycles < best_cycles)
+            best_cycles = cycles;
+    }
+
+    const double count = (double) data->count;
+    return {
+        best_seconds * 1e9 / count,
+        count / best_seconds,
+        has_cycle_counter() ? (double) best_cycles / count : -1.0
+    };
+}
+
+struct bench_options {
+    size_t count;
+    int repeats;
+    const char* json_path; // NULL means no JSON
+    const char* filter;    // Run only cases with this substring, NULL means all
+};
+
+static bool parse_options(int argc, char* argv[], bench_options* const options) {
+    *options = { 1 << 20, 5, NULL, NULL };
+
+    for (int i = 1; i < argc; ++ i) {
+        const bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--size") == 0 && has_value)
+            options->count = (size_t) strtoull(argv[++ i], NULL, 10);
+        else if (strcmp(argv[i], "--repeat") == 0 && has_value)
+            options->repeats = atoi(argv[++ i]);
+        else if (strcmp(argv[i], "--json") == 0 && has_value)
+            options->json_path = argv[++ i];
+        else if (strcmp(argv[i], "--filter") == 0 && has_value)
+            options->filter = argv[++ i];
+        else
+            return false;
+    }
+
+    return options->count > 0 && options->repeats > 0;
+}
+
+int main(int argc, char* argv[]) {
+    bench_options options {};
+    if (!parse_options(argc, argv, &options)) {
+        fprintf(stderr, "Usage: %s [--size equations] [--repeat runs] "
+                        "[--filter substring] [--json file|-]\n", argv[0]);
+        return 1;
+    }
+
+    bench_data data {};
+    if (!allocate_bench_data(&data, options.count)) {
+        fprintf(stderr, "Can't allocate %zu equations\n", options.count);
+        free_bench_data(&data);
+        return 1;
+    }
+
+    for (size_t i = 0; i < data.count; ++ i) {
+        data.d[i] = random_double(-100.0, 100.0);
+        data.e[i] = random_double(-100.0, 100.0);
+    }
+
+    FILE* json = NULL;
+    if (options.json_path != NULL) {
+        json = strcmp(options.json_path, "-") == 0 ? stdout : fopen(options.json_path, "w");
+
+        if (json == NULL) {
+            fprintf(stderr, "Can't open \"%s\"\n", options.json_path);
+            free_bench_data(&data);
+            return 1;
+        }
+    }
+
+    // Human-readable table goes to stderr when JSON goes to stdout
+    FILE* const table = json == stdout ? stderr : stdout;
+
+    const kernel_tier detected = detect_kernel_tier();
+    const kernel_tier default_tier = get_active_kernel_tier();
+
+    if (json != NULL)
+        fprintf(json, "{\n  \"equations\": %zu,\n  \"repeats\": %d,\n"
+                      "  \"detected_kernel\": \"%s\",\n  \"threads\": %zu,\n"
+                      "  \"results\": [",
+                options.count, options.repeats, kernel_tier_name(detected),
+                solver_thread_pool_size(get_default_solver_thread_pool()));
+
+    fprintf(table, "%-24s %-20s %12s %16s %12s\n",
+            "distribution", "benchmark", "ns/equation", "equations/s", "cycles/eq");
+
+    bool is_first_result = true;
+    for (const bench_distribution& distribution: DISTRIBUTIONS) {
+        distribution.fill(&data);
+        prepare_solutions(&data);
+        ++ bench_input_generation;
+
+        // Cached benchmarks start with empty caches on every input
+        if (bench_cache != NULL)
+            clear_solution_cache(bench_cache);
+
+        if (bench_sharded_cache != NULL)
+            clear_sharded_solution_cache(bench_sharded_cache);
+
+        for (const bench_case& bench: CASES) {
+            if (options.filter != NULL && strstr(bench.name, options.filter) == NULL)
+                continue;
+
+            if (bench.tier >= 0 && (bench.tier > detected ||
+                                    force_kernel_tier((kernel_tier) bench.tier) != 0))
+                continue; // Not supported here
+
+            is_bench_skipped = false;
+
+            const bench_result result = measure(&bench, &data, options.repeats);
+            force_kernel_tier(default_tier);
+            unpin_bench_main_thread();
+
+            if (is_bench_skipped)
+                continue;
+
+            fprintf(table, "%-24s %-20s %12.3f %16.0f %12.2f\n", distribution.name,
+                    bench.name, result.ns_per_equation, result.equations_per_second,
+                    result.cycles_per_equation);
+
+            if (json != NULL) {
+                fprintf(json, "%s\n    { \"distribution\": \"%s\", \"benchmark\": \"%s\", "
+                              "\"ns_per_equation\": %.6f, \"equations_per_second\": %.1f, "
+                              "\"cycles_per_equation\": ",
+                        is_first_result ? "" : ",", distribution.name, bench.name,
+                        result.ns_per_equation, result.equations_per_second);
+
+                if (result.cycles_per_equation >= 0.0)
+                    fprintf(json, "%.4f }", result.cycles_per_equation);
+                else
+                    fprintf(json, "null }");
+            }
+
+            is_first_result = false;
+        }
+    }
+
+    if (json != NULL) {
+        fprintf(json, "\n  ]\n}\n");
+
+        if (json != stdout)
+            fclose(json);
+    }
+
+    destroy_solution_cache(bench_cache);
+    destroy_sharded_solution_cache(bench_sharded_cache);
+    destroy_async_solver(bench_async_solver);
+    destroy_async_completion_queue(bench_completions);
+
+    for (batch_buffers& buffers : bench_buffers)
+        destroy_batch_buffers(&buffers);
+
+    destroy_solver_thread_pool(bench_pinned_pool);
+
+    free_bench_data(&data);
+    return 0;
+}
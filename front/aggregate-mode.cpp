@@ -0,0 +1,19 @@
+#include "aggregate-mode.h"
+#include "binary-equation-files.h"
+
+int run_aggregate_mode(const char* const input_path, solution_aggregate* const aggregate,
+                       FILE* const output) {
+
+    coefficient_file_view input {};
+    const int error = open_coefficient_file(input_path, &input);
+    if (error != 0)
+        return error;
+
+    aggregate_quadratic_equation_batch_parallel(NULL, aggregate, input.a, input.b, input.c,
+                                                (size_t) input.count);
+
+    close_coefficient_file(&input);
+
+    print_solution_aggregate(output, aggregate);
+    return 0;
+}
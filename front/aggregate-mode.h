@@ -0,0 +1,23 @@
+#ifndef EQUATION_SOLVER_FRONT_AGGREGATE_MODE_H
+#define EQUATION_SOLVER_FRONT_AGGREGATE_MODE_H
+
+#include <stdio.h>
+
+#include "solution-aggregate.h"
+
+/**
+   @brief Solve binary coefficient file and print only the totals of its solutions
+
+   The file is memory-mapped and solved on all threads, solutions are folded
+   into @p aggregate as they are produced and never stored.
+
+   @param [in]     input_path Coefficient file, see binary-equation-files.h
+   @param [in,out] aggregate  Aggregate set up by #init_solution_aggregate
+   @param [in]     output     Where the totals are printed
+
+   @return 0 on success, #binary_file_error_code on failure.
+ */
+int run_aggregate_mode(const char* const input_path, solution_aggregate* const aggregate,
+                       FILE* const output);
+
+#endif // EQUATION_SOLVER_FRONT_AGGREGATE_MODE_H
@@ -0,0 +1,37 @@
+#include <sys/stat.h>
+
+#include "binary-mode.h"
+#include "binary-equation-files.h"
+#include "quadratic-equation-parallel.h"
+
+// Creating the output truncates it, which would wipe the input out from under the solver
+static bool is_same_file(const char* const first_path, const char* const second_path) {
+    struct stat first {}, second {};
+
+    return stat(first_path, &first) == 0 && stat(second_path, &second) == 0 &&
+        first.st_dev == second.st_dev && first.st_ino == second.st_ino;
+}
+
+int run_binary_mode(const char* const input_path, const char* const output_path) {
+    if (is_same_file(input_path, output_path))
+        return BINARY_FILE_SAME_FILE;
+
+    coefficient_file_view input {};
+    int error = open_coefficient_file(input_path, &input);
+    if (error != 0)
+        return error;
+
+    solution_file_view output {};
+    error = create_solution_file(output_path, input.count, &output);
+    if (error != 0) {
+        close_coefficient_file(&input);
+        return error;
+    }
+
+    solve_quadratic_equation_batch_parallel(NULL, input.a, input.b, input.c,
+                                            (size_t) input.count, &output.columns);
+
+    error = close_solution_file(&output);
+    close_coefficient_file(&input);
+    return error;
+}
@@ -0,0 +1,14 @@
+#ifndef EQUATION_SOLVER_FRONT_BINARY_MODE_H
+#define EQUATION_SOLVER_FRONT_BINARY_MODE_H
+
+/**
+   @brief Solve binary coefficient file into a new binary solution file
+
+   Both files are memory-mapped and solver works directly on their columns,
+   see binary-equation-files.h for the format.
+
+   @return 0 on success, #binary_file_error_code on failure.
+ */
+int run_binary_mode(const char* const input_path, const char* const output_path);
+
+#endif // EQUATION_SOLVER_FRONT_BINARY_MODE_H
@@ -0,0 +1,9 @@
+#include <stdio.h>
+
+#include "stream-mode.h"
+#include "stream-pipeline.h"
+
+int run_stream_mode(FILE* const input, FILE* const output) {
+    // Parsing, solving and formatting overlap on different threads
+    return run_stream_pipeline(input, output, 0);
+}
@@ -0,0 +1,16 @@
+#ifndef EQUATION_SOLVER_FRONT_STREAM_MODE_H
+#define EQUATION_SOLVER_FRONT_STREAM_MODE_H
+
+#include <stdio.h>
+
+/**
+   @brief Solve every "a b c" line of @p input, write one line per equation
+
+   Input is read in large blocks and solved in batches, output lines are
+   described by #format_solution_line.
+
+   @return 0 on success, -1 on read, write or allocation failure.
+ */
+int run_stream_mode(FILE* const input, FILE* const output);
+
+#endif // EQUATION_SOLVER_FRONT_STREAM_MODE_H
@@ -0,0 +1,375 @@
+#include <cstddef>
+#include <cstdint>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <atomic>
+#include <new>
+#include <thread>
+#include <system_error>
+
+#include "async-solver.h"
+#include "ring-buffer.h"
+
+// Submissions gathered into one batch, every one has at least one equation
+static const size_t MAX_GATHERED_REQUESTS = 1024;
+
+struct async_request {
+    async_completion_queue* queue; // NULL asks the solver thread to stop
+
+    const double* a;
+    const double* b;
+    const double* c;
+    size_t count;
+    equation_solution_columns solutions;
+
+    async_ticket ticket;
+    void* user_data;
+};
+
+struct async_completion_queue {
+    mpsc_ring<async_completion> completions;
+    uint32_t capacity;
+    int event_fd;
+
+    // Submissions that have a slot in completions reserved
+    alignas(64) std::atomic<uint32_t> in_flight;
+
+    // Whether the fd was written since the consumer last looked, so the
+    // solver thread makes at most one write per drain
+    alignas(64) std::atomic<bool> is_signalled;
+};
+
+// Gathered submissions, solved in place by pool tasks of about
+// PARALLEL_BATCH_CHUNK_SIZE equations each. Solving them together in
+// staging columns would cost more in copies than the kernel takes
+struct async_batch {
+    async_request requests[MAX_GATHERED_REQUESTS];
+    size_t failed[MAX_GATHERED_REQUESTS];
+    size_t number_of_requests;
+    size_t size;
+
+    // Task i solves requests task_first[i] to task_first[i + 1] - 1
+    size_t task_first[MAX_GATHERED_REQUESTS + 1];
+    size_t number_of_tasks;
+    size_t task_size;
+};
+
+struct async_solver {
+    mpsc_ring<async_request> requests;
+    solver_thread_pool* pool;
+    std::thread thread;
+
+    // Solver thread sleeps on this fd rather than in pop_mpsc_ring: a thread
+    // waiting on a ring makes every push a futex syscall, here only the
+    // submitter that finds the thread asleep writes the fd
+    int wake_fd;
+
+    // Used by the solver thread only
+    async_batch* batch;
+
+    alignas(64) std::atomic<async_ticket> next_ticket;
+    alignas(64) std::atomic<bool> is_sleeping;
+};
+
+static void notify_queue(async_completion_queue* const queue) {
+    if (queue->is_signalled.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    const uint64_t one = 1;
+    while (write(queue->event_fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+// A slot was reserved on submission, so the push never waits. The queue
+// is notified separately, after every completion of a batch is pushed
+static void push_completion(const async_request* const request, const size_t failed) {
+    push_mpsc_ring(&request->queue->completions,
+                   async_completion { request->ticket, request->user_data, failed });
+}
+
+static void complete_request(const async_request* const request, const size_t failed) {
+    push_completion(request, failed);
+    notify_queue(request->queue);
+}
+
+static void solve_in_place(async_solver* const solver, const async_request* const request) {
+    const size_t failed = solve_quadratic_equation_batch_parallel(
+        solver->pool, request->a, request->b, request->c, request->count, &request->solutions);
+
+    complete_request(request, failed);
+}
+
+static void add_to_batch(async_batch* const batch, const async_request* const request) {
+    if (batch->number_of_tasks == 0 || batch->task_size >= PARALLEL_BATCH_CHUNK_SIZE) {
+        batch->task_first[batch->number_of_tasks ++] = batch->number_of_requests;
+        batch->task_size = 0;
+    }
+
+    batch->requests[batch->number_of_requests ++] = *request;
+    batch->size += request->count;
+    batch->task_size += request->count;
+}
+
+static void solve_batch_task(void* const context, const size_t task_index, const size_t) {
+    async_batch* const batch = (async_batch*) context;
+
+    for (size_t i = batch->task_first[task_index]; i < batch->task_first[task_index + 1]; ++ i) {
+        const async_request* const request = batch->requests + i;
+
+        batch->failed[i] = solve_quadratic_equation_batch(request->a, request->b, request->c,
+                                                          request->count, &request->solutions);
+    }
+}
+
+static void solve_batch(async_solver* const solver) {
+    async_batch* const batch = solver->batch;
+
+    if (batch->number_of_requests == 0)
+        return;
+
+    batch->task_first[batch->number_of_tasks] = batch->number_of_requests;
+
+    solver_thread_pool* const pool =
+        solver->pool != NULL ? solver->pool : get_default_solver_thread_pool();
+
+    if (batch->number_of_tasks == 1 || pool == NULL) {
+        for (size_t task = 0; task < batch->number_of_tasks; ++ task)
+            solve_batch_task(batch, task, 0);
+    } else
+        run_solver_thread_pool_tasks(pool, batch->number_of_tasks, solve_batch_task, batch);
+
+    for (size_t i = 0; i < batch->number_of_requests; ++ i)
+        push_completion(batch->requests + i, batch->failed[i]);
+
+    // A woken consumer drains the whole batch at once instead of one completion at a time
+    for (size_t i = 0; i < batch->number_of_requests; ++ i)
+        notify_queue(batch->requests[i].queue);
+
+    batch->number_of_requests = 0;
+    batch->number_of_tasks = 0;
+    batch->size = 0;
+}
+
+static void wake_solver(async_solver* const solver) {
+    // Pairs with the fence in wait_for_request: either the solver thread
+    // sees the pushed request, or this thread sees it asleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!solver->is_sleeping.load(std::memory_order_relaxed) ||
+        !solver->is_sleeping.exchange(false, std::memory_order_relaxed))
+        return;
+
+    const uint64_t one = 1;
+    while (write(solver->wake_fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+static void wait_for_request(async_solver* const solver, async_request* const request) {
+    while (true) {
+        for (int attempt = 0; attempt < RING_SPIN_ATTEMPTS; ++ attempt)
+            if (try_pop_mpsc_ring(&solver->requests, request))
+                return;
+
+        solver->is_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (try_pop_mpsc_ring(&solver->requests, request)) {
+            // If a submitter already took the flag, its write only causes a spurious wakeup
+            solver->is_sleeping.store(false, std::memory_order_relaxed);
+            return;
+        }
+
+        uint64_t value;
+        while (read(solver->wake_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+        }
+    }
+}
+
+static void solve_requests(async_solver* const solver) {
+    async_batch* const batch = solver->batch;
+
+    while (true) {
+        async_request request;
+        wait_for_request(solver, &request);
+
+        bool is_stopped = false;
+
+        // Take everything submitted so far, a batch is solved early only when it's full
+        do {
+            if (request.queue == NULL) {
+                is_stopped = true;
+                break;
+            }
+
+            if (request.count == 0)
+                complete_request(&request, 0);
+            else if (request.count > ASYNC_GATHER_LIMIT)
+                solve_in_place(solver, &request);
+            else {
+                if (batch->size + request.count > ASYNC_BATCH_SIZE ||
+                    batch->number_of_requests == MAX_GATHERED_REQUESTS)
+                    solve_batch(solver);
+
+                add_to_batch(batch, &request);
+            }
+        } while (try_pop_mpsc_ring(&solver->requests, &request));
+
+        solve_batch(solver);
+
+        if (is_stopped)
+            return;
+    }
+}
+
+static void free_async_solver(async_solver* const solver) {
+    if (solver->wake_fd >= 0)
+        close(solver->wake_fd);
+
+    destroy_mpsc_ring(&solver->requests);
+    delete solver->batch;
+    delete solver;
+}
+
+async_solver* create_async_solver(const size_t capacity, solver_thread_pool* const pool) {
+    async_solver* const solver = new (std::nothrow) async_solver {};
+    if (solver == NULL)
+        return NULL;
+
+    solver->pool = pool;
+    solver->next_ticket.store(1, std::memory_order_relaxed);
+    solver->batch = new (std::nothrow) async_batch;
+    solver->wake_fd = eventfd(0, EFD_CLOEXEC);
+
+    // One more slot for the stop request
+    if (solver->batch == NULL || solver->wake_fd < 0 ||
+        init_mpsc_ring(&solver->requests, capacity + 1) != 0) {
+
+        free_async_solver(solver);
+        return NULL;
+    }
+
+    solver->batch->number_of_requests = 0;
+    solver->batch->number_of_tasks = 0;
+    solver->batch->size = 0;
+
+    try {
+        solver->thread = std::thread(solve_requests, solver);
+    } catch (const std::system_error&) {
+        free_async_solver(solver);
+        return NULL;
+    }
+
+    return solver;
+}
+
+void destroy_async_solver(async_solver* const solver) {
+    if (solver == NULL)
+        return;
+
+    // Stop request comes after every earlier submission
+    push_mpsc_ring(&solver->requests, async_request {});
+    wake_solver(solver);
+
+    solver->thread.join();
+    free_async_solver(solver);
+}
+
+async_completion_queue* create_async_completion_queue(const size_t capacity) {
+    async_completion_queue* const queue = new (std::nothrow) async_completion_queue {};
+    if (queue == NULL)
+        return NULL;
+
+    queue->capacity = ring_capacity_for(capacity);
+    queue->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (queue->event_fd < 0 || init_mpsc_ring(&queue->completions, capacity) != 0) {
+        destroy_async_completion_queue(queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+void destroy_async_completion_queue(async_completion_queue* const queue) {
+    if (queue == NULL)
+        return;
+
+    if (queue->event_fd >= 0)
+        close(queue->event_fd);
+
+    destroy_mpsc_ring(&queue->completions);
+    delete queue;
+}
+
+int async_completion_queue_fd(const async_completion_queue* const queue) {
+    return queue->event_fd;
+}
+
+async_ticket submit_async_quadratic_equation_batch(async_solver* const solver,
+                                                   async_completion_queue* const queue,
+                                                   const double* const a, const double* const b,
+                                                   const double* const c, const size_t count,
+                                                   const equation_solution_columns* const solutions,
+                                                   void* const user_data) {
+
+    // Reserve the completion slot first, the solver thread must never wait for a consumer
+    if (queue->in_flight.fetch_add(1, std::memory_order_relaxed) >= queue->capacity) {
+        queue->in_flight.fetch_sub(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    const async_ticket ticket = solver->next_ticket.fetch_add(1, std::memory_order_relaxed);
+    const async_request request { queue, a, b, c, count, *solutions, ticket, user_data };
+
+    if (!try_push_mpsc_ring(&solver->requests, request)) {
+        queue->in_flight.fetch_sub(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    wake_solver(solver);
+    return ticket;
+}
+
+size_t poll_async_completions(async_completion_queue* const queue,
+                              async_completion* const completions,
+                              const size_t max_completions) {
+
+    // Reset the fd before the ring is read: a completion pushed after this
+    // point writes the fd again, so none is left behind without a wakeup
+    uint64_t value;
+    while (read(queue->event_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+    }
+
+    queue->is_signalled.exchange(false, std::memory_order_acq_rel);
+
+    size_t count = 0;
+    while (count < max_completions &&
+           try_pop_mpsc_ring(&queue->completions, completions + count))
+        ++ count;
+
+    queue->in_flight.fetch_sub((uint32_t) count, std::memory_order_relaxed);
+
+    // Keep the fd readable for the completions that didn't fit
+    if (count == max_completions && count > 0) {
+        queue->is_signalled.store(false, std::memory_order_relaxed);
+        notify_queue(queue);
+    }
+
+    return count;
+}
+
+size_t wait_async_completions(async_completion_queue* const queue,
+                              async_completion* const completions,
+                              const size_t max_completions) {
+    while (true) {
+        const size_t count = poll_async_completions(queue, completions, max_completions);
+        if (count > 0 || max_completions == 0)
+            return count;
+
+        pollfd readable { queue->event_fd, POLLIN, 0 };
+        if (poll(&readable, 1, -1) < 0 && errno != EINTR)
+            return 0;
+    }
+}
@@ -0,0 +1,244 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_ASYNC_SOLVER_H
+#define QUADRATIC_EQUATION_SOLVER_ASYNC_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "quadratic-equation-parallel.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define EQUATION_SOLVER_HAS_COROUTINES
+#endif
+
+/**
+   @file
+   @brief Solving batches without blocking the calling thread
+
+   Callers submit blocks of coefficients to an #async_solver and get a
+   ticket back right away. A solver thread collects everything submitted
+   since its last batch, from any number of threads, and hands small
+   blocks to the thread pool together, in tasks of about
+   #PARALLEL_BATCH_CHUNK_SIZE equations, so many small submissions cost one
+   wakeup and one pool job rather than one each.
+
+   Results are reported to an #async_completion_queue chosen at submission.
+   Every queue has an eventfd that is readable while the queue may have
+   completions, so a queue can be added to an existing epoll loop, and the
+   loop drains it with #poll_async_completions when the fd fires. No thread
+   is needed on the caller's side.
+
+   With C++20 coroutines a submission can also be awaited, see
+   #async_quadratic_equation_batch.
+ */
+struct async_solver;
+
+/**
+   @brief Queue of finished submissions of one consumer thread
+ */
+struct async_completion_queue;
+
+/**
+   @brief Handle of one submission, never 0
+ */
+typedef uint64_t async_ticket;
+
+/**
+   @brief Submissions of at most this many equations are gathered into
+   batches, larger ones are split into chunks by
+   #solve_quadratic_equation_batch_parallel on their own
+ */
+const size_t ASYNC_GATHER_LIMIT = PARALLEL_BATCH_CHUNK_SIZE;
+
+/**
+   @brief Number of equations a solver thread gathers before it hands them to the pool
+
+   Fewer are gathered when no more submissions are waiting.
+ */
+const size_t ASYNC_BATCH_SIZE = 4 * PARALLEL_BATCH_CHUNK_SIZE;
+
+/**
+   @brief Finished submission
+ */
+struct async_completion {
+    async_ticket ticket; /**< @brief Ticket returned by #submit_async_quadratic_equation_batch */
+    void* user_data;     /**< @brief Pointer passed on submission */
+    size_t failed;       /**< @brief Number of equations that had an illegal coefficient */
+};
+
+/**
+   @brief Start a solver thread
+
+   @param [in] capacity Max number of submissions waiting to be solved
+   @param [in] pool     Pool that solves large batches, NULL means
+                        #get_default_solver_thread_pool
+
+   @return New solver, or NULL if memory or the thread couldn't be allocated.
+ */
+async_solver* create_async_solver(const size_t capacity, solver_thread_pool* const pool);
+
+/**
+   @brief Finish every submission, then stop the solver thread and free the solver
+
+   @note Passing NULL is allowed and does nothing.
+ */
+void destroy_async_solver(async_solver* const solver);
+
+/**
+   @param [in] capacity Max number of submissions in flight to this queue,
+                        counting both unsolved and undrained ones
+
+   @return New queue, or NULL if memory or the eventfd couldn't be allocated.
+ */
+async_completion_queue* create_async_completion_queue(const size_t capacity);
+
+/**
+   @note Submissions to the queue must all be drained before it's destroyed.
+   Passing NULL is allowed and does nothing.
+ */
+void destroy_async_completion_queue(async_completion_queue* const queue);
+
+/**
+   @brief Eventfd that is readable while @p queue may have completions
+
+   Add it to epoll (or poll) for reading, then call #poll_async_completions.
+   The fd is owned by the queue, don't read from or close it.
+ */
+int async_completion_queue_fd(const async_completion_queue* const queue);
+
+/**
+   @brief Submit @p count equations to be solved like #solve_quadratic_equation_batch
+
+   @param [in] solver    Solver to submit to, from any thread
+   @param [in] queue     Queue that receives the completion
+   @param [in] a         Column of coefficients a
+   @param [in] b         Column of coefficients b
+   @param [in] c         Column of coefficients c
+   @param [in] count     Number of equations
+   @param [in] solutions Output columns, each with room for @p count elements
+   @param [in] user_data Pointer passed back in the completion
+
+   @return Ticket of the submission, or 0 if the solver or @p queue is full.
+   The caller should drain @p queue and try again.
+
+   @note Coefficient and output columns must stay valid and untouched until
+   the completion is drained, the #equation_solution_columns struct itself
+   is copied.
+ */
+async_ticket submit_async_quadratic_equation_batch(async_solver* const solver,
+                                                   async_completion_queue* const queue,
+                                                   const double* const a, const double* const b,
+                                                   const double* const c, const size_t count,
+                                                   const equation_solution_columns* const solutions,
+                                                   void* const user_data);
+
+/**
+   @brief Take up to @p max_completions finished submissions out of @p queue, without waiting
+
+   Outputs of a returned submission are complete and visible to the caller.
+
+   @return Number of completions written to @p completions. If it's
+   @p max_completions, more may be left and the fd stays readable.
+
+   @note Only one thread at a time may drain a queue.
+ */
+size_t poll_async_completions(async_completion_queue* const queue,
+                              async_completion* const completions,
+                              const size_t max_completions);
+
+/**
+   @brief Same as #poll_async_completions, but waits for at least one completion
+
+   @return Number of completions, 0 only if waiting for the fd failed.
+ */
+size_t wait_async_completions(async_completion_queue* const queue,
+                              async_completion* const completions,
+                              const size_t max_completions);
+
+#ifdef EQUATION_SOLVER_HAS_COROUTINES
+
+/**
+   @brief Awaitable submission, see #async_quadratic_equation_batch
+
+   Resumes the awaiting coroutine from #resume_async_awaiters, on the
+   thread that drains the queue, with the completion as the result. If
+   the submission is refused, the coroutine isn't suspended and gets a
+   completion with ticket 0.
+ */
+struct async_solve_awaitable {
+    async_solver* solver;
+    async_completion_queue* queue;
+
+    const double* a;
+    const double* b;
+    const double* c;
+    size_t count;
+    equation_solution_columns solutions;
+
+    std::coroutine_handle<> waiter;
+    async_completion completion;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    bool await_suspend(const std::coroutine_handle<> handle) noexcept {
+        waiter = handle;
+        completion = { 0, this, 0 };
+
+        // Suspend only if the completion will come
+        return submit_async_quadratic_equation_batch(solver, queue, a, b, c, count,
+                                                     &solutions, this) != 0;
+    }
+
+    async_completion await_resume() const noexcept {
+        return completion;
+    }
+};
+
+/**
+   @brief Submission for co_await
+
+   @note The queue must only be used for awaited submissions and drained
+   with #resume_async_awaiters.
+ */
+inline async_solve_awaitable
+async_quadratic_equation_batch(async_solver* const solver, async_completion_queue* const queue,
+                               const double* const a, const double* const b,
+                               const double* const c, const size_t count,
+                               const equation_solution_columns* const solutions) {
+    return { solver, queue, a, b, c, count, *solutions, {}, {} };
+}
+
+/**
+   @brief Drain @p queue and resume the coroutine of every completion
+
+   Call it when the fd of the queue fires, the same way as #poll_async_completions.
+
+   @return Number of resumed coroutines.
+ */
+inline size_t resume_async_awaiters(async_completion_queue* const queue) {
+    async_completion completions[64];
+    size_t resumed = 0;
+
+    while (true) {
+        const size_t count = poll_async_completions(queue, completions, 64);
+
+        for (size_t i = 0; i < count; ++ i) {
+            async_solve_awaitable* const awaitable =
+                (async_solve_awaitable*) completions[i].user_data;
+
+            awaitable->completion = completions[i];
+            awaitable->waiter.resume();
+        }
+
+        resumed += count;
+
+        if (count < 64)
+            return resumed;
+    }
+}
+
+#endif // EQUATION_SOLVER_HAS_COROUTINES
+
+#endif // QUADRATIC_EQUATION_SOLVER_ASYNC_SOLVER_H
@@ -0,0 +1,168 @@
+#include <cstddef>
+#include <cstdint>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "batch-buffers.h"
+
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static const size_t NUMBER_OF_COLUMNS = 8;
+
+static const char* const MODE_NAMES[] = {
+    "small_pages", "transparent_huge_pages", "explicit_huge_pages"
+};
+
+static_assert(sizeof(MODE_NAMES) / sizeof(*MODE_NAMES) == NUMBER_OF_BUFFER_PAGE_MODES,
+              "Every page mode needs a name");
+
+// Columns in the order they are laid out in the mapping
+struct buffer_columns {
+    void* column[NUMBER_OF_COLUMNS];
+    size_t element_size[NUMBER_OF_COLUMNS];
+    size_t count;
+};
+
+const char* buffer_page_mode_name(const buffer_page_mode mode) {
+    if ((size_t) mode >= NUMBER_OF_BUFFER_PAGE_MODES)
+        return NULL;
+
+    return MODE_NAMES[mode];
+}
+
+size_t buffer_page_size(const buffer_page_mode mode) {
+    return mode == SMALL_PAGES ? (size_t) sysconf(_SC_PAGESIZE) : HUGE_PAGE_SIZE;
+}
+
+static size_t round_up(const size_t size, const size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// Writing chunk zeroes is what places its pages, they are zero already
+static void touch_chunk(void* const context, const size_t task_index, const size_t) {
+    const buffer_columns* const columns = (const buffer_columns*) context;
+
+    const size_t begin = task_index * PARALLEL_BATCH_CHUNK_SIZE;
+    const size_t left = columns->count - begin;
+    const size_t size = left < PARALLEL_BATCH_CHUNK_SIZE ? left : PARALLEL_BATCH_CHUNK_SIZE;
+
+    for (size_t i = 0; i < NUMBER_OF_COLUMNS; ++ i)
+        memset((char*) columns->column[i] + begin * columns->element_size[i], 0,
+               size * columns->element_size[i]);
+}
+
+// Same split into tasks as solve_quadratic_equation_batch_parallel
+static void touch_columns(solver_thread_pool* const pool, buffer_columns* const columns) {
+    solver_thread_pool* const used_pool =
+        pool != NULL ? pool : get_default_solver_thread_pool();
+
+    const size_t number_of_chunks =
+        (columns->count + PARALLEL_BATCH_CHUNK_SIZE - 1) / PARALLEL_BATCH_CHUNK_SIZE;
+
+    if (number_of_chunks <= 1 || used_pool == NULL) {
+        for (size_t chunk = 0; chunk < number_of_chunks; ++ chunk)
+            touch_chunk(columns, chunk, 0);
+
+        return;
+    }
+
+    run_solver_thread_pool_tasks(used_pool, number_of_chunks, touch_chunk, columns);
+}
+
+static void* map_pages(const size_t size, const buffer_page_mode mode) {
+    const int protection = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (mode == EXPLICIT_HUGE_PAGES) {
+        int huge_flags = flags | MAP_HUGETLB;
+#ifdef MAP_HUGE_2MB
+        huge_flags |= MAP_HUGE_2MB;
+#endif
+        void* const data = mmap(NULL, size, protection, huge_flags, -1, 0);
+        return data != MAP_FAILED ? data : NULL;
+    }
+
+    if (mode == SMALL_PAGES) {
+        void* const data = mmap(NULL, size, protection, flags, -1, 0);
+        if (data == MAP_FAILED)
+            return NULL;
+
+        madvise(data, size, MADV_NOHUGEPAGE);
+        return data;
+    }
+
+    // Transparent huge pages need a 2 MiB aligned range, map more and cut the ends off
+    const size_t padded = size + HUGE_PAGE_SIZE;
+
+    char* const data = (char*) mmap(NULL, padded, protection, flags, -1, 0);
+    if (data == MAP_FAILED)
+        return NULL;
+
+    const size_t misalignment = (uintptr_t) data % HUGE_PAGE_SIZE;
+    char* const aligned = data + (misalignment == 0 ? 0 : HUGE_PAGE_SIZE - misalignment);
+
+    if (aligned != data)
+        munmap(data, (size_t) (aligned - data));
+
+    if (aligned + size != data + padded)
+        munmap(aligned + size, (size_t) (data + padded - (aligned + size)));
+
+    madvise(aligned, size, MADV_HUGEPAGE);
+    return aligned;
+}
+
+int init_batch_buffers(batch_buffers* const buffers, const size_t count,
+                       const buffer_page_mode mode, solver_thread_pool* const pool) {
+    *buffers = {};
+    buffers->mode = mode;
+
+    if (count == 0)
+        return 0;
+
+    const size_t element_size[NUMBER_OF_COLUMNS] = {
+        sizeof(double), sizeof(double), sizeof(double),
+        sizeof(solution_status), sizeof(int), sizeof(double), sizeof(double), sizeof(int)
+    };
+
+    const size_t page_size = buffer_page_size(mode);
+
+    size_t offsets[NUMBER_OF_COLUMNS + 1] = {};
+    for (size_t i = 0; i < NUMBER_OF_COLUMNS; ++ i)
+        offsets[i + 1] = offsets[i] + round_up(count * element_size[i], page_size);
+
+    char* const data = (char*) map_pages(offsets[NUMBER_OF_COLUMNS], mode);
+    if (data == NULL)
+        return -1;
+
+    buffers->count = count;
+    buffers->mapping = data;
+    buffers->mapping_size = offsets[NUMBER_OF_COLUMNS];
+
+    buffer_columns columns {};
+    columns.count = count;
+
+    for (size_t i = 0; i < NUMBER_OF_COLUMNS; ++ i) {
+        columns.column[i] = data + offsets[i];
+        columns.element_size[i] = element_size[i];
+    }
+
+    buffers->a = (double*) columns.column[0];
+    buffers->b = (double*) columns.column[1];
+    buffers->c = (double*) columns.column[2];
+
+    buffers->solutions = {
+        (solution_status*) columns.column[3], (int*) columns.column[4],
+        { (double*) columns.column[5], (double*) columns.column[6] }, (int*) columns.column[7]
+    };
+
+    touch_columns(pool, &columns);
+    return 0;
+}
+
+void destroy_batch_buffers(batch_buffers* const buffers) {
+    if (buffers->mapping != NULL)
+        munmap(buffers->mapping, buffers->mapping_size);
+
+    *buffers = {};
+}
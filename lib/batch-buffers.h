@@ -0,0 +1,84 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_BATCH_BUFFERS_H
+#define QUADRATIC_EQUATION_SOLVER_BATCH_BUFFERS_H
+
+#include <cstddef>
+
+#include "quadratic-equation-parallel.h"
+
+/**
+   @brief Pages that back columns of #batch_buffers
+ */
+enum buffer_page_mode {
+    SMALL_PAGES,            /**< @brief Regular 4 KiB pages, even if transparent huge
+                                        pages are on for every mapping */
+    TRANSPARENT_HUGE_PAGES, /**< @brief 2 MiB pages asked for with madvise(MADV_HUGEPAGE),
+                                        the kernel falls back to small pages silently */
+    EXPLICIT_HUGE_PAGES,    /**< @brief 2 MiB pages from the pool reserved in
+                                        /proc/sys/vm/nr_hugepages, never swapped */
+
+    NUMBER_OF_BUFFER_PAGE_MODES /**< @brief Not a mode, number of modes */
+};
+
+/**
+   @return Name of @p mode, like "transparent_huge_pages", or NULL for a
+   value that isn't a #buffer_page_mode.
+ */
+const char* buffer_page_mode_name(const buffer_page_mode mode);
+
+/**
+   @brief Size of a page of @p mode, columns are aligned to it
+ */
+size_t buffer_page_size(const buffer_page_mode mode);
+
+/**
+   @brief Coefficient and solution columns of a large batch in one mapping
+
+   Meant for batches of millions of equations and more, where 4 KiB pages
+   miss in the TLB all the time and, on machines with several NUMA nodes,
+   pages end up on a node far from the thread that solves them.
+
+   Each column starts on a page boundary. Pages are placed by the kernel on
+   the node of the thread that touches them first, so #init_batch_buffers
+   touches every chunk of #PARALLEL_BATCH_CHUNK_SIZE equations on the pool
+   worker that solves it in #solve_quadratic_equation_batch_parallel with the
+   same pool. Pin the pool first with #pin_solver_thread_pool_workers, or
+   workers may move to another node later.
+ */
+struct batch_buffers {
+    double* a;
+    double* b;
+    double* c;
+    equation_solution_columns solutions;
+
+    size_t count;
+    buffer_page_mode mode;
+
+    void* mapping;
+    size_t mapping_size;
+};
+
+/**
+   @brief Map zero-filled columns for @p count equations
+
+   @param [out] buffers Buffers to initialize
+   @param [in]  count   Number of equations
+   @param [in]  mode    Pages to back the columns with
+   @param [in]  pool    Pool whose workers touch the chunks they will solve,
+                        NULL means #get_default_solver_thread_pool
+
+   @return 0 on success, -1 if memory couldn't be mapped, for
+   #EXPLICIT_HUGE_PAGES also when too few huge pages are reserved. On
+   failure @p buffers is left empty, with no columns and a count of 0.
+
+   @note Every column is padded to a whole page, so with huge pages a small
+   batch takes at least 8 pages of 2 MiB.
+ */
+int init_batch_buffers(batch_buffers* const buffers, const size_t count,
+                       const buffer_page_mode mode, solver_thread_pool* const pool);
+
+/**
+   @brief Unmap columns of @p buffers
+ */
+void destroy_batch_buffers(batch_buffers* const buffers);
+
+#endif // QUADRATIC_EQUATION_SOLVER_BATCH_BUFFERS_H
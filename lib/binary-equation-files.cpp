@@ -0,0 +1,203 @@
+#include <cstddef>
+#include <cstdint>
+#include <string.h>
+#include <stdio.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "binary-equation-files.h"
+
+// Columns of solution file store statuses as int32
+static_assert(sizeof(solution_status) == sizeof(int32_t), "Unexpected enum size");
+static_assert(sizeof(int) == sizeof(int32_t), "Unexpected int size");
+
+static const size_t HEADER_SIZE = sizeof(binary_file_header);
+
+static const size_t COEFFICIENT_BYTES_PER_EQUATION = 3 * sizeof(double);
+static const size_t SOLUTION_BYTES_PER_EQUATION = 2 * sizeof(double) + 3 * sizeof(int32_t);
+
+size_t coefficient_file_size(const uint64_t count) {
+    return HEADER_SIZE + count * COEFFICIENT_BYTES_PER_EQUATION;
+}
+
+size_t solution_file_size(const uint64_t count) {
+    return HEADER_SIZE + count * SOLUTION_BYTES_PER_EQUATION;
+}
+
+static binary_file_header make_header(const char* const magic, const uint64_t count) {
+    binary_file_header header {};
+
+    memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = BINARY_FILE_VERSION;
+    header.byte_order_mark = BINARY_FILE_BYTE_ORDER_MARK;
+    header.count = count;
+
+    return header;
+}
+
+static bool is_header_valid(const binary_file_header* const header, const char* const magic) {
+    return memcmp(header->magic, magic, sizeof(header->magic)) == 0 &&
+        header->version == BINARY_FILE_VERSION &&
+        header->byte_order_mark == BINARY_FILE_BYTE_ORDER_MARK;
+}
+
+static equation_solution_columns solution_columns(void* const mapping, const uint64_t count) {
+    char* const columns = (char*) mapping + HEADER_SIZE;
+
+    double* const first_root  = (double*) columns;
+    double* const second_root = first_root + count;
+
+    int* const status          = (int*) (second_root + count);
+    int* const number_of_roots = status + count;
+    int* const error_code      = number_of_roots + count;
+
+    return { (solution_status*) status, number_of_roots,
+             { first_root, second_root }, error_code };
+}
+
+// Map whole file at path, check its header and that it's long enough
+static int map_existing_file(const char* const path, const char* const magic,
+                             const size_t bytes_per_equation, const bool is_private,
+                             void** const mapping, size_t* const mapping_size) {
+
+    const int file = open(path, O_RDONLY);
+    if (file < 0)
+        return BINARY_FILE_IO_ERROR;
+
+    struct stat file_stat {};
+    if (fstat(file, &file_stat) != 0) {
+        close(file);
+        return BINARY_FILE_IO_ERROR;
+    }
+
+    const size_t size = (size_t) file_stat.st_size;
+    if (size < HEADER_SIZE) {
+        close(file);
+        return BINARY_FILE_TRUNCATED;
+    }
+
+    const int protection = is_private ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* const data = mmap(NULL, size, protection, MAP_PRIVATE, file, 0);
+    close(file); // Mapping stays valid
+
+    if (data == MAP_FAILED)
+        return BINARY_FILE_IO_ERROR;
+
+    const binary_file_header* const header = (const binary_file_header*) data;
+
+    int error = 0;
+    if (!is_header_valid(header, magic))
+        error = BINARY_FILE_BAD_HEADER;
+    // Count comes from the file, multiplying it first could wrap around
+    else if (header->count > (size - HEADER_SIZE) / bytes_per_equation)
+        error = BINARY_FILE_TRUNCATED;
+
+    if (error != 0) {
+        munmap(data, size);
+        return error;
+    }
+
+    // Columns are read front to back
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    *mapping = data;
+    *mapping_size = size;
+    return 0;
+}
+
+int write_coefficient_file(const char* const path, const double* const a,
+                           const double* const b, const double* const c,
+                           const uint64_t count) {
+
+    FILE* const file = fopen(path, "wb");
+    if (file == NULL)
+        return BINARY_FILE_IO_ERROR;
+
+    const binary_file_header header = make_header(COEFFICIENT_FILE_MAGIC, count);
+
+    bool is_written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    const double* const columns[] = { a, b, c };
+    for (const double* column: columns)
+        if (is_written && count != 0)
+            is_written = fwrite(column, sizeof(double), count, file) == count;
+
+    const bool is_closed = fclose(file) == 0;
+    return is_written && is_closed ? 0 : BINARY_FILE_IO_ERROR;
+}
+
+int open_coefficient_file(const char* const path, coefficient_file_view* const view) {
+    void* mapping = NULL;
+    size_t mapping_size = 0;
+
+    const int error = map_existing_file(path, COEFFICIENT_FILE_MAGIC,
+                                        COEFFICIENT_BYTES_PER_EQUATION, false, &mapping, &mapping_size);
+    if (error != 0)
+        return error;
+
+    const uint64_t count = ((const binary_file_header*) mapping)->count;
+    const double* const a = (const double*) ((const char*) mapping + HEADER_SIZE);
+
+    *view = { a, a + count, a + 2 * count, count, mapping, mapping_size };
+    return 0;
+}
+
+void close_coefficient_file(coefficient_file_view* const view) {
+    munmap(view->mapping, view->mapping_size);
+    *view = {};
+}
+
+int create_solution_file(const char* const path, const uint64_t count,
+                         solution_file_view* const view) {
+
+    const int file = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        return BINARY_FILE_IO_ERROR;
+
+    // Blocks are allocated up front, a sparse file would report a full
+    // disk as SIGBUS on a write through the mapping
+    const size_t size = solution_file_size(count);
+    if (posix_fallocate(file, 0, (off_t) size) != 0) {
+        close(file);
+        return BINARY_FILE_IO_ERROR;
+    }
+
+    void* const mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+
+    if (mapping == MAP_FAILED)
+        return BINARY_FILE_IO_ERROR;
+
+    *(binary_file_header*) mapping = make_header(SOLUTION_FILE_MAGIC, count);
+
+    *view = { solution_columns(mapping, count), count, mapping, size };
+    return 0;
+}
+
+int open_solution_file(const char* const path, solution_file_view* const view) {
+    void* mapping = NULL;
+    size_t mapping_size = 0;
+
+    const int error = map_existing_file(path, SOLUTION_FILE_MAGIC,
+                                        SOLUTION_BYTES_PER_EQUATION, true, &mapping, &mapping_size);
+    if (error != 0)
+        return error;
+
+    const uint64_t count = ((const binary_file_header*) mapping)->count;
+
+    *view = { solution_columns(mapping, count), count, mapping, mapping_size };
+    return 0;
+}
+
+int close_solution_file(solution_file_view* const view) {
+    // Private mappings of opened files have nothing to write back
+    const bool is_synced = msync(view->mapping, view->mapping_size, MS_SYNC) == 0;
+
+    munmap(view->mapping, view->mapping_size);
+    *view = {};
+
+    return is_synced ? 0 : BINARY_FILE_IO_ERROR;
+}
@@ -0,0 +1,144 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_BINARY_FILES_H
+#define QUADRATIC_EQUATION_SOLVER_BINARY_FILES_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "quadratic-equation-batch.h"
+
+/*
+   Binary files start with #binary_file_header followed by columns, all
+   in the byte order of the machine that wrote them:
+
+     Coefficients file: double a[count], double b[count], double c[count]
+
+     Solutions file:    double root0[count], double root1[count],
+                        int32 status[count], int32 number_of_roots[count],
+                        int32 error_code[count]
+
+   Header is 64 bytes long, so double columns of a mapped file are
+   aligned to 64 bytes. Columns have the same meaning as fields of
+   #equation_solution_columns.
+ */
+
+#define COEFFICIENT_FILE_MAGIC "QEQCOEFS"
+#define SOLUTION_FILE_MAGIC    "QEQROOTS"
+
+/**
+   @brief Version of binary files this library reads and writes
+ */
+const uint32_t BINARY_FILE_VERSION = 1;
+
+/**
+   @brief Written as is, reads back differently on a machine with other byte order
+ */
+const uint32_t BINARY_FILE_BYTE_ORDER_MARK = 0x01020304;
+
+/**
+   @brief Header of binary coefficient and solution files
+ */
+struct binary_file_header {
+    char magic[8];                /**< @brief #COEFFICIENT_FILE_MAGIC or #SOLUTION_FILE_MAGIC,
+                                       not null-terminated */
+    uint32_t version;             /**< @brief #BINARY_FILE_VERSION */
+    uint32_t byte_order_mark;     /**< @brief #BINARY_FILE_BYTE_ORDER_MARK */
+    uint64_t count;               /**< @brief Number of equations in the file */
+    uint8_t reserved[40];         /**< @brief Zero-filled */
+};
+
+static_assert(sizeof(binary_file_header) == 64, "Header must keep columns aligned");
+
+/**
+   @brief Possible error codes of binary file functions
+ */
+enum binary_file_error_code {
+    BINARY_FILE_IO_ERROR   = -1, /**< @brief File couldn't be opened, resized or mapped */
+    BINARY_FILE_BAD_HEADER = -2, /**< @brief Wrong magic, version or byte order */
+    BINARY_FILE_TRUNCATED  = -3, /**< @brief File is shorter than its header says */
+    BINARY_FILE_SAME_FILE  = -4, /**< @brief Output path names the input file */
+};
+
+/**
+   @brief Coefficient file mapped into memory, columns point into the mapping
+ */
+struct coefficient_file_view {
+    const double* a;     /**< @brief Column of coefficients a */
+    const double* b;     /**< @brief Column of coefficients b */
+    const double* c;     /**< @brief Column of coefficients c */
+    uint64_t count;      /**< @brief Number of equations */
+
+    void* mapping;       /**< @brief Start of the mapping */
+    size_t mapping_size; /**< @brief Size of the mapping in bytes */
+};
+
+/**
+   @brief Solution file mapped into memory, columns point into the mapping
+ */
+struct solution_file_view {
+    equation_solution_columns columns; /**< @brief Columns of the solutions */
+    uint64_t count;                    /**< @brief Number of equations */
+
+    void* mapping;                     /**< @brief Start of the mapping */
+    size_t mapping_size;               /**< @brief Size of the mapping in bytes */
+};
+
+/**
+   @brief Size in bytes of a coefficient file with @p count equations
+ */
+size_t coefficient_file_size(const uint64_t count);
+
+/**
+   @brief Size in bytes of a solution file with @p count equations
+ */
+size_t solution_file_size(const uint64_t count);
+
+/**
+   @brief Write coefficient columns to a new coefficient file at @p path
+
+   @return 0 on success, #binary_file_error_code on failure.
+ */
+int write_coefficient_file(const char* const path, const double* const a,
+                           const double* const b, const double* const c,
+                           const uint64_t count);
+
+/**
+   @brief Map existing coefficient file read-only
+
+   @return 0 on success, #binary_file_error_code on failure.
+ */
+int open_coefficient_file(const char* const path, coefficient_file_view* const view);
+
+/**
+   @brief Unmap coefficient file
+ */
+void close_coefficient_file(coefficient_file_view* const view);
+
+/**
+   @brief Create solution file of @p count equations and map it for writing
+
+   Everything written to the columns of @p view ends up in the file, there
+   is no need to write anything explicitly.
+
+   @return 0 on success, #binary_file_error_code on failure.
+ */
+int create_solution_file(const char* const path, const uint64_t count,
+                         solution_file_view* const view);
+
+/**
+   @brief Map existing solution file for reading
+
+   @note Mapping is private, changes to the columns don't reach the file.
+
+   @return 0 on success, #binary_file_error_code on failure.
+ */
+int open_solution_file(const char* const path, solution_file_view* const view);
+
+/**
+   @brief Unmap solution file, flushing the changes to a created one
+
+   @return 0 on success, #BINARY_FILE_IO_ERROR if the changes couldn't be
+   written back. The file is unmapped either way.
+ */
+int close_solution_file(solution_file_view* const view);
+
+#endif // QUADRATIC_EQUATION_SOLVER_BINARY_FILES_H
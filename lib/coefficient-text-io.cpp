@@ -0,0 +1,139 @@
+#include <cstddef>
+#include <cstdlib>
+#include <string.h>
+#include <stdio.h>
+#include <cmath>
+#include <charconv>
+
+#include "coefficient-text-io.h"
+
+static inline bool is_separator(const char symbol) {
+    return symbol == ' ' || symbol == '\t' || symbol == ',' || symbol == '\r';
+}
+
+// Parse one coefficient from [position, line_end), NAN if there's none
+static double parse_coefficient(const char** const position, const char* const line_end) {
+    const char* current = *position;
+    while (current < line_end && is_separator(*current))
+        ++ current;
+
+    // from_chars doesn't accept explicit plus sign
+    if (current < line_end && *current == '+')
+        ++ current;
+
+    double value = NAN;
+    const std::from_chars_result result = std::from_chars(current, line_end, value);
+
+    const char* token_end = result.ptr;
+    const bool is_whole_token = result.ec == std::errc() &&
+        (token_end == line_end || is_separator(*token_end));
+
+    if (!is_whole_token) {
+        value = NAN;
+
+        // Skip the whole garbage token
+        token_end = current;
+        while (token_end < line_end && !is_separator(*token_end))
+            ++ token_end;
+    }
+
+    *position = token_end;
+    return value;
+}
+
+size_t parse_coefficient_lines(const char* const text, const size_t length,
+                               const bool is_last_chunk,
+                               double* const a, double* const b, double* const c,
+                               const size_t capacity, size_t* const consumed) {
+
+    const char* current = text;
+    const char* const text_end = text + length;
+
+    size_t parsed = 0;
+    while (parsed < capacity && current < text_end) {
+        const char* line_end =
+            (const char*) memchr(current, '\n', (size_t) (text_end - current));
+
+        if (line_end == NULL) {
+            if (!is_last_chunk)
+                break; // Rest of the line is in the next chunk
+
+            line_end = text_end;
+        }
+
+        const char* position = current;
+        while (position < line_end && is_separator(*position))
+            ++ position;
+
+        const bool is_skipped = position == line_end || *position == '#';
+        if (!is_skipped) {
+            a[parsed] = parse_coefficient(&position, line_end);
+            b[parsed] = parse_coefficient(&position, line_end);
+            c[parsed] = parse_coefficient(&position, line_end);
+            ++ parsed;
+        }
+
+        current = line_end == text_end ? text_end : line_end + 1;
+    }
+
+    *consumed = (size_t) (current - text);
+    return parsed;
+}
+
+size_t format_solution_line(const solution_status status, const int number_of_roots,
+                            const double roots[2], const int error_code,
+                            char* const buffer) {
+
+    char* current = buffer;
+    char* const end = buffer + SOLUTION_LINE_MAX_LENGTH;
+
+    if (error_code != 0) {
+        memcpy(current, "error ", 6);
+        current = std::to_chars(current + 6, end, error_code).ptr;
+    } else if (status == INF_ROOTS) {
+        memcpy(current, "inf", 3);
+        current += 3;
+    } else {
+        current = std::to_chars(current, end, number_of_roots).ptr;
+
+        for (int i = 0; i < number_of_roots && i < 2; ++ i) {
+            *current ++ = ' ';
+            current = std::to_chars(current, end, roots[i]).ptr;
+        }
+    }
+
+    *current ++ = '\n';
+    return (size_t) (current - buffer);
+}
+
+int init_text_output_sink(text_output_sink* const sink, FILE* const file,
+                          const size_t capacity) {
+
+    *sink = { file, (char*) malloc(capacity), capacity, 0, false };
+    return sink->buffer == NULL ? -1 : 0;
+}
+
+int destroy_text_output_sink(text_output_sink* const sink) {
+    const int result = flush_text_output_sink(sink);
+
+    free(sink->buffer);
+    sink->buffer = NULL;
+    sink->capacity = 0;
+
+    return result;
+}
+
+int flush_text_output_sink(text_output_sink* const sink) {
+    if (sink->used != 0 && fwrite(sink->buffer, 1, sink->used, sink->file) != sink->used)
+        sink->has_failed = true;
+
+    sink->used = 0;
+    return sink->has_failed ? -1 : 0;
+}
+
+char* reserve_text_output_sink(text_output_sink* const sink, const size_t size) {
+    if (sink->capacity - sink->used < size)
+        flush_text_output_sink(sink);
+
+    return sink->buffer + sink->used;
+}
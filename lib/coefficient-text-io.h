@@ -0,0 +1,102 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_TEXT_IO_H
+#define QUADRATIC_EQUATION_SOLVER_TEXT_IO_H
+
+#include <cstddef>
+#include <stdio.h>
+
+#include "quadratic-equation-solver.h"
+
+/**
+   @brief Max number of bytes #format_solution_line can write
+ */
+const size_t SOLUTION_LINE_MAX_LENGTH = 64;
+
+/**
+   @brief Parse lines of form "a b c" into coefficient columns
+
+   Coefficients are separated by spaces, tabs or commas. Empty lines and lines
+   starting with '#' are skipped. A coefficient that is missing or can't be
+   parsed becomes NAN, so the solver reports it as an illegal value.
+
+   @param [in]  text          Text to parse, doesn't need to be null-terminated
+   @param [in]  length        Number of bytes in @p text
+   @param [in]  is_last_chunk Whether @p text ends the input. If not, a trailing
+                              line without '\n' is left unparsed.
+   @param [out] a             Column for coefficients a
+   @param [out] b             Column for coefficients b
+   @param [out] c             Column for coefficients c
+   @param [in]  capacity      Max number of triples to parse
+   @param [out] consumed      Number of bytes of @p text that were parsed
+
+   @return Number of parsed triples, parsing stops when it reaches @p capacity.
+ */
+size_t parse_coefficient_lines(const char* const text, const size_t length,
+                               const bool is_last_chunk,
+                               double* const a, double* const b, double* const c,
+                               const size_t capacity, size_t* const consumed);
+
+/**
+   @brief Write one-line machine-readable description of a solution
+
+   Line is one of "<number of roots> [root] [root]", "inf" or "error <code>",
+   followed by '\n'. Roots are written in the shortest form that reads back to
+   the same double.
+
+   @param [in]  status          Status of the solution
+   @param [in]  number_of_roots Number of roots, 0 to 2
+   @param [in]  roots           Roots of the equation
+   @param [in]  error_code      Error code of the solver, 0 on success
+   @param [out] buffer          Buffer of at least #SOLUTION_LINE_MAX_LENGTH bytes
+
+   @return Number of bytes written, buffer is not null-terminated.
+ */
+size_t format_solution_line(const solution_status status, const int number_of_roots,
+                            const double roots[2], const int error_code,
+                            char* const buffer);
+
+/**
+   @brief Output buffer that writes to a file in large blocks
+ */
+struct text_output_sink {
+    FILE* file;      /**< @brief File that buffer is flushed to */
+
+    char* buffer;    /**< @brief Pending output */
+    size_t capacity; /**< @brief Size of #buffer */
+    size_t used;     /**< @brief Number of pending bytes in #buffer */
+
+    bool has_failed; /**< @brief Whether some write to #file has failed */
+};
+
+/**
+   @brief Create sink that writes to @p file through @p capacity bytes buffer
+
+   @return 0 on success, -1 if buffer couldn't be allocated.
+ */
+int init_text_output_sink(text_output_sink* const sink, FILE* const file,
+                          const size_t capacity);
+
+/**
+   @brief Flush pending output and free the buffer
+
+   @return 0 on success, -1 if some write has failed.
+ */
+int destroy_text_output_sink(text_output_sink* const sink);
+
+/**
+   @brief Write pending output to the file
+
+   @return 0 on success, -1 if some write has failed.
+ */
+int flush_text_output_sink(text_output_sink* const sink);
+
+/**
+   @brief Get space for at least @p size bytes at the end of pending output
+
+   Write to the returned pointer, then add number of written bytes to
+   text_output_sink::used.
+
+   @note @p size must not exceed sink's capacity.
+ */
+char* reserve_text_output_sink(text_output_sink* const sink, const size_t size);
+
+#endif // QUADRATIC_EQUATION_SOLVER_TEXT_IO_H
@@ -0,0 +1,268 @@
+#include <cstddef>
+#include <cstdint>
+
+#include "equation-sweep.h"
+#include "quadratic-equation-kernels.h"
+#include "quadratic-equation-dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+typedef absolute_tolerance<double> tolerance;
+
+static inline double range_value(const coefficient_range* const range, const size_t index) {
+    return range->first + (double) index * range->step;
+}
+
+// Run of equations with the same a and b, c takes values [begin, begin + count)
+struct sweep_run {
+    const coefficient_range* c;
+    size_t begin;
+    size_t count;
+
+    double a;
+    double b;
+
+    // Terms of basic_solve_quadratic_equation that don't depend on c,
+    // computed with the same operations, so results don't change
+    double square_b;    // b * b
+    double four_a;      // 4 * a, the discriminant subtracts (4 * a) * c
+    double single_root; // -b / (2 * a)
+};
+
+// ============================= Run kernels ============================
+
+static void solve_invalid_run(const sweep_run* const run, const int error,
+                              const equation_solution_columns* const solutions) {
+
+    for (size_t i = 0; i < run->count; ++ i) {
+        solutions->status[i] = FINITE_ROOTS;
+        solutions->number_of_roots[i] = 0;
+        solutions->root[0][i] = 0.0;
+        solutions->root[1][i] = 0.0;
+        solutions->error_code[i] = error;
+    }
+}
+
+// a is zero: bx + c == 0 with b fixed along the run
+static void solve_linear_run(const sweep_run* const run,
+                             const equation_solution_columns* const solutions) {
+
+    const bool b_is_zero = tolerance::is_zero(run->b);
+    const double divisor = b_is_zero ? 1.0 : run->b;
+
+    for (size_t i = 0; i < run->count; ++ i) {
+        const double c = range_value(run->c, run->begin + i);
+
+        const bool is_valid = is_finite_value(c);
+        const bool is_infinite = b_is_zero && tolerance::is_zero(c);
+        const bool has_root = is_valid && !b_is_zero;
+
+        solutions->status[i] = is_valid && is_infinite ? INF_ROOTS : FINITE_ROOTS;
+        solutions->number_of_roots[i] = has_root ? 1 : 0;
+        solutions->root[0][i] = has_root ? - c / divisor : 0.0;
+        solutions->root[1][i] = 0.0;
+        solutions->error_code[i] = is_valid ? 0 : 3;
+    }
+}
+
+static void solve_quadratic_run_scalar(const sweep_run* const run, const size_t begin,
+                                       const equation_solution_columns* const solutions) {
+
+    for (size_t i = begin; i < run->count; ++ i) {
+        const double c = range_value(run->c, run->begin + i);
+        const bool is_valid = is_finite_value(c);
+
+        const double discriminant = run->square_b - run->four_a * c;
+
+        const bool discriminant_is_zero = tolerance::is_zero(discriminant);
+        const bool discriminant_is_negative = discriminant < 0;
+
+        const double sqrt_from_discriminant =
+            std::sqrt(discriminant_is_negative ? 0.0 : discriminant);
+
+        const bool b_is_negative = run->b < 0;
+        const double q = ((b_is_negative ? -run->b : run->b) + sqrt_from_discriminant) /
+                         (b_is_negative ? 2 : -2);
+
+        const double root1 = b_is_negative ? q / run->a : c / q,
+                     root2 = b_is_negative ? c / q : q / run->a;
+
+        const int roots = discriminant_is_zero ? 1 : discriminant_is_negative ? 0 : 2;
+
+        solutions->status[i] = FINITE_ROOTS;
+        solutions->number_of_roots[i] = is_valid ? roots : 0;
+        solutions->root[0][i] = !is_valid || roots == 0 ? 0.0 :
+                                roots == 1 ? run->single_root : root1;
+        solutions->root[1][i] = is_valid && roots == 2 ? root2 : 0.0;
+        solutions->error_code[i] = is_valid ? 0 : 3;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Same as solve_quadratic_run_scalar, four equations at a time, c is
+// generated in registers and known to be finite along the whole run
+AVX2_TARGET
+static void solve_quadratic_run_avx2(const sweep_run* const run,
+                                     const equation_solution_columns* const solutions) {
+
+    const __m256d epsilon = _mm256_set1_pd(EQUATION_SOLVER_EPSILON);
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d two  = _mm256_set1_pd(2.0);
+
+    const __m256d va          = _mm256_set1_pd(run->a);
+    const __m256d square_b    = _mm256_set1_pd(run->square_b);
+    const __m256d four_a      = _mm256_set1_pd(run->four_a);
+    const __m256d single_root = _mm256_set1_pd(run->single_root);
+
+    // b is fixed along the run, so are |b|, the sign of q and the choice
+    // between q / a and c / q
+    const bool b_is_negative = run->b < 0;
+
+    const __m256d abs_b = _mm256_set1_pd(b_is_negative ? -run->b : run->b);
+    const __m256d q_scale = _mm256_set1_pd(b_is_negative ? 0.5 : -0.5);
+
+    const __m256d c_first = _mm256_set1_pd(run->c->first);
+    const __m256d c_step  = _mm256_set1_pd(run->c->step);
+
+    // Indices are below 2^53, so they and their sums are exact doubles
+    const __m256d lane_offsets = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+
+    size_t i = 0;
+    for (; i + 4 <= run->count; i += 4) {
+        const __m256d index =
+            _mm256_add_pd(_mm256_set1_pd((double) (run->begin + i)), lane_offsets);
+        const __m256d c = _mm256_add_pd(c_first, _mm256_mul_pd(index, c_step));
+
+        const __m256d discriminant = _mm256_sub_pd(square_b, _mm256_mul_pd(four_a, c));
+
+        const __m256d discriminant_is_zero =
+            _mm256_cmp_pd(abs_avx2(discriminant), epsilon, _CMP_LE_OQ);
+
+        // Not less than zero, so NaN discriminant gives two NaN roots like the solver
+        const __m256d has_two_roots = _mm256_andnot_pd(
+            discriminant_is_zero, _mm256_cmp_pd(discriminant, zero, _CMP_NLT_UQ));
+
+        const __m256d sqrt_from_discriminant =
+            _mm256_sqrt_pd(_mm256_and_pd(has_two_roots, discriminant));
+
+        // root_product_term_avx2 with the sign choice taken out of the loop
+        const __m256d q = _mm256_mul_pd(_mm256_add_pd(abs_b, sqrt_from_discriminant), q_scale);
+
+        const __m256d root_from_q = _mm256_div_pd(q, va), root_from_c = _mm256_div_pd(c, q);
+
+        const __m256d root1 = b_is_negative ? root_from_q : root_from_c;
+        const __m256d root2 = b_is_negative ? root_from_c : root_from_q;
+
+        const __m256d roots = _mm256_blendv_pd(_mm256_and_pd(has_two_roots, two), one,
+                                               discriminant_is_zero);
+
+        // FINITE_ROOTS and error code 0 are both zero
+        _mm_storeu_si128((__m128i*) (solutions->status + i), _mm_setzero_si128());
+        _mm_storeu_si128((__m128i*) (solutions->error_code + i), _mm_setzero_si128());
+
+        _mm_storeu_si128((__m128i*) (solutions->number_of_roots + i),
+                         _mm256_cvttpd_epi32(roots));
+
+        _mm256_storeu_pd(solutions->root[0] + i,
+                         _mm256_blendv_pd(_mm256_and_pd(has_two_roots, root1), single_root,
+                                          discriminant_is_zero));
+        _mm256_storeu_pd(solutions->root[1] + i, _mm256_and_pd(has_two_roots, root2));
+    }
+
+    solve_quadratic_run_scalar(run, i, solutions);
+}
+
+#endif
+
+static void solve_quadratic_run(const sweep_run* const run,
+                                const equation_solution_columns* const solutions) {
+#if defined(__x86_64__) || defined(__i386__)
+    // c is monotonic along the run, so finite ends mean finite everywhere
+    const bool c_is_finite = is_finite_value(range_value(run->c, run->begin)) &&
+        is_finite_value(range_value(run->c, run->begin + run->count - 1));
+
+    if (c_is_finite && has_avx2_kernels()) {
+        solve_quadratic_run_avx2(run, solutions);
+        return;
+    }
+#endif
+
+    solve_quadratic_run_scalar(run, 0, solutions);
+}
+
+// ================================ Sweep ===============================
+
+int init_equation_sweep(equation_sweep* const sweep, const coefficient_range* const a,
+                        const coefficient_range* const b, const coefficient_range* const c) {
+
+    if (a->count == 0 || b->count == 0 || c->count == 0)
+        return -1;
+
+    if (a->count > SIZE_MAX / b->count || a->count * b->count > SIZE_MAX / c->count)
+        return -1;
+
+    *sweep = { *a, *b, *c, a->count * b->count * c->count, 0 };
+    return 0;
+}
+
+size_t solve_next_sweep_block(equation_sweep* const sweep,
+                              const equation_solution_columns* const solutions,
+                              const size_t capacity) {
+
+    const size_t left = sweep->size - sweep->next;
+    const size_t size = left < capacity ? left : capacity;
+
+    for (size_t done = 0; done < size; ) {
+        const size_t index = sweep->next + done;
+
+        const size_t c_index = index % sweep->c.count;
+        const size_t b_index = index / sweep->c.count % sweep->b.count;
+        const size_t a_index = index / sweep->c.count / sweep->b.count;
+
+        const double a = range_value(&sweep->a, a_index);
+        const double b = range_value(&sweep->b, b_index);
+
+        const size_t rest_of_row = sweep->c.count - c_index;
+
+        sweep_run run {};
+        run.c = &sweep->c;
+        run.begin = c_index;
+        run.count = rest_of_row < size - done ? rest_of_row : size - done;
+        run.a = a;
+        run.b = b;
+
+        const equation_solution_columns output = offset_solution_columns(solutions, done);
+
+        if (!is_finite_value(a) || !is_finite_value(b))
+            solve_invalid_run(&run, is_finite_value(a) ? 2 : 1, &output);
+
+        else if (tolerance::is_zero(a))
+            solve_linear_run(&run, &output);
+
+        else {
+            run.square_b = b * b;
+            run.four_a = 4 * a;
+            run.single_root = - b / (2 * a);
+
+            solve_quadratic_run(&run, &output);
+        }
+
+        done += run.count;
+    }
+
+    sweep->next += size;
+    return size;
+}
+
+void get_sweep_coefficients(const equation_sweep* const sweep, const size_t index,
+                            double* const a, double* const b, double* const c) {
+
+    *a = range_value(&sweep->a, index / sweep->c.count / sweep->b.count);
+    *b = range_value(&sweep->b, index / sweep->c.count % sweep->b.count);
+    *c = range_value(&sweep->c, index % sweep->c.count);
+}
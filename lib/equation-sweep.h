@@ -0,0 +1,83 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_EQUATION_SWEEP_H
+#define QUADRATIC_EQUATION_SOLVER_EQUATION_SWEEP_H
+
+#include <cstddef>
+
+#include "quadratic-equation-batch.h"
+
+/**
+   @brief Values first, first + step, ..., first + (count - 1) * step of a coefficient
+
+   @note Value i is computed as first + i * step, not by repeated addition,
+   so long sweeps don't drift.
+ */
+struct coefficient_range {
+    double first; /**< @brief Value at index 0 */
+    double step;  /**< @brief Difference between neighbouring values */
+    size_t count; /**< @brief Number of values, a fixed coefficient has 1 */
+};
+
+/**
+   @brief Grid of equations over ranges of a, b and c, solved block by block
+
+   Equations are numbered in row-major order with c varying fastest: index
+   (i * b.count + j) * c.count + k is the equation with value i of a, j of
+   b and k of c. The grid is never stored, blocks of it are generated and
+   solved on demand by #solve_next_sweep_block.
+
+   @note Fields are public so that a sweep can live on the stack, but
+   should only be changed by the functions below.
+ */
+struct equation_sweep {
+    coefficient_range a; /**< @brief Range of coefficient a */
+    coefficient_range b; /**< @brief Range of coefficient b */
+    coefficient_range c; /**< @brief Range of coefficient c */
+
+    size_t size;         /**< @brief Number of equations in the grid */
+    size_t next;         /**< @brief Index of the first equation of the next block */
+};
+
+/**
+   @brief Recommended number of equations per block
+
+   Outputs of one block (~100 KiB) stay in L2 cache until the caller reads them.
+ */
+const size_t SWEEP_BLOCK_SIZE = 2048;
+
+/**
+   @brief Start a sweep over the grid of @p a, @p b and @p c
+
+   @return 0 on success, -1 if some range is empty or the grid has more
+   than SIZE_MAX equations.
+ */
+int init_equation_sweep(equation_sweep* const sweep, const coefficient_range* const a,
+                        const coefficient_range* const b, const coefficient_range* const c);
+
+/**
+   @brief Solve next block of at most @p capacity equations of the sweep
+
+   Terms that are fixed along c (b * b, 4 * a, 2 * a and -b / 2a, along with
+   the linear/quadratic decision) are computed once per run of c instead of
+   once per equation.
+
+   @param [in]  sweep     Sweep to continue, its #equation_sweep::next is advanced
+   @param [out] solutions Output columns, each with room for @p capacity elements
+   @param [in]  capacity  Max number of equations to solve
+
+   @return Number of equations solved, 0 when the sweep is over.
+
+   @note Results, error codes included, are bit-identical to
+   #solve_quadratic_equation_batch on the same coefficients, see
+   #get_sweep_coefficients.
+ */
+size_t solve_next_sweep_block(equation_sweep* const sweep,
+                              const equation_solution_columns* const solutions,
+                              const size_t capacity);
+
+/**
+   @brief Coefficients of equation @p index of the sweep
+ */
+void get_sweep_coefficients(const equation_sweep* const sweep, const size_t index,
+                            double* const a, double* const b, double* const c);
+
+#endif // QUADRATIC_EQUATION_SOLVER_EQUATION_SWEEP_H
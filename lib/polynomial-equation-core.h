@@ -0,0 +1,380 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_POLYNOMIAL_CORE_H
+#define QUADRATIC_EQUATION_SOLVER_POLYNOMIAL_CORE_H
+
+#include <cstddef>
+#include <cmath>
+
+#include "quadratic-equation-core.h"
+
+/*
+   Header-only closed-form solvers of cubic and quartic equations, templates
+   on the scalar type and the tolerance policy like the quadratic ones.
+   They need cube roots and trigonometry, which have no constant-expression
+   implementation, so unlike the quadratic solvers they aren't constexpr.
+
+   Roots are distinct and sorted in ascending order. Leading coefficients
+   that are zero by the tolerance policy reduce the equation to a lower
+   degree, down to #basic_solve_linear_equation.
+ */
+
+/**
+   @brief Sort the first number_of_roots roots of a solution in ascending order
+ */
+template <typename scalar_t, int max_number_of_roots>
+inline void sort_equation_roots(
+    basic_equation_solution<scalar_t, max_number_of_roots>* const solution) {
+
+    for (int i = 1; i < solution->number_of_roots; ++ i) {
+        const scalar_t root = solution->root[i];
+
+        int j = i;
+        for (; j > 0 && root < solution->root[j - 1]; -- j)
+            solution->root[j] = solution->root[j - 1];
+
+        solution->root[j] = root;
+    }
+}
+
+/**
+   @brief Copy roots of a lower-degree solution into a solution with more room
+ */
+template <typename scalar_t, int max_number_of_roots, int lower_number_of_roots>
+inline void widen_equation_solution(
+    const basic_equation_solution<scalar_t, lower_number_of_roots>* const lower,
+    basic_equation_solution<scalar_t, max_number_of_roots>* const solution) {
+
+    static_assert(lower_number_of_roots <= max_number_of_roots, "Solution can't be narrowed");
+
+    *solution = { lower->status, lower->number_of_roots, { } };
+
+    for (int i = 0; i < lower->number_of_roots; ++ i)
+        solution->root[i] = lower->root[i];
+}
+
+
+/**
+   @brief Add root to a solution unless it's already there by the tolerance policy
+ */
+template <typename scalar_t, typename tolerance, int max_number_of_roots>
+inline void add_distinct_equation_root(
+    basic_equation_solution<scalar_t, max_number_of_roots>* const solution, const scalar_t root) {
+
+    for (int i = 0; i < solution->number_of_roots; ++ i)
+        if (tolerance::is_zero(root - solution->root[i]))
+            return;
+
+    solution->root[solution->number_of_roots ++] = root;
+}
+
+/**
+   @brief Solve cubic equation of form ax^3 + bx^2 + cx + d == 0
+
+   @tparam scalar_t  Type of coefficients and roots
+   @tparam tolerance Policy that decides which values are zero
+
+   @param [out] solution Pointer to output equation solution, roots are
+   distinct and in ascending order
+
+   @return 0 on success, illegal coefficient's number (1 for a, 2 for b, etc...)
+   otherwise.
+
+   @note With x = t - b / 3a the equation becomes t^3 + pt + q == 0 with
+   discriminant (q / 2)^2 + (p / 3)^3. When it's positive, the one real root
+   comes from Cardano's formula, written so that its two cube roots never
+   cancel. When it's negative, the three roots come from the trigonometric
+   method. When it's zero, roots are 3q / p and a double root -3q / 2p,
+   which merge into a triple root when p and q are zero too. Small p makes
+   the discriminant look zero while the roots are still apart, so zero q
+   is solved as t (t^2 + p) == 0 instead.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+inline int basic_solve_cubic_equation(const scalar_t a, const scalar_t b, const scalar_t c,
+                                      const scalar_t d,
+                                      basic_equation_solution<scalar_t, 3>* const solution) {
+
+    if (!is_finite_value(a))
+        return 1;
+
+    if (!is_finite_value(b))
+        return 2;
+
+    if (!is_finite_value(c))
+        return 3;
+
+    if (!is_finite_value(d))
+        return 4;
+
+    if (tolerance::is_zero(a)) { // a == 0 => This is a quadratic equation
+        basic_equation_solution<scalar_t> quadratic = { FINITE_ROOTS, 0, { 0, 0 } };
+
+        // Coefficients are finite, so it succeeds
+        basic_solve_quadratic_equation<scalar_t, tolerance>(b, c, d, &quadratic);
+
+        widen_equation_solution(&quadratic, solution);
+        sort_equation_roots(solution);
+        return 0;
+    }
+
+    const scalar_t normalized_b = b / a, normalized_c = c / a, normalized_d = d / a;
+
+    // x = t - shift
+    const scalar_t shift = normalized_b / 3;
+
+    const scalar_t p = normalized_c - normalized_b * shift;
+    const scalar_t q = (2 * shift * shift - normalized_c) * shift + normalized_d;
+
+    const scalar_t half_q = q / 2, third_p = p / 3;
+    const scalar_t discriminant = half_q * half_q + third_p * third_p * third_p;
+
+    if (tolerance::is_zero(p) && tolerance::is_zero(q))
+        *solution = { FINITE_ROOTS, /* num roots */ 1, { - shift, 0, 0 } };
+
+    else if (tolerance::is_zero(p)) // t^3 == -q
+        *solution = { FINITE_ROOTS, /* num roots */ 1, { std::cbrt(- q) - shift, 0, 0 } };
+
+    else if (tolerance::is_zero(q)) { // t (t^2 + p) == 0
+        *solution = { FINITE_ROOTS, /* num roots */ 1, { - shift, 0, 0 } };
+
+        if (p < 0) {
+            const scalar_t root = std::sqrt(- p);
+            *solution = { FINITE_ROOTS, /* num roots */ 3,
+                          { - root - shift, - shift, root - shift } };
+        }
+    }
+
+    else if (tolerance::is_zero(discriminant)) {
+        *solution = { FINITE_ROOTS, /* num roots */ 1, { 3 * q / p - shift, 0, 0 } };
+        add_distinct_equation_root<scalar_t, tolerance>(solution, - 3 * q / (2 * p) - shift);
+    }
+
+    else if (discriminant > 0) {
+        // u^3 = -q / 2 +- sqrt(d) with the sign of -q, so nothing cancels,
+        // the other cube root is -p / 3u
+        const scalar_t sqrt_from_discriminant = std::sqrt(discriminant);
+        const scalar_t u = std::cbrt(half_q < 0 ? sqrt_from_discriminant - half_q
+                                                : - (half_q + sqrt_from_discriminant));
+
+        *solution = { FINITE_ROOTS, /* num roots */ 1, { u - third_p / u - shift, 0, 0 } };
+    }
+
+    else { // Three real roots, p < 0
+        const scalar_t two_thirds_of_pi = (scalar_t) 2.09439510239319549230842892218633526L;
+
+        const scalar_t magnitude = 2 * std::sqrt(- third_p);
+
+        // Rounding may push the cosine of 3 theta slightly out of [-1, 1]
+        const scalar_t cosine = 3 * q / (p * magnitude);
+        const scalar_t theta =
+            std::acos(cosine < -1 ? -1 : cosine > 1 ? 1 : cosine) / 3;
+
+        // Cosines of theta, theta - 2pi / 3 and theta - 4pi / 3 are descending
+        *solution = { FINITE_ROOTS, /* num roots */ 3, {
+            magnitude * std::cos(theta - 2 * two_thirds_of_pi) - shift,
+            magnitude * std::cos(theta - two_thirds_of_pi) - shift,
+            magnitude * std::cos(theta) - shift
+        } };
+    }
+
+    sort_equation_roots(solution);
+    return 0;
+}
+
+/**
+   @brief Add x = +-sqrt(z) - shift for each root z of a quadratic in x^2
+ */
+template <typename scalar_t, typename tolerance>
+inline void add_square_roots_of_roots(const basic_equation_solution<scalar_t>* const squares,
+                                      const scalar_t shift,
+                                      basic_equation_solution<scalar_t, 4>* const solution) {
+
+    for (int i = 0; i < squares->number_of_roots; ++ i) {
+        const scalar_t square = squares->root[i];
+
+        if (tolerance::is_zero(square))
+            add_distinct_equation_root<scalar_t, tolerance>(solution, - shift);
+
+        else if (square > 0) {
+            const scalar_t root = std::sqrt(square);
+
+            add_distinct_equation_root<scalar_t, tolerance>(solution, - root - shift);
+            add_distinct_equation_root<scalar_t, tolerance>(solution, root - shift);
+        }
+    }
+}
+
+/**
+   @brief Solve quartic equation of form ax^4 + bx^3 + cx^2 + dx + e == 0
+
+   @tparam scalar_t  Type of coefficients and roots
+   @tparam tolerance Policy that decides which values are zero
+
+   @param [out] solution Pointer to output equation solution, roots are
+   distinct and in ascending order
+
+   @return 0 on success, illegal coefficient's number (1 for a, 2 for b, etc...)
+   otherwise.
+
+   @note Ferrari's method. With x = y - b / 4a the equation becomes
+   y^4 + py^2 + qy + r == 0. When q is zero it's a quadratic in y^2.
+   Otherwise, for the largest root m of the resolvent cubic
+   m^3 + pm^2 + (p^2 / 4 - r)m - q^2 / 8 == 0, which is positive, it splits
+   into quadratics y^2 -+ sy + p / 2 + m +- q / 2s with s = sqrt(2m).
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+inline int basic_solve_quartic_equation(const scalar_t a, const scalar_t b, const scalar_t c,
+                                        const scalar_t d, const scalar_t e,
+                                        basic_equation_solution<scalar_t, 4>* const solution) {
+
+    if (!is_finite_value(a))
+        return 1;
+
+    if (!is_finite_value(b))
+        return 2;
+
+    if (!is_finite_value(c))
+        return 3;
+
+    if (!is_finite_value(d))
+        return 4;
+
+    if (!is_finite_value(e))
+        return 5;
+
+    if (tolerance::is_zero(a)) { // a == 0 => This is a cubic equation
+        basic_equation_solution<scalar_t, 3> cubic = { FINITE_ROOTS, 0, { 0, 0, 0 } };
+
+        // Coefficients are finite, so it succeeds
+        basic_solve_cubic_equation<scalar_t, tolerance>(b, c, d, e, &cubic);
+
+        widen_equation_solution(&cubic, solution);
+        return 0;
+    }
+
+    const scalar_t normalized_b = b / a, normalized_c = c / a,
+                   normalized_d = d / a, normalized_e = e / a;
+
+    // x = y - shift
+    const scalar_t shift = normalized_b / 4, square_shift = shift * shift;
+
+    const scalar_t p = normalized_c - 6 * square_shift;
+    const scalar_t q = normalized_d - 2 * normalized_c * shift + 8 * square_shift * shift;
+    const scalar_t r = normalized_e - normalized_d * shift + normalized_c * square_shift -
+                       3 * square_shift * square_shift;
+
+    *solution = { FINITE_ROOTS, 0, { 0, 0, 0, 0 } };
+
+    basic_equation_solution<scalar_t, 3> resolvent = { FINITE_ROOTS, 0, { 0, 0, 0 } };
+    if (!tolerance::is_zero(q))
+        basic_solve_cubic_equation<scalar_t, tolerance>(1, p, p * p / 4 - r, - q * q / 8,
+                                                        &resolvent);
+
+    // Largest root is the last one. It's only missing or not positive when
+    // q is zero, or so close to it that the quadratic in y^2 is as good
+    const scalar_t m = resolvent.number_of_roots > 0 ?
+                       resolvent.root[resolvent.number_of_roots - 1] : 0;
+
+    if (!(m > 0)) {
+        basic_equation_solution<scalar_t> squares = { FINITE_ROOTS, 0, { 0, 0 } };
+        basic_solve_quadratic_equation<scalar_t, tolerance>(1, p, r, &squares);
+
+        add_square_roots_of_roots<scalar_t, tolerance>(&squares, shift, solution);
+        sort_equation_roots(solution);
+        return 0;
+    }
+
+    const scalar_t s = std::sqrt(2 * m);
+    const scalar_t half_p_plus_m = p / 2 + m, q_over_2s = q / (2 * s);
+
+    basic_equation_solution<scalar_t> factors[2] = {
+        { FINITE_ROOTS, 0, { 0, 0 } }, { FINITE_ROOTS, 0, { 0, 0 } }
+    };
+
+    basic_solve_quadratic_equation<scalar_t, tolerance>(1, - s, half_p_plus_m + q_over_2s,
+                                                        &factors[0]);
+    basic_solve_quadratic_equation<scalar_t, tolerance>(1, s, half_p_plus_m - q_over_2s,
+                                                        &factors[1]);
+
+    // Both factors may have the same double root of the quartic
+    for (const basic_equation_solution<scalar_t>& factor : factors)
+        for (int i = 0; i < factor.number_of_roots; ++ i)
+            add_distinct_equation_root<scalar_t, tolerance>(solution, factor.root[i] - shift);
+
+    sort_equation_roots(solution);
+    return 0;
+}
+
+
+/**
+   @brief Store a single-equation solution as element @p index of output columns
+ */
+template <typename scalar_t, int max_number_of_roots>
+inline void store_equation_solution(
+    const basic_equation_solution<scalar_t, max_number_of_roots>* const solution,
+    const int error, const size_t index,
+    const basic_equation_solution_columns<scalar_t, max_number_of_roots>* const solutions) {
+
+    solutions->status[index] = solution->status;
+    solutions->number_of_roots[index] = solution->number_of_roots;
+    solutions->error_code[index] = error;
+
+    for (int i = 0; i < max_number_of_roots; ++ i)
+        solutions->root[i][index] = solution->root[i];
+}
+
+/**
+   @brief Solve @p count cubic equations stored as coefficient columns
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are the same as of #basic_solve_cubic_equation, illegal
+   equations get #FINITE_ROOTS status with zero roots.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+inline size_t basic_solve_cubic_equation_batch(
+    const scalar_t* const a, const scalar_t* const b, const scalar_t* const c,
+    const scalar_t* const d, const size_t count,
+    const basic_equation_solution_columns<scalar_t, 3>* const solutions) {
+
+    size_t failed = 0;
+
+    for (size_t i = 0; i < count; ++ i) {
+        basic_equation_solution<scalar_t, 3> solution = { FINITE_ROOTS, 0, { 0, 0, 0 } };
+        const int error =
+            basic_solve_cubic_equation<scalar_t, tolerance>(a[i], b[i], c[i], d[i], &solution);
+
+        store_equation_solution(&solution, error, i, solutions);
+        failed += error != 0;
+    }
+
+    return failed;
+}
+
+/**
+   @brief Solve @p count quartic equations stored as coefficient columns
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are the same as of #basic_solve_quartic_equation, illegal
+   equations get #FINITE_ROOTS status with zero roots.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+inline size_t basic_solve_quartic_equation_batch(
+    const scalar_t* const a, const scalar_t* const b, const scalar_t* const c,
+    const scalar_t* const d, const scalar_t* const e, const size_t count,
+    const basic_equation_solution_columns<scalar_t, 4>* const solutions) {
+
+    size_t failed = 0;
+
+    for (size_t i = 0; i < count; ++ i) {
+        basic_equation_solution<scalar_t, 4> solution = { FINITE_ROOTS, 0, { 0, 0, 0, 0 } };
+        const int error = basic_solve_quartic_equation<scalar_t, tolerance>(
+            a[i], b[i], c[i], d[i], e[i], &solution);
+
+        store_equation_solution(&solution, error, i, solutions);
+        failed += error != 0;
+    }
+
+    return failed;
+}
+
+#endif // QUADRATIC_EQUATION_SOLVER_POLYNOMIAL_CORE_H
@@ -0,0 +1,31 @@
+#include <cstddef>
+
+#include "polynomial-equation-solver.h"
+
+int solve_cubic_equation(const double a, const double b, const double c, const double d,
+                         cubic_equation_solution* const solution) {
+
+    return basic_solve_cubic_equation<double>(a, b, c, d, solution);
+}
+
+int solve_quartic_equation(const double a, const double b, const double c, const double d,
+                           const double e, quartic_equation_solution* const solution) {
+
+    return basic_solve_quartic_equation<double>(a, b, c, d, e, solution);
+}
+
+size_t solve_cubic_equation_batch(const double* const a, const double* const b,
+                                  const double* const c, const double* const d,
+                                  const size_t count,
+                                  const cubic_equation_solution_columns* const solutions) {
+
+    return basic_solve_cubic_equation_batch<double>(a, b, c, d, count, solutions);
+}
+
+size_t solve_quartic_equation_batch(const double* const a, const double* const b,
+                                    const double* const c, const double* const d,
+                                    const double* const e, const size_t count,
+                                    const quartic_equation_solution_columns* const solutions) {
+
+    return basic_solve_quartic_equation_batch<double>(a, b, c, d, e, count, solutions);
+}
@@ -0,0 +1,120 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_POLYNOMIAL_H
+#define QUADRATIC_EQUATION_SOLVER_POLYNOMIAL_H
+
+#include <cstddef>
+
+#include "polynomial-equation-core.h"
+
+/**
+   @brief Solution of a cubic equation with double-precision roots
+
+   @see basic_equation_solution
+ */
+typedef basic_equation_solution<double, 3> cubic_equation_solution;
+
+/**
+   @brief Solution of a quartic equation with double-precision roots
+
+   @see basic_equation_solution
+ */
+typedef basic_equation_solution<double, 4> quartic_equation_solution;
+
+/**
+   @brief Output columns of a cubic batch solve, three root columns
+
+   @see basic_equation_solution_columns
+ */
+typedef basic_equation_solution_columns<double, 3> cubic_equation_solution_columns;
+
+/**
+   @brief Output columns of a quartic batch solve, four root columns
+
+   @see basic_equation_solution_columns
+ */
+typedef basic_equation_solution_columns<double, 4> quartic_equation_solution_columns;
+
+
+/**
+   @brief Solve cubic equation of form ax^3 + bx^2 + cx + d == 0
+
+   @param [in]  a        Coefficient a of the equation
+   @param [in]  b        Coefficient b of the equation
+   @param [in]  c        Coefficient c of the equation
+   @param [in]  d        Coefficient d of the equation
+   @param [out] solution Pointer to output equation solution
+
+   @return 0 on success, illegal coefficient's number (1 for a, 2 for b, etc...)
+   otherwise.
+
+   @note Roots are distinct and in ascending order. Equation with zero a
+   is solved as the quadratic bx^2 + cx + d == 0.
+
+   @note Thin wrapper over #basic_solve_cubic_equation.
+ */
+int solve_cubic_equation(const double a, const double b, const double c, const double d,
+                         cubic_equation_solution* const solution);
+
+/**
+   @brief Solve quartic equation of form ax^4 + bx^3 + cx^2 + dx + e == 0
+
+   @param [in]  a        Coefficient a of the equation
+   @param [in]  b        Coefficient b of the equation
+   @param [in]  c        Coefficient c of the equation
+   @param [in]  d        Coefficient d of the equation
+   @param [in]  e        Coefficient e of the equation
+   @param [out] solution Pointer to output equation solution
+
+   @return 0 on success, illegal coefficient's number (1 for a, 2 for b, etc...)
+   otherwise.
+
+   @note Roots are distinct and in ascending order. Equation with zero a
+   is solved as the cubic bx^3 + cx^2 + dx + e == 0.
+
+   @note Thin wrapper over #basic_solve_quartic_equation.
+ */
+int solve_quartic_equation(const double a, const double b, const double c, const double d,
+                           const double e, quartic_equation_solution* const solution);
+
+
+/**
+   @brief Solve @p count cubic equations stored as coefficient columns
+
+   @param [in]  a         Column of coefficients a
+   @param [in]  b         Column of coefficients b
+   @param [in]  c         Column of coefficients c
+   @param [in]  d         Column of coefficients d
+   @param [in]  count     Number of equations in the batch
+   @param [out] solutions Output columns, each with room for @p count elements
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are identical to calling #solve_cubic_equation on each
+   equation, laid out like the ones of #solve_quadratic_equation_batch.
+ */
+size_t solve_cubic_equation_batch(const double* const a, const double* const b,
+                                  const double* const c, const double* const d,
+                                  const size_t count,
+                                  const cubic_equation_solution_columns* const solutions);
+
+/**
+   @brief Solve @p count quartic equations stored as coefficient columns
+
+   @param [in]  a         Column of coefficients a
+   @param [in]  b         Column of coefficients b
+   @param [in]  c         Column of coefficients c
+   @param [in]  d         Column of coefficients d
+   @param [in]  e         Column of coefficients e
+   @param [in]  count     Number of equations in the batch
+   @param [out] solutions Output columns, each with room for @p count elements
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are identical to calling #solve_quartic_equation on each
+   equation, laid out like the ones of #solve_quadratic_equation_batch.
+ */
+size_t solve_quartic_equation_batch(const double* const a, const double* const b,
+                                    const double* const c, const double* const d,
+                                    const double* const e, const size_t count,
+                                    const quartic_equation_solution_columns* const solutions);
+
+#endif // QUADRATIC_EQUATION_SOLVER_POLYNOMIAL_H
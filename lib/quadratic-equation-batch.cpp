@@ -0,0 +1,32 @@
+#include <cstddef>
+
+#include "quadratic-equation-batch.h"
+#include "quadratic-equation-kernels.h"
+#include "quadratic-equation-dispatch.h"
+
+size_t solve_quadratic_equation_batch_scalar(const double* const a, const double* const b,
+                                             const double* const c, const size_t count,
+                                             const equation_solution_columns* const solutions) {
+
+    return basic_solve_quadratic_equation_batch<double>(a, b, c, count, solutions);
+}
+
+void polish_quadratic_equation_roots_batch(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions,
+                                           const int iterations) {
+
+    if (has_avx2_kernels()) {
+        polish_quadratic_equation_roots_batch_avx2(a, b, c, count, solutions, iterations);
+        return;
+    }
+
+    basic_polish_quadratic_equation_roots_batch<double>(a, b, c, count, solutions, iterations);
+}
+
+size_t solve_quadratic_equation_batch_float(const float* const a, const float* const b,
+                                            const float* const c, const size_t count,
+                                            const float_equation_solution_columns* const solutions) {
+
+    return basic_solve_quadratic_equation_batch<float>(a, b, c, count, solutions);
+}
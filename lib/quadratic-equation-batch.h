@@ -0,0 +1,74 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_BATCH_H
+#define QUADRATIC_EQUATION_SOLVER_BATCH_H
+
+#include <cstddef>
+
+#include "quadratic-equation-solver.h"
+
+/**
+   @brief Output columns of a batch solve with double-precision roots
+
+   @see basic_equation_solution_columns
+ */
+typedef basic_equation_solution_columns<double> equation_solution_columns;
+
+/**
+   @brief Output columns of a batch solve with single-precision roots
+ */
+typedef basic_equation_solution_columns<float> float_equation_solution_columns;
+
+
+/**
+   @brief Solve @p count quadratic equations of form a[i]x^2 + b[i]x + c[i] == 0
+
+   @param [in]  a         Column of coefficients a
+   @param [in]  b         Column of coefficients b
+   @param [in]  c         Column of coefficients c
+   @param [in]  count     Number of equations in the batch
+   @param [out] solutions Output columns, each with room for @p count elements
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are identical to calling #solve_quadratic_equation on each
+   triple. Equations with an illegal coefficient get a non-zero error code,
+   #FINITE_ROOTS status, zero roots and zero-filled root columns.
+
+   @note Work is done by the widest kernel the CPU supports, see
+   quadratic-equation-dispatch.h to inspect or override the choice.
+ */
+size_t solve_quadratic_equation_batch(const double* const a, const double* const b,
+                                      const double* const c, const size_t count,
+                                      const equation_solution_columns* const solutions);
+
+/**
+   @brief #polish_quadratic_equation_roots of every equation of a batch
+
+   @param [in]     a          Column of coefficients a
+   @param [in]     b          Column of coefficients b
+   @param [in]     c          Column of coefficients c
+   @param [in]     count      Number of equations in the batch
+   @param [in,out] solutions  Columns filled by #solve_quadratic_equation_batch
+   @param [in]     iterations Number of Newton steps for every root
+
+   @note Same fixed number of steps for every lane and no branches, so vector
+   kernels polish several equations per instruction. Results are identical
+   to polishing each equation on its own.
+ */
+void polish_quadratic_equation_roots_batch(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions,
+                                           const int iterations);
+
+/**
+   @brief Solve @p count quadratic equations in single precision
+
+   Same as #solve_quadratic_equation_batch, but for float columns, so twice
+   as many equations fit into one vector register.
+
+   @note Uses the same absolute tolerance as the double-precision solver.
+ */
+size_t solve_quadratic_equation_batch_float(const float* const a, const float* const b,
+                                            const float* const c, const size_t count,
+                                            const float_equation_solution_columns* const solutions);
+
+#endif // QUADRATIC_EQUATION_SOLVER_BATCH_H
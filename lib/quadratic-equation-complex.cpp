@@ -0,0 +1,154 @@
+#include <cstddef>
+#include <cfloat>
+
+#include "quadratic-equation-complex.h"
+#include "quadratic-equation-kernels.h"
+#include "quadratic-equation-dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+int solve_quadratic_equation_complex(const double a, const double b, const double c,
+                                     complex_equation_solution* const solution) {
+
+    return basic_solve_quadratic_equation_complex<double>(a, b, c, solution);
+}
+
+static complex_equation_solution_columns
+offset_complex_columns(const complex_equation_solution_columns* const columns,
+                       const size_t offset) {
+    return {
+        columns->status + offset,
+        columns->number_of_roots + offset,
+        { columns->real[0] + offset, columns->real[1] + offset },
+        { columns->imaginary[0] + offset, columns->imaginary[1] + offset },
+        columns->error_code + offset
+    };
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Same as basic_solve_quadratic_equation_batch_complex, four equations at a time
+AVX2_TARGET
+static size_t solve_batch_complex_avx2(const double* const a, const double* const b,
+                                       const double* const c, const size_t count,
+                                       const complex_equation_solution_columns* const solutions) {
+
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d epsilon   = _mm256_set1_pd(EQUATION_SOLVER_EPSILON);
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d two  = _mm256_set1_pd(2.0);
+
+    const __m256d inf_roots = _mm256_set1_pd((double) INF_ROOTS);
+
+    size_t failed = 0, i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d vc = _mm256_loadu_pd(c + i);
+
+        const __m256d abs_a = abs_avx2(va);
+        const __m256d abs_b = abs_avx2(vb);
+        const __m256d abs_c = abs_avx2(vc);
+
+        const __m256d a_is_finite = is_finite_avx2(abs_a);
+        const __m256d b_is_finite = is_finite_avx2(abs_b);
+        const __m256d c_is_finite = is_finite_avx2(abs_c);
+
+        const __m256d error = error_code_avx2(a_is_finite, b_is_finite, c_is_finite);
+
+        const __m256d is_valid =
+            _mm256_and_pd(a_is_finite, _mm256_and_pd(b_is_finite, c_is_finite));
+
+        const __m256d a_is_zero = _mm256_cmp_pd(abs_a, epsilon, _CMP_LE_OQ);
+        const __m256d b_is_zero = _mm256_cmp_pd(abs_b, epsilon, _CMP_LE_OQ);
+        const __m256d c_is_zero = _mm256_cmp_pd(abs_c, epsilon, _CMP_LE_OQ);
+
+        // Linear equation bx + c == 0
+        const __m256d linear_root =
+            _mm256_div_pd(_mm256_xor_pd(vc, sign_mask), select_avx2(b_is_zero, one, vb));
+
+        const __m256d linear_roots = _mm256_andnot_pd(b_is_zero, one);
+        const __m256d linear_real0 = _mm256_andnot_pd(b_is_zero, linear_root);
+
+        // Quadratic equation, sqrt(|d|) is the real or the imaginary offset
+        const __m256d discriminant = discriminant_avx2(va, vb, vc);
+
+        const __m256d discriminant_is_zero =
+            _mm256_cmp_pd(abs_avx2(discriminant), epsilon, _CMP_LE_OQ);
+        const __m256d discriminant_is_negative =
+            _mm256_cmp_pd(discriminant, zero, _CMP_LT_OQ);
+
+        // Only negative lanes are flipped, NaN keeps its sign like in the scalar kernel
+        const __m256d sqrt_from_discriminant = _mm256_sqrt_pd(
+            _mm256_xor_pd(discriminant, _mm256_and_pd(discriminant_is_negative, sign_mask)));
+
+        const __m256d double_a = select_avx2(a_is_zero, one, _mm256_mul_pd(two, va));
+        const __m256d minus_b = _mm256_xor_pd(vb, sign_mask);
+
+        const __m256d single_root = _mm256_div_pd(minus_b, double_a);
+        const __m256d imaginary_part = _mm256_div_pd(sqrt_from_discriminant, double_a);
+
+        const __m256d b_is_negative = _mm256_cmp_pd(vb, zero, _CMP_LT_OQ);
+        const __m256d q = root_product_term_avx2(abs_b, b_is_negative, sqrt_from_discriminant);
+
+        const __m256d root_from_q = _mm256_div_pd(q, select_avx2(a_is_zero, one, va));
+        const __m256d root_from_c = _mm256_div_pd(vc, q);
+
+        const __m256d root1 = select_avx2(b_is_negative, root_from_q, root_from_c);
+        const __m256d root2 = select_avx2(b_is_negative, root_from_c, root_from_q);
+
+        const __m256d is_complex = _mm256_andnot_pd(
+            _mm256_or_pd(a_is_zero, discriminant_is_zero), discriminant_is_negative);
+
+        const __m256d quadratic_roots = select_avx2(discriminant_is_zero, one, two);
+        const __m256d quadratic_real0 =
+            select_avx2(_mm256_or_pd(discriminant_is_zero, is_complex), single_root, root1);
+        const __m256d quadratic_real1 =
+            _mm256_andnot_pd(discriminant_is_zero, select_avx2(is_complex, single_root, root2));
+
+        // Pick linear or quadratic answer, then zero out illegal lanes
+        const __m256d roots = select_avx2(a_is_zero, linear_roots, quadratic_roots);
+        const __m256d real0 = select_avx2(a_is_zero, linear_real0, quadratic_real0);
+        const __m256d real1 = _mm256_andnot_pd(a_is_zero, quadratic_real1);
+
+        const __m256d has_imaginary = _mm256_and_pd(is_valid, is_complex);
+
+        const __m256d is_infinite =
+            _mm256_and_pd(is_valid, _mm256_and_pd(a_is_zero, _mm256_and_pd(b_is_zero, c_is_zero)));
+
+        _mm_storeu_si128((__m128i*) (solutions->status + i),
+                         _mm256_cvttpd_epi32(_mm256_and_pd(is_infinite, inf_roots)));
+        _mm_storeu_si128((__m128i*) (solutions->number_of_roots + i),
+                         _mm256_cvttpd_epi32(_mm256_and_pd(is_valid, roots)));
+        _mm_storeu_si128((__m128i*) (solutions->error_code + i), _mm256_cvttpd_epi32(error));
+
+        _mm256_storeu_pd(solutions->real[0] + i, _mm256_and_pd(is_valid, real0));
+        _mm256_storeu_pd(solutions->real[1] + i, _mm256_and_pd(is_valid, real1));
+        _mm256_storeu_pd(solutions->imaginary[0] + i, _mm256_and_pd(has_imaginary, imaginary_part));
+        _mm256_storeu_pd(solutions->imaginary[1] + i,
+                         _mm256_and_pd(has_imaginary, _mm256_xor_pd(imaginary_part, sign_mask)));
+
+        failed += (size_t) __builtin_popcount(_mm256_movemask_pd(is_valid) ^ 0xf);
+    }
+
+    const complex_equation_solution_columns tail = offset_complex_columns(solutions, i);
+    return failed + basic_solve_quadratic_equation_batch_complex<double>(a + i, b + i, c + i,
+                                                                         count - i, &tail);
+}
+
+#endif
+
+size_t solve_quadratic_equation_batch_complex(const double* const a, const double* const b,
+                                              const double* const c, const size_t count,
+                                              const complex_equation_solution_columns* const solutions) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (has_avx2_kernels())
+        return solve_batch_complex_avx2(a, b, c, count, solutions);
+#endif
+
+    return basic_solve_quadratic_equation_batch_complex<double>(a, b, c, count, solutions);
+}
@@ -0,0 +1,60 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_COMPLEX_H
+#define QUADRATIC_EQUATION_SOLVER_COMPLEX_H
+
+#include <cstddef>
+
+#include "quadratic-equation-core.h"
+
+/**
+   @brief Solution of an equation with double-precision complex roots
+
+   @see basic_complex_equation_solution
+ */
+typedef basic_complex_equation_solution<double> complex_equation_solution;
+
+/**
+   @brief Output columns of a complex batch solve with double-precision roots
+
+   @see basic_complex_equation_solution_columns
+ */
+typedef basic_complex_equation_solution_columns<double> complex_equation_solution_columns;
+
+
+/**
+   @brief Solve quadratic equation of form ax^2 + bx + c == 0 over complex numbers
+
+   @param [in]  a        Coefficient a of the equation
+   @param [in]  b        Coefficient b of the equation
+   @param [in]  c        Coefficient c of the equation
+   @param [out] solution Pointer to output equation solution
+
+   @return 0 on success, illegal coefficient's number (1 for a, 2 for b, etc...)
+   otherwise.
+
+   @note Real roots are bit-identical to the ones of #solve_quadratic_equation.
+   Equations it reports as having no roots get a complex conjugate pair.
+ */
+int solve_quadratic_equation_complex(const double a, const double b, const double c,
+                                     complex_equation_solution* const solution);
+
+/**
+   @brief Solve @p count quadratic equations over complex numbers
+
+   @param [in]  a         Column of coefficients a
+   @param [in]  b         Column of coefficients b
+   @param [in]  c         Column of coefficients c
+   @param [in]  count     Number of equations in the batch
+   @param [out] solutions Output columns, each with room for @p count elements
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are identical to calling #solve_quadratic_equation_complex
+   on each triple. Vector kernels take one square root of |d| per equation
+   and select real or complex roots with a mask, so batches that mix them
+   are solved in one pass.
+ */
+size_t solve_quadratic_equation_batch_complex(const double* const a, const double* const b,
+                                              const double* const c, const size_t count,
+                                              const complex_equation_solution_columns* const solutions);
+
+#endif // QUADRATIC_EQUATION_SOLVER_COMPLEX_H
@@ -0,0 +1,597 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_CORE_H
+#define QUADRATIC_EQUATION_SOLVER_CORE_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+/*
+   Header-only solver core. Everything here is a template on the scalar
+   type (float, double or long double) and on a tolerance policy, and is
+   usable in constant expressions, so equations with known coefficients
+   are solved at compile time and calls inline completely.
+
+   A tolerance policy is a type with a static member function
+
+       static constexpr bool is_zero(const scalar_t value);
+
+   that decides whether a computed value should be treated as zero.
+ */
+
+/**
+   @brief Absolute tolerance used to compare floating-point values with zero
+ */
+constexpr double EQUATION_SOLVER_EPSILON = 1e-9;
+
+/**
+   @brief Enum of possible statuses of an equation solution
+
+   Fixed to int, so a status column read from a damaged file may hold any
+   int and describing it reports the corruption instead of being undefined.
+ */
+enum solution_status : int {
+    FINITE_ROOTS, /**< @brief The equation has a finite number of roots */
+    INF_ROOTS,    /**< @brief The equation has an infinite number of roots */
+};
+
+
+/**
+   @brief Struct that represents the solution of some equation
+
+   @tparam scalar_t            Type of the roots
+   @tparam max_number_of_roots Room for roots, the degree of the equation: 2 is
+                               enough for linear and quadratic equations, cubic
+                               and quartic ones need 3 and 4
+
+   @note Roots are stored in place, so solutions never allocate.
+ */
+template <typename scalar_t, int max_number_of_roots = 2>
+struct basic_equation_solution {
+    solution_status status; /**< @brief Status of the current solution */
+
+    int number_of_roots;    /**< @brief Number of real roots of the equation
+                                 @note Guaranteed to be >= zero. */
+
+    scalar_t root[max_number_of_roots]; /**< @brief Real roots of the equation
+                                             @note First #number_of_roots are real
+                                             roots and the rest is zero-initialized. */
+};
+
+
+/**
+   @brief Default tolerance policy, |value| <= #EQUATION_SOLVER_EPSILON is zero
+ */
+template <typename scalar_t>
+struct absolute_tolerance {
+    static constexpr scalar_t epsilon = (scalar_t) EQUATION_SOLVER_EPSILON;
+
+    static constexpr bool is_zero(const scalar_t value) {
+        return (value < 0 ? -value : value) <= epsilon;
+    }
+};
+
+
+/**
+   @brief Whether @p value is neither infinity nor NaN
+
+   @note Plain comparison (NaN compares false with everything), so unlike
+   std::isfinite it's constexpr and loops using it still vectorize.
+ */
+template <typename scalar_t>
+constexpr bool is_finite_value(const scalar_t value) {
+    return (value < 0 ? -value : value) <= std::numeric_limits<scalar_t>::max();
+}
+
+/**
+   @brief Square root that also works in constant expressions
+
+   @note At compile time it's computed with Newton's method, which may differ
+   from the runtime std::sqrt in the last bit.
+ */
+template <typename scalar_t>
+constexpr scalar_t constexpr_sqrt(const scalar_t value) {
+    if (!std::is_constant_evaluated())
+        return std::sqrt(value);
+
+    // Zero and infinity are their own roots, negative numbers and NaN have none
+    if (!(value > 0) || !is_finite_value(value))
+        return value >= 0 ? value : std::numeric_limits<scalar_t>::quiet_NaN();
+
+    scalar_t current = value > 1 ? value : 1, previous = 0;
+
+    // Decreases monotonically from above, stops when it can't anymore
+    while (current != previous) {
+        previous = current;
+        current = (current + value / current) / 2;
+
+        if (current >= previous)
+            return previous;
+    }
+
+    return current;
+}
+
+
+/**
+   @brief Solve linear equation of form bx + c == 0
+
+   @tparam scalar_t  Type of coefficients and roots
+   @tparam tolerance Policy that decides which values are zero
+
+   @param [in]  b        Coefficient b of the equation
+   @param [in]  c        Coefficient c of the equation
+   @param [out] solution Pointer to output equation solution
+
+   @return 0 on success, illegal coefficient's number (1 for b, 2 for c) otherwise.
+
+   @note If multiple coefficients have illegal value, number of
+   the first one is returned.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+constexpr int basic_solve_linear_equation(const scalar_t b, const scalar_t c,
+                                          basic_equation_solution<scalar_t>* const solution) {
+
+    if (!is_finite_value(b))
+        return 1;
+
+    if (!is_finite_value(c))
+        return 2;
+
+
+    if (tolerance::is_zero(b)) { // 0x == -c
+        // 0x == 0
+        if (tolerance::is_zero(c)) {
+            *solution = { INF_ROOTS, /* num roots */ 0, { 0, 0 } };
+            return 0;
+        }
+
+        // 0x != 0
+        *solution = { FINITE_ROOTS, /* num roots */ 0, { 0, 0 } };
+        return 0;
+    }
+
+    // bx == -c
+    *solution = { FINITE_ROOTS, /* num roots */ 1, /* root */ { - c / b, 0 } };
+    return 0;
+}
+
+/**
+   @brief Solve quadratic equation of form ax^2 + bx + c == 0
+
+   @tparam scalar_t  Type of coefficients and roots
+   @tparam tolerance Policy that decides which values are zero
+
+   @param [in]  a        Coefficient a of the equation
+   @param [in]  b        Coefficient b of the equation
+   @param [in]  c        Coefficient c of the equation
+   @param [out] solution Pointer to output equation solution
+
+   @return 0 on success, illegal coefficient's number (1 for a, 2 for b, etc...)
+   otherwise.
+
+   @note Two distinct roots are computed as q / a and c / q, where
+   q = -(b + sign(b) sqrt(d)) / 2, so neither loses digits to cancellation
+   when |b| dominates. The first root is still (-b + sqrt(d)) / 2a.
+
+   @note If multiple coefficients have illegal value, number of
+   the first one is returned.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+constexpr int basic_solve_quadratic_equation(const scalar_t a, const scalar_t b, const scalar_t c,
+                                             basic_equation_solution<scalar_t>* const solution) {
+
+    if (!is_finite_value(a))
+        return 1;
+
+    if (!is_finite_value(b))
+        return 2;
+
+    if (!is_finite_value(c))
+        return 3;
+
+
+    const scalar_t discriminant = b * b - 4 * a * c;
+
+    if (tolerance::is_zero(a)) { // a == 0 => This is a linear equation
+        int return_code = basic_solve_linear_equation<scalar_t, tolerance>(b, c, solution);
+        return return_code == 0 ? 0 : /* one less argument */ return_code + 1;
+    }
+
+    // Check for discriminant == 0
+    if (tolerance::is_zero(discriminant))
+        *solution = { FINITE_ROOTS, /* num roots */ 1,
+                      /* root */ { - b / (2 * a), 0 } };
+
+    else if (discriminant < 0)
+        *solution = { FINITE_ROOTS, /* num roots */ 0, { 0, 0 } };
+
+    else {
+        // From here discriminant is guaranteed to be bigger than zero
+        const scalar_t sqrt_from_discriminant = constexpr_sqrt(discriminant);
+
+        // q = -(b + sign(b) sqrt(d)) / 2 adds |b| and sqrt(d), so nothing cancels.
+        // Nothing is negated after the square root, so a NaN one keeps its sign.
+        const scalar_t q = ((b < 0 ? -b : b) + sqrt_from_discriminant) / (b < 0 ? 2 : -2);
+
+        // q / a is (-b - sqrt(d)) / 2a when b >= 0, (-b + sqrt(d)) / 2a otherwise
+        const scalar_t root_from_q = q / a, root_from_c = c / q;
+
+        const scalar_t root1 = b < 0 ? root_from_q : root_from_c,
+                       root2 = b < 0 ? root_from_c : root_from_q;
+
+        *solution = { FINITE_ROOTS, /* num roots */ 2, { root1, root2 } };
+    }
+
+    return 0;
+}
+
+
+/**
+   @brief Caller-provided output columns of a batch solve
+
+   Element i of every column describes equation i of the batch, the same
+   way fields of #basic_equation_solution describe a single equation.
+
+   @note Every column must have room for at least as many elements as
+   there are equations in the batch.
+ */
+template <typename scalar_t, int max_number_of_roots = 2>
+struct basic_equation_solution_columns {
+    solution_status* status;          /**< @brief Status of each solution */
+
+    int* number_of_roots;             /**< @brief Number of real roots of each equation
+                                           @note Guaranteed to be >= zero. */
+
+    scalar_t* root[max_number_of_roots]; /**< @brief Column of each root, first to last
+                                              @note Roots past number_of_roots are zero. */
+
+    int* error_code;                  /**< @brief Per-equation error code, the same one
+                                           the single-equation solver would return. */
+};
+
+/**
+   @brief Solve @p count equations stored as coefficient columns without branching
+
+   Every branch of #basic_solve_quadratic_equation is evaluated for every
+   equation and the right results are selected afterwards. There are no
+   data-dependent jumps, so compilers vectorize the loop, with twice as many
+   lanes for float as for double.
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are the same as of #basic_solve_quadratic_equation, illegal
+   equations get #FINITE_ROOTS status with zero roots.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+constexpr size_t basic_solve_quadratic_equation_batch(
+    const scalar_t* const a, const scalar_t* const b, const scalar_t* const c,
+    const size_t count, const basic_equation_solution_columns<scalar_t>* const solutions) {
+
+    solution_status* const status = solutions->status;
+    int* const number_of_roots = solutions->number_of_roots;
+    scalar_t* const first_root = solutions->root[0];
+    scalar_t* const second_root = solutions->root[1];
+    int* const error_code = solutions->error_code;
+
+    const scalar_t zero = 0, one = 1;
+
+    size_t failed = 0;
+
+    for (size_t i = 0; i < count; ++ i) {
+        const scalar_t ai = a[i], bi = b[i], ci = c[i];
+
+        const int error = !is_finite_value(ai) ? 1 :
+                          !is_finite_value(bi) ? 2 :
+                          !is_finite_value(ci) ? 3 : 0;
+
+        const bool is_valid = error == 0;
+
+        const bool a_is_zero = tolerance::is_zero(ai);
+        const bool b_is_zero = tolerance::is_zero(bi);
+        const bool c_is_zero = tolerance::is_zero(ci);
+
+        // Linear equation bx + c == 0 (divisor is replaced to avoid
+        // dividing by zero in lanes whose result is discarded anyway)
+        const scalar_t linear_root = - ci / (b_is_zero ? one : bi);
+
+        // Quadratic equation, same operation order as the scalar solver
+        const scalar_t discriminant = bi * bi - 4 * ai * ci;
+
+        const bool discriminant_is_zero = tolerance::is_zero(discriminant);
+        const bool discriminant_is_negative = discriminant < 0;
+
+        const scalar_t sqrt_from_discriminant =
+            constexpr_sqrt(discriminant_is_negative ? zero : discriminant);
+
+        const scalar_t double_a = a_is_zero ? one : 2 * ai;
+        const scalar_t single_root = - bi / double_a;
+
+        // q is non-zero wherever both roots are used
+        const bool b_is_negative = bi < 0;
+        const scalar_t q =
+            ((b_is_negative ? -bi : bi) + sqrt_from_discriminant) / (b_is_negative ? 2 : -2);
+
+        const scalar_t root_from_q = q / (a_is_zero ? one : ai), root_from_c = ci / q;
+
+        const scalar_t root1 = b_is_negative ? root_from_q : root_from_c,
+                       root2 = b_is_negative ? root_from_c : root_from_q;
+
+        int roots = 0;
+        scalar_t root0_value = 0, root1_value = 0;
+
+        if (a_is_zero) {
+            roots = b_is_zero ? 0 : 1;
+            root0_value = b_is_zero ? zero : linear_root;
+        } else {
+            roots = discriminant_is_zero ? 1 : discriminant_is_negative ? 0 : 2;
+            root0_value = discriminant_is_zero ? single_root :
+                          discriminant_is_negative ? zero : root1;
+            root1_value = roots == 2 ? root2 : zero;
+        }
+
+        const bool infinite = a_is_zero && b_is_zero && c_is_zero;
+
+        status[i]          = is_valid && infinite ? INF_ROOTS : FINITE_ROOTS;
+        number_of_roots[i] = is_valid ? roots : 0;
+        first_root[i]      = is_valid ? root0_value : zero;
+        second_root[i]     = is_valid ? root1_value : zero;
+        error_code[i]      = error;
+
+        failed += !is_valid;
+    }
+
+    return failed;
+}
+
+
+/**
+   @brief Newton iterations that bring a root from the solver to full precision
+
+   Roots computed as q / a and c / q are off by a few ulps at most, and each
+   iteration roughly doubles the number of correct digits.
+ */
+constexpr int EQUATION_SOLVER_POLISH_ITERATIONS = 2;
+
+/**
+   @brief Refine @p root of ax^2 + bx + c == 0 with @p iterations Newton steps
+
+   Every step is computed, and it is only taken if it reduces |ax^2 + bx + c|,
+   so the result is never worse than @p root. There are no data-dependent
+   branches, so loops calling it vectorize.
+
+   @return Refined root, or @p root itself if no step improved it.
+ */
+template <typename scalar_t>
+constexpr scalar_t basic_polish_quadratic_equation_root(const scalar_t a, const scalar_t b,
+                                                        const scalar_t c, const scalar_t root,
+                                                        const int iterations) {
+    scalar_t x = root;
+    scalar_t residual = (a * x + b) * x + c;
+
+    for (int i = 0; i < iterations; ++ i) {
+        const scalar_t candidate = x - residual / (2 * a * x + b);
+        const scalar_t candidate_residual = (a * candidate + b) * candidate + c;
+
+        // Comparisons with NaN are false, so NaN steps are never taken
+        const bool is_better = (candidate_residual < 0 ? -candidate_residual : candidate_residual) <
+                               (residual < 0 ? -residual : residual);
+
+        x = is_better ? candidate : x;
+        residual = is_better ? candidate_residual : residual;
+    }
+
+    return x;
+}
+
+/**
+   @brief Polish both roots of a solution from #basic_solve_quadratic_equation
+
+   Only solutions with two distinct roots are changed. A single root is
+   already as precise as -b / 2a, and a linear root is a single division.
+ */
+template <typename scalar_t>
+constexpr void basic_polish_quadratic_equation_roots(
+    const scalar_t a, const scalar_t b, const scalar_t c,
+    basic_equation_solution<scalar_t>* const solution, const int iterations) {
+    if (solution->number_of_roots != 2)
+        return;
+
+    for (int i = 0; i < 2; ++ i)
+        solution->root[i] =
+            basic_polish_quadratic_equation_root(a, b, c, solution->root[i], iterations);
+}
+
+/**
+   @brief #basic_polish_quadratic_equation_roots of every equation of a batch
+
+   @param [in, out] solutions Columns filled by #basic_solve_quadratic_equation_batch
+   for the same coefficients
+ */
+template <typename scalar_t>
+constexpr void basic_polish_quadratic_equation_roots_batch(
+    const scalar_t* const a, const scalar_t* const b, const scalar_t* const c,
+    const size_t count, const basic_equation_solution_columns<scalar_t>* const solutions,
+    const int iterations) {
+
+    for (size_t i = 0; i < count; ++ i) {
+        const bool has_two_roots = solutions->number_of_roots[i] == 2;
+
+        for (int j = 0; j < 2; ++ j) {
+            const scalar_t root = solutions->root[j][i];
+            const scalar_t polished =
+                basic_polish_quadratic_equation_root(a[i], b[i], c[i], root, iterations);
+
+            solutions->root[j][i] = has_two_roots ? polished : root;
+        }
+    }
+}
+
+
+/**
+   @brief Solution of an equation whose roots may be complex
+
+   Same as #basic_equation_solution, but a quadratic equation with negative
+   discriminant has two complex conjugate roots instead of none.
+
+   @tparam scalar_t Type of the parts of the roots
+
+   @note Roots are complex exactly when their imaginary parts are non-zero.
+ */
+template <typename scalar_t>
+struct basic_complex_equation_solution {
+    solution_status status; /**< @brief Status of the current solution */
+
+    int number_of_roots;    /**< @brief Number of real or complex roots of the equation
+                                 @note Guaranteed to be >= zero. */
+
+    scalar_t real[2];       /**< @brief Real parts of the roots
+                                 @note First #number_of_roots are roots and the rest
+                                 is zero-initialized. */
+
+    scalar_t imaginary[2];  /**< @brief Imaginary parts of the roots, zero for real roots */
+};
+
+/**
+   @brief Solve quadratic equation of form ax^2 + bx + c == 0 over complex numbers
+
+   Same as #basic_solve_quadratic_equation, bit for bit, except when the
+   discriminant is negative. Then roots are -b / 2a +- i sqrt(-d) / 2a, the
+   one with + first.
+
+   @return 0 on success, illegal coefficient's number (1 for a, 2 for b, etc...)
+   otherwise.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+constexpr int basic_solve_quadratic_equation_complex(
+    const scalar_t a, const scalar_t b, const scalar_t c,
+    basic_complex_equation_solution<scalar_t>* const solution) {
+
+    basic_equation_solution<scalar_t> real_solution = { FINITE_ROOTS, 0, { 0, 0 } };
+
+    const int error = basic_solve_quadratic_equation<scalar_t, tolerance>(a, b, c, &real_solution);
+    if (error != 0)
+        return error;
+
+    *solution = { real_solution.status, real_solution.number_of_roots,
+                  { real_solution.root[0], real_solution.root[1] }, { 0, 0 } };
+
+    const scalar_t discriminant = b * b - 4 * a * c;
+
+    if (!tolerance::is_zero(a) && !tolerance::is_zero(discriminant) && discriminant < 0) {
+        const scalar_t real_part = - b / (2 * a);
+        const scalar_t imaginary_part = constexpr_sqrt(-discriminant) / (2 * a);
+
+        *solution = { FINITE_ROOTS, /* num roots */ 2,
+                      { real_part, real_part }, { imaginary_part, -imaginary_part } };
+    }
+
+    return 0;
+}
+
+
+/**
+   @brief Caller-provided output columns of a complex batch solve
+
+   @see basic_complex_equation_solution, basic_equation_solution_columns
+ */
+template <typename scalar_t>
+struct basic_complex_equation_solution_columns {
+    solution_status* status;          /**< @brief Status of each solution */
+    int* number_of_roots;             /**< @brief Number of real or complex roots */
+
+    scalar_t* real[2];                /**< @brief Columns of real parts of the roots */
+    scalar_t* imaginary[2];           /**< @brief Columns of imaginary parts of the roots */
+
+    int* error_code;                  /**< @brief Per-equation error code */
+};
+
+/**
+   @brief Solve @p count equations over complex numbers without branching
+
+   Branch-free like #basic_solve_quadratic_equation_batch: real and complex
+   answers are both computed from sqrt(|d|) and the right one is selected.
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Results are the same as of #basic_solve_quadratic_equation_complex,
+   illegal equations get #FINITE_ROOTS status with zero roots.
+ */
+template <typename scalar_t, typename tolerance = absolute_tolerance<scalar_t>>
+constexpr size_t basic_solve_quadratic_equation_batch_complex(
+    const scalar_t* const a, const scalar_t* const b, const scalar_t* const c,
+    const size_t count, const basic_complex_equation_solution_columns<scalar_t>* const solutions) {
+
+    const scalar_t zero = 0, one = 1;
+
+    size_t failed = 0;
+
+    for (size_t i = 0; i < count; ++ i) {
+        const scalar_t ai = a[i], bi = b[i], ci = c[i];
+
+        const int error = !is_finite_value(ai) ? 1 :
+                          !is_finite_value(bi) ? 2 :
+                          !is_finite_value(ci) ? 3 : 0;
+
+        const bool is_valid = error == 0;
+
+        const bool a_is_zero = tolerance::is_zero(ai);
+        const bool b_is_zero = tolerance::is_zero(bi);
+        const bool c_is_zero = tolerance::is_zero(ci);
+
+        const scalar_t linear_root = - ci / (b_is_zero ? one : bi);
+
+        const scalar_t discriminant = bi * bi - 4 * ai * ci;
+
+        const bool discriminant_is_zero = tolerance::is_zero(discriminant);
+        const bool discriminant_is_negative = discriminant < 0;
+
+        // One square root serves both real and complex roots
+        const scalar_t sqrt_from_discriminant =
+            constexpr_sqrt(discriminant_is_negative ? -discriminant : discriminant);
+
+        const scalar_t double_a = a_is_zero ? one : 2 * ai;
+
+        const scalar_t single_root = - bi / double_a;
+        const scalar_t imaginary_part = sqrt_from_discriminant / double_a;
+
+        const bool b_is_negative = bi < 0;
+        const scalar_t q =
+            ((b_is_negative ? -bi : bi) + sqrt_from_discriminant) / (b_is_negative ? 2 : -2);
+
+        const scalar_t root_from_q = q / (a_is_zero ? one : ai), root_from_c = ci / q;
+
+        const scalar_t root1 = b_is_negative ? root_from_q : root_from_c,
+                       root2 = b_is_negative ? root_from_c : root_from_q;
+
+        const bool is_complex = !a_is_zero && !discriminant_is_zero && discriminant_is_negative;
+
+        int roots = 0;
+        scalar_t real0 = 0, real1 = 0;
+
+        if (a_is_zero) {
+            roots = b_is_zero ? 0 : 1;
+            real0 = b_is_zero ? zero : linear_root;
+        } else {
+            roots = discriminant_is_zero ? 1 : 2;
+            real0 = discriminant_is_zero || is_complex ? single_root : root1;
+            real1 = discriminant_is_zero ? zero : is_complex ? single_root : root2;
+        }
+
+        const bool infinite = a_is_zero && b_is_zero && c_is_zero;
+
+        solutions->status[i]          = is_valid && infinite ? INF_ROOTS : FINITE_ROOTS;
+        solutions->number_of_roots[i] = is_valid ? roots : 0;
+        solutions->real[0][i]         = is_valid ? real0 : zero;
+        solutions->real[1][i]         = is_valid ? real1 : zero;
+        solutions->imaginary[0][i]    = is_valid && is_complex ? imaginary_part : zero;
+        solutions->imaginary[1][i]    = is_valid && is_complex ? -imaginary_part : zero;
+        solutions->error_code[i]      = error;
+
+        failed += !is_valid;
+    }
+
+    return failed;
+}
+
+#endif // QUADRATIC_EQUATION_SOLVER_CORE_H
@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <cstdlib>
+#include <string.h>
+#include <atomic>
+
+#include "quadratic-equation-dispatch.h"
+#include "quadratic-equation-kernels.h"
+#include "solver-stats.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+static const char* const TIER_NAMES[] = { "scalar", "sse2", "avx2", "avx512" };
+
+static const batch_kernel TIER_KERNELS[] = {
+    solve_quadratic_equation_batch_scalar,
+    solve_quadratic_equation_batch_sse2,
+    solve_quadratic_equation_batch_avx2,
+    solve_quadratic_equation_batch_avx512
+};
+
+static const size_t NUMBER_OF_TIERS = sizeof(TIER_NAMES) / sizeof(*TIER_NAMES);
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Register state the OS has enabled saving on context switches (XCR0)
+static unsigned long long read_extended_control_register(void) {
+    unsigned int eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+
+    return ((unsigned long long) edx << 32) | eax;
+}
+
+static kernel_tier probe_kernel_tier(void) {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return SCALAR_KERNEL;
+
+    if (!(edx & bit_SSE2))
+        return SCALAR_KERNEL;
+
+    // AVX registers are usable only if OS saves them, check with xgetbv
+    const bool has_xsave = (ecx & bit_OSXSAVE) && (ecx & bit_AVX);
+    if (!has_xsave)
+        return SSE2_KERNEL;
+
+    const unsigned long long xcr0 = read_extended_control_register();
+
+    const unsigned long long AVX_STATE    = 0x6;  // XMM and YMM
+    const unsigned long long AVX512_STATE = 0xe0; // Opmask and ZMM
+
+    if ((xcr0 & AVX_STATE) != AVX_STATE)
+        return SSE2_KERNEL;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX2))
+        return SSE2_KERNEL;
+
+    const unsigned int avx512_features = bit_AVX512F | bit_AVX512DQ | bit_AVX512VL;
+    if ((ebx & avx512_features) != avx512_features ||
+        (xcr0 & AVX512_STATE) != AVX512_STATE)
+        return AVX2_KERNEL;
+
+    return AVX512_KERNEL;
+}
+
+#else // Only the portable kernel is available
+
+static kernel_tier probe_kernel_tier(void) {
+    return SCALAR_KERNEL;
+}
+
+#endif
+
+kernel_tier detect_kernel_tier(void) {
+    static const kernel_tier detected = probe_kernel_tier();
+    return detected;
+}
+
+// Tier requested with KERNEL_TIER_ENVIRONMENT_VARIABLE, if it is supported
+static kernel_tier initial_kernel_tier(void) {
+    const kernel_tier detected = detect_kernel_tier();
+
+    const char* const requested = getenv(KERNEL_TIER_ENVIRONMENT_VARIABLE);
+    if (requested == NULL)
+        return detected;
+
+    for (size_t tier = 0; tier < NUMBER_OF_TIERS; ++ tier)
+        if (strcmp(requested, TIER_NAMES[tier]) == 0 && tier <= (size_t) detected)
+            return (kernel_tier) tier;
+
+    return detected;
+}
+
+static std::atomic<int>& active_kernel_tier(void) {
+    static std::atomic<int> active { initial_kernel_tier() };
+    return active;
+}
+
+kernel_tier get_active_kernel_tier(void) {
+    return (kernel_tier) active_kernel_tier().load(std::memory_order_relaxed);
+}
+
+int force_kernel_tier(const kernel_tier tier) {
+    if ((size_t) tier >= NUMBER_OF_TIERS || tier > detect_kernel_tier())
+        return -1;
+
+    active_kernel_tier().store(tier, std::memory_order_relaxed);
+    return 0;
+}
+
+const char* kernel_tier_name(const kernel_tier tier) {
+    if ((size_t) tier >= NUMBER_OF_TIERS)
+        return NULL;
+
+    return TIER_NAMES[tier];
+}
+
+size_t solve_quadratic_equation_batch(const double* const a, const double* const b,
+                                      const double* const c, const size_t count,
+                                      const equation_solution_columns* const solutions) {
+
+    const batch_kernel kernel = TIER_KERNELS[get_active_kernel_tier()];
+    const size_t failed = kernel(a, b, c, count, solutions);
+
+#ifdef EQUATION_SOLVER_STATS
+    // Kernels are left alone, outcomes are counted afterwards
+    for (size_t i = 0; i < count; ++ i)
+        SOLVER_STATS_COUNT_SOLUTION(a[i], solutions->error_code[i], solutions->status[i],
+                                    solutions->number_of_roots[i]);
+#endif
+
+    return failed;
+}
@@ -0,0 +1,55 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_DISPATCH_H
+#define QUADRATIC_EQUATION_SOLVER_DISPATCH_H
+
+/**
+   @brief Instruction set tiers the batch kernels are available for
+
+   @note Tiers are ordered, every tier is wider than the previous one.
+ */
+enum kernel_tier {
+    SCALAR_KERNEL, /**< @brief Portable kernel, works everywhere */
+    SSE2_KERNEL,   /**< @brief Two equations per instruction */
+    AVX2_KERNEL,   /**< @brief Four equations per instruction */
+    AVX512_KERNEL, /**< @brief Eight equations per instruction, needs AVX-512 F, DQ and VL */
+};
+
+/**
+   @brief Name of the environment variable that forces a kernel tier
+
+   Accepted values are the ones returned by #kernel_tier_name. It is read once,
+   on the first batch solve. Unknown or unsupported values are ignored.
+ */
+#define KERNEL_TIER_ENVIRONMENT_VARIABLE "EQUATION_SOLVER_KERNEL"
+
+/**
+   @brief Widest kernel tier supported by the current CPU and OS
+
+   @note CPUID is only probed on the first call, the result is cached.
+ */
+kernel_tier detect_kernel_tier(void);
+
+/**
+   @brief Kernel tier currently used by #solve_quadratic_equation_batch
+ */
+kernel_tier get_active_kernel_tier(void);
+
+/**
+   @brief Make #solve_quadratic_equation_batch use a specific kernel tier
+
+   @param [in] tier Tier to use from now on
+
+   @return 0 on success, -1 if @p tier is not supported by this CPU (in which
+   case the active tier stays the same).
+
+   @note Pass result of #detect_kernel_tier to go back to the default.
+ */
+int force_kernel_tier(const kernel_tier tier);
+
+/**
+   @brief Human-readable tier name ("scalar", "sse2", "avx2" or "avx512")
+
+   @return Name of the tier, or NULL for a value that isn't a #kernel_tier.
+ */
+const char* kernel_tier_name(const kernel_tier tier);
+
+#endif // QUADRATIC_EQUATION_SOLVER_DISPATCH_H
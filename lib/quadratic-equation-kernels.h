@@ -0,0 +1,174 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_KERNELS_H
+#define QUADRATIC_EQUATION_SOLVER_KERNELS_H
+
+#include <cstddef>
+#include <cfloat>
+
+#include "quadratic-equation-batch.h"
+#include "quadratic-equation-dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+   @brief Signature shared by all batch kernels
+
+   Kernels are interchangeable implementations of
+   #solve_quadratic_equation_batch, they produce identical results.
+ */
+typedef size_t (*batch_kernel)(const double* const a, const double* const b,
+                               const double* const c, const size_t count,
+                               const equation_solution_columns* const solutions);
+
+/**
+   @brief Portable branch-free kernel, one equation per iteration
+ */
+size_t solve_quadratic_equation_batch_scalar(const double* const a, const double* const b,
+                                             const double* const c, const size_t count,
+                                             const equation_solution_columns* const solutions);
+
+/**
+   @brief SSE2 kernel, two equations per instruction
+ */
+size_t solve_quadratic_equation_batch_sse2(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions);
+
+/**
+   @brief AVX2 kernel, four equations per instruction
+
+   @warning Must only be called on CPUs that support AVX2.
+ */
+size_t solve_quadratic_equation_batch_avx2(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions);
+
+/**
+   @brief AVX-512 kernel, eight equations per instruction
+
+   @warning Must only be called on CPUs that support AVX-512 F, DQ and VL.
+ */
+size_t solve_quadratic_equation_batch_avx512(const double* const a, const double* const b,
+                                             const double* const c, const size_t count,
+                                             const equation_solution_columns* const solutions);
+
+/**
+   @brief AVX2 kernel of #polish_quadratic_equation_roots_batch
+
+   @warning Must only be called on CPUs that support AVX2.
+ */
+void polish_quadratic_equation_roots_batch_avx2(const double* const a, const double* const b,
+                                                const double* const c, const size_t count,
+                                                const equation_solution_columns* const solutions,
+                                                const int iterations);
+
+/**
+   @brief Columns that start @p offset elements later than @p columns
+ */
+static inline equation_solution_columns
+offset_solution_columns(const equation_solution_columns* const columns, const size_t offset) {
+    return {
+        columns->status + offset,
+        columns->number_of_roots + offset,
+        { columns->root[0] + offset, columns->root[1] + offset },
+        columns->error_code + offset
+    };
+}
+
+/**
+   @brief Whether AVX2 kernels should run, AVX-512 machines use them too
+ */
+static inline bool has_avx2_kernels(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return get_active_kernel_tier() >= AVX2_KERNEL;
+#else
+    return false;
+#endif
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Building blocks of the AVX2 kernels, each has a double and a float
+// version. Operation order matches the scalar solver, so kernels built
+// from them stay bit-identical to it.
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+// Lanes of if_true where mask is set, lanes of if_false elsewhere
+AVX2_TARGET static inline __m256d select_avx2(const __m256d mask, const __m256d if_true,
+                                              const __m256d if_false) {
+    return _mm256_blendv_pd(if_false, if_true, mask);
+}
+
+AVX2_TARGET static inline __m256 select_avx2(const __m256 mask, const __m256 if_true,
+                                             const __m256 if_false) {
+    return _mm256_blendv_ps(if_false, if_true, mask);
+}
+
+AVX2_TARGET static inline __m256d abs_avx2(const __m256d value) {
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+}
+
+AVX2_TARGET static inline __m256 abs_avx2(const __m256 value) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value);
+}
+
+// Mask of lanes whose magnitude is neither infinite nor NaN
+AVX2_TARGET static inline __m256d is_finite_avx2(const __m256d magnitude) {
+    return _mm256_cmp_pd(magnitude, _mm256_set1_pd(DBL_MAX), _CMP_LE_OQ);
+}
+
+AVX2_TARGET static inline __m256 is_finite_avx2(const __m256 magnitude) {
+    return _mm256_cmp_ps(magnitude, _mm256_set1_ps(FLT_MAX), _CMP_LE_OQ);
+}
+
+// Error code of the solver: 1, 2 or 3 for the first non finite of a, b and c, 0 otherwise
+AVX2_TARGET static inline __m256d error_code_avx2(const __m256d a_is_finite,
+                                                  const __m256d b_is_finite,
+                                                  const __m256d c_is_finite) {
+    __m256d error = select_avx2(c_is_finite, _mm256_setzero_pd(), _mm256_set1_pd(3.0));
+    error = select_avx2(b_is_finite, error, _mm256_set1_pd(2.0));
+    return select_avx2(a_is_finite, error, _mm256_set1_pd(1.0));
+}
+
+AVX2_TARGET static inline __m256 error_code_avx2(const __m256 a_is_finite,
+                                                 const __m256 b_is_finite,
+                                                 const __m256 c_is_finite) {
+    __m256 error = select_avx2(c_is_finite, _mm256_setzero_ps(), _mm256_set1_ps(3.0f));
+    error = select_avx2(b_is_finite, error, _mm256_set1_ps(2.0f));
+    return select_avx2(a_is_finite, error, _mm256_set1_ps(1.0f));
+}
+
+// b^2 - 4ac
+AVX2_TARGET static inline __m256d discriminant_avx2(const __m256d va, const __m256d vb,
+                                                    const __m256d vc) {
+    return _mm256_sub_pd(_mm256_mul_pd(vb, vb),
+                         _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(4.0), va), vc));
+}
+
+AVX2_TARGET static inline __m256 discriminant_avx2(const __m256 va, const __m256 vb,
+                                                   const __m256 vc) {
+    return _mm256_sub_ps(_mm256_mul_ps(vb, vb),
+                         _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(4.0f), va), vc));
+}
+
+// q = -sign(b) (|b| + sqrt(d)) / 2, roots are q / a and c / q. Halving
+// is exact, so it's a multiplication.
+AVX2_TARGET static inline __m256d root_product_term_avx2(const __m256d abs_b,
+                                                         const __m256d b_is_negative,
+                                                         const __m256d sqrt_from_discriminant) {
+    return _mm256_mul_pd(_mm256_add_pd(abs_b, sqrt_from_discriminant),
+                         select_avx2(b_is_negative, _mm256_set1_pd(0.5), _mm256_set1_pd(-0.5)));
+}
+
+AVX2_TARGET static inline __m256 root_product_term_avx2(const __m256 abs_b,
+                                                        const __m256 b_is_negative,
+                                                        const __m256 sqrt_from_discriminant) {
+    return _mm256_mul_ps(_mm256_add_ps(abs_b, sqrt_from_discriminant),
+                         select_avx2(b_is_negative, _mm256_set1_ps(0.5f), _mm256_set1_ps(-0.5f)));
+}
+
+#endif
+
+#endif // QUADRATIC_EQUATION_SOLVER_KERNELS_H
@@ -0,0 +1,424 @@
+#include <cstddef>
+#include <cfloat>
+#include <cmath>
+
+#include "quadratic-equation-mixed.h"
+#include "quadratic-equation-solver.h"
+#include "quadratic-equation-kernels.h"
+#include "quadratic-equation-dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Unit roundoff of float, bound on the relative error of one rounding
+static const float FLOAT_ROUNDOFF = FLT_EPSILON / 2;
+
+static const float FLOAT_EPSILON = absolute_tolerance<float>::epsilon;
+
+// Float rounding moves a coefficient and the epsilon itself by one roundoff
+// each, so the zero test may only change for values this close to epsilon
+static const float NEAR_EPSILON_DISTANCE = 6 * FLOAT_ROUNDOFF * FLOAT_EPSILON;
+
+// Every check below is written so that the vector kernel can do exactly the
+// same operations, and both kernels flag the same equations.
+
+static inline bool is_near_epsilon(const float value) {
+    return std::fabs(std::fabs(value) - FLOAT_EPSILON) <= NEAR_EPSILON_DISTANCE;
+}
+
+// Nonzero coefficients below FLT_MIN become subnormal or zero floats
+static inline bool loses_precision(const double value) {
+    return std::fabs(value) < FLT_MIN && value != 0;
+}
+
+// Zero root is only exact when its numerator is zero, otherwise it underflowed
+static inline bool is_doubtful_root(const float root, const bool may_be_zero) {
+    const float magnitude = std::fabs(root);
+    return !(magnitude <= FLT_MAX) || (magnitude < FLT_MIN && !(may_be_zero && root == 0));
+}
+
+// Whether float solution of equation (a, b, c) may be off by more than tolerance
+static inline bool needs_refinement(const float a, const float b, const float c,
+                                    const int number_of_roots, const float tolerance) {
+
+    // Linear root -c / b: two conversions to float and one division
+    if (absolute_tolerance<float>::is_zero(a))
+        return number_of_roots == 1 && !(3 * FLOAT_ROUNDOFF <= tolerance);
+
+    // Same operation order as the solver, so discriminant is the same value
+    const float square = b * b, product = 4 * a * c;
+    const float discriminant = square - product;
+
+    // Both products and the subtraction round once, coefficients themselves
+    // were rounded when converted to float
+    const float magnitude = std::fabs(discriminant);
+    const float discriminant_error = 3 * FLOAT_ROUNDOFF * (square + std::fabs(product));
+
+    // Sign of the discriminant, or its comparison with epsilon, is uncertain
+    const bool is_ambiguous = std::fabs(magnitude - FLOAT_EPSILON) <=
+                              discriminant_error + 4 * FLOAT_ROUNDOFF * FLOAT_EPSILON;
+
+    if (number_of_roots != 2)
+        return is_ambiguous;
+
+    // Relative error of sqrt(d) is half of the discriminant's one. Roots are
+    // q / a and c / q, and b + sign(b) sqrt(d) in q never cancels, so they
+    // only add a rounding of the sum, of the division and of a or c each
+    const float sqrt_error = FLOAT_ROUNDOFF + discriminant_error / (2 * magnitude);
+    const float root_error = 3 * FLOAT_ROUNDOFF + sqrt_error;
+
+    // Written so that NaN and infinite estimates also need refinement
+    return is_ambiguous || !(root_error <= tolerance);
+}
+
+// Solves at most MIXED_PRECISION_CHUNK_SIZE equations in float, writes indices
+// of the ones that need refinement to doubtful and returns their number
+static size_t solve_mixed_chunk_scalar(const double* const a, const double* const b,
+                                       const double* const c, const size_t size,
+                                       const equation_solution_columns* const solutions,
+                                       const float tolerance, size_t* const doubtful) {
+
+    float float_a[MIXED_PRECISION_CHUNK_SIZE];
+    float float_b[MIXED_PRECISION_CHUNK_SIZE];
+    float float_c[MIXED_PRECISION_CHUNK_SIZE];
+
+    float first_root[MIXED_PRECISION_CHUNK_SIZE], second_root[MIXED_PRECISION_CHUNK_SIZE];
+
+    for (size_t i = 0; i < size; ++ i) {
+        float_a[i] = (float) a[i];
+        float_b[i] = (float) b[i];
+        float_c[i] = (float) c[i];
+    }
+
+    // Unused rest is zeroed so the compiler can see that nothing
+    // uninitialized reaches the float solver, full chunks have no rest
+    for (size_t i = size; i < MIXED_PRECISION_CHUNK_SIZE; ++ i)
+        float_a[i] = float_b[i] = float_c[i] = 0.0f;
+
+    // Status, number of roots and error code go straight to the output
+    const float_equation_solution_columns chunk {
+        solutions->status, solutions->number_of_roots,
+        { first_root, second_root }, solutions->error_code
+    };
+
+    solve_quadratic_equation_batch_float(float_a, float_b, float_c, size, &chunk);
+
+    size_t number_of_doubtful = 0;
+
+    for (size_t i = 0; i < size; ++ i) {
+        solutions->root[0][i] = first_root[i];
+        solutions->root[1][i] = second_root[i];
+
+        // Numerator is b for -b / 2a, c for the linear root, c / q and q / a,
+        // which is never zero when there are two roots
+        const int number_of_roots = chunk.number_of_roots[i];
+        const bool is_single_quadratic_root =
+            number_of_roots == 1 && !absolute_tolerance<float>::is_zero(float_a[i]);
+        const float numerator = is_single_quadratic_root ? float_b[i] : float_c[i];
+
+        const bool is_doubtful =
+            chunk.error_code[i] != 0 ||
+            is_near_epsilon(float_a[i]) || is_near_epsilon(float_b[i]) ||
+            is_near_epsilon(float_c[i]) ||
+            loses_precision(a[i]) || loses_precision(b[i]) || loses_precision(c[i]) ||
+            is_doubtful_root(first_root[i], number_of_roots < 1 || numerator == 0) ||
+            is_doubtful_root(second_root[i], number_of_roots < 2 || float_c[i] == 0) ||
+            needs_refinement(float_a[i], float_b[i], float_c[i],
+                             chunk.number_of_roots[i], tolerance);
+
+        doubtful[number_of_doubtful] = i;
+        number_of_doubtful += is_doubtful;
+    }
+
+    return number_of_doubtful;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+AVX2_TARGET static inline __m256 load_as_float_avx2(const double* const values) {
+    const __m128 low = _mm256_cvtpd_ps(_mm256_loadu_pd(values));
+    const __m128 high = _mm256_cvtpd_ps(_mm256_loadu_pd(values + 4));
+
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+}
+
+AVX2_TARGET static inline void store_as_double_avx2(double* const output, const __m256 values) {
+    _mm256_storeu_pd(output, _mm256_cvtps_pd(_mm256_castps256_ps128(values)));
+    _mm256_storeu_pd(output + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)));
+}
+
+// Bit mask of lanes where loses_precision is true
+AVX2_TARGET static inline int loses_precision_avx2(const double* const values) {
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d min_normal = _mm256_set1_pd(FLT_MIN);
+    const __m256d zero = _mm256_setzero_pd();
+
+    const __m256d low = _mm256_loadu_pd(values), high = _mm256_loadu_pd(values + 4);
+
+    const __m256d low_loses = _mm256_and_pd(
+        _mm256_cmp_pd(_mm256_andnot_pd(sign_mask, low), min_normal, _CMP_LT_OQ),
+        _mm256_cmp_pd(low, zero, _CMP_NEQ_OQ));
+
+    const __m256d high_loses = _mm256_and_pd(
+        _mm256_cmp_pd(_mm256_andnot_pd(sign_mask, high), min_normal, _CMP_LT_OQ),
+        _mm256_cmp_pd(high, zero, _CMP_NEQ_OQ));
+
+    return _mm256_movemask_pd(low_loses) | _mm256_movemask_pd(high_loses) << 4;
+}
+
+// Mask of lanes where is_doubtful_root is true
+AVX2_TARGET static inline __m256 is_doubtful_root_avx2(const __m256 root,
+                                                      const __m256 may_be_zero) {
+    const __m256 magnitude = abs_avx2(root);
+
+    const __m256 is_exact_zero =
+        _mm256_and_ps(may_be_zero, _mm256_cmp_ps(root, _mm256_setzero_ps(), _CMP_EQ_OQ));
+
+    return _mm256_or_ps(
+        _mm256_cmp_ps(magnitude, _mm256_set1_ps(FLT_MAX), _CMP_NLE_UQ),
+        _mm256_andnot_ps(is_exact_zero,
+                         _mm256_cmp_ps(magnitude, _mm256_set1_ps(FLT_MIN), _CMP_LT_OQ)));
+}
+
+// Mask of lanes where is_near_epsilon is true
+AVX2_TARGET static inline __m256 is_near_epsilon_avx2(const __m256 magnitude) {
+    return _mm256_cmp_ps(abs_avx2(_mm256_sub_ps(magnitude, _mm256_set1_ps(FLOAT_EPSILON))),
+                         _mm256_set1_ps(NEAR_EPSILON_DISTANCE), _CMP_LE_OQ);
+}
+
+// Same as solve_mixed_chunk_scalar, eight equations at a time. The solve
+// itself mirrors basic_solve_quadratic_equation_batch<float> operation by
+// operation, so results are bit-identical to the scalar chunk.
+AVX2_TARGET
+static size_t solve_mixed_chunk_avx2(const double* const a, const double* const b,
+                                     const double* const c, const size_t size,
+                                     const equation_solution_columns* const solutions,
+                                     const float tolerance, size_t* const doubtful) {
+
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const __m256 epsilon   = _mm256_set1_ps(FLOAT_EPSILON);
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    const __m256 two  = _mm256_set1_ps(2.0f);
+    const __m256 four = _mm256_set1_ps(4.0f);
+    const __m256 all  = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+
+    const __m256 inf_roots = _mm256_set1_ps((float) INF_ROOTS);
+
+    const __m256 roundoff        = _mm256_set1_ps(FLOAT_ROUNDOFF);
+    const __m256 triple_roundoff = _mm256_set1_ps(3 * FLOAT_ROUNDOFF);
+    const __m256 epsilon_error   = _mm256_set1_ps(4 * FLOAT_ROUNDOFF * FLOAT_EPSILON);
+    const __m256 relative_limit  = _mm256_set1_ps(tolerance);
+
+    const __m256 linear_is_imprecise = 3 * FLOAT_ROUNDOFF <= tolerance ? zero : all;
+
+    size_t number_of_doubtful = 0, i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256 va = load_as_float_avx2(a + i);
+        const __m256 vb = load_as_float_avx2(b + i);
+        const __m256 vc = load_as_float_avx2(c + i);
+
+        const __m256 abs_a = abs_avx2(va);
+        const __m256 abs_b = abs_avx2(vb);
+        const __m256 abs_c = abs_avx2(vc);
+
+        const __m256 a_is_finite = is_finite_avx2(abs_a);
+        const __m256 b_is_finite = is_finite_avx2(abs_b);
+        const __m256 c_is_finite = is_finite_avx2(abs_c);
+
+        const __m256 error = error_code_avx2(a_is_finite, b_is_finite, c_is_finite);
+
+        const __m256 is_valid =
+            _mm256_and_ps(a_is_finite, _mm256_and_ps(b_is_finite, c_is_finite));
+
+        const __m256 a_is_zero = _mm256_cmp_ps(abs_a, epsilon, _CMP_LE_OQ);
+        const __m256 b_is_zero = _mm256_cmp_ps(abs_b, epsilon, _CMP_LE_OQ);
+        const __m256 c_is_zero = _mm256_cmp_ps(abs_c, epsilon, _CMP_LE_OQ);
+
+        // Linear equation bx + c == 0
+        const __m256 linear_root =
+            _mm256_div_ps(_mm256_xor_ps(vc, sign_mask), select_avx2(b_is_zero, one, vb));
+
+        const __m256 linear_roots = _mm256_andnot_ps(b_is_zero, one);
+        const __m256 linear_root0 = _mm256_andnot_ps(b_is_zero, linear_root);
+
+        // Quadratic equation
+        const __m256 square = _mm256_mul_ps(vb, vb);
+        const __m256 product = _mm256_mul_ps(_mm256_mul_ps(four, va), vc);
+        const __m256 discriminant = _mm256_sub_ps(square, product);
+        const __m256 magnitude = abs_avx2(discriminant);
+
+        const __m256 discriminant_is_zero = _mm256_cmp_ps(magnitude, epsilon, _CMP_LE_OQ);
+        const __m256 discriminant_is_negative = _mm256_cmp_ps(discriminant, zero, _CMP_LT_OQ);
+
+        const __m256 sqrt_from_discriminant =
+            _mm256_sqrt_ps(select_avx2(discriminant_is_negative, zero, discriminant));
+
+        const __m256 double_a = select_avx2(a_is_zero, one, _mm256_mul_ps(two, va));
+        const __m256 minus_b = _mm256_xor_ps(vb, sign_mask);
+
+        const __m256 single_root = _mm256_div_ps(minus_b, double_a);
+
+        const __m256 b_is_negative = _mm256_cmp_ps(vb, zero, _CMP_LT_OQ);
+        const __m256 q = root_product_term_avx2(abs_b, b_is_negative, sqrt_from_discriminant);
+
+        const __m256 root_from_q = _mm256_div_ps(q, select_avx2(a_is_zero, one, va));
+        const __m256 root_from_c = _mm256_div_ps(vc, q);
+
+        const __m256 root1 = select_avx2(b_is_negative, root_from_q, root_from_c);
+        const __m256 root2 = select_avx2(b_is_negative, root_from_c, root_from_q);
+
+        const __m256 has_two_roots =
+            _mm256_andnot_ps(_mm256_or_ps(discriminant_is_zero, discriminant_is_negative), all);
+
+        const __m256 quadratic_roots =
+            select_avx2(discriminant_is_zero, one, _mm256_and_ps(has_two_roots, two));
+        const __m256 quadratic_root0 =
+            select_avx2(discriminant_is_zero, single_root, _mm256_and_ps(has_two_roots, root1));
+        const __m256 quadratic_root1 = _mm256_and_ps(has_two_roots, root2);
+
+        // Pick linear or quadratic answer, then zero out illegal lanes
+        const __m256 roots = select_avx2(a_is_zero, linear_roots, quadratic_roots);
+        const __m256 root0 =
+            _mm256_and_ps(is_valid, select_avx2(a_is_zero, linear_root0, quadratic_root0));
+        const __m256 root1_value =
+            _mm256_and_ps(is_valid, _mm256_andnot_ps(a_is_zero, quadratic_root1));
+
+        const __m256 is_infinite =
+            _mm256_and_ps(is_valid, _mm256_and_ps(a_is_zero, _mm256_and_ps(b_is_zero, c_is_zero)));
+
+        _mm256_storeu_si256((__m256i*) (solutions->status + i),
+                            _mm256_cvttps_epi32(_mm256_and_ps(is_infinite, inf_roots)));
+        const __m256 number_of_roots = _mm256_and_ps(is_valid, roots);
+
+        _mm256_storeu_si256((__m256i*) (solutions->number_of_roots + i),
+                            _mm256_cvttps_epi32(number_of_roots));
+        _mm256_storeu_si256((__m256i*) (solutions->error_code + i), _mm256_cvttps_epi32(error));
+
+        store_as_double_avx2(solutions->root[0] + i, root0);
+        store_as_double_avx2(solutions->root[1] + i, root1_value);
+
+        // Error estimate, operation by operation the same as needs_refinement
+        const __m256 discriminant_error =
+            _mm256_mul_ps(triple_roundoff, _mm256_add_ps(square, abs_avx2(product)));
+
+        const __m256 is_ambiguous =
+            _mm256_cmp_ps(abs_avx2(_mm256_sub_ps(magnitude, epsilon)),
+                          _mm256_add_ps(discriminant_error, epsilon_error), _CMP_LE_OQ);
+
+        const __m256 sqrt_error = _mm256_add_ps(
+            roundoff, _mm256_div_ps(discriminant_error, _mm256_mul_ps(two, magnitude)));
+
+        const __m256 root_error = _mm256_add_ps(triple_roundoff, sqrt_error);
+
+        const __m256 is_imprecise = _mm256_cmp_ps(root_error, relative_limit, _CMP_NLE_UQ);
+
+        const __m256 needs_refinement = select_avx2(
+            a_is_zero,
+            _mm256_andnot_ps(b_is_zero, linear_is_imprecise),
+            _mm256_or_ps(is_ambiguous, _mm256_and_ps(has_two_roots, is_imprecise)));
+
+        // Numerators of roots, same as in solve_mixed_chunk_scalar
+        const __m256 numerator =
+            select_avx2(_mm256_andnot_ps(a_is_zero, discriminant_is_zero), vb, vc);
+
+        const __m256 root0_may_be_zero = _mm256_or_ps(
+            _mm256_cmp_ps(number_of_roots, one, _CMP_LT_OQ),
+            _mm256_cmp_ps(numerator, zero, _CMP_EQ_OQ));
+        const __m256 root1_may_be_zero = _mm256_or_ps(
+            _mm256_cmp_ps(number_of_roots, two, _CMP_LT_OQ),
+            _mm256_cmp_ps(vc, zero, _CMP_EQ_OQ));
+
+        const __m256 is_doubtful = _mm256_or_ps(
+            _mm256_or_ps(_mm256_andnot_ps(is_valid, all), needs_refinement),
+            _mm256_or_ps(
+                _mm256_or_ps(is_near_epsilon_avx2(abs_a), is_near_epsilon_avx2(abs_b)),
+                _mm256_or_ps(is_near_epsilon_avx2(abs_c),
+                             _mm256_or_ps(is_doubtful_root_avx2(root0, root0_may_be_zero),
+                                          is_doubtful_root_avx2(root1_value,
+                                                                root1_may_be_zero)))));
+
+        unsigned lanes = (unsigned) (_mm256_movemask_ps(is_doubtful) |
+                                     loses_precision_avx2(a + i) |
+                                     loses_precision_avx2(b + i) |
+                                     loses_precision_avx2(c + i));
+
+        for (; lanes != 0; lanes &= lanes - 1)
+            doubtful[number_of_doubtful ++] = i + (size_t) __builtin_ctz(lanes);
+    }
+
+    // Remaining equations, their indices come relative to i
+    const equation_solution_columns tail = offset_solution_columns(solutions, i);
+
+    const size_t tail_doubtful = solve_mixed_chunk_scalar(a + i, b + i, c + i, size - i, &tail,
+                                                          tolerance, doubtful + number_of_doubtful);
+
+    for (size_t j = 0; j < tail_doubtful; ++ j)
+        doubtful[number_of_doubtful ++] += i;
+
+    return number_of_doubtful;
+}
+
+#endif
+
+typedef size_t (*mixed_chunk_kernel)(const double* const a, const double* const b,
+                                     const double* const c, const size_t size,
+                                     const equation_solution_columns* const solutions,
+                                     const float tolerance, size_t* const doubtful);
+
+static mixed_chunk_kernel select_mixed_chunk_kernel(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (has_avx2_kernels())
+        return solve_mixed_chunk_avx2;
+#endif
+
+    return solve_mixed_chunk_scalar;
+}
+
+size_t solve_quadratic_equation_batch_mixed(const double* const a, const double* const b,
+                                            const double* const c, const size_t count,
+                                            const equation_solution_columns* const solutions,
+                                            const double relative_tolerance,
+                                            size_t* const refined_count) {
+
+    const float tolerance = (float) relative_tolerance;
+    const mixed_chunk_kernel solve_chunk = select_mixed_chunk_kernel();
+
+    size_t doubtful[MIXED_PRECISION_CHUNK_SIZE];
+    size_t failed = 0, refined = 0;
+
+    for (size_t begin = 0; begin < count; begin += MIXED_PRECISION_CHUNK_SIZE) {
+        const size_t left = count - begin;
+        const size_t size = left < MIXED_PRECISION_CHUNK_SIZE ? left : MIXED_PRECISION_CHUNK_SIZE;
+
+        const equation_solution_columns chunk = offset_solution_columns(solutions, begin);
+
+        const size_t number_of_doubtful = solve_chunk(a + begin, b + begin, c + begin, size,
+                                                      &chunk, tolerance, doubtful);
+
+        // Rare equations are solved again with the double-precision solver
+        for (size_t j = 0; j < number_of_doubtful; ++ j) {
+            const size_t i = begin + doubtful[j];
+
+            equation_solution solution { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+            const int error = solve_quadratic_equation(a[i], b[i], c[i], &solution);
+
+            solutions->status[i]          = solution.status;
+            solutions->number_of_roots[i] = solution.number_of_roots;
+            solutions->root[0][i]         = solution.root[0];
+            solutions->root[1][i]         = solution.root[1];
+            solutions->error_code[i]      = error;
+
+            failed += error != 0;
+        }
+
+        refined += number_of_doubtful;
+    }
+
+    if (refined_count != NULL)
+        *refined_count = refined;
+
+    return failed;
+}
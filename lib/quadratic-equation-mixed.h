@@ -0,0 +1,55 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_MIXED_H
+#define QUADRATIC_EQUATION_SOLVER_MIXED_H
+
+#include <cstddef>
+
+#include "quadratic-equation-batch.h"
+
+/**
+   @brief Default bound on the estimated relative error of mixed-precision roots
+
+   Error estimate of a single-precision root is a worst-case bound of a few
+   dozen float ulps (~6e-8 each) for well-conditioned equations, so they
+   pass it, while equations with close roots or heavy cancellation don't.
+ */
+const double MIXED_PRECISION_DEFAULT_TOLERANCE = 1e-5;
+
+/**
+   @brief Number of equations converted to float and solved at a time
+ */
+const size_t MIXED_PRECISION_CHUNK_SIZE = 256;
+
+/**
+   @brief Solve batch of equations in single precision, refining doubtful ones
+
+   Every equation is first solved in float with #solve_quadratic_equation_batch_float.
+   Equations whose float result can't be trusted are then solved again with
+   #solve_quadratic_equation, and their float results are discarded. Equation
+   is solved again when:
+     - the estimated relative error of one of its roots exceeds
+       @p relative_tolerance, which happens when b*b - 4*a*c nearly cancels;
+     - a coefficient or the discriminant is so close to #EQUATION_SOLVER_EPSILON
+       that float rounding may change the number of roots;
+     - a coefficient or a root isn't representable as a normal float;
+     - the equation has an illegal coefficient.
+
+   @param [in]  a                  Column of coefficients a
+   @param [in]  b                  Column of coefficients b
+   @param [in]  c                  Column of coefficients c
+   @param [in]  count              Number of equations in the batch
+   @param [out] solutions          Output columns, each with room for @p count elements
+   @param [in]  relative_tolerance Bound on the estimated relative error of every root
+   @param [out] refined_count      Number of equations solved again in double, may be NULL
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Number of roots and status always match #solve_quadratic_equation_batch.
+   Tolerance below ~3e-7 makes every equation with roots fall back to double.
+ */
+size_t solve_quadratic_equation_batch_mixed(const double* const a, const double* const b,
+                                            const double* const c, const size_t count,
+                                            const equation_solution_columns* const solutions,
+                                            const double relative_tolerance,
+                                            size_t* const refined_count);
+
+#endif // QUADRATIC_EQUATION_SOLVER_MIXED_H
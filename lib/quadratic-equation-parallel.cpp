@@ -0,0 +1,52 @@
+#include <cstddef>
+#include <atomic>
+
+#include "quadratic-equation-parallel.h"
+#include "quadratic-equation-kernels.h"
+
+struct parallel_batch_job {
+    const double* a;
+    const double* b;
+    const double* c;
+    size_t count;
+
+    const equation_solution_columns* solutions;
+
+    std::atomic<size_t> failed;
+};
+
+static void solve_chunk(void* const context, const size_t task_index, const size_t) {
+    parallel_batch_job* const job = (parallel_batch_job*) context;
+
+    const size_t begin = task_index * PARALLEL_BATCH_CHUNK_SIZE;
+    const size_t left = job->count - begin;
+    const size_t size = left < PARALLEL_BATCH_CHUNK_SIZE ? left : PARALLEL_BATCH_CHUNK_SIZE;
+
+    const equation_solution_columns chunk = offset_solution_columns(job->solutions, begin);
+
+    const size_t failed = solve_quadratic_equation_batch(job->a + begin, job->b + begin,
+                                                         job->c + begin, size, &chunk);
+    if (failed != 0)
+        job->failed.fetch_add(failed, std::memory_order_relaxed);
+}
+
+size_t solve_quadratic_equation_batch_parallel(solver_thread_pool* const pool,
+                                               const double* const a, const double* const b,
+                                               const double* const c, const size_t count,
+                                               const equation_solution_columns* const solutions) {
+
+    solver_thread_pool* const used_pool =
+        pool != NULL ? pool : get_default_solver_thread_pool();
+
+    if (count <= PARALLEL_BATCH_CHUNK_SIZE || used_pool == NULL)
+        return solve_quadratic_equation_batch(a, b, c, count, solutions);
+
+    parallel_batch_job job { a, b, c, count, solutions, { 0 } };
+
+    const size_t number_of_chunks =
+        (count + PARALLEL_BATCH_CHUNK_SIZE - 1) / PARALLEL_BATCH_CHUNK_SIZE;
+
+    run_solver_thread_pool_tasks(used_pool, number_of_chunks, solve_chunk, &job);
+
+    return job.failed.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,327 @@
+#include <cstddef>
+#include <cstdint>
+#include <cfloat>
+#include <cmath>
+
+#include "quadratic-equation-partition.h"
+#include "quadratic-equation-kernels.h"
+#include "quadratic-equation-dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+typedef absolute_tolerance<double> tolerance;
+
+// Branch-free, so interleaved classes cost no mispredictions
+static inline equation_class classify(const double a, const double b, const double c) {
+    const double abs_a = std::fabs(a), abs_b = std::fabs(b), abs_c = std::fabs(c);
+
+    const int is_valid = (abs_a <= DBL_MAX) & (abs_b <= DBL_MAX) & (abs_c <= DBL_MAX);
+    const int a_is_zero = abs_a <= EQUATION_SOLVER_EPSILON;
+    const int b_is_zero = abs_b <= EQUATION_SOLVER_EPSILON;
+
+    // 3 for quadratic, 1 for linear, 2 for degenerate, 0 for invalid
+    return (equation_class) (is_valid * (3 - 2 * a_is_zero + (a_is_zero & b_is_zero)));
+}
+
+equation_class classify_equation(const double a, const double b, const double c) {
+    return classify(a, b, c);
+}
+
+// ========================== Quadratic kernels =========================
+
+// Coefficient and result columns of quadratic equations
+struct quadratic_columns {
+    const double* a;
+    const double* b;
+    const double* c;
+
+    int* number_of_roots;
+    double* root[2];
+};
+
+// Quadratic branch of basic_solve_quadratic_equation with the same
+// operation order, a is known to be nonzero and every coefficient finite
+static void solve_quadratic_group_scalar(const quadratic_columns* const group,
+                                         const size_t begin, const size_t count) {
+
+    for (size_t i = begin; i < count; ++ i) {
+        const double a = group->a[i], b = group->b[i], c = group->c[i];
+        const double discriminant = b * b - 4 * a * c;
+
+        int roots = 0;
+        double root0 = 0, root1 = 0;
+
+        if (tolerance::is_zero(discriminant)) {
+            roots = 1;
+            root0 = - b / (2 * a);
+        } else if (!(discriminant < 0)) {
+            const double sqrt_from_discriminant = std::sqrt(discriminant);
+            const double q = ((b < 0 ? -b : b) + sqrt_from_discriminant) / (b < 0 ? 2 : -2);
+
+            roots = 2;
+            root0 = b < 0 ? q / a : c / q;
+            root1 = b < 0 ? c / q : q / a;
+        }
+
+        group->number_of_roots[i] = roots;
+        group->root[0][i] = root0;
+        group->root[1][i] = root1;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Same as solve_quadratic_group_scalar, four equations at a time. Compared
+// to the full batch kernel there are no validity checks and no linear case.
+AVX2_TARGET
+static void solve_quadratic_group_avx2(const quadratic_columns* const group, const size_t count) {
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d epsilon   = _mm256_set1_pd(EQUATION_SOLVER_EPSILON);
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d two  = _mm256_set1_pd(2.0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d va = _mm256_loadu_pd(group->a + i);
+        const __m256d vb = _mm256_loadu_pd(group->b + i);
+        const __m256d vc = _mm256_loadu_pd(group->c + i);
+
+        const __m256d discriminant = discriminant_avx2(va, vb, vc);
+
+        const __m256d discriminant_is_zero =
+            _mm256_cmp_pd(abs_avx2(discriminant), epsilon, _CMP_LE_OQ);
+
+        // Not less than zero, so NaN discriminant gives two NaN roots like the solver
+        const __m256d has_two_roots = _mm256_andnot_pd(
+            discriminant_is_zero, _mm256_cmp_pd(discriminant, zero, _CMP_NLT_UQ));
+
+        const __m256d sqrt_from_discriminant =
+            _mm256_sqrt_pd(_mm256_and_pd(has_two_roots, discriminant));
+
+        const __m256d double_a = _mm256_mul_pd(two, va);
+        const __m256d minus_b = _mm256_xor_pd(vb, sign_mask);
+
+        const __m256d single_root = _mm256_div_pd(minus_b, double_a);
+
+        const __m256d b_is_negative = _mm256_cmp_pd(vb, zero, _CMP_LT_OQ);
+        const __m256d q =
+            root_product_term_avx2(abs_avx2(vb), b_is_negative, sqrt_from_discriminant);
+
+        const __m256d root_from_q = _mm256_div_pd(q, va);
+        const __m256d root_from_c = _mm256_div_pd(vc, q);
+
+        const __m256d root1 = select_avx2(b_is_negative, root_from_q, root_from_c);
+        const __m256d root2 = select_avx2(b_is_negative, root_from_c, root_from_q);
+
+        const __m256d roots =
+            select_avx2(discriminant_is_zero, one, _mm256_and_pd(has_two_roots, two));
+
+        _mm_storeu_si128((__m128i*) (group->number_of_roots + i), _mm256_cvttpd_epi32(roots));
+
+        _mm256_storeu_pd(group->root[0] + i,
+                         select_avx2(discriminant_is_zero, single_root,
+                                     _mm256_and_pd(has_two_roots, root1)));
+        _mm256_storeu_pd(group->root[1] + i, _mm256_and_pd(has_two_roots, root2));
+    }
+
+    solve_quadratic_group_scalar(group, i, count);
+}
+
+#endif
+
+static void solve_quadratic_group(const quadratic_columns* const group, const size_t count) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (has_avx2_kernels()) {
+        solve_quadratic_group_avx2(group, count);
+        return;
+    }
+#endif
+
+    solve_quadratic_group_scalar(group, 0, count);
+}
+
+// ============================ Partitioning ============================
+
+struct partition_scratch {
+    uint32_t order[PARTITION_CHUNK_SIZE]; // Indices grouped by class
+    uint8_t classes[PARTITION_CHUNK_SIZE];
+
+    size_t group_begin[NUMBER_OF_EQUATION_CLASSES + 1];
+
+    // Gathered quadratic equations and their results
+    double a[PARTITION_CHUNK_SIZE];
+    double b[PARTITION_CHUNK_SIZE];
+    double c[PARTITION_CHUNK_SIZE];
+
+    int number_of_roots[PARTITION_CHUNK_SIZE];
+    double root[2][PARTITION_CHUNK_SIZE];
+};
+
+// Classifies chunk equations, fills group_begin and returns whether every
+// equation is of the same class
+static bool classify_chunk(const double* const a, const double* const b, const double* const c,
+                           const size_t size, partition_scratch* const scratch) {
+
+    // Separate counters, so that the loop has no dependency through memory
+    size_t invalid = 0, linear = 0, degenerate = 0;
+
+    for (size_t i = 0; i < size; ++ i) {
+        const equation_class current = classify(a[i], b[i], c[i]);
+        scratch->classes[i] = (uint8_t) current;
+
+        invalid    += current == INVALID_EQUATION;
+        linear     += current == LINEAR_EQUATION;
+        degenerate += current == DEGENERATE_EQUATION;
+    }
+
+    size_t* const group_begin = scratch->group_begin;
+
+    group_begin[INVALID_EQUATION]    = 0;
+    group_begin[LINEAR_EQUATION]     = invalid;
+    group_begin[DEGENERATE_EQUATION] = invalid + linear;
+    group_begin[QUADRATIC_EQUATION]  = invalid + linear + degenerate;
+    group_begin[NUMBER_OF_EQUATION_CLASSES] = size;
+
+    for (size_t i = 0; i < NUMBER_OF_EQUATION_CLASSES; ++ i)
+        if (group_begin[i + 1] - group_begin[i] == size)
+            return true;
+
+    return false;
+}
+
+// Counting sort of chunk indices by class, stable inside every class
+static void partition_chunk(const size_t size, partition_scratch* const scratch) {
+    size_t next[NUMBER_OF_EQUATION_CLASSES];
+
+    for (size_t i = 0; i < NUMBER_OF_EQUATION_CLASSES; ++ i)
+        next[i] = scratch->group_begin[i];
+
+    for (size_t i = 0; i < size; ++ i)
+        scratch->order[next[scratch->classes[i]] ++] = (uint32_t) i;
+}
+
+static void write_solution(const equation_solution_columns* const solutions, const size_t i,
+                           const solution_status status, const int number_of_roots,
+                           const double root0, const double root1, const int error) {
+
+    solutions->status[i]          = status;
+    solutions->number_of_roots[i] = number_of_roots;
+    solutions->root[0][i]         = root0;
+    solutions->root[1][i]         = root1;
+    solutions->error_code[i]      = error;
+}
+
+static size_t solve_partitioned_chunk(const double* const a, const double* const b,
+                                      const double* const c, const size_t size,
+                                      const equation_solution_columns* const solutions,
+                                      partition_scratch* const scratch) {
+
+    const bool is_uniform = classify_chunk(a, b, c, size, scratch);
+
+    const size_t* const group_begin = scratch->group_begin;
+
+    const size_t linear_count = group_begin[LINEAR_EQUATION + 1] - group_begin[LINEAR_EQUATION];
+    const size_t quadratic_count =
+        group_begin[QUADRATIC_EQUATION + 1] - group_begin[QUADRATIC_EQUATION];
+
+    // Chunk inside a run of linear or quadratic equations needs neither
+    // gather nor scatter
+    if (is_uniform && (quadratic_count == size || linear_count == size)) {
+        for (size_t i = 0; i < size; ++ i) {
+            solutions->status[i] = FINITE_ROOTS;
+            solutions->error_code[i] = 0;
+        }
+
+        if (linear_count == size)
+            for (size_t i = 0; i < size; ++ i) {
+                solutions->number_of_roots[i] = 1;
+                solutions->root[0][i] = - c[i] / b[i];
+                solutions->root[1][i] = 0.0;
+            }
+        else {
+            const quadratic_columns group {
+                a, b, c, solutions->number_of_roots, { solutions->root[0], solutions->root[1] }
+            };
+
+            solve_quadratic_group(&group, size);
+        }
+
+        return 0;
+    }
+
+    partition_chunk(size, scratch);
+    const uint32_t* const order = scratch->order;
+
+    // Invalid equations only need an error code
+    for (size_t j = group_begin[INVALID_EQUATION]; j < group_begin[INVALID_EQUATION + 1]; ++ j) {
+        const size_t i = order[j];
+
+        const int error = !is_finite_value(a[i]) ? 1 : !is_finite_value(b[i]) ? 2 : 3;
+        write_solution(solutions, i, FINITE_ROOTS, 0, 0.0, 0.0, error);
+    }
+
+    // Degenerate equations 0 == c have either no roots or infinitely many
+    const size_t degenerate_end = group_begin[DEGENERATE_EQUATION + 1];
+
+    for (size_t j = group_begin[DEGENERATE_EQUATION]; j < degenerate_end; ++ j) {
+        const size_t i = order[j];
+
+        const solution_status status = tolerance::is_zero(c[i]) ? INF_ROOTS : FINITE_ROOTS;
+        write_solution(solutions, i, status, 0, 0.0, 0.0, 0);
+    }
+
+    // Linear equations, one division each
+    const uint32_t* const linear = order + group_begin[LINEAR_EQUATION];
+
+    for (size_t j = 0; j < linear_count; ++ j)
+        write_solution(solutions, linear[j], FINITE_ROOTS, 1,
+                       - c[linear[j]] / b[linear[j]], 0.0, 0);
+
+    // Quadratic equations
+    const uint32_t* const quadratic = order + group_begin[QUADRATIC_EQUATION];
+
+    for (size_t j = 0; j < quadratic_count; ++ j) {
+        scratch->a[j] = a[quadratic[j]];
+        scratch->b[j] = b[quadratic[j]];
+        scratch->c[j] = c[quadratic[j]];
+    }
+
+    const quadratic_columns group {
+        scratch->a, scratch->b, scratch->c,
+        scratch->number_of_roots, { scratch->root[0], scratch->root[1] }
+    };
+
+    solve_quadratic_group(&group, quadratic_count);
+
+    for (size_t j = 0; j < quadratic_count; ++ j)
+        write_solution(solutions, quadratic[j], FINITE_ROOTS, scratch->number_of_roots[j],
+                       scratch->root[0][j], scratch->root[1][j], 0);
+
+    return group_begin[INVALID_EQUATION + 1] - group_begin[INVALID_EQUATION];
+}
+
+size_t solve_quadratic_equation_batch_partitioned(const double* const a, const double* const b,
+                                                  const double* const c, const size_t count,
+                                                  const equation_solution_columns* const solutions) {
+
+    // ~25 KiB, too much for stacks of some threads
+    static thread_local partition_scratch scratch;
+
+    size_t failed = 0;
+
+    for (size_t begin = 0; begin < count; begin += PARTITION_CHUNK_SIZE) {
+        const size_t left = count - begin;
+        const size_t size = left < PARTITION_CHUNK_SIZE ? left : PARTITION_CHUNK_SIZE;
+
+        const equation_solution_columns chunk = offset_solution_columns(solutions, begin);
+
+        failed += solve_partitioned_chunk(a + begin, b + begin, c + begin, size,
+                                          &chunk, &scratch);
+    }
+
+    return failed;
+}
@@ -0,0 +1,49 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_PARTITION_H
+#define QUADRATIC_EQUATION_SOLVER_PARTITION_H
+
+#include <cstddef>
+
+#include "quadratic-equation-batch.h"
+
+/**
+   @brief Number of equations classified and solved at a time
+ */
+const size_t PARTITION_CHUNK_SIZE = 512;
+
+/**
+   @brief Classes equations are partitioned into before solving
+ */
+enum equation_class {
+    INVALID_EQUATION,    /**< @brief Some coefficient is infinity or NaN */
+    LINEAR_EQUATION,     /**< @brief a is zero, b isn't, exactly one root */
+    DEGENERATE_EQUATION, /**< @brief a and b are zero, no roots or #INF_ROOTS */
+    QUADRATIC_EQUATION,  /**< @brief a isn't zero */
+
+    NUMBER_OF_EQUATION_CLASSES
+};
+
+/**
+   @brief Solve batch of equations, grouping them by class first
+
+   Same as #solve_quadratic_equation_batch, but each chunk of
+   #PARTITION_CHUNK_SIZE equations is first partitioned by #equation_class.
+   Every group is gathered into contiguous columns and solved by a kernel
+   that only handles its class, then results are scattered back. Vector
+   lanes never compute answers of other classes just to mask them out.
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Pays off for batches that mix classes, like long runs of linear
+   equations between quadratic ones. Results are bit-identical to
+   #solve_quadratic_equation_batch.
+ */
+size_t solve_quadratic_equation_batch_partitioned(const double* const a, const double* const b,
+                                                  const double* const c, const size_t count,
+                                                  const equation_solution_columns* const solutions);
+
+/**
+   @brief Class of equation ax^2 + bx + c == 0, as #solve_quadratic_equation sees it
+ */
+equation_class classify_equation(const double a, const double b, const double c);
+
+#endif // QUADRATIC_EQUATION_SOLVER_PARTITION_H
@@ -0,0 +1,490 @@
+#include <cstddef>
+#include <cfloat>
+#include <cmath>
+
+#include "quadratic-equation-queries.h"
+#include "quadratic-equation-kernels.h"
+#include "quadratic-equation-dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+typedef absolute_tolerance<double> tolerance;
+
+// ============================ Single queries ==========================
+
+static inline int illegal_coefficient(const double a, const double b, const double c) {
+    return !is_finite_value(a) ? 1 :
+           !is_finite_value(b) ? 2 :
+           !is_finite_value(c) ? 3 : 0;
+}
+
+// Branches of basic_solve_quadratic_equation without computing any root,
+// every coefficient is known to be finite
+static inline int count_roots(const double a, const double b, const double c,
+                              solution_status* const status) {
+    *status = FINITE_ROOTS;
+
+    if (tolerance::is_zero(a)) {
+        if (!tolerance::is_zero(b))
+            return 1;
+
+        if (tolerance::is_zero(c))
+            *status = INF_ROOTS;
+
+        return 0;
+    }
+
+    const double discriminant = b * b - 4 * a * c;
+
+    return tolerance::is_zero(discriminant) ? 1 : discriminant < 0 ? 0 : 2;
+}
+
+// q of the solver's q / a and c / q roots
+static inline double root_product_term(const double b, const double sqrt_from_discriminant) {
+    return ((b < 0 ? -b : b) + sqrt_from_discriminant) / (b < 0 ? 2 : -2);
+}
+
+// Of the two roots (-b + sqrt) / 2a and (-b - sqrt) / 2a the first one is
+// larger when a is positive, and it's q / a when b is negative
+static inline double choose_root(const double a, const double b, const double c,
+                                 const double sqrt_from_discriminant, const root_choice choice) {
+
+    const bool is_plus = (a > 0) == (choice == LARGEST_ROOT);
+    const double q = root_product_term(b, sqrt_from_discriminant);
+
+    return is_plus == (b < 0) ? q / a : c / q;
+}
+
+static inline int find_root(const double a, const double b, const double c,
+                            const root_choice choice, solution_status* const status,
+                            double* const root) {
+    *root = 0;
+
+    const int number_of_roots = count_roots(a, b, c, status);
+    if (number_of_roots == 0)
+        return 0;
+
+    if (tolerance::is_zero(a))
+        *root = - c / b;
+
+    else if (number_of_roots == 1)
+        *root = - b / (2 * a);
+
+    else
+        *root = choose_root(a, b, c, std::sqrt(b * b - 4 * a * c), choice);
+
+    return number_of_roots;
+}
+
+static inline bool is_in_interval(const double value, const double lo, const double hi) {
+    return lo <= value && value <= hi;
+}
+
+static inline bool has_root_in(const double a, const double b, const double c,
+                               const double lo, const double hi) {
+    solution_status status = FINITE_ROOTS;
+    const int number_of_roots = count_roots(a, b, c, &status);
+
+    if (number_of_roots == 0)
+        return status == INF_ROOTS && lo <= hi;
+
+    if (tolerance::is_zero(a))
+        return is_in_interval(- c / b, lo, hi);
+
+    if (number_of_roots == 1)
+        return is_in_interval(- b / (2 * a), lo, hi);
+
+    const double q = root_product_term(b, std::sqrt(b * b - 4 * a * c));
+
+    return is_in_interval(q / a, lo, hi) || is_in_interval(c / q, lo, hi);
+}
+
+int count_quadratic_equation_roots(const double a, const double b, const double c,
+                                   solution_status* const status, int* const number_of_roots) {
+
+    const int error = illegal_coefficient(a, b, c);
+    if (error != 0)
+        return error;
+
+    *number_of_roots = count_roots(a, b, c, status);
+    return 0;
+}
+
+int find_quadratic_equation_root(const double a, const double b, const double c,
+                                 const root_choice choice, solution_status* const status,
+                                 int* const number_of_roots, double* const root) {
+
+    const int error = illegal_coefficient(a, b, c);
+    if (error != 0)
+        return error;
+
+    *number_of_roots = find_root(a, b, c, choice, status, root);
+    return 0;
+}
+
+int has_quadratic_equation_root_in(const double a, const double b, const double c,
+                                   const double lo, const double hi, bool* const has_root) {
+
+    const int error = illegal_coefficient(a, b, c);
+    if (error != 0)
+        return error;
+
+    *has_root = has_root_in(a, b, c, lo, hi);
+    return 0;
+}
+
+// ========================= Portable batch loops =======================
+
+static size_t count_roots_batch_scalar(const double* const a, const double* const b,
+                                       const double* const c, const size_t begin,
+                                       const size_t count, const root_count_columns* const counts) {
+    size_t failed = 0;
+
+    for (size_t i = begin; i < count; ++ i) {
+        const int error = illegal_coefficient(a[i], b[i], c[i]);
+
+        solution_status status = FINITE_ROOTS;
+        const int number_of_roots = error == 0 ? count_roots(a[i], b[i], c[i], &status) : 0;
+
+        counts->status[i] = status;
+        counts->number_of_roots[i] = number_of_roots;
+        counts->error_code[i] = error;
+
+        failed += error != 0;
+    }
+
+    return failed;
+}
+
+static size_t find_root_batch_scalar(const double* const a, const double* const b,
+                                     const double* const c, const size_t begin,
+                                     const size_t count, const root_choice choice,
+                                     const root_count_columns* const counts,
+                                     double* const root) {
+    size_t failed = 0;
+
+    for (size_t i = begin; i < count; ++ i) {
+        const int error = illegal_coefficient(a[i], b[i], c[i]);
+
+        solution_status status = FINITE_ROOTS;
+        double chosen = 0;
+        const int number_of_roots =
+            error == 0 ? find_root(a[i], b[i], c[i], choice, &status, &chosen) : 0;
+
+        counts->status[i] = status;
+        counts->number_of_roots[i] = number_of_roots;
+        counts->error_code[i] = error;
+        root[i] = chosen;
+
+        failed += error != 0;
+    }
+
+    return failed;
+}
+
+static size_t has_root_in_batch_scalar(const double* const a, const double* const b,
+                                       const double* const c, const size_t begin,
+                                       const size_t count, const double lo, const double hi,
+                                       bool* const has_root) {
+    size_t found = 0;
+
+    for (size_t i = begin; i < count; ++ i) {
+        has_root[i] = illegal_coefficient(a[i], b[i], c[i]) == 0 &&
+                      has_root_in(a[i], b[i], c[i], lo, hi);
+
+        found += has_root[i];
+    }
+
+    return found;
+}
+
+// ============================ AVX2 kernels ============================
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// What count_roots decides for four equations, every mask is all ones or zeros
+struct avx2_root_classes {
+    __m256d error;
+    __m256d is_valid;
+
+    __m256d a_is_zero;
+    __m256d b_is_zero;
+    __m256d is_infinite;
+
+    __m256d discriminant;
+    __m256d discriminant_is_zero;
+    __m256d has_two_roots; // Quadratic with positive (or NaN) discriminant
+    __m256d has_root;      // At least one real root
+
+    __m256d number_of_roots;
+};
+
+AVX2_TARGET
+static inline void classify_roots_avx2(const __m256d va, const __m256d vb, const __m256d vc,
+                                       avx2_root_classes* const classes) {
+
+    const __m256d epsilon = _mm256_set1_pd(EQUATION_SOLVER_EPSILON);
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d two  = _mm256_set1_pd(2.0);
+
+    const __m256d all_ones = _mm256_cmp_pd(zero, zero, _CMP_EQ_OQ);
+
+    const __m256d abs_a = abs_avx2(va);
+    const __m256d abs_b = abs_avx2(vb);
+    const __m256d abs_c = abs_avx2(vc);
+
+    const __m256d a_is_finite = is_finite_avx2(abs_a);
+    const __m256d b_is_finite = is_finite_avx2(abs_b);
+    const __m256d c_is_finite = is_finite_avx2(abs_c);
+
+    classes->error = error_code_avx2(a_is_finite, b_is_finite, c_is_finite);
+    classes->is_valid = _mm256_and_pd(a_is_finite, _mm256_and_pd(b_is_finite, c_is_finite));
+
+    classes->a_is_zero = _mm256_cmp_pd(abs_a, epsilon, _CMP_LE_OQ);
+    classes->b_is_zero = _mm256_cmp_pd(abs_b, epsilon, _CMP_LE_OQ);
+
+    const __m256d c_is_zero = _mm256_cmp_pd(abs_c, epsilon, _CMP_LE_OQ);
+    classes->is_infinite = _mm256_and_pd(classes->is_valid, _mm256_and_pd(
+        classes->a_is_zero, _mm256_and_pd(classes->b_is_zero, c_is_zero)));
+
+    classes->discriminant = discriminant_avx2(va, vb, vc);
+
+    classes->discriminant_is_zero =
+        _mm256_cmp_pd(abs_avx2(classes->discriminant), epsilon, _CMP_LE_OQ);
+
+    // Not less than zero, so NaN discriminant gives two roots like the solver
+    classes->has_two_roots = _mm256_andnot_pd(
+        _mm256_or_pd(classes->a_is_zero, classes->discriminant_is_zero),
+        _mm256_cmp_pd(classes->discriminant, zero, _CMP_NLT_UQ));
+
+    const __m256d quadratic_has_root =
+        _mm256_or_pd(classes->discriminant_is_zero, classes->has_two_roots);
+
+    classes->has_root = _mm256_and_pd(classes->is_valid,
+        select_avx2(classes->a_is_zero, _mm256_xor_pd(classes->b_is_zero, all_ones),
+                    quadratic_has_root));
+
+    classes->number_of_roots = _mm256_and_pd(classes->has_root,
+                                             select_avx2(classes->has_two_roots, two, one));
+}
+
+AVX2_TARGET
+static inline void store_root_counts_avx2(const avx2_root_classes* const classes,
+                                          const root_count_columns* const counts,
+                                          const size_t i) {
+
+    const __m256d inf_roots = _mm256_set1_pd((double) INF_ROOTS);
+
+    _mm_storeu_si128((__m128i*) (counts->status + i),
+                     _mm256_cvttpd_epi32(_mm256_and_pd(classes->is_infinite, inf_roots)));
+    _mm_storeu_si128((__m128i*) (counts->number_of_roots + i),
+                     _mm256_cvttpd_epi32(classes->number_of_roots));
+    _mm_storeu_si128((__m128i*) (counts->error_code + i),
+                     _mm256_cvttpd_epi32(classes->error));
+}
+
+AVX2_TARGET
+static size_t count_roots_batch_avx2(const double* const a, const double* const b,
+                                     const double* const c, const size_t count,
+                                     const root_count_columns* const counts) {
+    size_t failed = 0, i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        avx2_root_classes classes;
+        classify_roots_avx2(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i),
+                            _mm256_loadu_pd(c + i), &classes);
+
+        store_root_counts_avx2(&classes, counts, i);
+
+        failed += (size_t) __builtin_popcount(_mm256_movemask_pd(classes.is_valid) ^ 0xf);
+    }
+
+    return failed + count_roots_batch_scalar(a, b, c, i, count, counts);
+}
+
+// Numerator and denominator of a root, so that a single division gives the
+// linear root, the single root or one of the two roots, q / a or c / q
+AVX2_TARGET
+static inline void root_fraction_avx2(const __m256d vb, const __m256d vc,
+                                      const __m256d double_a, const __m256d two_roots_numerator,
+                                      const __m256d two_roots_denominator,
+                                      const avx2_root_classes* const classes,
+                                      __m256d* const numerator, __m256d* const denominator) {
+
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    const __m256d quadratic_numerator = select_avx2(classes->has_two_roots, two_roots_numerator,
+                                                    _mm256_xor_pd(vb, sign_mask));
+    const __m256d quadratic_denominator =
+        select_avx2(classes->has_two_roots, two_roots_denominator, double_a);
+
+    *numerator = select_avx2(classes->a_is_zero, _mm256_xor_pd(vc, sign_mask),
+                             quadratic_numerator);
+    *denominator = select_avx2(classes->a_is_zero,
+                               select_avx2(classes->b_is_zero, one, vb), quadratic_denominator);
+}
+
+AVX2_TARGET
+static size_t find_root_batch_avx2(const double* const a, const double* const b,
+                                   const double* const c, const size_t count,
+                                   const root_choice choice,
+                                   const root_count_columns* const counts, double* const root) {
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d two  = _mm256_set1_pd(2.0);
+    const __m256d all_ones = _mm256_cmp_pd(zero, zero, _CMP_EQ_OQ);
+
+    // Larger root takes +sqrt when a > 0, smaller one when a < 0
+    const bool is_largest = choice == LARGEST_ROOT;
+
+    size_t failed = 0, i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d vc = _mm256_loadu_pd(c + i);
+
+        avx2_root_classes classes;
+        classify_roots_avx2(va, vb, vc, &classes);
+
+        const __m256d sqrt_from_discriminant =
+            _mm256_sqrt_pd(_mm256_and_pd(classes.has_two_roots, classes.discriminant));
+
+        const __m256d b_is_negative = _mm256_cmp_pd(vb, zero, _CMP_LT_OQ);
+        const __m256d q =
+            root_product_term_avx2(abs_avx2(vb), b_is_negative, sqrt_from_discriminant);
+
+        const __m256d a_is_positive = _mm256_cmp_pd(va, zero, _CMP_GT_OQ);
+        const __m256d is_plus = is_largest ? a_is_positive
+                                           : _mm256_xor_pd(a_is_positive, all_ones);
+
+        // Root with +sqrt(d) is q / a when b is negative, c / q otherwise
+        const __m256d is_root_from_c = _mm256_xor_pd(is_plus, b_is_negative);
+
+        __m256d numerator, denominator;
+        root_fraction_avx2(vb, vc, _mm256_mul_pd(two, va),
+                           select_avx2(is_root_from_c, vc, q), select_avx2(is_root_from_c, q, va),
+                           &classes, &numerator, &denominator);
+
+        store_root_counts_avx2(&classes, counts, i);
+        _mm256_storeu_pd(root + i,
+                         _mm256_and_pd(classes.has_root, _mm256_div_pd(numerator, denominator)));
+
+        failed += (size_t) __builtin_popcount(_mm256_movemask_pd(classes.is_valid) ^ 0xf);
+    }
+
+    return failed + find_root_batch_scalar(a, b, c, i, count, choice, counts, root);
+}
+
+AVX2_TARGET
+static inline __m256d is_in_interval_avx2(const __m256d value, const __m256d lo,
+                                          const __m256d hi) {
+    return _mm256_and_pd(_mm256_cmp_pd(lo, value, _CMP_LE_OQ),
+                         _mm256_cmp_pd(value, hi, _CMP_LE_OQ));
+}
+
+AVX2_TARGET
+static size_t has_root_in_batch_avx2(const double* const a, const double* const b,
+                                     const double* const c, const size_t count,
+                                     const double lo, const double hi, bool* const has_root) {
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d two = _mm256_set1_pd(2.0);
+
+    const __m256d vlo = _mm256_set1_pd(lo);
+    const __m256d vhi = _mm256_set1_pd(hi);
+
+    const __m256d interval_is_empty = _mm256_cmp_pd(vlo, vhi, _CMP_NLE_UQ);
+
+    size_t found = 0, i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d vc = _mm256_loadu_pd(c + i);
+
+        avx2_root_classes classes;
+        classify_roots_avx2(va, vb, vc, &classes);
+
+        __m256d answer = _mm256_andnot_pd(interval_is_empty, classes.is_infinite);
+
+        // Roots are only needed if some lane has them
+        if (_mm256_movemask_pd(classes.has_root) != 0) {
+            const __m256d sqrt_from_discriminant =
+                _mm256_sqrt_pd(_mm256_and_pd(classes.has_two_roots, classes.discriminant));
+
+            const __m256d double_a = _mm256_mul_pd(two, va);
+
+            const __m256d b_is_negative = _mm256_cmp_pd(vb, zero, _CMP_LT_OQ);
+            const __m256d q =
+                root_product_term_avx2(abs_avx2(vb), b_is_negative, sqrt_from_discriminant);
+
+            __m256d numerator, denominator;
+            root_fraction_avx2(vb, vc, double_a, select_avx2(b_is_negative, q, vc),
+                               select_avx2(b_is_negative, va, q), &classes,
+                               &numerator, &denominator);
+
+            // Same roots as root[0] and root[1] of the solution
+            const __m256d first_root = _mm256_div_pd(numerator, denominator);
+            const __m256d second_root = _mm256_div_pd(select_avx2(b_is_negative, vc, q),
+                                                      select_avx2(b_is_negative, q, va));
+
+            answer = _mm256_or_pd(answer, _mm256_and_pd(classes.has_root,
+                                  is_in_interval_avx2(first_root, vlo, vhi)));
+            answer = _mm256_or_pd(answer, _mm256_and_pd(classes.has_two_roots,
+                                  is_in_interval_avx2(second_root, vlo, vhi)));
+            answer = _mm256_and_pd(answer, classes.is_valid);
+        }
+
+        const int mask = _mm256_movemask_pd(answer);
+        for (int lane = 0; lane < 4; ++ lane)
+            has_root[i + lane] = (mask >> lane) & 1;
+
+        found += (size_t) __builtin_popcount(mask);
+    }
+
+    return found + has_root_in_batch_scalar(a, b, c, i, count, lo, hi, has_root);
+}
+
+#endif
+
+// =============================== Batches ==============================
+
+size_t count_quadratic_equation_roots_batch(const double* const a, const double* const b,
+                                            const double* const c, const size_t count,
+                                            const root_count_columns* const counts) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (has_avx2_kernels())
+        return count_roots_batch_avx2(a, b, c, count, counts);
+#endif
+
+    return count_roots_batch_scalar(a, b, c, 0, count, counts);
+}
+
+size_t find_quadratic_equation_root_batch(const double* const a, const double* const b,
+                                          const double* const c, const size_t count,
+                                          const root_choice choice,
+                                          const root_count_columns* const counts,
+                                          double* const root) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (has_avx2_kernels())
+        return find_root_batch_avx2(a, b, c, count, choice, counts, root);
+#endif
+
+    return find_root_batch_scalar(a, b, c, 0, count, choice, counts, root);
+}
+
+size_t has_quadratic_equation_root_in_batch(const double* const a, const double* const b,
+                                            const double* const c, const size_t count,
+                                            const double lo, const double hi,
+                                            bool* const has_root) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (has_avx2_kernels())
+        return has_root_in_batch_avx2(a, b, c, count, lo, hi, has_root);
+#endif
+
+    return has_root_in_batch_scalar(a, b, c, 0, count, lo, hi, has_root);
+}
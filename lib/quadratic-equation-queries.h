@@ -0,0 +1,106 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_QUERIES_H
+#define QUADRATIC_EQUATION_SOLVER_QUERIES_H
+
+#include <cstddef>
+
+#include "quadratic-equation-batch.h"
+
+/*
+   Queries that answer part of what #solve_quadratic_equation computes and
+   skip the work the rest would need. Every answer is the one a full solve
+   would give: root counts and statuses are the same, roots are
+   bit-identical to the corresponding root of the solution.
+ */
+
+/**
+   @brief Which root #find_quadratic_equation_root looks for
+ */
+enum root_choice {
+    SMALLEST_ROOT, /**< @brief Smaller of the real roots */
+    LARGEST_ROOT   /**< @brief Larger of the real roots */
+};
+
+/**
+   @brief Output columns of #count_quadratic_equation_roots_batch
+
+   Same as the columns of #equation_solution_columns without the roots.
+ */
+struct root_count_columns {
+    solution_status* status; /**< @brief Status of each solution */
+    int* number_of_roots;    /**< @brief Number of real roots of each equation */
+    int* error_code;         /**< @brief Per-equation error code */
+};
+
+
+/**
+   @brief Status and number of roots of ax^2 + bx + c == 0, without sqrt or division
+
+   @return 0 on success, illegal coefficient's number otherwise.
+ */
+int count_quadratic_equation_roots(const double a, const double b, const double c,
+                                   solution_status* const status, int* const number_of_roots);
+
+/**
+   @brief Only the smallest or the largest real root of ax^2 + bx + c == 0
+
+   Needs one square root and one division at most.
+
+   @param [out] root Chosen root, or zero if @p number_of_roots is zero
+
+   @return 0 on success, illegal coefficient's number otherwise.
+ */
+int find_quadratic_equation_root(const double a, const double b, const double c,
+                                 const root_choice choice, solution_status* const status,
+                                 int* const number_of_roots, double* const root);
+
+/**
+   @brief Whether ax^2 + bx + c == 0 has a root r such that lo <= r <= hi
+
+   Equations with #INF_ROOTS have a root in every non-empty interval.
+   Roots are only computed for equations that have some.
+
+   @return 0 on success, illegal coefficient's number otherwise.
+ */
+int has_quadratic_equation_root_in(const double a, const double b, const double c,
+                                   const double lo, const double hi, bool* const has_root);
+
+
+/**
+   @brief #count_quadratic_equation_roots of every equation of the batch
+
+   @return Number of equations that had an illegal coefficient.
+ */
+size_t count_quadratic_equation_roots_batch(const double* const a, const double* const b,
+                                            const double* const c, const size_t count,
+                                            const root_count_columns* const counts);
+
+/**
+   @brief #find_quadratic_equation_root of every equation of the batch
+
+   @param [out] counts Status, number of roots and error code of each equation
+   @param [out] root   Column of chosen roots, zero for equations without roots
+
+   @return Number of equations that had an illegal coefficient.
+ */
+size_t find_quadratic_equation_root_batch(const double* const a, const double* const b,
+                                          const double* const c, const size_t count,
+                                          const root_choice choice,
+                                          const root_count_columns* const counts,
+                                          double* const root);
+
+/**
+   @brief #has_quadratic_equation_root_in of every equation of the batch
+
+   @param [out] has_root Column of answers, false for illegal equations
+
+   @return Number of equations that have a root in [lo, hi].
+
+   @note Vector kernels skip square roots and divisions of every group of
+   equations where none has a real root.
+ */
+size_t has_quadratic_equation_root_in_batch(const double* const a, const double* const b,
+                                            const double* const c, const size_t count,
+                                            const double lo, const double hi,
+                                            bool* const has_root);
+
+#endif // QUADRATIC_EQUATION_SOLVER_QUERIES_H
@@ -0,0 +1,449 @@
+#include <cstddef>
+#include <cfloat>
+
+#include "quadratic-equation-kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+// Kernels below store statuses as 32-bit integers
+static_assert(sizeof(solution_status) == sizeof(int), "Unexpected enum size");
+
+// Every kernel mirrors solve_quadratic_equation_batch_scalar: all
+// branches of the scalar solver are computed in every lane and the
+// answer is picked with masks. Operation order is kept the same, so
+// the results are bit-identical to the scalar kernel.
+
+// ================================ SSE2 ================================
+
+#define SSE2_TARGET __attribute__((target("sse2")))
+
+SSE2_TARGET static inline __m128d select_sse2(const __m128d mask, const __m128d if_true,
+                                              const __m128d if_false) {
+    return _mm_or_pd(_mm_and_pd(mask, if_true), _mm_andnot_pd(mask, if_false));
+}
+
+SSE2_TARGET
+size_t solve_quadratic_equation_batch_sse2(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions) {
+
+    const __m128d sign_mask  = _mm_set1_pd(-0.0);
+    const __m128d max_finite = _mm_set1_pd(DBL_MAX);
+    const __m128d epsilon    = _mm_set1_pd(EQUATION_SOLVER_EPSILON);
+
+    const __m128d zero  = _mm_setzero_pd();
+    const __m128d half  = _mm_set1_pd(0.5);
+    const __m128d minus_half = _mm_set1_pd(-0.5);
+    const __m128d one   = _mm_set1_pd(1.0);
+    const __m128d two   = _mm_set1_pd(2.0);
+    const __m128d three = _mm_set1_pd(3.0);
+    const __m128d four  = _mm_set1_pd(4.0);
+
+    const __m128d inf_roots = _mm_set1_pd((double) INF_ROOTS);
+
+    size_t failed = 0, i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d va = _mm_loadu_pd(a + i);
+        const __m128d vb = _mm_loadu_pd(b + i);
+        const __m128d vc = _mm_loadu_pd(c + i);
+
+        const __m128d abs_a = _mm_andnot_pd(sign_mask, va);
+        const __m128d abs_b = _mm_andnot_pd(sign_mask, vb);
+        const __m128d abs_c = _mm_andnot_pd(sign_mask, vc);
+
+        const __m128d a_is_finite = _mm_cmple_pd(abs_a, max_finite);
+        const __m128d b_is_finite = _mm_cmple_pd(abs_b, max_finite);
+        const __m128d c_is_finite = _mm_cmple_pd(abs_c, max_finite);
+
+        __m128d error = select_sse2(c_is_finite, zero, three);
+        error = select_sse2(b_is_finite, error, two);
+        error = select_sse2(a_is_finite, error, one);
+
+        const __m128d is_valid = _mm_and_pd(a_is_finite, _mm_and_pd(b_is_finite, c_is_finite));
+
+        const __m128d a_is_zero = _mm_cmple_pd(abs_a, epsilon);
+        const __m128d b_is_zero = _mm_cmple_pd(abs_b, epsilon);
+        const __m128d c_is_zero = _mm_cmple_pd(abs_c, epsilon);
+
+        // Linear equation bx + c == 0
+        const __m128d linear_root =
+            _mm_div_pd(_mm_xor_pd(vc, sign_mask), select_sse2(b_is_zero, one, vb));
+
+        const __m128d linear_roots = _mm_andnot_pd(b_is_zero, one);
+        const __m128d linear_root0 = _mm_andnot_pd(b_is_zero, linear_root);
+
+        // Quadratic equation
+        const __m128d discriminant =
+            _mm_sub_pd(_mm_mul_pd(vb, vb), _mm_mul_pd(_mm_mul_pd(four, va), vc));
+
+        const __m128d discriminant_is_zero =
+            _mm_cmple_pd(_mm_andnot_pd(sign_mask, discriminant), epsilon);
+        const __m128d discriminant_is_negative = _mm_cmplt_pd(discriminant, zero);
+
+        const __m128d sqrt_from_discriminant =
+            _mm_sqrt_pd(select_sse2(discriminant_is_negative, zero, discriminant));
+
+        const __m128d double_a = select_sse2(a_is_zero, one, _mm_mul_pd(two, va));
+        const __m128d minus_b = _mm_xor_pd(vb, sign_mask);
+
+        const __m128d single_root = _mm_div_pd(minus_b, double_a);
+
+        // Same q as root_product_term_avx2
+        const __m128d b_is_negative = _mm_cmplt_pd(vb, zero);
+        const __m128d q = _mm_mul_pd(_mm_add_pd(abs_b, sqrt_from_discriminant),
+                                     select_sse2(b_is_negative, half, minus_half));
+
+        const __m128d root_from_q = _mm_div_pd(q, select_sse2(a_is_zero, one, va));
+        const __m128d root_from_c = _mm_div_pd(vc, q);
+
+        const __m128d root1 = select_sse2(b_is_negative, root_from_q, root_from_c);
+        const __m128d root2 = select_sse2(b_is_negative, root_from_c, root_from_q);
+
+        const __m128d has_two_roots =
+            _mm_andnot_pd(_mm_or_pd(discriminant_is_zero, discriminant_is_negative),
+                          _mm_cmpeq_pd(zero, zero));
+
+        const __m128d quadratic_roots =
+            select_sse2(discriminant_is_zero, one, _mm_and_pd(has_two_roots, two));
+        const __m128d quadratic_root0 =
+            select_sse2(discriminant_is_zero, single_root, _mm_and_pd(has_two_roots, root1));
+        const __m128d quadratic_root1 = _mm_and_pd(has_two_roots, root2);
+
+        // Pick linear or quadratic answer, then zero out illegal lanes
+        const __m128d roots = select_sse2(a_is_zero, linear_roots, quadratic_roots);
+        const __m128d root0 = select_sse2(a_is_zero, linear_root0, quadratic_root0);
+        const __m128d root1_value = _mm_andnot_pd(a_is_zero, quadratic_root1);
+
+        const __m128d is_infinite =
+            _mm_and_pd(is_valid, _mm_and_pd(a_is_zero, _mm_and_pd(b_is_zero, c_is_zero)));
+
+        _mm_storel_epi64((__m128i*) (solutions->status + i),
+                         _mm_cvttpd_epi32(_mm_and_pd(is_infinite, inf_roots)));
+        _mm_storel_epi64((__m128i*) (solutions->number_of_roots + i),
+                         _mm_cvttpd_epi32(_mm_and_pd(is_valid, roots)));
+        _mm_storel_epi64((__m128i*) (solutions->error_code + i), _mm_cvttpd_epi32(error));
+
+        _mm_storeu_pd(solutions->root[0] + i, _mm_and_pd(is_valid, root0));
+        _mm_storeu_pd(solutions->root[1] + i, _mm_and_pd(is_valid, root1_value));
+
+        failed += (size_t) __builtin_popcount(_mm_movemask_pd(is_valid) ^ 0x3);
+    }
+
+    const equation_solution_columns tail = offset_solution_columns(solutions, i);
+    return failed + solve_quadratic_equation_batch_scalar(a + i, b + i, c + i,
+                                                          count - i, &tail);
+}
+
+// ================================ AVX2 ================================
+
+AVX2_TARGET
+size_t solve_quadratic_equation_batch_avx2(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions) {
+
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d epsilon   = _mm256_set1_pd(EQUATION_SOLVER_EPSILON);
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d two  = _mm256_set1_pd(2.0);
+
+    const __m256d inf_roots = _mm256_set1_pd((double) INF_ROOTS);
+
+    size_t failed = 0, i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d vc = _mm256_loadu_pd(c + i);
+
+        const __m256d abs_a = abs_avx2(va);
+        const __m256d abs_b = abs_avx2(vb);
+        const __m256d abs_c = abs_avx2(vc);
+
+        const __m256d a_is_finite = is_finite_avx2(abs_a);
+        const __m256d b_is_finite = is_finite_avx2(abs_b);
+        const __m256d c_is_finite = is_finite_avx2(abs_c);
+
+        const __m256d error = error_code_avx2(a_is_finite, b_is_finite, c_is_finite);
+
+        const __m256d is_valid =
+            _mm256_and_pd(a_is_finite, _mm256_and_pd(b_is_finite, c_is_finite));
+
+        const __m256d a_is_zero = _mm256_cmp_pd(abs_a, epsilon, _CMP_LE_OQ);
+        const __m256d b_is_zero = _mm256_cmp_pd(abs_b, epsilon, _CMP_LE_OQ);
+        const __m256d c_is_zero = _mm256_cmp_pd(abs_c, epsilon, _CMP_LE_OQ);
+
+        // Linear equation bx + c == 0
+        const __m256d linear_root =
+            _mm256_div_pd(_mm256_xor_pd(vc, sign_mask), select_avx2(b_is_zero, one, vb));
+
+        const __m256d linear_roots = _mm256_andnot_pd(b_is_zero, one);
+        const __m256d linear_root0 = _mm256_andnot_pd(b_is_zero, linear_root);
+
+        // Quadratic equation
+        const __m256d discriminant = discriminant_avx2(va, vb, vc);
+
+        const __m256d discriminant_is_zero =
+            _mm256_cmp_pd(abs_avx2(discriminant), epsilon, _CMP_LE_OQ);
+        const __m256d discriminant_is_negative =
+            _mm256_cmp_pd(discriminant, zero, _CMP_LT_OQ);
+
+        const __m256d sqrt_from_discriminant =
+            _mm256_sqrt_pd(select_avx2(discriminant_is_negative, zero, discriminant));
+
+        const __m256d double_a = select_avx2(a_is_zero, one, _mm256_mul_pd(two, va));
+        const __m256d minus_b = _mm256_xor_pd(vb, sign_mask);
+
+        const __m256d single_root = _mm256_div_pd(minus_b, double_a);
+
+        const __m256d b_is_negative = _mm256_cmp_pd(vb, zero, _CMP_LT_OQ);
+        const __m256d q = root_product_term_avx2(abs_b, b_is_negative, sqrt_from_discriminant);
+
+        const __m256d root_from_q = _mm256_div_pd(q, select_avx2(a_is_zero, one, va));
+        const __m256d root_from_c = _mm256_div_pd(vc, q);
+
+        const __m256d root1 = select_avx2(b_is_negative, root_from_q, root_from_c);
+        const __m256d root2 = select_avx2(b_is_negative, root_from_c, root_from_q);
+
+        const __m256d has_two_roots =
+            _mm256_andnot_pd(_mm256_or_pd(discriminant_is_zero, discriminant_is_negative),
+                             _mm256_cmp_pd(zero, zero, _CMP_EQ_OQ));
+
+        const __m256d quadratic_roots =
+            select_avx2(discriminant_is_zero, one, _mm256_and_pd(has_two_roots, two));
+        const __m256d quadratic_root0 =
+            select_avx2(discriminant_is_zero, single_root, _mm256_and_pd(has_two_roots, root1));
+        const __m256d quadratic_root1 = _mm256_and_pd(has_two_roots, root2);
+
+        // Pick linear or quadratic answer, then zero out illegal lanes
+        const __m256d roots = select_avx2(a_is_zero, linear_roots, quadratic_roots);
+        const __m256d root0 = select_avx2(a_is_zero, linear_root0, quadratic_root0);
+        const __m256d root1_value = _mm256_andnot_pd(a_is_zero, quadratic_root1);
+
+        const __m256d is_infinite =
+            _mm256_and_pd(is_valid, _mm256_and_pd(a_is_zero, _mm256_and_pd(b_is_zero, c_is_zero)));
+
+        _mm_storeu_si128((__m128i*) (solutions->status + i),
+                         _mm256_cvttpd_epi32(_mm256_and_pd(is_infinite, inf_roots)));
+        _mm_storeu_si128((__m128i*) (solutions->number_of_roots + i),
+                         _mm256_cvttpd_epi32(_mm256_and_pd(is_valid, roots)));
+        _mm_storeu_si128((__m128i*) (solutions->error_code + i), _mm256_cvttpd_epi32(error));
+
+        _mm256_storeu_pd(solutions->root[0] + i, _mm256_and_pd(is_valid, root0));
+        _mm256_storeu_pd(solutions->root[1] + i, _mm256_and_pd(is_valid, root1_value));
+
+        failed += (size_t) __builtin_popcount(_mm256_movemask_pd(is_valid) ^ 0xf);
+    }
+
+    const equation_solution_columns tail = offset_solution_columns(solutions, i);
+    return failed + solve_quadratic_equation_batch_scalar(a + i, b + i, c + i,
+                                                          count - i, &tail);
+}
+
+// Same as basic_polish_quadratic_equation_roots_batch, four equations at a time
+AVX2_TARGET
+void polish_quadratic_equation_roots_batch_avx2(const double* const a, const double* const b,
+                                                const double* const c, const size_t count,
+                                                const equation_solution_columns* const solutions,
+                                                const int iterations) {
+
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m128i two_roots = _mm_set1_epi32(2);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d vc = _mm256_loadu_pd(c + i);
+
+        const __m256d double_a = _mm256_mul_pd(two, va);
+
+        // Widened to 64-bit lanes, so the mask lines up with the roots
+        const __m256d has_two_roots = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(
+            _mm_loadu_si128((const __m128i*) (solutions->number_of_roots + i)), two_roots)));
+
+        for (int j = 0; j < 2; ++ j) {
+            const __m256d root = _mm256_loadu_pd(solutions->root[j] + i);
+
+            __m256d x = root;
+            __m256d residual =
+                _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(va, x), vb), x), vc);
+
+            for (int k = 0; k < iterations; ++ k) {
+                const __m256d derivative = _mm256_add_pd(_mm256_mul_pd(double_a, x), vb);
+                const __m256d candidate = _mm256_sub_pd(x, _mm256_div_pd(residual, derivative));
+
+                const __m256d candidate_residual = _mm256_add_pd(_mm256_mul_pd(
+                    _mm256_add_pd(_mm256_mul_pd(va, candidate), vb), candidate), vc);
+
+                const __m256d is_better = _mm256_cmp_pd(abs_avx2(candidate_residual),
+                                                        abs_avx2(residual), _CMP_LT_OQ);
+
+                x = select_avx2(is_better, candidate, x);
+                residual = select_avx2(is_better, candidate_residual, residual);
+            }
+
+            _mm256_storeu_pd(solutions->root[j] + i, select_avx2(has_two_roots, x, root));
+        }
+    }
+
+    const equation_solution_columns tail = offset_solution_columns(solutions, i);
+    basic_polish_quadratic_equation_roots_batch<double>(a + i, b + i, c + i, count - i,
+                                                        &tail, iterations);
+}
+
+// =============================== AVX-512 ==============================
+
+#define AVX512_TARGET __attribute__((target("avx512f,avx512dq,avx512vl")))
+
+AVX512_TARGET
+size_t solve_quadratic_equation_batch_avx512(const double* const a, const double* const b,
+                                             const double* const c, const size_t count,
+                                             const equation_solution_columns* const solutions) {
+
+    const __m512d sign_mask  = _mm512_set1_pd(-0.0);
+    const __m512d max_finite = _mm512_set1_pd(DBL_MAX);
+    const __m512d epsilon    = _mm512_set1_pd(EQUATION_SOLVER_EPSILON);
+
+    const __m512d zero  = _mm512_setzero_pd();
+    const __m512d half  = _mm512_set1_pd(0.5);
+    const __m512d minus_half = _mm512_set1_pd(-0.5);
+    const __m512d one   = _mm512_set1_pd(1.0);
+    const __m512d two   = _mm512_set1_pd(2.0);
+    const __m512d four  = _mm512_set1_pd(4.0);
+
+    const __m256i zero_int  = _mm256_setzero_si256();
+    const __m256i one_int   = _mm256_set1_epi32(1);
+    const __m256i two_int   = _mm256_set1_epi32(2);
+    const __m256i three_int = _mm256_set1_epi32(3);
+
+    const __m256i inf_roots = _mm256_set1_epi32(INF_ROOTS);
+
+    size_t failed = 0;
+
+    // Tail is handled with masked loads and stores, no scalar loop needed
+    for (size_t i = 0; i < count; i += 8) {
+        const size_t left = count - i;
+        const __mmask8 lanes = left >= 8 ? (__mmask8) 0xff : (__mmask8) ((1u << left) - 1);
+
+        const __m512d va = _mm512_maskz_loadu_pd(lanes, a + i);
+        const __m512d vb = _mm512_maskz_loadu_pd(lanes, b + i);
+        const __m512d vc = _mm512_maskz_loadu_pd(lanes, c + i);
+
+        const __m512d abs_a = _mm512_abs_pd(va);
+        const __m512d abs_b = _mm512_abs_pd(vb);
+        const __m512d abs_c = _mm512_abs_pd(vc);
+
+        const __mmask8 a_is_finite = _mm512_cmp_pd_mask(abs_a, max_finite, _CMP_LE_OQ);
+        const __mmask8 b_is_finite = _mm512_cmp_pd_mask(abs_b, max_finite, _CMP_LE_OQ);
+        const __mmask8 c_is_finite = _mm512_cmp_pd_mask(abs_c, max_finite, _CMP_LE_OQ);
+
+        __m256i error = _mm256_mask_blend_epi32(c_is_finite, three_int, zero_int);
+        error = _mm256_mask_blend_epi32(b_is_finite, two_int, error);
+        error = _mm256_mask_blend_epi32(a_is_finite, one_int, error);
+
+        const __mmask8 is_valid = a_is_finite & b_is_finite & c_is_finite;
+
+        const __mmask8 a_is_zero = _mm512_cmp_pd_mask(abs_a, epsilon, _CMP_LE_OQ);
+        const __mmask8 b_is_zero = _mm512_cmp_pd_mask(abs_b, epsilon, _CMP_LE_OQ);
+        const __mmask8 c_is_zero = _mm512_cmp_pd_mask(abs_c, epsilon, _CMP_LE_OQ);
+
+        // Linear equation bx + c == 0
+        const __m512d linear_root =
+            _mm512_div_pd(_mm512_xor_pd(vc, sign_mask), _mm512_mask_blend_pd(b_is_zero, vb, one));
+
+        // Quadratic equation
+        const __m512d discriminant =
+            _mm512_sub_pd(_mm512_mul_pd(vb, vb), _mm512_mul_pd(_mm512_mul_pd(four, va), vc));
+
+        const __mmask8 discriminant_is_zero =
+            _mm512_cmp_pd_mask(_mm512_abs_pd(discriminant), epsilon, _CMP_LE_OQ);
+        const __mmask8 discriminant_is_negative =
+            _mm512_cmp_pd_mask(discriminant, zero, _CMP_LT_OQ);
+
+        // Negative lanes take zero as the source, _mm512_sqrt_pd would leave it undefined
+        const __m512d sqrt_from_discriminant =
+            _mm512_mask_sqrt_pd(zero, (__mmask8) ~discriminant_is_negative, discriminant);
+
+        const __m512d double_a = _mm512_mask_blend_pd(a_is_zero, _mm512_mul_pd(two, va), one);
+        const __m512d minus_b = _mm512_xor_pd(vb, sign_mask);
+
+        const __m512d single_root = _mm512_div_pd(minus_b, double_a);
+
+        // Same q as root_product_term_avx2
+        const __mmask8 b_is_negative = _mm512_cmp_pd_mask(vb, zero, _CMP_LT_OQ);
+        const __m512d q = _mm512_mul_pd(_mm512_add_pd(abs_b, sqrt_from_discriminant),
+                                        _mm512_mask_blend_pd(b_is_negative, minus_half, half));
+
+        const __m512d root_from_q = _mm512_div_pd(q, _mm512_mask_blend_pd(a_is_zero, va, one));
+        const __m512d root_from_c = _mm512_div_pd(vc, q);
+
+        const __m512d root1 = _mm512_mask_blend_pd(b_is_negative, root_from_c, root_from_q);
+        const __m512d root2 = _mm512_mask_blend_pd(b_is_negative, root_from_q, root_from_c);
+
+        const __mmask8 has_two_roots =
+            (__mmask8) ~(discriminant_is_zero | discriminant_is_negative);
+
+        // Lanes where each result applies, illegal lanes are masked out
+        const __mmask8 is_linear = is_valid & a_is_zero;
+        const __mmask8 is_quadratic = is_valid & (__mmask8) ~a_is_zero;
+
+        const __mmask8 root0_is_linear = is_linear & (__mmask8) ~b_is_zero;
+        const __mmask8 root0_is_single = is_quadratic & discriminant_is_zero;
+        const __mmask8 root0_is_first = is_quadratic & has_two_roots;
+
+        __m512d root0 = _mm512_maskz_mov_pd(root0_is_linear, linear_root);
+        root0 = _mm512_mask_mov_pd(root0, root0_is_single, single_root);
+        root0 = _mm512_mask_mov_pd(root0, root0_is_first, root1);
+
+        const __m512d root1_value = _mm512_maskz_mov_pd(root0_is_first, root2);
+
+        __m256i roots = _mm256_maskz_mov_epi32(root0_is_linear | root0_is_single, one_int);
+        roots = _mm256_mask_mov_epi32(roots, root0_is_first, two_int);
+
+        const __mmask8 is_infinite = is_linear & b_is_zero & c_is_zero;
+
+        _mm256_mask_storeu_epi32(solutions->status + i, lanes,
+                                 _mm256_maskz_mov_epi32(is_infinite, inf_roots));
+        _mm256_mask_storeu_epi32(solutions->number_of_roots + i, lanes, roots);
+        _mm256_mask_storeu_epi32(solutions->error_code + i, lanes, error);
+
+        _mm512_mask_storeu_pd(solutions->root[0] + i, lanes, root0);
+        _mm512_mask_storeu_pd(solutions->root[1] + i, lanes, root1_value);
+
+        failed += (size_t) __builtin_popcount((unsigned) (lanes & (__mmask8) ~is_valid));
+    }
+
+    return failed;
+}
+
+#else // Not x86, there are no vector kernels yet
+
+size_t solve_quadratic_equation_batch_sse2(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions) {
+    return solve_quadratic_equation_batch_scalar(a, b, c, count, solutions);
+}
+
+size_t solve_quadratic_equation_batch_avx2(const double* const a, const double* const b,
+                                           const double* const c, const size_t count,
+                                           const equation_solution_columns* const solutions) {
+    return solve_quadratic_equation_batch_scalar(a, b, c, count, solutions);
+}
+
+size_t solve_quadratic_equation_batch_avx512(const double* const a, const double* const b,
+                                             const double* const c, const size_t count,
+                                             const equation_solution_columns* const solutions) {
+    return solve_quadratic_equation_batch_scalar(a, b, c, count, solutions);
+}
+
+void polish_quadratic_equation_roots_batch_avx2(const double* const a, const double* const b,
+                                                const double* const c, const size_t count,
+                                                const equation_solution_columns* const solutions,
+                                                const int iterations) {
+    basic_polish_quadratic_equation_roots_batch<double>(a, b, c, count, solutions, iterations);
+}
+
+#endif
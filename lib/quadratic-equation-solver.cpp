@@ -3,83 +3,47 @@
 #include <cmath>
 
 #include "quadratic-equation-solver.h"
-
-// Epsilon for floating-point number comparison
-static inline bool is_zero(const double value) {
-    return fabs(value) <= 1e-9 /* EPSILON */;
-}
+#include "solver-stats.h"
 
 int solve_linear_equation(const double b, const double c,
                           equation_solution* const solution) {
 
-    if (!std::isfinite(b))
-        return 1;
-
-    if (!std::isfinite(c))
-        return 2;
-
+    return basic_solve_linear_equation<double>(b, c, solution);
+}
 
-    if (is_zero(b)) { // 0x == -c
-        // 0x == 0
-        if (is_zero(c)) {
-            *solution = { INF_ROOTS };
-            return 0;
-        }
+#ifdef EQUATION_SOLVER_STATS
+// Inlined next to the probes, branch-free coefficient checks get
+// compiled into branches on coefficient signs, which mispredict a lot
+__attribute__((noinline))
+#endif
+static int solve_quadratic_equation_core(const double a, const double b, const double c,
+                                         equation_solution* const solution) {
 
-        // 0x != 0
-        *solution = { FINITE_ROOTS, /* num roots */ 0 };
-        return 0;
-    }
-
-    // bx == -c
-    *solution = { FINITE_ROOTS, /* num roots */ 1, /* root */ { - c / b } };
-    return 0;
+    return basic_solve_quadratic_equation<double>(a, b, c, solution);
 }
 
 int solve_quadratic_equation(const double a, const double b, const double c,
                              equation_solution* const solution) {
 
-    if (!std::isfinite(a))
-        return 1;
-
-    if (!std::isfinite(b))
-        return 2;
-
-    if (!std::isfinite(c))
-        return 3;
+    SOLVER_STATS_BEGIN_SAMPLE(sample, STATS_SOLVE_LATENCY);
 
+    const int error_code = solve_quadratic_equation_core(a, b, c, solution);
 
-    double discriminant = b * b - 4 * a * c;
-
-    if (is_zero(a)) { // a == 0 => This is a linear equation
-        int return_code = solve_linear_equation(b, c, solution);
-        return return_code == 0 ? 0 : /* one less argument */ return_code + 1;
-    }
-
-    // Check for discriminant == 0
-    if (is_zero(discriminant))
-        *solution = { FINITE_ROOTS, /* num roots */ 1,
-                      /* root */ { - b / (2 * a) } };
+    SOLVER_STATS_END_SAMPLE(sample, STATS_SOLVE_LATENCY);
+    SOLVER_STATS_COUNT_SOLUTION(a, error_code, solution->status, solution->number_of_roots);
 
-    else if (discriminant < 0.0)
-        *solution = { FINITE_ROOTS, /* num roots */ 0 };
-
-    else {
-        // From here discriminant is guaranteed to be bigger than zero
-        double sqrt_from_discriminant = sqrt(discriminant);
-
-        double root1 = (-b + sqrt_from_discriminant) / (2 * a),
-            root2 = (-b - sqrt_from_discriminant) / (2 * a);
+    return error_code;
+}
 
-        *solution = { FINITE_ROOTS, /* num roots */ 2, { root1, root2 } };
-    }
+void polish_quadratic_equation_roots(const double a, const double b, const double c,
+                                     equation_solution* const solution, const int iterations) {
 
-    return 0;
+    basic_polish_quadratic_equation_roots<double>(a, b, c, solution, iterations);
 }
 
-int describe_equation_solution(const equation_solution* const solution,
-                               size_t buffer_size, char* const buffer) {
-    // This value changes:            ^~~~~~~~~~~
+static int print_equation_solution(const equation_solution* const solution,
+                                   size_t buffer_size, char* const buffer) {
+    // This value changes:                ^~~~~~~~~~~
 
     switch (solution->status) {
     case FINITE_ROOTS: {
@@ -138,3 +102,15 @@ int describe_equation_solution(const equation_solution* const solution,
         return CORRUPTED_SOLUTION;
     }
 }
+
+int describe_equation_solution(const equation_solution* const solution,
+                               const size_t buffer_size, char* const buffer) {
+
+    SOLVER_STATS_BEGIN_SAMPLE(sample, STATS_DESCRIBE_LATENCY);
+
+    const int written = print_equation_solution(solution, buffer_size, buffer);
+
+    SOLVER_STATS_END_SAMPLE(sample, STATS_DESCRIBE_LATENCY);
+
+    return written;
+}
@@ -3,34 +3,14 @@
 
 #include <cstddef>
 
-/**
-   @brief Enum of possible statuses of an equation solution
- */
-enum solution_status {
-    FINITE_ROOTS, /**< @brief The equation has a finite number of roots */
-    INF_ROOTS,    /**< @brief The equation has an infinite number of roots */
-};
-
+#include "quadratic-equation-core.h"
 
 /**
-   @brief Struct that represents the solution of some equation
+   @brief Solution of an equation with double-precision roots
 
-   @note Equation of N's power might have up to N roots.
-   For now, this struct only allocates space for two roots which is
-   enough only for linear and quadratic equations. If in the future
-   equations of bigger powers would needed to be represented, this
-   number should be manually adjusted.
+   @see basic_equation_solution
  */
-struct equation_solution {
-    solution_status status; /**< @brief Status of the current solution */
-
-    int number_of_roots;    /**< @brief Number of real roots of the equation
-                                 @note Guaranteed to be >= zero. */
-
-    double root[2];         /**< @brief Real roots of the equation
-                                 @note First #number_of_roots are real roots
-                                 and the rest is zero-initialized. */
-};
+typedef basic_equation_solution<double> equation_solution;
 
 
 /**
@@ -40,15 +20,19 @@ struct equation_solution {
    @param [in]  c        Coefficient c of the equation
    @param [out] solution Pointer to output equation solution
 
-   @return 0 on success, illegal coefficient's number (1 for a, 2 for b) otherwise.
+   @return 0 on success, illegal coefficient's number (1 for b, 2 for c) otherwise.
 
    @note If multiple coefficients have illegal value, number of
    the first one is returned.
 
    @note Coefficients are called @p b and @p c to avoid confusion
    with coefficients of the #solve_quadratic_equation function.
+
+   @note Thin wrapper over #basic_solve_linear_equation, use it directly
+   to get the call inlined or evaluated at compile time.
  */
-equation_solution solve_linear_equation(const double b, const double c);
+int solve_linear_equation(const double b, const double c,
+                          equation_solution* const solution);
 
 
 /**
@@ -64,10 +48,28 @@ equation_solution solve_linear_equation(const double b, const double c);
 
    @note If multiple coefficients have illegal value, number of
    the first one is returned.
+
+   @note Thin wrapper over #basic_solve_quadratic_equation, use it directly
+   to get the call inlined or evaluated at compile time.
  */
 int solve_quadratic_equation(const double a, const double b, const double c,
                              equation_solution* const solution);
 
+/**
+   @brief Refine roots found by #solve_quadratic_equation with Newton's method
+
+   @param [in]     a          Coefficient a of the equation
+   @param [in]     b          Coefficient b of the equation
+   @param [in]     c          Coefficient c of the equation
+   @param [in,out] solution   Solution of the same equation
+   @param [in]     iterations Number of Newton steps, see #EQUATION_SOLVER_POLISH_ITERATIONS
+
+   @note Only solutions with two roots are changed, and a root only moves
+   when that reduces the residual.
+ */
+void polish_quadratic_equation_roots(const double a, const double b, const double c,
+                                     equation_solution* const solution, const int iterations);
+
  
 /**
    @brief Possible error codes of the #describe_equation_soution function
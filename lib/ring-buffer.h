@@ -0,0 +1,286 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_RING_BUFFER_H
+#define QUADRATIC_EQUATION_SOLVER_RING_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <atomic>
+
+/**
+   @file
+   @brief Bounded lock-free rings that connect pipeline stages
+
+   Both rings hold trivially copyable values, usually pointers to blocks of
+   work. try_* functions never wait. Blocking push and pop spin for a short
+   while and then sleep on the ring's index (a futex on Linux), so a full
+   ring stops its producer and an empty ring stops its consumer.
+
+   @note Capacity is rounded up to a power of two.
+ */
+
+/**
+   @brief Number of failed attempts before a blocking call goes to sleep
+ */
+const int RING_SPIN_ATTEMPTS = 64;
+
+inline uint32_t ring_capacity_for(const size_t capacity) {
+    uint32_t rounded = 1;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    return rounded;
+}
+
+/**
+   @brief Ring with exactly one producer thread and one consumer thread
+ */
+template <typename value_t>
+struct spsc_ring {
+    value_t* values;
+    uint32_t mask;
+
+    // Written by the consumer
+    alignas(64) std::atomic<uint32_t> head;
+    uint32_t cached_tail;
+
+    // Written by the producer
+    alignas(64) std::atomic<uint32_t> tail;
+    uint32_t cached_head;
+};
+
+/**
+   @return 0 on success, -1 if the buffer couldn't be allocated.
+ */
+template <typename value_t>
+int init_spsc_ring(spsc_ring<value_t>* const ring, const size_t capacity) {
+    const uint32_t rounded = ring_capacity_for(capacity);
+
+    ring->values = new (std::nothrow) value_t[rounded];
+    ring->mask = rounded - 1;
+
+    ring->head.store(0, std::memory_order_relaxed);
+    ring->tail.store(0, std::memory_order_relaxed);
+    ring->cached_head = ring->cached_tail = 0;
+
+    return ring->values != NULL ? 0 : -1;
+}
+
+template <typename value_t>
+void destroy_spsc_ring(spsc_ring<value_t>* const ring) {
+    delete[] ring->values;
+    ring->values = NULL;
+}
+
+/**
+   @return Whether @p value was pushed, false if the ring is full.
+ */
+template <typename value_t>
+bool try_push_spsc_ring(spsc_ring<value_t>* const ring, const value_t value) {
+    const uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+
+    // Head is only reloaded when the ring looks full
+    if (tail - ring->cached_head > ring->mask) {
+        ring->cached_head = ring->head.load(std::memory_order_acquire);
+
+        if (tail - ring->cached_head > ring->mask)
+            return false;
+    }
+
+    ring->values[tail & ring->mask] = value;
+
+    ring->tail.store(tail + 1, std::memory_order_release);
+    ring->tail.notify_one();
+
+    return true;
+}
+
+/**
+   @return Whether a value was popped into @p value, false if the ring is empty.
+ */
+template <typename value_t>
+bool try_pop_spsc_ring(spsc_ring<value_t>* const ring, value_t* const value) {
+    const uint32_t head = ring->head.load(std::memory_order_relaxed);
+
+    if (head == ring->cached_tail) {
+        ring->cached_tail = ring->tail.load(std::memory_order_acquire);
+
+        if (head == ring->cached_tail)
+            return false;
+    }
+
+    *value = ring->values[head & ring->mask];
+
+    ring->head.store(head + 1, std::memory_order_release);
+    ring->head.notify_one();
+
+    return true;
+}
+
+/**
+   @brief Push @p value, waiting while the ring is full
+ */
+template <typename value_t>
+void push_spsc_ring(spsc_ring<value_t>* const ring, const value_t value) {
+    for (int attempt = 0; !try_push_spsc_ring(ring, value); ++ attempt) {
+        if (attempt < RING_SPIN_ATTEMPTS)
+            continue;
+
+        // Only the consumer moves head, wait for it to move past the seen value
+        ring->head.wait(ring->cached_head, std::memory_order_acquire);
+    }
+}
+
+/**
+   @brief Pop into @p value, waiting while the ring is empty
+ */
+template <typename value_t>
+void pop_spsc_ring(spsc_ring<value_t>* const ring, value_t* const value) {
+    for (int attempt = 0; !try_pop_spsc_ring(ring, value); ++ attempt) {
+        if (attempt < RING_SPIN_ATTEMPTS)
+            continue;
+
+        ring->tail.wait(ring->cached_tail, std::memory_order_acquire);
+    }
+}
+
+/**
+   @brief Ring with any number of producer threads and one consumer thread
+
+   Every slot carries a sequence number, producers claim slots by moving
+   tail with compare-and-swap and publish them through the sequence number.
+ */
+template <typename value_t>
+struct mpsc_ring {
+    struct alignas(64) slot {
+        std::atomic<uint32_t> sequence;
+        value_t value;
+    };
+
+    slot* slots;
+    uint32_t mask;
+
+    alignas(64) std::atomic<uint32_t> tail;
+
+    // Written by the consumer only
+    alignas(64) uint32_t head;
+};
+
+/**
+   @return 0 on success, -1 if the buffer couldn't be allocated.
+ */
+template <typename value_t>
+int init_mpsc_ring(mpsc_ring<value_t>* const ring, const size_t capacity) {
+    const uint32_t rounded = ring_capacity_for(capacity);
+
+    ring->slots = new (std::nothrow) typename mpsc_ring<value_t>::slot[rounded];
+    ring->mask = rounded - 1;
+
+    ring->tail.store(0, std::memory_order_relaxed);
+    ring->head = 0;
+
+    if (ring->slots == NULL)
+        return -1;
+
+    for (uint32_t i = 0; i < rounded; ++ i)
+        ring->slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    return 0;
+}
+
+template <typename value_t>
+void destroy_mpsc_ring(mpsc_ring<value_t>* const ring) {
+    delete[] ring->slots;
+    ring->slots = NULL;
+}
+
+/**
+   @return Whether @p value was pushed, false if the ring is full.
+ */
+template <typename value_t>
+bool try_push_mpsc_ring(mpsc_ring<value_t>* const ring, const value_t value) {
+    uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+
+    while (true) {
+        typename mpsc_ring<value_t>::slot* const slot = ring->slots + (tail & ring->mask);
+        const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+
+        // Slot is still taken by the value pushed a whole lap before
+        if ((int32_t) (sequence - tail) < 0)
+            return false;
+
+        if (sequence == tail &&
+            ring->tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+
+            slot->value = value;
+
+            // Consumer and a producer pushing a lap later may both wait on
+            // this sequence, a single wakeup could reach the producer only
+            slot->sequence.store(tail + 1, std::memory_order_release);
+            slot->sequence.notify_all();
+
+            return true;
+        }
+
+        // Another producer took the slot, try the next one
+        if (sequence != tail)
+            tail = ring->tail.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+   @return Whether a value was popped into @p value, false if the ring is empty.
+ */
+template <typename value_t>
+bool try_pop_mpsc_ring(mpsc_ring<value_t>* const ring, value_t* const value) {
+    typename mpsc_ring<value_t>::slot* const slot = ring->slots + (ring->head & ring->mask);
+
+    if (slot->sequence.load(std::memory_order_acquire) != ring->head + 1)
+        return false;
+
+    *value = slot->value;
+
+    // Free the slot for the producer that comes a lap later
+    slot->sequence.store(ring->head + ring->mask + 1, std::memory_order_release);
+    slot->sequence.notify_all();
+
+    ++ ring->head;
+    return true;
+}
+
+/**
+   @brief Push @p value, waiting while the ring is full
+ */
+template <typename value_t>
+void push_mpsc_ring(mpsc_ring<value_t>* const ring, const value_t value) {
+    for (int attempt = 0; !try_push_mpsc_ring(ring, value); ++ attempt) {
+        if (attempt < RING_SPIN_ATTEMPTS)
+            continue;
+
+        // Wait for the consumer to free the slot at tail
+        const uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+        typename mpsc_ring<value_t>::slot* const slot = ring->slots + (tail & ring->mask);
+
+        const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if ((int32_t) (sequence - tail) < 0)
+            slot->sequence.wait(sequence, std::memory_order_acquire);
+    }
+}
+
+/**
+   @brief Pop into @p value, waiting while the ring is empty
+ */
+template <typename value_t>
+void pop_mpsc_ring(mpsc_ring<value_t>* const ring, value_t* const value) {
+    for (int attempt = 0; !try_pop_mpsc_ring(ring, value); ++ attempt) {
+        if (attempt < RING_SPIN_ATTEMPTS)
+            continue;
+
+        typename mpsc_ring<value_t>::slot* const slot = ring->slots + (ring->head & ring->mask);
+
+        const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence != ring->head + 1)
+            slot->sequence.wait(sequence, std::memory_order_acquire);
+    }
+}
+
+#endif // QUADRATIC_EQUATION_SOLVER_RING_BUFFER_H
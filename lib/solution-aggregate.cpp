@@ -0,0 +1,483 @@
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <string.h>
+#include <new>
+
+#include "solution-aggregate.h"
+#include "quadratic-equation-parallel.h"
+#include "quadratic-equation-kernels.h"
+#include "quadratic-equation-dispatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+int init_solution_aggregate(solution_aggregate* const aggregate, const double first,
+                            const double last, const size_t bins) {
+
+    if (!std::isfinite(first) || !std::isfinite(last) || !(first < last) ||
+        bins == 0 || bins > AGGREGATE_HISTOGRAM_MAX_BINS)
+        return -1;
+
+    *aggregate = {};
+
+    aggregate->min_root = INFINITY;
+    aggregate->max_root = -INFINITY;
+
+    aggregate->histogram_first = first;
+    aggregate->histogram_last = last;
+    aggregate->histogram_bins = bins;
+
+    return 0;
+}
+
+// Neumaier's compensated summation, so billions of roots don't lose the mean
+static void add_to_root_sum(solution_aggregate* const aggregate, const double value) {
+    const double sum = aggregate->root_sum + value;
+
+    aggregate->root_sum_error += std::fabs(aggregate->root_sum) >= std::fabs(value) ?
+        (aggregate->root_sum - sum) + value : (value - sum) + aggregate->root_sum;
+
+    aggregate->root_sum = sum;
+}
+
+// Slots of the root counters of a fold, histogram bins are slots 1 to bins
+enum fold_slot {
+    BELOW_HISTOGRAM_SLOT = 0,
+    ABOVE_HISTOGRAM_SLOT = 1, // + bins
+    NON_FINITE_SLOT      = 2, // + bins
+    NO_ROOT_SLOT         = 3, // + bins, root column past number_of_roots
+
+    NUMBER_OF_FOLD_SLOTS = 4  // + bins
+};
+
+const size_t NUMBER_OF_ROOT_SLOTS = AGGREGATE_HISTOGRAM_MAX_BINS + NUMBER_OF_FOLD_SLOTS;
+const size_t ROOT_SLOT_COPIES = 4;
+
+// What a fold computes for one root column, before it's added to the aggregate
+struct column_fold {
+    double first;          // Histogram of the aggregate
+    double last;
+    size_t bins;
+    double bins_per_unit;
+
+    double min_root;
+    double max_root;
+    double sum;
+};
+
+// Every check below is written so that the vector kernel can do exactly the
+// same operations, and both kernels put every root into the same slot.
+
+// Clamped from above, so the upper edge and roots rounded up to it go to the last bin
+static inline double histogram_position(const column_fold* const fold, const double root) {
+    const double position = (root - fold->first) * fold->bins_per_unit;
+    const double last_position = (double) fold->bins - 0.5;
+
+    return position < last_position ? position : last_position;
+}
+
+static void fold_root_column_scalar(const double* const roots, const int* const number_of_roots,
+                                    const int column, const size_t begin, const size_t count,
+                                    column_fold* const fold, uint8_t* const slots) {
+
+    for (size_t i = begin; i < count; ++ i) {
+        const double root = roots[i];
+
+        const bool is_root = column < number_of_roots[i];
+        const bool is_finite = std::fabs(root) <= DBL_MAX;
+
+        if (!is_root || !is_finite) {
+            slots[i] = (uint8_t) (fold->bins + (is_root ? NON_FINITE_SLOT : NO_ROOT_SLOT));
+            continue;
+        }
+
+        fold->min_root = root < fold->min_root ? root : fold->min_root;
+        fold->max_root = root > fold->max_root ? root : fold->max_root;
+        fold->sum += root;
+
+        slots[i] = root < fold->first ? (uint8_t) BELOW_HISTOGRAM_SLOT :
+                   root > fold->last ? (uint8_t) (fold->bins + ABOVE_HISTOGRAM_SLOT) :
+                   (uint8_t) (1 + (int) histogram_position(fold, root));
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Same as fold_root_column_scalar, four roots at a time. Random roots would
+// mispredict a branch almost every time, the vector kernel has none. Returns
+// number of roots done, the rest is left to the scalar kernel, so that it
+// doesn't run right after AVX instructions with upper halves still dirty
+AVX2_TARGET
+static size_t fold_root_column_avx2(const double* const roots, const int* const number_of_roots,
+                                  const int column, const size_t count,
+                                  column_fold* const fold, uint8_t* const slots) {
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    const __m256d first = _mm256_set1_pd(fold->first);
+    const __m256d last = _mm256_set1_pd(fold->last);
+    const __m256d bins_per_unit = _mm256_set1_pd(fold->bins_per_unit);
+    const __m256d last_position = _mm256_set1_pd((double) fold->bins - 0.5);
+
+    const __m256d column_index = _mm256_set1_pd((double) column);
+
+    const double bins = (double) fold->bins;
+    const __m256d below_slot = _mm256_set1_pd((double) BELOW_HISTOGRAM_SLOT);
+    const __m256d above_slot = _mm256_set1_pd(bins + (double) ABOVE_HISTOGRAM_SLOT);
+    const __m256d non_finite_slot = _mm256_set1_pd(bins + (double) NON_FINITE_SLOT);
+    const __m256d no_root_slot = _mm256_set1_pd(bins + (double) NO_ROOT_SLOT);
+
+    __m256d min_root = _mm256_set1_pd(fold->min_root);
+    __m256d max_root = _mm256_set1_pd(fold->max_root);
+    __m256d sum = zero;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d root = _mm256_loadu_pd(roots + i);
+        const __m256d root_count =
+            _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*) (number_of_roots + i)));
+
+        const __m256d is_root = _mm256_cmp_pd(column_index, root_count, _CMP_LT_OQ);
+        const __m256d is_finite = is_finite_avx2(abs_avx2(root));
+
+        const __m256d is_counted = _mm256_and_pd(is_root, is_finite);
+
+        min_root = _mm256_min_pd(select_avx2(is_counted, root, min_root), min_root);
+        max_root = _mm256_max_pd(select_avx2(is_counted, root, max_root), max_root);
+        sum = _mm256_add_pd(sum, _mm256_and_pd(is_counted, root));
+
+        // Zero below the histogram and for NaN, those lanes get other slots
+        // anyway, but the conversion must stay in range
+        const __m256d position = _mm256_max_pd(
+            _mm256_min_pd(_mm256_mul_pd(_mm256_sub_pd(root, first), bins_per_unit),
+                          last_position), zero);
+
+        __m256d slot = _mm256_add_pd(_mm256_round_pd(position, _MM_FROUND_TRUNC), one);
+        slot = select_avx2(_mm256_cmp_pd(root, first, _CMP_LT_OQ), below_slot, slot);
+        slot = select_avx2(_mm256_cmp_pd(root, last, _CMP_GT_OQ), above_slot, slot);
+        slot = select_avx2(is_finite, slot, non_finite_slot);
+        slot = select_avx2(is_root, slot, no_root_slot);
+
+        // Slots are below 256, so both packs keep them as they are
+        const __m128i slots32 = _mm256_cvttpd_epi32(slot);
+        const __m128i slots8 = _mm_packus_epi16(_mm_packus_epi32(slots32, slots32), slots32);
+
+        const int packed = _mm_cvtsi128_si32(slots8);
+        memcpy(slots + i, &packed, sizeof(packed));
+    }
+
+    double lanes[4];
+
+    _mm256_storeu_pd(lanes, min_root);
+    for (size_t lane = 0; lane < 4; ++ lane)
+        fold->min_root = lanes[lane] < fold->min_root ? lanes[lane] : fold->min_root;
+
+    _mm256_storeu_pd(lanes, max_root);
+    for (size_t lane = 0; lane < 4; ++ lane)
+        fold->max_root = lanes[lane] > fold->max_root ? lanes[lane] : fold->max_root;
+
+    _mm256_storeu_pd(lanes, sum);
+    fold->sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    return i;
+}
+
+#endif
+
+void aggregate_equation_solutions(solution_aggregate* const aggregate,
+                                  const equation_solution_columns* const solutions,
+                                  const size_t count) {
+
+    column_fold fold {
+        aggregate->histogram_first, aggregate->histogram_last, aggregate->histogram_bins,
+        (double) aggregate->histogram_bins /
+            (aggregate->histogram_last - aggregate->histogram_first),
+        aggregate->min_root, aggregate->max_root, 0.0
+    };
+
+    uint64_t illegal[3] = {}, infinite = 0, one_root = 0, two_roots = 0;
+
+    // Neighbouring roots are counted in different copies of the slots, so
+    // increments of the same slot don't wait for each other through memory
+    uint64_t root_slots[ROOT_SLOT_COPIES][NUMBER_OF_ROOT_SLOTS] = {};
+
+    for (size_t begin = 0; begin < count; begin += AGGREGATE_BLOCK_SIZE) {
+        const size_t left = count - begin;
+        const size_t size = left < AGGREGATE_BLOCK_SIZE ? left : AGGREGATE_BLOCK_SIZE;
+
+        const int* const error_code = solutions->error_code + begin;
+        const int* const number_of_roots = solutions->number_of_roots + begin;
+        const solution_status* const status = solutions->status + begin;
+
+        // Summed as 0 or 1 into counters as wide as the columns, so the loop
+        // has no branches and the compiler vectorizes it. Equations with an
+        // error code have #FINITE_ROOTS status and no roots
+        uint32_t block_illegal[3] = {}, block_infinite = 0, block_one_root = 0,
+                 block_two_roots = 0;
+
+        for (size_t i = 0; i < size; ++ i) {
+            block_illegal[0] += error_code[i] == 1;
+            block_illegal[1] += error_code[i] == 2;
+            block_illegal[2] += error_code[i] == 3;
+
+            block_infinite += status[i] == INF_ROOTS;
+            block_one_root += number_of_roots[i] == 1;
+            block_two_roots += number_of_roots[i] == 2;
+        }
+
+        for (size_t i = 0; i < 3; ++ i)
+            illegal[i] += block_illegal[i];
+
+        infinite += block_infinite;
+        one_root += block_one_root;
+        two_roots += block_two_roots;
+
+        for (int column = 0; column < 2; ++ column) {
+            const double* const roots = solutions->root[column] + begin;
+            uint8_t slots[AGGREGATE_BLOCK_SIZE];
+
+            size_t done = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+            if (has_avx2_kernels())
+                done = fold_root_column_avx2(roots, number_of_roots, column, size, &fold, slots);
+#endif
+
+            fold_root_column_scalar(roots, number_of_roots, column, done, size, &fold, slots);
+
+            for (size_t i = 0; i < size; ++ i)
+                ++ root_slots[i % ROOT_SLOT_COPIES][slots[i]];
+        }
+    }
+
+    for (size_t i = 0; i < 3; ++ i)
+        aggregate->illegal[i] += illegal[i];
+
+    aggregate->counts[FINITE_ROOTS][0] +=
+        count - illegal[0] - illegal[1] - illegal[2] - infinite - one_root - two_roots;
+    aggregate->counts[FINITE_ROOTS][1] += one_root;
+    aggregate->counts[FINITE_ROOTS][2] += two_roots;
+    aggregate->counts[INF_ROOTS][0] += infinite;
+
+    const size_t bins = aggregate->histogram_bins;
+
+    for (size_t copy = 0; copy < ROOT_SLOT_COPIES; ++ copy) {
+        const uint64_t* const slots = root_slots[copy];
+
+        aggregate->below_histogram += slots[BELOW_HISTOGRAM_SLOT];
+        aggregate->above_histogram += slots[bins + ABOVE_HISTOGRAM_SLOT];
+        aggregate->non_finite_roots += slots[bins + NON_FINITE_SLOT];
+
+        aggregate->roots += slots[BELOW_HISTOGRAM_SLOT] + slots[bins + ABOVE_HISTOGRAM_SLOT];
+
+        for (size_t bin = 0; bin < bins; ++ bin) {
+            aggregate->histogram[bin] += slots[1 + bin];
+            aggregate->roots += slots[1 + bin];
+        }
+    }
+
+    aggregate->equations += count;
+    aggregate->min_root = fold.min_root;
+    aggregate->max_root = fold.max_root;
+
+    add_to_root_sum(aggregate, fold.sum);
+}
+
+int merge_solution_aggregates(solution_aggregate* const aggregate,
+                              const solution_aggregate* const other) {
+
+    if (aggregate->histogram_first != other->histogram_first ||
+        aggregate->histogram_last != other->histogram_last ||
+        aggregate->histogram_bins != other->histogram_bins)
+        return -1;
+
+    aggregate->equations += other->equations;
+
+    for (size_t i = 0; i < 3; ++ i)
+        aggregate->illegal[i] += other->illegal[i];
+
+    for (size_t status = 0; status < 2; ++ status)
+        for (size_t roots = 0; roots < 3; ++ roots)
+            aggregate->counts[status][roots] += other->counts[status][roots];
+
+    aggregate->roots += other->roots;
+    aggregate->non_finite_roots += other->non_finite_roots;
+
+    if (other->min_root < aggregate->min_root)
+        aggregate->min_root = other->min_root;
+
+    if (other->max_root > aggregate->max_root)
+        aggregate->max_root = other->max_root;
+
+    add_to_root_sum(aggregate, other->root_sum);
+    aggregate->root_sum_error += other->root_sum_error;
+
+    aggregate->below_histogram += other->below_histogram;
+    aggregate->above_histogram += other->above_histogram;
+
+    for (size_t i = 0; i < aggregate->histogram_bins; ++ i)
+        aggregate->histogram[i] += other->histogram[i];
+
+    return 0;
+}
+
+double get_aggregate_mean_root(const solution_aggregate* const aggregate) {
+    if (aggregate->roots == 0)
+        return NAN;
+
+    return (aggregate->root_sum + aggregate->root_sum_error) / (double) aggregate->roots;
+}
+
+size_t aggregate_quadratic_equation_batch(solution_aggregate* const aggregate,
+                                          const double* const a, const double* const b,
+                                          const double* const c, const size_t count) {
+
+    solution_status status[AGGREGATE_BLOCK_SIZE];
+    int number_of_roots[AGGREGATE_BLOCK_SIZE];
+    double first_root[AGGREGATE_BLOCK_SIZE], second_root[AGGREGATE_BLOCK_SIZE];
+    int error_code[AGGREGATE_BLOCK_SIZE];
+
+    const equation_solution_columns block {
+        status, number_of_roots, { first_root, second_root }, error_code
+    };
+
+    size_t failed = 0;
+
+    for (size_t begin = 0; begin < count; begin += AGGREGATE_BLOCK_SIZE) {
+        const size_t left = count - begin;
+        const size_t size = left < AGGREGATE_BLOCK_SIZE ? left : AGGREGATE_BLOCK_SIZE;
+
+        failed += solve_quadratic_equation_batch(a + begin, b + begin, c + begin, size, &block);
+        aggregate_equation_solutions(aggregate, &block, size);
+    }
+
+    return failed;
+}
+
+struct parallel_aggregate_job {
+    const double* a;
+    const double* b;
+    const double* c;
+    size_t count;
+
+    solution_aggregate* worker_aggregates;
+};
+
+static void aggregate_chunk(void* const context, const size_t task_index,
+                            const size_t worker_index) {
+
+    parallel_aggregate_job* const job = (parallel_aggregate_job*) context;
+
+    const size_t begin = task_index * PARALLEL_BATCH_CHUNK_SIZE;
+    const size_t left = job->count - begin;
+    const size_t size = left < PARALLEL_BATCH_CHUNK_SIZE ? left : PARALLEL_BATCH_CHUNK_SIZE;
+
+    // Each worker has its own aggregate, so nothing is shared until the merge
+    aggregate_quadratic_equation_batch(job->worker_aggregates + worker_index,
+                                       job->a + begin, job->b + begin, job->c + begin, size);
+}
+
+size_t aggregate_quadratic_equation_batch_parallel(solver_thread_pool* const pool,
+                                                   solution_aggregate* const aggregate,
+                                                   const double* const a, const double* const b,
+                                                   const double* const c, const size_t count) {
+
+    solver_thread_pool* const used_pool =
+        pool != NULL ? pool : get_default_solver_thread_pool();
+
+    if (count <= PARALLEL_BATCH_CHUNK_SIZE || used_pool == NULL)
+        return aggregate_quadratic_equation_batch(aggregate, a, b, c, count);
+
+    const size_t number_of_workers = solver_thread_pool_size(used_pool);
+
+    solution_aggregate* const worker_aggregates =
+        new (std::nothrow) solution_aggregate[number_of_workers];
+
+    if (worker_aggregates == NULL)
+        return aggregate_quadratic_equation_batch(aggregate, a, b, c, count);
+
+    for (size_t i = 0; i < number_of_workers; ++ i)
+        init_solution_aggregate(worker_aggregates + i, aggregate->histogram_first,
+                                aggregate->histogram_last, aggregate->histogram_bins);
+
+    parallel_aggregate_job job { a, b, c, count, worker_aggregates };
+
+    const size_t number_of_chunks =
+        (count + PARALLEL_BATCH_CHUNK_SIZE - 1) / PARALLEL_BATCH_CHUNK_SIZE;
+
+    run_solver_thread_pool_tasks(used_pool, number_of_chunks, aggregate_chunk, &job);
+
+    size_t failed = 0;
+
+    for (size_t i = 0; i < number_of_workers; ++ i) {
+        const solution_aggregate* const worker = worker_aggregates + i;
+
+        failed += worker->illegal[0] + worker->illegal[1] + worker->illegal[2];
+        merge_solution_aggregates(aggregate, worker);
+    }
+
+    delete[] worker_aggregates;
+    return failed;
+}
+
+void print_solution_aggregate(FILE* const output, const solution_aggregate* const aggregate) {
+    fprintf(output, "equations        %llu\n", (unsigned long long) aggregate->equations);
+
+    for (size_t i = 0; i < 3; ++ i)
+        fprintf(output, "illegal %c        %llu\n", "abc"[i],
+                (unsigned long long) aggregate->illegal[i]);
+
+    fprintf(output,
+            "no roots         %llu\n"
+            "one root         %llu\n"
+            "two roots        %llu\n"
+            "infinite roots   %llu\n",
+            (unsigned long long) aggregate->counts[FINITE_ROOTS][0],
+            (unsigned long long) aggregate->counts[FINITE_ROOTS][1],
+            (unsigned long long) aggregate->counts[FINITE_ROOTS][2],
+            (unsigned long long) aggregate->counts[INF_ROOTS][0]);
+
+    fprintf(output,
+            "finite roots     %llu\n"
+            "non-finite roots %llu\n"
+            "min root         %.17g\n"
+            "max root         %.17g\n"
+            "mean root        %.17g\n",
+            (unsigned long long) aggregate->roots,
+            (unsigned long long) aggregate->non_finite_roots,
+            aggregate->roots != 0 ? aggregate->min_root : NAN,
+            aggregate->roots != 0 ? aggregate->max_root : NAN,
+            get_aggregate_mean_root(aggregate));
+
+    const double width = (aggregate->histogram_last - aggregate->histogram_first) /
+                         (double) aggregate->histogram_bins;
+
+    fprintf(output, "histogram of finite roots:\n");
+
+    // Bin labels are bounded: two %g numbers and a few more characters
+    char label[64];
+
+    snprintf(label, sizeof(label), "< %g", aggregate->histogram_first);
+    fprintf(output, "  %-28s %llu\n", label, (unsigned long long) aggregate->below_histogram);
+
+    for (size_t i = 0; i < aggregate->histogram_bins; ++ i) {
+        if (aggregate->histogram[i] == 0)
+            continue;
+
+        const bool is_last = i + 1 == aggregate->histogram_bins;
+
+        snprintf(label, sizeof(label), "[%g, %g%c",
+                 aggregate->histogram_first + (double) i * width,
+                 is_last ? aggregate->histogram_last :
+                           aggregate->histogram_first + (double) (i + 1) * width,
+                 is_last ? ']' : ')');
+
+        fprintf(output, "  %-28s %llu\n", label, (unsigned long long) aggregate->histogram[i]);
+    }
+
+    snprintf(label, sizeof(label), "> %g", aggregate->histogram_last);
+    fprintf(output, "  %-28s %llu\n", label, (unsigned long long) aggregate->above_histogram);
+}
@@ -0,0 +1,139 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_SOLUTION_AGGREGATE_H
+#define QUADRATIC_EQUATION_SOLVER_SOLUTION_AGGREGATE_H
+
+#include <stdio.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "quadratic-equation-batch.h"
+#include "solver-thread-pool.h"
+
+/**
+   @brief Max number of histogram bins of a #solution_aggregate
+ */
+const size_t AGGREGATE_HISTOGRAM_MAX_BINS = 64;
+
+/**
+   @brief Number of equations solved at a time before they are folded
+
+   Solutions of one block (~7 KiB) stay in L1 cache between the kernel that
+   writes them and the fold that reads them.
+ */
+const size_t AGGREGATE_BLOCK_SIZE = 256;
+
+/**
+   @brief Totals over solutions of any number of equations, in constant memory
+
+   Only finite roots are folded into the extremes, the mean and the
+   histogram. The histogram splits [histogram_first, histogram_last] into
+   #histogram_bins bins of equal width, the last bin includes its upper edge.
+
+   @note Fields are public so that an aggregate can live on the stack, but
+   should only be changed by the functions below.
+ */
+struct alignas(64) solution_aggregate {
+    uint64_t equations;       /**< @brief Number of folded equations */
+    uint64_t illegal[3];      /**< @brief illegal[i] counts equations with error code i + 1 */
+
+    /**
+       @brief counts[status][number of roots] of equations without an error
+     */
+    uint64_t counts[2][3];
+
+    uint64_t roots;            /**< @brief Number of finite roots */
+    uint64_t non_finite_roots; /**< @brief Roots that overflowed to infinity or NaN */
+
+    double min_root;           /**< @brief Smallest finite root, +inf if there are none */
+    double max_root;           /**< @brief Largest finite root, -inf if there are none */
+
+    double root_sum;           /**< @brief Sum of finite roots... */
+    double root_sum_error;     /**< @brief ...plus this, the compensation of the summation */
+
+    double histogram_first;    /**< @brief Lower edge of the first bin */
+    double histogram_last;     /**< @brief Upper edge of the last bin */
+    size_t histogram_bins;     /**< @brief Number of bins in use */
+
+    uint64_t below_histogram;  /**< @brief Finite roots less than #histogram_first */
+    uint64_t above_histogram;  /**< @brief Finite roots greater than #histogram_last */
+    uint64_t histogram[AGGREGATE_HISTOGRAM_MAX_BINS]; /**< @brief Roots per bin */
+};
+
+/**
+   @brief Start an empty aggregate
+
+   @param [out] aggregate Aggregate to initialize
+   @param [in]  first     Lower edge of the histogram
+   @param [in]  last      Upper edge of the histogram
+   @param [in]  bins      Number of histogram bins
+
+   @return 0 on success, -1 if the edges aren't finite, @p first isn't less
+   than @p last, or @p bins is 0 or more than #AGGREGATE_HISTOGRAM_MAX_BINS.
+ */
+int init_solution_aggregate(solution_aggregate* const aggregate, const double first,
+                            const double last, const size_t bins);
+
+/**
+   @brief Fold solutions of @p count equations into @p aggregate
+
+   @param [in,out] aggregate Aggregate to add to
+   @param [in]     solutions Columns filled by a batch solver
+   @param [in]     count     Number of equations in the columns
+
+   @note Roots are folded without branches by the AVX2 kernel when the active
+   kernel tier allows it, see quadratic-equation-dispatch.h. Every kernel
+   gives the same counts and extremes, the mean may differ in the last bits.
+ */
+void aggregate_equation_solutions(solution_aggregate* const aggregate,
+                                  const equation_solution_columns* const solutions,
+                                  const size_t count);
+
+/**
+   @brief Add everything folded into @p other to @p aggregate
+
+   @return 0 on success, -1 if histograms of the two aggregates differ,
+   in which case @p aggregate is left unchanged.
+ */
+int merge_solution_aggregates(solution_aggregate* const aggregate,
+                              const solution_aggregate* const other);
+
+/**
+   @brief Mean of the finite roots, NaN if there are none
+ */
+double get_aggregate_mean_root(const solution_aggregate* const aggregate);
+
+/**
+   @brief Solve @p count equations and fold them into @p aggregate
+
+   Equations are solved by #solve_quadratic_equation_batch in blocks of
+   #AGGREGATE_BLOCK_SIZE on the stack, so memory use doesn't depend on @p count.
+
+   @return Number of equations that had an illegal coefficient.
+ */
+size_t aggregate_quadratic_equation_batch(solution_aggregate* const aggregate,
+                                          const double* const a, const double* const b,
+                                          const double* const c, const size_t count);
+
+/**
+   @brief Same as #aggregate_quadratic_equation_batch, on all threads of @p pool
+
+   Each worker folds its chunks into its own aggregate, they are merged into
+   @p aggregate when all chunks are done.
+
+   @param [in] pool Pool to solve on, NULL means #get_default_solver_thread_pool
+
+   @note Counts, extremes and the histogram are the same as in a single-thread
+   run, the mean may differ in the last bits since roots are summed in a
+   different order. Falls back to the calling thread like
+   #solve_quadratic_equation_batch_parallel.
+ */
+size_t aggregate_quadratic_equation_batch_parallel(solver_thread_pool* const pool,
+                                                   solution_aggregate* const aggregate,
+                                                   const double* const a, const double* const b,
+                                                   const double* const c, const size_t count);
+
+/**
+   @brief Print counts, root statistics and non-empty histogram bins
+ */
+void print_solution_aggregate(FILE* const output, const solution_aggregate* const aggregate);
+
+#endif // QUADRATIC_EQUATION_SOLVER_SOLUTION_AGGREGATE_H
@@ -0,0 +1,432 @@
+#include <cstddef>
+#include <cstdint>
+#include <string.h>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "solution-cache.h"
+#include "quadratic-equation-parallel.h"
+
+// One entry per cache line: a probe reads the key and, on a hit, the
+// solution from the same line
+struct alignas(64) cache_entry {
+    uint64_t key[3];
+    double root[2];
+
+    int8_t status;
+    int8_t number_of_roots;
+
+    bool is_occupied;
+    bool is_referenced;
+};
+
+struct solution_cache {
+    cache_entry* entries;
+    size_t mask;
+
+    // Home slot of a hash is its top bits: hash >> shift
+    unsigned shift;
+
+    // Start of the next eviction sweep within a probe window
+    size_t clock_hand;
+
+    solution_cache_stats stats;
+};
+
+struct alignas(64) cache_shard {
+    std::mutex mutex;
+    solution_cache table;
+};
+
+struct sharded_solution_cache {
+    cache_shard* shards;
+    size_t mask;
+
+    // Shard of a hash is its top shard_bits bits
+    unsigned shard_bits;
+};
+
+// ============================== Hashing ===============================
+
+struct cache_key {
+    uint64_t bits[3];
+};
+
+static inline cache_key make_cache_key(const double a, const double b, const double c) {
+    cache_key key;
+    memcpy(key.bits + 0, &a, sizeof(double));
+    memcpy(key.bits + 1, &b, sizeof(double));
+    memcpy(key.bits + 2, &c, sizeof(double));
+    return key;
+}
+
+// Multiplicative hash: bit i of a product depends on key bits 0..i, so
+// only the top bits of the sum depend on the whole key, including sign
+// and exponent, and it's the top bits that pick the shard and the slot.
+// Three independent multiplications keep the hash off the critical path
+static inline uint64_t hash_cache_key(const cache_key* const key) {
+    return key->bits[0] * 0x9e3779b97f4a7c15u +
+           key->bits[1] * 0xc2b2ae3d27d4eb4fu +
+           key->bits[2] * 0x165667b19e3779f9u;
+}
+
+// One branch for the whole key: many keys share a word (a == 0.0 in
+// linear equations), so word by word comparison mispredicts a lot
+static inline bool is_same_key(const cache_entry* const entry, const cache_key* const key) {
+    return ((entry->key[0] ^ key->bits[0]) | (entry->key[1] ^ key->bits[1]) |
+            (entry->key[2] ^ key->bits[2])) == 0;
+}
+
+// ============================ Single table ============================
+
+static size_t round_up_to_power_of_two(const size_t value) {
+    size_t power = 1;
+    while (power < value)
+        power *= 2;
+
+    return power;
+}
+
+static bool init_cache_table(solution_cache* const table, const size_t capacity) {
+    const size_t size = round_up_to_power_of_two(
+        capacity < SOLUTION_CACHE_PROBE_LENGTH ? SOLUTION_CACHE_PROBE_LENGTH : capacity);
+
+    table->entries = new (std::nothrow) cache_entry[size];
+    if (table->entries == NULL)
+        return false;
+
+    table->mask = size - 1;
+    table->shift = 64;
+    for (size_t i = size; i > 1; i /= 2)
+        -- table->shift;
+
+    clear_solution_cache(table);
+    return true;
+}
+
+// Entries are only ever replaced, never removed one by one, so the first
+// free slot ends the probe sequence of every key
+static bool find_cached_solution(solution_cache* const table, const cache_key* const key,
+                                 const uint64_t hash, equation_solution* const solution) {
+
+    const size_t home = (size_t) (hash >> table->shift);
+
+    for (size_t probe = 0; probe < SOLUTION_CACHE_PROBE_LENGTH; ++ probe) {
+        cache_entry* const entry = table->entries + ((home + probe) & table->mask);
+
+        if (!entry->is_occupied)
+            break;
+
+        if (is_same_key(entry, key)) {
+            entry->is_referenced = true;
+
+            *solution = { (solution_status) entry->status, entry->number_of_roots,
+                          { entry->root[0], entry->root[1] } };
+
+            ++ table->stats.hits;
+            return true;
+        }
+    }
+
+    ++ table->stats.misses;
+    return false;
+}
+
+// Slot for a key that wasn't found: the key itself if another thread has
+// stored it meanwhile, a free slot, or the first unreferenced one the
+// CLOCK sweep reaches
+static cache_entry* choose_cache_slot(solution_cache* const table, const cache_key* const key,
+                                      const uint64_t hash) {
+
+    const size_t home = (size_t) (hash >> table->shift);
+
+    for (size_t probe = 0; probe < SOLUTION_CACHE_PROBE_LENGTH; ++ probe) {
+        cache_entry* const entry = table->entries + ((home + probe) & table->mask);
+
+        if (!entry->is_occupied || is_same_key(entry, key))
+            return entry;
+    }
+
+    // Two rounds at most: the first one clears every reference bit it meets
+    const size_t hand = table->clock_hand ++;
+
+    for (size_t step = 0; ; ++ step) {
+        const size_t probe = (hand + step) % SOLUTION_CACHE_PROBE_LENGTH;
+        cache_entry* const entry = table->entries + ((home + probe) & table->mask);
+
+        if (!entry->is_referenced) {
+            ++ table->stats.evictions;
+            return entry;
+        }
+
+        entry->is_referenced = false;
+    }
+}
+
+static void store_cached_solution(solution_cache* const table, const cache_key* const key,
+                                  const uint64_t hash, const equation_solution* const solution) {
+
+    cache_entry* const entry = choose_cache_slot(table, key, hash);
+
+    entry->key[0] = key->bits[0];
+    entry->key[1] = key->bits[1];
+    entry->key[2] = key->bits[2];
+
+    entry->root[0] = solution->root[0];
+    entry->root[1] = solution->root[1];
+
+    entry->status = (int8_t) solution->status;
+    entry->number_of_roots = (int8_t) solution->number_of_roots;
+
+    entry->is_occupied = true;
+    entry->is_referenced = false;
+}
+
+solution_cache* create_solution_cache(const size_t capacity) {
+    solution_cache* const cache = new (std::nothrow) solution_cache;
+    if (cache == NULL)
+        return NULL;
+
+    if (!init_cache_table(cache, capacity)) {
+        delete cache;
+        return NULL;
+    }
+
+    return cache;
+}
+
+void destroy_solution_cache(solution_cache* const cache) {
+    if (cache == NULL)
+        return;
+
+    delete[] cache->entries;
+    delete cache;
+}
+
+size_t solution_cache_capacity(const solution_cache* const cache) {
+    return cache->mask + 1;
+}
+
+void clear_solution_cache(solution_cache* const cache) {
+    for (size_t i = 0; i <= cache->mask; ++ i)
+        cache->entries[i] = {};
+
+    cache->clock_hand = 0;
+    cache->stats = {};
+}
+
+solution_cache_stats get_solution_cache_stats(const solution_cache* const cache) {
+    return cache->stats;
+}
+
+int solve_quadratic_equation_cached(solution_cache* const cache,
+                                    const double a, const double b, const double c,
+                                    equation_solution* const solution) {
+
+    const cache_key key = make_cache_key(a, b, c);
+    const uint64_t hash = hash_cache_key(&key);
+
+    if (find_cached_solution(cache, &key, hash, solution))
+        return 0;
+
+    const int error = solve_quadratic_equation(a, b, c, solution);
+    if (error == 0)
+        store_cached_solution(cache, &key, hash, solution);
+
+    return error;
+}
+
+// Batch layout of a result, illegal equations get zero roots like in
+// #solve_quadratic_equation_batch
+static void write_solution_column(const equation_solution_columns* const solutions,
+                                  const size_t index, const int error,
+                                  const equation_solution* const solution) {
+    const bool is_valid = error == 0;
+
+    solutions->status[index] = is_valid ? solution->status : FINITE_ROOTS;
+    solutions->number_of_roots[index] = is_valid ? solution->number_of_roots : 0;
+    solutions->root[0][index] = is_valid ? solution->root[0] : 0.0;
+    solutions->root[1][index] = is_valid ? solution->root[1] : 0.0;
+    solutions->error_code[index] = error;
+}
+
+size_t solve_quadratic_equation_batch_cached(solution_cache* const cache,
+                                             const double* const a, const double* const b,
+                                             const double* const c, const size_t count,
+                                             const equation_solution_columns* const solutions) {
+    size_t failed = 0;
+
+    for (size_t i = 0; i < count; ++ i) {
+        equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+        const int error = solve_quadratic_equation_cached(cache, a[i], b[i], c[i], &solution);
+
+        write_solution_column(solutions, i, error, &solution);
+        failed += error != 0;
+    }
+
+    return failed;
+}
+
+// =========================== Sharded table ============================
+
+sharded_solution_cache* create_sharded_solution_cache(const size_t capacity,
+                                                      const size_t number_of_shards) {
+
+    const size_t threads = std::thread::hardware_concurrency();
+    const size_t shards = round_up_to_power_of_two(
+        number_of_shards != 0 ? number_of_shards : 4 * (threads != 0 ? threads : 1));
+
+    sharded_solution_cache* const cache = new (std::nothrow) sharded_solution_cache;
+    cache_shard* const array = new (std::nothrow) cache_shard[shards];
+
+    bool is_created = cache != NULL && array != NULL;
+
+    size_t initialized = 0;
+    for (; is_created && initialized < shards; ++ initialized)
+        is_created = init_cache_table(&array[initialized].table,
+                                      (capacity + shards - 1) / shards);
+
+    if (!is_created) {
+        for (size_t i = 0; i + 1 < initialized; ++ i)
+            delete[] array[i].table.entries;
+
+        delete[] array;
+        delete cache;
+        return NULL;
+    }
+
+    cache->shards = array;
+    cache->mask = shards - 1;
+
+    cache->shard_bits = 0;
+    for (size_t i = shards; i > 1; i /= 2)
+        ++ cache->shard_bits;
+    return cache;
+}
+
+void destroy_sharded_solution_cache(sharded_solution_cache* const cache) {
+    if (cache == NULL)
+        return;
+
+    for (size_t i = 0; i <= cache->mask; ++ i)
+        delete[] cache->shards[i].table.entries;
+
+    delete[] cache->shards;
+    delete cache;
+}
+
+size_t sharded_solution_cache_shards(const sharded_solution_cache* const cache) {
+    return cache->mask + 1;
+}
+
+void clear_sharded_solution_cache(sharded_solution_cache* const cache) {
+    for (size_t i = 0; i <= cache->mask; ++ i) {
+        std::lock_guard<std::mutex> lock(cache->shards[i].mutex);
+        clear_solution_cache(&cache->shards[i].table);
+    }
+}
+
+solution_cache_stats get_sharded_solution_cache_stats(sharded_solution_cache* const cache) {
+    solution_cache_stats total = {};
+
+    for (size_t i = 0; i <= cache->mask; ++ i) {
+        std::lock_guard<std::mutex> lock(cache->shards[i].mutex);
+        const solution_cache_stats& stats = cache->shards[i].table.stats;
+
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+    }
+
+    return total;
+}
+
+int solve_quadratic_equation_sharded_cached(sharded_solution_cache* const cache,
+                                            const double a, const double b, const double c,
+                                            equation_solution* const solution) {
+
+    const cache_key key = make_cache_key(a, b, c);
+    const uint64_t hash = hash_cache_key(&key);
+
+    // Top bits pick the shard, the ones below them the slot within it
+    // (two shifts, so a single shard doesn't need a shift by 64)
+    cache_shard* const shard = cache->shards + ((hash >> 1) >> (63 - cache->shard_bits));
+    const uint64_t shard_hash = hash << cache->shard_bits;
+
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if (find_cached_solution(&shard->table, &key, shard_hash, solution))
+            return 0;
+    }
+
+    const int error = solve_quadratic_equation(a, b, c, solution);
+
+    if (error == 0) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        store_cached_solution(&shard->table, &key, shard_hash, solution);
+    }
+
+    return error;
+}
+
+struct cached_batch_job {
+    sharded_solution_cache* cache;
+
+    const double* a;
+    const double* b;
+    const double* c;
+    size_t count;
+
+    const equation_solution_columns* solutions;
+
+    std::atomic<size_t> failed;
+};
+
+static void solve_cached_chunk(void* const context, const size_t task_index, const size_t) {
+    cached_batch_job* const job = (cached_batch_job*) context;
+
+    const size_t begin = task_index * PARALLEL_BATCH_CHUNK_SIZE;
+    const size_t left = job->count - begin;
+    const size_t end = begin + (left < PARALLEL_BATCH_CHUNK_SIZE ? left
+                                                                 : PARALLEL_BATCH_CHUNK_SIZE);
+    size_t failed = 0;
+
+    for (size_t i = begin; i < end; ++ i) {
+        equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+        const int error = solve_quadratic_equation_sharded_cached(
+            job->cache, job->a[i], job->b[i], job->c[i], &solution);
+
+        write_solution_column(job->solutions, i, error, &solution);
+        failed += error != 0;
+    }
+
+    if (failed != 0)
+        job->failed.fetch_add(failed, std::memory_order_relaxed);
+}
+
+size_t solve_quadratic_equation_batch_parallel_cached(solver_thread_pool* const pool,
+                                                      sharded_solution_cache* const cache,
+                                                      const double* const a,
+                                                      const double* const b,
+                                                      const double* const c,
+                                                      const size_t count,
+                                                      const equation_solution_columns* const solutions) {
+
+    solver_thread_pool* const used_pool =
+        pool != NULL ? pool : get_default_solver_thread_pool();
+
+    cached_batch_job job { cache, a, b, c, count, solutions, { 0 } };
+
+    const size_t number_of_chunks =
+        (count + PARALLEL_BATCH_CHUNK_SIZE - 1) / PARALLEL_BATCH_CHUNK_SIZE;
+
+    if (number_of_chunks <= 1 || used_pool == NULL) {
+        for (size_t i = 0; i < number_of_chunks; ++ i)
+            solve_cached_chunk(&job, i, 0);
+    } else
+        run_solver_thread_pool_tasks(used_pool, number_of_chunks, solve_cached_chunk, &job);
+
+    return job.failed.load(std::memory_order_relaxed);
+}
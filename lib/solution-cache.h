@@ -0,0 +1,172 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_SOLUTION_CACHE_H
+#define QUADRATIC_EQUATION_SOLVER_SOLUTION_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "quadratic-equation-batch.h"
+#include "solver-thread-pool.h"
+
+/**
+   @brief Bounded memo of solved equations, keyed on bit patterns of a, b and c
+
+   Open-addressing hash table with one entry per cache line. A key is
+   looked for in at most #SOLUTION_CACHE_PROBE_LENGTH consecutive slots
+   from its home slot, so a lookup touches a few adjacent lines at most.
+   When all of them are taken, CLOCK (second chance) picks the victim:
+   every hit marks an entry as referenced, and eviction skips and clears
+   referenced entries until it finds one that wasn't used since the last
+   sweep.
+
+   Coefficients are compared bit by bit, so 0.0 and -0.0 are different
+   keys. Equations with an illegal coefficient are never cached.
+
+   @note Not thread-safe, see #sharded_solution_cache for that.
+ */
+struct solution_cache;
+
+/**
+   @brief Thread-safe cache split into independently locked shards
+
+   Each shard is a #solution_cache of its own behind a mutex, the shard of
+   a key is picked by its hash, so threads solving different equations
+   rarely wait for each other.
+ */
+struct sharded_solution_cache;
+
+/**
+   @brief Max number of slots a key is looked for in
+ */
+const size_t SOLUTION_CACHE_PROBE_LENGTH = 8;
+
+/**
+   @brief Counters of a cache since creation or the last clear
+ */
+struct solution_cache_stats {
+    uint64_t hits;      /**< @brief Solutions returned from the cache */
+    uint64_t misses;    /**< @brief Solutions that had to be computed */
+    uint64_t evictions; /**< @brief Entries replaced by newer ones */
+};
+
+
+/**
+   @brief Create cache of at least @p capacity entries
+
+   @param [in] capacity Number of entries, rounded up to a power of two
+                        and to at least #SOLUTION_CACHE_PROBE_LENGTH
+
+   @return New cache, or NULL if it couldn't be allocated.
+ */
+solution_cache* create_solution_cache(const size_t capacity);
+
+/**
+   @brief Free the cache
+
+   @note Passing NULL is allowed and does nothing.
+ */
+void destroy_solution_cache(solution_cache* const cache);
+
+/**
+   @brief Number of entries the cache holds at most
+ */
+size_t solution_cache_capacity(const solution_cache* const cache);
+
+/**
+   @brief Drop all entries and zero the statistics
+ */
+void clear_solution_cache(solution_cache* const cache);
+
+/**
+   @brief Statistics of the cache
+ */
+solution_cache_stats get_solution_cache_stats(const solution_cache* const cache);
+
+/**
+   @brief Same as #solve_quadratic_equation, but returns a remembered solution when there is one
+
+   @return 0 on success, illegal coefficient's number otherwise.
+ */
+int solve_quadratic_equation_cached(solution_cache* const cache,
+                                    const double a, const double b, const double c,
+                                    equation_solution* const solution);
+
+/**
+   @brief Same as #solve_quadratic_equation_batch, but every equation goes through @p cache
+
+   @return Number of equations that had an illegal coefficient.
+
+   @note Equations are looked up one by one, so this pays off only when
+   most of them are hits. Otherwise the vector kernels are faster.
+ */
+size_t solve_quadratic_equation_batch_cached(solution_cache* const cache,
+                                             const double* const a, const double* const b,
+                                             const double* const c, const size_t count,
+                                             const equation_solution_columns* const solutions);
+
+
+/**
+   @brief Create sharded cache of at least @p capacity entries in total
+
+   @param [in] capacity         Number of entries, split evenly between shards
+   @param [in] number_of_shards Number of shards, rounded up to a power of two.
+                                0 means four per hardware thread.
+
+   @return New cache, or NULL if it couldn't be allocated.
+ */
+sharded_solution_cache* create_sharded_solution_cache(const size_t capacity,
+                                                      const size_t number_of_shards);
+
+/**
+   @brief Free the cache
+
+   @note Passing NULL is allowed and does nothing.
+ */
+void destroy_sharded_solution_cache(sharded_solution_cache* const cache);
+
+/**
+   @brief Number of shards of the cache
+ */
+size_t sharded_solution_cache_shards(const sharded_solution_cache* const cache);
+
+/**
+   @brief Drop all entries and zero the statistics of all shards
+ */
+void clear_sharded_solution_cache(sharded_solution_cache* const cache);
+
+/**
+   @brief Statistics summed over all shards
+ */
+solution_cache_stats get_sharded_solution_cache_stats(sharded_solution_cache* const cache);
+
+/**
+   @brief Thread-safe #solve_quadratic_equation_cached
+
+   @note Shard isn't locked while the equation is solved, so two threads
+   that miss the same key at once both solve it, and it's stored once.
+ */
+int solve_quadratic_equation_sharded_cached(sharded_solution_cache* const cache,
+                                            const double a, const double b, const double c,
+                                            equation_solution* const solution);
+
+/**
+   @brief Same as #solve_quadratic_equation_batch_parallel, but every equation goes through @p cache
+
+   @param [in]  pool      Pool to solve on, NULL means #get_default_solver_thread_pool
+   @param [in]  cache     Cache shared by all workers
+   @param [in]  a         Column of coefficients a
+   @param [in]  b         Column of coefficients b
+   @param [in]  c         Column of coefficients c
+   @param [in]  count     Number of equations in the batch
+   @param [out] solutions Output columns, each with room for @p count elements
+
+   @return Number of equations that had an illegal coefficient.
+ */
+size_t solve_quadratic_equation_batch_parallel_cached(solver_thread_pool* const pool,
+                                                      sharded_solution_cache* const cache,
+                                                      const double* const a,
+                                                      const double* const b,
+                                                      const double* const c,
+                                                      const size_t count,
+                                                      const equation_solution_columns* const solutions);
+
+#endif // QUADRATIC_EQUATION_SOLVER_SOLUTION_CACHE_H
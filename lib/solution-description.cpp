@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <string.h>
+#include <charconv>
+
+#include "solution-description.h"
+#include "solver-stats.h"
+
+// Copy string literal without its null-terminator
+#define APPEND_LITERAL(position, literal)                   \
+    do {                                                    \
+        memcpy((position), (literal), sizeof(literal) - 1); \
+        (position) += sizeof(literal) - 1;                  \
+    } while(false)
+
+// Longest shortest-round-trip double, e.g. "-2.2250738585072014e-308"
+static const size_t MAX_ROOT_LENGTH = 24;
+
+// Write description with null-terminator, return its length or error
+static int write_description(const solution_status status, const int number_of_roots,
+                             const double first_root, const double second_root,
+                             const int error_code, char* const buffer) {
+    char* current = buffer;
+
+    if (error_code != 0) {
+        APPEND_LITERAL(current, "Illegal value for argument ");
+        current = std::to_chars(current, current + 11, error_code).ptr;
+
+        *current = '\0';
+        return (int) (current - buffer);
+    }
+
+    switch (status) {
+    case FINITE_ROOTS: {
+        if (number_of_roots < 0 || number_of_roots > 2)
+            return CORRUPTED_SOLUTION;
+
+        if (number_of_roots == 0) {
+            APPEND_LITERAL(current, "Equation has no solution");
+            break;
+        }
+
+        APPEND_LITERAL(current, "Equation has ");
+        *current ++ = (char) ('0' + number_of_roots);
+        APPEND_LITERAL(current, " roots: ");
+
+        current = std::to_chars(current, current + MAX_ROOT_LENGTH, first_root).ptr;
+
+        if (number_of_roots == 2) {
+            APPEND_LITERAL(current, ", ");
+            current = std::to_chars(current, current + MAX_ROOT_LENGTH, second_root).ptr;
+        }
+
+        break;
+    }
+
+    case INF_ROOTS:
+        APPEND_LITERAL(current, "This equation has infinite number of roots");
+        break;
+
+    default:
+        return CORRUPTED_SOLUTION;
+    }
+
+    *current = '\0';
+    return (int) (current - buffer);
+}
+
+int describe_equation_solution_fast(const equation_solution* const solution,
+                                    char* const buffer) {
+
+    SOLVER_STATS_BEGIN_SAMPLE(sample, STATS_DESCRIBE_LATENCY);
+
+    const int written = write_description(solution->status, solution->number_of_roots,
+                                          solution->root[0], solution->root[1], 0, buffer);
+
+    SOLVER_STATS_END_SAMPLE(sample, STATS_DESCRIBE_LATENCY);
+
+    return written;
+}
+
+size_t description_arena_size(const size_t count) {
+    return count * (EQUATION_DESCRIPTION_MAX_LENGTH + 1);
+}
+
+long describe_equation_solutions_batch(const equation_solution_columns* const solutions,
+                                       const size_t count, char* const arena,
+                                       size_t* const offsets) {
+    size_t used = 0;
+
+    for (size_t i = 0; i < count; ++ i) {
+        offsets[i] = used;
+
+        const int written = write_description(solutions->status[i],
+                                              solutions->number_of_roots[i],
+                                              solutions->root[0][i], solutions->root[1][i],
+                                              solutions->error_code[i], arena + used);
+        if (written < 0)
+            return written;
+
+        used += (size_t) written + 1; // Keep null-terminator
+    }
+
+    offsets[count] = used;
+    return (long) used;
+}
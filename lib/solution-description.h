@@ -0,0 +1,59 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_DESCRIPTION_H
+#define QUADRATIC_EQUATION_SOLVER_DESCRIPTION_H
+
+#include <cstddef>
+
+#include "quadratic-equation-solver.h"
+#include "quadratic-equation-batch.h"
+
+/**
+   @brief Upper bound on length of one description (excluding null-terminator)
+
+   Longest description is "Equation has 2 roots: " followed by two roots of
+   at most 24 characters each, separated by ", ".
+ */
+const size_t EQUATION_DESCRIPTION_MAX_LENGTH = 22 + 24 + 2 + 24;
+
+/**
+   @brief Describe the solution of an equation in a single pass
+
+   Same sentences as #describe_equation_solution, but roots are written in
+   the shortest form that reads back to the same double ("0.5" instead of
+   "0.500000"), and the buffer size is known in advance, so there's no need
+   to measure the description first.
+
+   @param [in]  solution Solution to describe
+   @param [out] buffer   Buffer of at least #EQUATION_DESCRIPTION_MAX_LENGTH + 1 bytes
+
+   @return Number of characters written (excluding null-terminator) on success,
+   #CORRUPTED_SOLUTION if status or number of roots is out of range.
+ */
+int describe_equation_solution_fast(const equation_solution* const solution,
+                                    char* const buffer);
+
+/**
+   @brief Size of arena #describe_equation_solutions_batch needs for @p count solutions
+ */
+size_t description_arena_size(const size_t count);
+
+/**
+   @brief Describe many solutions into one contiguous arena
+
+   Description i starts at arena + offsets[i] and is null-terminated, its length
+   is offsets[i + 1] - offsets[i] - 1. Equations with non-zero error code are
+   described as "Illegal value for argument <code>".
+
+   @param [in]  solutions Columns of solutions, like #solve_quadratic_equation_batch
+                          writes them
+   @param [in]  count     Number of solutions
+   @param [out] arena     Buffer of at least #description_arena_size bytes
+   @param [out] offsets   Array of @p count + 1 offsets
+
+   @return Number of bytes used in the arena on success, #CORRUPTED_SOLUTION if
+   some solution is corrupted (descriptions before it are still written).
+ */
+long describe_equation_solutions_batch(const equation_solution_columns* const solutions,
+                                       const size_t count, char* const arena,
+                                       size_t* const offsets);
+
+#endif // QUADRATIC_EQUATION_SOLVER_DESCRIPTION_H
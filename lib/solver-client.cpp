@@ -0,0 +1,219 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "solver-client.h"
+
+struct client_buffer {
+    char* data;
+    size_t capacity;
+};
+
+struct solver_client {
+    int fd;
+
+    // Request being sent and response being received, separate so that
+    // sending and receiving may run on two threads
+    client_buffer send_buffer;
+    client_buffer receive_buffer;
+};
+
+static solver_client* create_client(const int fd) {
+    if (fd < 0)
+        return NULL;
+
+    solver_client* const client = (solver_client*) calloc(1, sizeof(solver_client));
+    if (client == NULL) {
+        close(fd);
+        return NULL;
+    }
+
+    client->fd = fd;
+    return client;
+}
+
+solver_client* connect_solver_client(const char* const socket_path) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+        return NULL;
+
+    strcpy(address.sun_path, socket_path);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, (const sockaddr*) &address, sizeof(address)) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    return create_client(fd);
+}
+
+solver_client* connect_solver_client_tcp(const uint16_t port) {
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, (const sockaddr*) &address, sizeof(address)) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // Requests are small and latency matters more than packet count
+    const int enabled = 1;
+    if (fd >= 0)
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+
+    return create_client(fd);
+}
+
+void disconnect_solver_client(solver_client* const client) {
+    if (client == NULL)
+        return;
+
+    close(client->fd);
+    free(client->send_buffer.data);
+    free(client->receive_buffer.data);
+    free(client);
+}
+
+static bool reserve_client_buffer(client_buffer* const buffer, const size_t size) {
+    if (size <= buffer->capacity)
+        return true;
+
+    char* const data = (char*) realloc(buffer->data, size);
+    if (data == NULL)
+        return false;
+
+    buffer->data = data;
+    buffer->capacity = size;
+    return true;
+}
+
+static int send_all(const int fd, const char* data, size_t size) {
+    while (size != 0) {
+        const ssize_t written = send(fd, data, size, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        data += written;
+        size -= (size_t) written;
+    }
+
+    return 0;
+}
+
+static int receive_all(const int fd, char* data, size_t size) {
+    while (size != 0) {
+        const ssize_t received = recv(fd, data, size, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+
+        if (received <= 0)
+            return -1;
+
+        data += received;
+        size -= (size_t) received;
+    }
+
+    return 0;
+}
+
+int send_solver_request(solver_client* const client, const uint64_t id,
+                        const double* const a, const double* const b, const double* const c,
+                        const size_t count) {
+
+    if (count > SOLVER_PROTOCOL_MAX_EQUATIONS)
+        return -1;
+
+    client_buffer* const buffer = &client->send_buffer;
+
+    const size_t size = solver_request_size(count);
+    if (!reserve_client_buffer(buffer, size))
+        return -1;
+
+    const solver_request_header header = { SOLVER_REQUEST_MAGIC, (uint32_t) count, id };
+    memcpy(buffer->data, &header, sizeof(header));
+
+    double* const triples = (double*) (buffer->data + sizeof(header));
+    for (size_t i = 0; i < count; ++ i) {
+        triples[3 * i + 0] = a[i];
+        triples[3 * i + 1] = b[i];
+        triples[3 * i + 2] = c[i];
+    }
+
+    return send_all(client->fd, buffer->data, size);
+}
+
+int receive_solver_response(solver_client* const client, uint64_t* const id,
+                            const equation_solution_columns* const solutions,
+                            const size_t capacity, size_t* const count) {
+
+    solver_response_header header;
+    if (receive_all(client->fd, (char*) &header, sizeof(header)) != 0)
+        return -1;
+
+    if (header.magic != SOLVER_RESPONSE_MAGIC || header.count > capacity)
+        return -1;
+
+    client_buffer* const buffer = &client->receive_buffer;
+
+    const size_t size = header.count * sizeof(solver_response_record);
+    if (!reserve_client_buffer(buffer, size) || receive_all(client->fd, buffer->data, size) != 0)
+        return -1;
+
+    const solver_response_record* const records = (const solver_response_record*) buffer->data;
+    for (size_t i = 0; i < header.count; ++ i) {
+        solutions->status[i] = (solution_status) records[i].status;
+        solutions->number_of_roots[i] = records[i].number_of_roots;
+        solutions->root[0][i] = records[i].root[0];
+        solutions->root[1][i] = records[i].root[1];
+        solutions->error_code[i] = records[i].error_code;
+    }
+
+    *id = header.id;
+    *count = header.count;
+    return 0;
+}
+
+int solve_quadratic_equation_remote(solver_client* const client,
+                                    const double* const a, const double* const b,
+                                    const double* const c, const size_t count,
+                                    const equation_solution_columns* const solutions) {
+
+    for (size_t first = 0; first < count; first += SOLVER_PROTOCOL_MAX_EQUATIONS) {
+        const size_t left = count - first;
+        const size_t chunk = left < SOLVER_PROTOCOL_MAX_EQUATIONS ? left
+                                                                  : SOLVER_PROTOCOL_MAX_EQUATIONS;
+
+        const equation_solution_columns chunk_solutions {
+            solutions->status + first, solutions->number_of_roots + first,
+            { solutions->root[0] + first, solutions->root[1] + first },
+            solutions->error_code + first
+        };
+
+        uint64_t id = 0;
+        size_t received = 0;
+
+        if (send_solver_request(client, first, a + first, b + first, c + first, chunk) != 0 ||
+            receive_solver_response(client, &id, &chunk_solutions, chunk, &received) != 0 ||
+            id != first || received != chunk)
+            return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_CLIENT_H
+#define QUADRATIC_EQUATION_SOLVER_CLIENT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "solver-protocol.h"
+#include "quadratic-equation-batch.h"
+
+/**
+   @brief Blocking connection to a solver daemon, see solver-server.h
+
+   @note A client must only be used by one thread at a time, except that
+   one thread may send requests while another receives responses.
+ */
+struct solver_client;
+
+/**
+   @brief Connect to a server listening on Unix domain socket @p socket_path
+
+   @return New client, or NULL if connection failed.
+ */
+solver_client* connect_solver_client(const char* const socket_path);
+
+/**
+   @brief Connect to a server listening on @p port of 127.0.0.1
+
+   @return New client, or NULL if connection failed.
+ */
+solver_client* connect_solver_client_tcp(const uint16_t port);
+
+/**
+   @brief Close connection and free the client
+
+   @note Passing NULL is allowed and does nothing.
+ */
+void disconnect_solver_client(solver_client* const client);
+
+/**
+   @brief Send one request without waiting for its response
+
+   Several requests can be sent before receiving responses, they are
+   answered in order. Server stops reading from a client that has
+   megabytes of unreceived responses, so a client that keeps sending
+   without receiving eventually blocks forever. Keep many large requests
+   in flight by receiving on another thread.
+
+   @param [in] client Connected client
+   @param [in] id     Any value, response will carry it
+   @param [in] a      Column of coefficients a
+   @param [in] b      Column of coefficients b
+   @param [in] c      Column of coefficients c
+   @param [in] count  Number of equations, at most #SOLVER_PROTOCOL_MAX_EQUATIONS
+
+   @return 0 on success, -1 if the request is too large or couldn't be sent.
+ */
+int send_solver_request(solver_client* const client, const uint64_t id,
+                        const double* const a, const double* const b, const double* const c,
+                        const size_t count);
+
+/**
+   @brief Wait for the next response
+
+   @param [in]  client    Connected client
+   @param [out] id        Id of the answered request
+   @param [out] solutions Output columns, each with room for @p capacity elements
+   @param [in]  capacity  Max number of equations the response may have
+   @param [out] count     Number of equations in the response
+
+   @return 0 on success, -1 if the connection failed, the response was
+   malformed or longer than @p capacity.
+ */
+int receive_solver_response(solver_client* const client, uint64_t* const id,
+                            const equation_solution_columns* const solutions,
+                            const size_t capacity, size_t* const count);
+
+/**
+   @brief Solve batch of any size on the server, same results as #solve_quadratic_equation_batch
+
+   @return 0 on success, -1 if the connection failed.
+ */
+int solve_quadratic_equation_remote(solver_client* const client,
+                                    const double* const a, const double* const b,
+                                    const double* const c, const size_t count,
+                                    const equation_solution_columns* const solutions);
+
+#endif // QUADRATIC_EQUATION_SOLVER_CLIENT_H
@@ -0,0 +1,74 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_PROTOCOL_H
+#define QUADRATIC_EQUATION_SOLVER_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+   Messages of the solver daemon, see solver-server.h and solver-client.h.
+   Server and clients run on the same host, so everything is in machine
+   byte order, like in binary equation files.
+
+     Request:  solver_request_header,  double triples[count][3] (a, b, c)
+     Response: solver_response_header, solver_response_record[count]
+
+   Responses have the same id as their requests. Requests sent over one
+   connection are answered in the order they were sent.
+ */
+
+const uint32_t SOLVER_REQUEST_MAGIC  = 0x52514551; // "QEQR"
+const uint32_t SOLVER_RESPONSE_MAGIC = 0x53514551; // "QEQS"
+
+/**
+   @brief Max number of equations in one request, larger requests close the connection
+ */
+const uint32_t SOLVER_PROTOCOL_MAX_EQUATIONS = 1 << 16;
+
+/**
+   @brief Header of a request, followed by @p count triples of coefficients
+ */
+struct solver_request_header {
+    uint32_t magic; /**< @brief #SOLVER_REQUEST_MAGIC */
+    uint32_t count; /**< @brief Number of equations, at most #SOLVER_PROTOCOL_MAX_EQUATIONS */
+    uint64_t id;    /**< @brief Any value, copied into the response */
+};
+
+/**
+   @brief Header of a response, followed by @p count records
+ */
+struct solver_response_header {
+    uint32_t magic; /**< @brief #SOLVER_RESPONSE_MAGIC */
+    uint32_t count; /**< @brief Same as in the request */
+    uint64_t id;    /**< @brief Same as in the request */
+};
+
+/**
+   @brief Solution of one equation, fields mean the same as in #equation_solution_columns
+ */
+struct solver_response_record {
+    double root[2];
+    int32_t status;
+    int32_t number_of_roots;
+    int32_t error_code;
+    int32_t reserved; /**< @brief Zero */
+};
+
+static_assert(sizeof(solver_request_header) == 16, "Header must have no padding");
+static_assert(sizeof(solver_response_header) == 16, "Header must have no padding");
+static_assert(sizeof(solver_response_record) == 32, "Record must have no padding");
+
+/**
+   @brief Size of a request with @p count equations, in bytes
+ */
+inline size_t solver_request_size(const size_t count) {
+    return sizeof(solver_request_header) + count * 3 * sizeof(double);
+}
+
+/**
+   @brief Size of a response with @p count equations, in bytes
+ */
+inline size_t solver_response_size(const size_t count) {
+    return sizeof(solver_response_header) + count * sizeof(solver_response_record);
+}
+
+#endif // QUADRATIC_EQUATION_SOLVER_PROTOCOL_H
@@ -0,0 +1,603 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "solver-server.h"
+#include "quadratic-equation-parallel.h"
+
+// Bytes a connection reads at most per loop iteration, on top of the frame it waits for
+static const size_t READ_CHUNK_SIZE = 64 * 1024;
+
+// Connection stops reading requests while it has more unsent output than this
+static const size_t OUTPUT_LIMIT = 8 * 1024 * 1024;
+
+static const int MAX_EVENTS = 64;
+
+struct byte_buffer {
+    char* data;
+    size_t used;
+    size_t capacity;
+};
+
+struct server_connection {
+    int fd;
+    uint32_t events; // Events the connection is registered for in epoll
+
+    byte_buffer input;
+    byte_buffer output;
+    size_t sent; // Bytes of output already written to the socket
+
+    bool is_peer_done;   // Peer won't send more, close after last response
+    bool is_broken;      // Protocol or socket error, close right away
+    bool is_touched;     // Already in the touched list of this iteration
+
+    server_connection* previous;
+    server_connection* next;
+};
+
+// Request waiting in the batch of the current loop iteration
+struct pending_request {
+    server_connection* connection;
+    uint64_t id;
+    size_t first;
+    uint32_t count;
+};
+
+struct solver_server {
+    int epoll_fd;
+    int stop_fd;
+    int unix_fd;
+    int tcp_fd;
+
+    char* socket_path;
+    uint16_t tcp_port;
+
+    server_connection* connections;
+
+    // Coefficients and solutions of all requests of one loop iteration
+    double* a;
+    double* b;
+    double* c;
+    solution_status* status;
+    int* number_of_roots;
+    double* root[2];
+    int* error_code;
+    size_t batch_size;
+    size_t batch_capacity;
+
+    pending_request* requests;
+    size_t number_of_requests;
+    size_t requests_capacity;
+
+    server_connection** touched;
+    size_t number_of_touched;
+    size_t touched_capacity;
+};
+
+static bool reserve_bytes(byte_buffer* const buffer, const size_t size) {
+    if (buffer->capacity - buffer->used >= size)
+        return true;
+
+    size_t capacity = buffer->capacity == 0 ? READ_CHUNK_SIZE : buffer->capacity;
+    while (capacity - buffer->used < size)
+        capacity *= 2;
+
+    char* const data = (char*) realloc(buffer->data, capacity);
+    if (data == NULL)
+        return false;
+
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+// Grow every column together, they are indexed the same way
+static bool reserve_batch(solver_server* const server, const size_t count) {
+    const size_t needed = server->batch_size + count;
+    if (needed <= server->batch_capacity)
+        return true;
+
+    size_t capacity = server->batch_capacity == 0 ? PARALLEL_BATCH_CHUNK_SIZE
+                                                  : server->batch_capacity;
+    while (capacity < needed)
+        capacity *= 2;
+
+    double** const double_columns[] = { &server->a, &server->b, &server->c,
+                                        &server->root[0], &server->root[1] };
+
+    for (double** column : double_columns) {
+        double* const grown = (double*) realloc(*column, capacity * sizeof(double));
+        if (grown == NULL)
+            return false;
+
+        *column = grown;
+    }
+
+    int** const int_columns[] = { &server->number_of_roots, &server->error_code };
+
+    for (int** column : int_columns) {
+        int* const grown = (int*) realloc(*column, capacity * sizeof(int));
+        if (grown == NULL)
+            return false;
+
+        *column = grown;
+    }
+
+    solution_status* const status =
+        (solution_status*) realloc(server->status, capacity * sizeof(solution_status));
+    if (status == NULL)
+        return false;
+
+    server->status = status;
+    server->batch_capacity = capacity;
+    return true;
+}
+
+template <typename value_t>
+static bool reserve_array(value_t** const array, size_t* const capacity, const size_t needed) {
+    if (needed <= *capacity)
+        return true;
+
+    const size_t grown_capacity = needed < 16 ? 16 : needed * 2;
+
+    value_t* const grown = (value_t*) realloc(*array, grown_capacity * sizeof(value_t));
+    if (grown == NULL)
+        return false;
+
+    *array = grown;
+    *capacity = grown_capacity;
+    return true;
+}
+
+static void touch_connection(solver_server* const server, server_connection* const connection) {
+    if (connection->is_touched)
+        return;
+
+    if (!reserve_array(&server->touched, &server->touched_capacity,
+                       server->number_of_touched + 1)) {
+        connection->is_broken = true;
+        return;
+    }
+
+    connection->is_touched = true;
+    server->touched[server->number_of_touched ++] = connection;
+}
+
+static int add_to_epoll(const int epoll_fd, const int fd, const uint32_t events, void* const data) {
+    epoll_event event {};
+    event.events = events;
+    event.data.ptr = data;
+
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+static void close_connection(solver_server* const server, server_connection* const connection) {
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+    close(connection->fd);
+
+    if (connection->previous != NULL)
+        connection->previous->next = connection->next;
+    else
+        server->connections = connection->next;
+
+    if (connection->next != NULL)
+        connection->next->previous = connection->previous;
+
+    free(connection->input.data);
+    free(connection->output.data);
+    free(connection);
+}
+
+static void accept_connections(solver_server* const server, const int listening_fd) {
+    while (true) {
+        const int fd = accept4(listening_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return; // EAGAIN, or a connection that was reset before we got to it
+
+        if (listening_fd == server->tcp_fd) {
+            const int enabled = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+        }
+
+        server_connection* const connection =
+            (server_connection*) calloc(1, sizeof(server_connection));
+
+        if (connection == NULL) {
+            close(fd);
+            continue;
+        }
+
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+
+        if (add_to_epoll(server->epoll_fd, fd, EPOLLIN, connection) != 0) {
+            close(fd);
+            free(connection);
+            continue;
+        }
+
+        connection->next = server->connections;
+        if (server->connections != NULL)
+            server->connections->previous = connection;
+
+        server->connections = connection;
+    }
+}
+
+// Move complete requests of the input buffer into the batch
+static void parse_requests(solver_server* const server, server_connection* const connection) {
+    byte_buffer* const input = &connection->input;
+    size_t parsed = 0;
+
+    while (input->used - parsed >= sizeof(solver_request_header)) {
+        solver_request_header header;
+        memcpy(&header, input->data + parsed, sizeof(header));
+
+        if (header.magic != SOLVER_REQUEST_MAGIC || header.count > SOLVER_PROTOCOL_MAX_EQUATIONS) {
+            connection->is_broken = true;
+            return;
+        }
+
+        const size_t size = solver_request_size(header.count);
+        if (input->used - parsed < size) {
+            // Make room for the rest of the request
+            if (!reserve_bytes(input, size))
+                connection->is_broken = true;
+
+            break;
+        }
+
+        if (!reserve_batch(server, header.count) ||
+            !reserve_array(&server->requests, &server->requests_capacity,
+                           server->number_of_requests + 1)) {
+
+            connection->is_broken = true;
+            return;
+        }
+
+        const char* const triples = input->data + parsed + sizeof(header);
+        const size_t first = server->batch_size;
+
+        for (size_t i = 0; i < header.count; ++ i) {
+            double triple[3];
+            memcpy(triple, triples + i * sizeof(triple), sizeof(triple));
+
+            server->a[first + i] = triple[0];
+            server->b[first + i] = triple[1];
+            server->c[first + i] = triple[2];
+        }
+
+        server->requests[server->number_of_requests ++] = { connection, header.id, first,
+                                                            header.count };
+        server->batch_size += header.count;
+
+        parsed += size;
+    }
+
+    memmove(input->data, input->data + parsed, input->used - parsed);
+    input->used -= parsed;
+}
+
+static void read_requests(solver_server* const server, server_connection* const connection) {
+    byte_buffer* const input = &connection->input;
+
+    if (!reserve_bytes(input, READ_CHUNK_SIZE)) {
+        connection->is_broken = true;
+        return;
+    }
+
+    // Reads at most the free space, level-triggered epoll reports the rest next time
+    const ssize_t received = recv(connection->fd, input->data + input->used,
+                                  input->capacity - input->used, 0);
+
+    if (received == 0)
+        connection->is_peer_done = true;
+    else if (received < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            connection->is_broken = true;
+    } else {
+        input->used += (size_t) received;
+        parse_requests(server, connection);
+    }
+}
+
+static void write_responses(solver_server* const server) {
+    for (size_t i = 0; i < server->number_of_requests; ++ i) {
+        const pending_request* const request = server->requests + i;
+        server_connection* const connection = request->connection;
+
+        byte_buffer* const output = &connection->output;
+        if (connection->is_broken || !reserve_bytes(output, solver_response_size(request->count))) {
+            connection->is_broken = true;
+            continue;
+        }
+
+        const solver_response_header header = { SOLVER_RESPONSE_MAGIC, request->count, request->id };
+        memcpy(output->data + output->used, &header, sizeof(header));
+        output->used += sizeof(header);
+
+        for (size_t j = request->first; j < request->first + request->count; ++ j) {
+            const solver_response_record record = {
+                { server->root[0][j], server->root[1][j] },
+                server->status[j], server->number_of_roots[j], server->error_code[j], 0
+            };
+
+            memcpy(output->data + output->used, &record, sizeof(record));
+            output->used += sizeof(record);
+        }
+    }
+}
+
+// Solve requests of all connections at once
+static void solve_batch(solver_server* const server) {
+    if (server->batch_size == 0)
+        return;
+
+    const equation_solution_columns solutions {
+        server->status, server->number_of_roots,
+        { server->root[0], server->root[1] }, server->error_code
+    };
+
+    solve_quadratic_equation_batch_parallel(NULL, server->a, server->b, server->c,
+                                            server->batch_size, &solutions);
+
+    write_responses(server);
+
+    server->batch_size = 0;
+    server->number_of_requests = 0;
+}
+
+static void flush_output(server_connection* const connection) {
+    byte_buffer* const output = &connection->output;
+
+    while (connection->sent < output->used) {
+        const ssize_t written = send(connection->fd, output->data + connection->sent,
+                                     output->used - connection->sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                connection->is_broken = true;
+
+            return;
+        }
+
+        connection->sent += (size_t) written;
+    }
+
+    output->used = connection->sent = 0;
+}
+
+// New responses go after everything in output, sent or not, so the sent
+// part is dropped once it's the larger one. Otherwise a peer that keeps
+// sending while reading slowly grows output without bound, and moving
+// only when half is sent keeps the copies linear in bytes sent
+static void compact_output(server_connection* const connection) {
+    byte_buffer* const output = &connection->output;
+
+    if (connection->sent < output->used - connection->sent)
+        return;
+
+    memmove(output->data, output->data + connection->sent, output->used - connection->sent);
+    output->used -= connection->sent;
+    connection->sent = 0;
+}
+
+// Connections with too much unsent output stop reading, so a slow reader
+// can't make the server buffer unlimited responses
+static void finish_connection(solver_server* const server, server_connection* const connection) {
+    connection->is_touched = false;
+
+    if (!connection->is_broken) {
+        flush_output(connection);
+        compact_output(connection);
+    }
+
+    const size_t unsent = connection->output.used - connection->sent;
+
+    if (connection->is_broken || (connection->is_peer_done && unsent == 0)) {
+        close_connection(server, connection);
+        return;
+    }
+
+    const bool is_reading = !connection->is_peer_done && unsent < OUTPUT_LIMIT;
+    const uint32_t events =
+        (unsent != 0 ? (uint32_t) EPOLLOUT : 0u) | (is_reading ? (uint32_t) EPOLLIN : 0u);
+    if (events == connection->events)
+        return;
+
+    epoll_event event {};
+    event.events = events;
+    event.data.ptr = connection;
+
+    if (epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, connection->fd, &event) != 0) {
+        close_connection(server, connection);
+        return;
+    }
+
+    connection->events = events;
+}
+
+int run_solver_server(solver_server* const server) {
+    epoll_event events[MAX_EVENTS];
+
+    bool is_stopping = false;
+    while (!is_stopping) {
+        const int number_of_events = epoll_wait(server->epoll_fd, events, MAX_EVENTS, -1);
+        if (number_of_events < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        for (int i = 0; i < number_of_events; ++ i) {
+            void* const source = events[i].data.ptr;
+
+            if (source == &server->stop_fd) {
+                is_stopping = true;
+                continue;
+            }
+
+            if (source == &server->unix_fd || source == &server->tcp_fd) {
+                accept_connections(server, *(int*) source);
+                continue;
+            }
+
+            server_connection* const connection = (server_connection*) source;
+            touch_connection(server, connection);
+
+            if (events[i].events & EPOLLIN)
+                read_requests(server, connection);
+            else if (events[i].events & (EPOLLERR | EPOLLHUP))
+                connection->is_broken = true;
+        }
+
+        solve_batch(server);
+
+        for (size_t i = 0; i < server->number_of_touched; ++ i)
+            finish_connection(server, server->touched[i]);
+
+        server->number_of_touched = 0;
+    }
+
+    return 0;
+}
+
+void stop_solver_server(solver_server* const server) {
+    const uint64_t value = 1;
+    ssize_t written = write(server->stop_fd, &value, sizeof(value));
+    (void) written; // Counter can't overflow from a few stops
+}
+
+uint16_t solver_server_tcp_port(const solver_server* const server) {
+    return server->tcp_port;
+}
+
+static int listen_on_unix_socket(const char* const path) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+
+    if (strlen(path) >= sizeof(address.sun_path))
+        return -1;
+
+    strcpy(address.sun_path, path);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    unlink(path);
+
+    if (bind(fd, (const sockaddr*) &address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static int listen_on_tcp_port(const uint16_t port, uint16_t* const bound_port) {
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    const int enabled = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t length = sizeof(address);
+
+    if (bind(fd, (const sockaddr*) &address, sizeof(address)) != 0 ||
+        listen(fd, SOMAXCONN) != 0 ||
+        getsockname(fd, (sockaddr*) &address, &length) != 0) {
+
+        close(fd);
+        return -1;
+    }
+
+    *bound_port = ntohs(address.sin_port);
+    return fd;
+}
+
+solver_server* create_solver_server(const solver_server_config* const config) {
+    if (config->socket_path == NULL && !config->use_tcp)
+        return NULL;
+
+    solver_server* const server = (solver_server*) calloc(1, sizeof(solver_server));
+    if (server == NULL)
+        return NULL;
+
+    server->unix_fd = server->tcp_fd = -1;
+
+    server->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    server->stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    bool is_created = server->epoll_fd >= 0 && server->stop_fd >= 0 &&
+        add_to_epoll(server->epoll_fd, server->stop_fd, EPOLLIN, &server->stop_fd) == 0;
+
+    if (is_created && config->socket_path != NULL) {
+        server->unix_fd = listen_on_unix_socket(config->socket_path);
+        server->socket_path = strdup(config->socket_path);
+
+        is_created = server->unix_fd >= 0 && server->socket_path != NULL &&
+            add_to_epoll(server->epoll_fd, server->unix_fd, EPOLLIN, &server->unix_fd) == 0;
+    }
+
+    if (is_created && config->use_tcp) {
+        server->tcp_fd = listen_on_tcp_port(config->tcp_port, &server->tcp_port);
+
+        is_created = server->tcp_fd >= 0 &&
+            add_to_epoll(server->epoll_fd, server->tcp_fd, EPOLLIN, &server->tcp_fd) == 0;
+    }
+
+    if (!is_created) {
+        destroy_solver_server(server);
+        return NULL;
+    }
+
+    return server;
+}
+
+void destroy_solver_server(solver_server* const server) {
+    if (server == NULL)
+        return;
+
+    while (server->connections != NULL)
+        close_connection(server, server->connections);
+
+    const int fds[] = { server->epoll_fd, server->stop_fd, server->unix_fd, server->tcp_fd };
+    for (int fd : fds)
+        if (fd >= 0)
+            close(fd);
+
+    if (server->unix_fd >= 0 && server->socket_path != NULL)
+        unlink(server->socket_path);
+
+    free(server->socket_path);
+
+    free(server->a);
+    free(server->b);
+    free(server->c);
+    free(server->status);
+    free(server->number_of_roots);
+    free(server->root[0]);
+    free(server->root[1]);
+    free(server->error_code);
+
+    free(server->requests);
+    free(server->touched);
+    free(server);
+}
@@ -0,0 +1,65 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_SERVER_H
+#define QUADRATIC_EQUATION_SOLVER_SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "solver-protocol.h"
+
+/**
+   @brief Solver daemon that answers requests of solver-client.h
+
+   One thread runs an epoll loop over all connections. Requests that
+   arrive in the same loop iteration, from any number of connections, are
+   solved together as one batch, so many small requests still reach the
+   vector kernels in large batches.
+ */
+struct solver_server;
+
+/**
+   @brief Where a server listens
+ */
+struct solver_server_config {
+    const char* socket_path; /**< @brief Unix domain socket to create, NULL for none.
+                                  An existing file at this path is replaced. */
+    bool use_tcp;            /**< @brief Whether to also listen on 127.0.0.1 */
+    uint16_t tcp_port;       /**< @brief TCP port, 0 picks any free one */
+};
+
+/**
+   @brief Create listening sockets of a server, requests are served by #run_solver_server
+
+   @return New server, or NULL if a socket couldn't be created or bound, or
+   if @p config has no socket at all.
+ */
+solver_server* create_solver_server(const solver_server_config* const config);
+
+/**
+   @brief Serve requests until #stop_solver_server is called
+
+   @return 0 after a stop, -1 if the event loop failed.
+ */
+int run_solver_server(solver_server* const server);
+
+/**
+   @brief Make #run_solver_server return
+
+   @note Can be called from any thread and from a signal handler.
+ */
+void stop_solver_server(solver_server* const server);
+
+/**
+   @brief TCP port the server listens on, useful when it was created with port 0
+
+   @return Port number, or 0 if the server doesn't listen on TCP.
+ */
+uint16_t solver_server_tcp_port(const solver_server* const server);
+
+/**
+   @brief Close all connections and sockets, remove the Unix socket file
+
+   @note Passing NULL is allowed and does nothing.
+ */
+void destroy_solver_server(solver_server* const server);
+
+#endif // QUADRATIC_EQUATION_SOLVER_SERVER_H
@@ -0,0 +1,177 @@
+#include <cstring>
+
+#include "solver-stats.h"
+
+static const char* const COUNTER_NAMES[NUMBER_OF_STATS_COUNTERS] = {
+    "two_roots", "one_root", "no_roots", "linear_fallback",
+    "inf_roots", "illegal_a", "illegal_b", "illegal_c"
+};
+
+static const char* const HISTOGRAM_NAMES[NUMBER_OF_STATS_HISTOGRAMS] = {
+    "solve", "describe"
+};
+
+const char* solver_stats_counter_name(const solver_stats_counter counter) {
+    if ((size_t) counter >= NUMBER_OF_STATS_COUNTERS)
+        return NULL;
+
+    return COUNTER_NAMES[counter];
+}
+
+void print_solver_stats(FILE* const output, const solver_stats_snapshot* const snapshot) {
+    for (size_t i = 0; i < NUMBER_OF_STATS_COUNTERS; ++ i)
+        fprintf(output, "%-16s %llu\n", COUNTER_NAMES[i],
+                (unsigned long long) snapshot->counters[i]);
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_HISTOGRAMS; ++ i) {
+        fprintf(output, "%s latency, 1 in %u calls sampled:\n",
+                HISTOGRAM_NAMES[i], (unsigned) STATS_SAMPLING_PERIOD);
+
+        for (size_t bucket = 0; bucket < STATS_HISTOGRAM_BUCKETS; ++ bucket) {
+            const uint64_t samples = snapshot->histograms[i][bucket];
+            if (samples == 0)
+                continue;
+
+            const unsigned long long upper_bound = 1ull << bucket;
+            fprintf(output, "  %s%10llu ns %llu\n",
+                    bucket + 1 == STATS_HISTOGRAM_BUCKETS ? ">=" : "< ",
+                    bucket + 1 == STATS_HISTOGRAM_BUCKETS ? upper_bound / 2 : upper_bound,
+                    (unsigned long long) samples);
+        }
+    }
+}
+
+#ifdef EQUATION_SOLVER_STATS
+
+#include <chrono>
+#include <mutex>
+
+constinit thread_local solver_stats_block* thread_stats_block = NULL;
+
+// Blocks of running threads, and totals of finished ones
+static std::mutex registry_mutex;
+static solver_stats_block* live_blocks = NULL;
+static solver_stats_snapshot finished_threads_total = {};
+
+// Snapshot taken by the last reset, subtracted from every later snapshot
+static solver_stats_snapshot reset_baseline = {};
+
+static void add_block_to_snapshot(solver_stats_snapshot* const total,
+                                  const solver_stats_block* const block) {
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_COUNTERS; ++ i)
+        total->counters[i] += block->counters[i].load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_HISTOGRAMS; ++ i)
+        for (size_t bucket = 0; bucket < STATS_HISTOGRAM_BUCKETS; ++ bucket)
+            total->histograms[i][bucket] +=
+                block->histograms[i][bucket].load(std::memory_order_relaxed);
+}
+
+// Requires registry_mutex
+static void sum_all_threads(solver_stats_snapshot* const total) {
+    *total = finished_threads_total;
+
+    for (const solver_stats_block* block = live_blocks; block != NULL; block = block->next)
+        add_block_to_snapshot(total, block);
+}
+
+// Moves counters of a finishing thread into finished_threads_total
+struct thread_stats_block_owner {
+    solver_stats_block* block;
+
+    ~thread_stats_block_owner() {
+        if (block == NULL)
+            return;
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        solver_stats_block** link = &live_blocks;
+        while (*link != block)
+            link = &(*link)->next;
+
+        *link = block->next;
+
+        add_block_to_snapshot(&finished_threads_total, block);
+        thread_stats_block = NULL;
+
+        delete block;
+    }
+};
+
+static thread_local thread_stats_block_owner thread_block_owner = { NULL };
+
+solver_stats_block* register_thread_stats_block(void) {
+    solver_stats_block* const block = new solver_stats_block();
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_HISTOGRAMS; ++ i)
+        block->calls_until_sample[i] = STATS_SAMPLING_PERIOD;
+
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        block->next = live_blocks;
+        live_blocks = block;
+    }
+
+    thread_block_owner.block = block;
+    thread_stats_block = block;
+
+    return block;
+}
+
+uint64_t read_stats_clock(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record_latency_sample(solver_stats_block* const block, const solver_stats_histogram histogram,
+                           const uint64_t start) {
+
+    const uint64_t elapsed = read_stats_clock() - start;
+
+    // Index of the highest set bit plus one, 0 for 0 ns
+    size_t bucket = elapsed == 0 ? 0 : 64 - (size_t) __builtin_clzll(elapsed);
+    if (bucket >= STATS_HISTOGRAM_BUCKETS)
+        bucket = STATS_HISTOGRAM_BUCKETS - 1;
+
+    add_to_stats_counter(&block->histograms[histogram][bucket], 1);
+}
+
+bool solver_stats_enabled(void) {
+    return true;
+}
+
+void take_solver_stats_snapshot(solver_stats_snapshot* const snapshot) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+
+    sum_all_threads(snapshot);
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_COUNTERS; ++ i)
+        snapshot->counters[i] -= reset_baseline.counters[i];
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_HISTOGRAMS; ++ i)
+        for (size_t bucket = 0; bucket < STATS_HISTOGRAM_BUCKETS; ++ bucket)
+            snapshot->histograms[i][bucket] -= reset_baseline.histograms[i][bucket];
+}
+
+void reset_solver_stats(void) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+
+    sum_all_threads(&reset_baseline);
+}
+
+#else
+
+bool solver_stats_enabled(void) {
+    return false;
+}
+
+void take_solver_stats_snapshot(solver_stats_snapshot* const snapshot) {
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+void reset_solver_stats(void) {
+}
+
+#endif // EQUATION_SOLVER_STATS
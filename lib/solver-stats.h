@@ -0,0 +1,208 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_STATS_H
+#define QUADRATIC_EQUATION_SOLVER_STATS_H
+
+#include <stdio.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "quadratic-equation-core.h"
+
+/**
+   @brief Branches of #solve_quadratic_equation that are counted
+
+   Every solved equation hits exactly one of #STATS_TWO_ROOTS,
+   #STATS_ONE_ROOT, #STATS_NO_ROOTS, #STATS_LINEAR_FALLBACK or an error
+   counter. #STATS_INF_ROOTS is a part of #STATS_LINEAR_FALLBACK.
+ */
+enum solver_stats_counter {
+    STATS_TWO_ROOTS,       /**< @brief Positive discriminant */
+    STATS_ONE_ROOT,        /**< @brief Discriminant is zero (within epsilon) */
+    STATS_NO_ROOTS,        /**< @brief Negative discriminant */
+    STATS_LINEAR_FALLBACK, /**< @brief a is zero, solved as linear equation */
+    STATS_INF_ROOTS,       /**< @brief Linear equation with #INF_ROOTS */
+    STATS_ILLEGAL_A,       /**< @brief Error code 1 */
+    STATS_ILLEGAL_B,       /**< @brief Error code 2 */
+    STATS_ILLEGAL_C,       /**< @brief Error code 3 */
+
+    NUMBER_OF_STATS_COUNTERS
+};
+
+/**
+   @brief Operations whose latency is sampled
+ */
+enum solver_stats_histogram {
+    STATS_SOLVE_LATENCY,    /**< @brief #solve_quadratic_equation */
+    STATS_DESCRIBE_LATENCY, /**< @brief #describe_equation_solution and its fast variant */
+
+    NUMBER_OF_STATS_HISTOGRAMS
+};
+
+/**
+   @brief Number of latency histogram buckets
+
+   Bucket 0 counts samples that took less than 1 ns, bucket i > 0 counts
+   samples in [2^(i - 1), 2^i) ns. The last bucket also takes everything slower.
+ */
+const size_t STATS_HISTOGRAM_BUCKETS = 32;
+
+/**
+   @brief Only one call in this many is timed, per thread and operation
+ */
+const uint32_t STATS_SAMPLING_PERIOD = 64;
+
+/**
+   @brief Totals of all threads since the last #reset_solver_stats
+ */
+struct solver_stats_snapshot {
+    uint64_t counters[NUMBER_OF_STATS_COUNTERS];
+    uint64_t histograms[NUMBER_OF_STATS_HISTOGRAMS][STATS_HISTOGRAM_BUCKETS];
+};
+
+/**
+   @brief Whether the library was built with EQUATION_SOLVER_STATS
+
+   @note When it wasn't, snapshots are always zero.
+ */
+bool solver_stats_enabled(void);
+
+/**
+   @brief Sum counters and histograms of every thread, including finished ones
+
+   @note Threads keep counting while the snapshot is taken, so totals of a
+   running program are only consistent per counter.
+ */
+void take_solver_stats_snapshot(solver_stats_snapshot* const snapshot);
+
+/**
+   @brief Start counting from zero
+
+   @note Doesn't write to per-thread counters, so it never races with them.
+ */
+void reset_solver_stats(void);
+
+/**
+   @brief Human-readable counter name, like "two_roots"
+
+   @return Name of the counter, or NULL for a value that isn't a #solver_stats_counter.
+ */
+const char* solver_stats_counter_name(const solver_stats_counter counter);
+
+/**
+   @brief Print counters and non-empty histogram buckets of @p snapshot to @p output
+ */
+void print_solver_stats(FILE* const output, const solver_stats_snapshot* const snapshot);
+
+#ifdef EQUATION_SOLVER_STATS
+
+#include <atomic>
+#include <cmath>
+
+/**
+   @brief Counters of one thread, written only by that thread
+ */
+struct alignas(64) solver_stats_block {
+    std::atomic<uint64_t> counters[NUMBER_OF_STATS_COUNTERS];
+    std::atomic<uint64_t> histograms[NUMBER_OF_STATS_HISTOGRAMS][STATS_HISTOGRAM_BUCKETS];
+
+    uint32_t calls_until_sample[NUMBER_OF_STATS_HISTOGRAMS];
+
+    solver_stats_block* next;
+};
+
+// constinit lets other files read it directly instead of calling a TLS init wrapper
+extern constinit thread_local solver_stats_block* thread_stats_block;
+
+/**
+   @brief Counters of the calling thread, registered on first use
+ */
+solver_stats_block* register_thread_stats_block(void);
+
+/**
+   @brief Nanoseconds of a monotonic clock
+ */
+uint64_t read_stats_clock(void);
+
+void record_latency_sample(solver_stats_block* const block, const solver_stats_histogram histogram,
+                           const uint64_t start);
+
+inline solver_stats_block* get_thread_stats_block(void) {
+    solver_stats_block* const block = thread_stats_block;
+    return block != NULL ? block : register_thread_stats_block();
+}
+
+// Only the owning thread writes, so plain load and store are enough and
+// no locked instruction is needed
+inline void add_to_stats_counter(std::atomic<uint64_t>* const counter, const uint64_t value) {
+    counter->store(counter->load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void count_solver_event(const solver_stats_counter counter) {
+    add_to_stats_counter(&get_thread_stats_block()->counters[counter], 1);
+}
+
+/**
+   @return Start time if this call is sampled, 0 otherwise.
+ */
+inline uint64_t begin_latency_sample(const solver_stats_histogram histogram) {
+    solver_stats_block* const block = get_thread_stats_block();
+
+    if (-- block->calls_until_sample[histogram] != 0)
+        return 0;
+
+    block->calls_until_sample[histogram] = STATS_SAMPLING_PERIOD;
+    return read_stats_clock();
+}
+
+inline void end_latency_sample(const solver_stats_histogram histogram, const uint64_t start) {
+    if (start != 0)
+        record_latency_sample(thread_stats_block, histogram, start);
+}
+
+/**
+   @brief Count branch that #solve_quadratic_equation took for one equation
+ */
+inline void count_solved_equation(const double a, const int error_code,
+                                  const solution_status status, const int number_of_roots) {
+
+    // Solution isn't written on error, so it is not even read
+    if (error_code != 0) {
+        count_solver_event((solver_stats_counter) (STATS_ILLEGAL_A + error_code - 1));
+        return;
+    }
+
+    // Selects instead of branches, outcomes of uniform data are unpredictable
+    static const solver_stats_counter BY_NUMBER_OF_ROOTS[] = {
+        STATS_NO_ROOTS, STATS_ONE_ROOT, STATS_TWO_ROOTS
+    };
+
+    const bool is_linear = std::fabs(a) <= absolute_tolerance<double>::epsilon;
+    const solver_stats_counter counter =
+        is_linear ? STATS_LINEAR_FALLBACK : BY_NUMBER_OF_ROOTS[number_of_roots];
+
+    solver_stats_block* const block = get_thread_stats_block();
+
+    add_to_stats_counter(&block->counters[counter], 1);
+    add_to_stats_counter(&block->counters[STATS_INF_ROOTS], status == INF_ROOTS);
+}
+
+#define SOLVER_STATS_COUNT(counter) count_solver_event(counter)
+
+#define SOLVER_STATS_COUNT_SOLUTION(a, error_code, status, number_of_roots) \
+    count_solved_equation((a), (error_code), (status), (number_of_roots))
+
+#define SOLVER_STATS_BEGIN_SAMPLE(name, histogram) \
+    const uint64_t name = begin_latency_sample(histogram)
+
+#define SOLVER_STATS_END_SAMPLE(name, histogram) end_latency_sample((histogram), (name))
+
+#else
+
+// Probes vanish from the code, there is not even a branch left
+#define SOLVER_STATS_COUNT(counter) ((void) 0)
+#define SOLVER_STATS_COUNT_SOLUTION(a, error_code, status, number_of_roots) ((void) 0)
+#define SOLVER_STATS_BEGIN_SAMPLE(name, histogram) ((void) 0)
+#define SOLVER_STATS_END_SAMPLE(name, histogram) ((void) 0)
+
+#endif // EQUATION_SOLVER_STATS
+
+#endif // QUADRATIC_EQUATION_SOLVER_STATS_H
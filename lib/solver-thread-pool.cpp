@@ -0,0 +1,286 @@
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+#include <thread>
+#include <sched.h>
+#include <pthread.h>
+
+#ifdef EQUATION_SOLVER_HAS_LIBNUMA
+#include <numa.h>
+#endif
+
+#include "solver-thread-pool.h"
+
+// Tasks left to a worker, packed as [begin, end) into one word, so the
+// owner and thieves can both claim tasks with a single compare-and-swap
+struct alignas(64) worker_queue {
+    std::atomic<uint64_t> range { 0 };
+};
+
+static inline uint64_t pack_range(const uint64_t begin, const uint64_t end) {
+    return (end << 32) | begin;
+}
+
+static inline uint64_t range_begin(const uint64_t range) { return range & 0xffffffffu; }
+static inline uint64_t range_end(const uint64_t range) { return range >> 32; }
+
+struct solver_thread_pool {
+    size_t size;
+
+    std::thread* threads;
+    worker_queue* queues;
+
+    std::mutex mutex;
+    std::condition_variable job_started;
+    std::condition_variable job_finished;
+
+    uint64_t job_generation;
+    bool is_stopping;
+
+    size_t busy_workers;
+
+    // Serializes jobs submitted by different threads
+    std::mutex job_mutex;
+
+    pool_task_function function;
+    void* context;
+};
+
+// Owner takes tasks one by one from the front of its range
+static bool take_own_task(worker_queue* const queue, size_t* const task) {
+    uint64_t range = queue->range.load(std::memory_order_acquire);
+
+    while (range_begin(range) < range_end(range)) {
+        const uint64_t taken = pack_range(range_begin(range) + 1, range_end(range));
+
+        if (queue->range.compare_exchange_weak(range, taken, std::memory_order_acq_rel)) {
+            *task = (size_t) range_begin(range);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Thief takes back half of the victim's range and makes it its own
+static bool steal_tasks(solver_thread_pool* const pool, const size_t thief) {
+    for (size_t shift = 1; shift < pool->size; ++ shift) {
+        worker_queue* const victim = pool->queues + (thief + shift) % pool->size;
+        uint64_t range = victim->range.load(std::memory_order_acquire);
+
+        while (range_begin(range) < range_end(range)) {
+            const uint64_t left = range_end(range) - range_begin(range);
+            const uint64_t split = range_end(range) - (left + 1) / 2;
+
+            if (victim->range.compare_exchange_weak(range, pack_range(range_begin(range), split),
+                                                    std::memory_order_acq_rel)) {
+                // Own queue is empty, so no one else can succeed in changing it
+                pool->queues[thief].range.store(pack_range(split, range_end(range)),
+                                                std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static void work_on_job(solver_thread_pool* const pool, const size_t worker) {
+    worker_queue* const queue = pool->queues + worker;
+
+    do {
+        size_t task = 0;
+        while (take_own_task(queue, &task))
+            pool->function(pool->context, task, worker);
+
+    } while (steal_tasks(pool, worker));
+}
+
+static void worker_main(solver_thread_pool* const pool, const size_t worker) {
+    uint64_t seen_generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->job_started.wait(lock, [&] {
+                return pool->is_stopping || pool->job_generation != seen_generation;
+            });
+
+            if (pool->is_stopping)
+                return;
+
+            seen_generation = pool->job_generation;
+        }
+
+        work_on_job(pool, worker);
+
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (-- pool->busy_workers == 0)
+            pool->job_finished.notify_one();
+    }
+}
+
+static void stop_workers(solver_thread_pool* const pool, const size_t started) {
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->is_stopping = true;
+    }
+
+    pool->job_started.notify_all();
+
+    for (size_t i = 0; i < started; ++ i)
+        pool->threads[i].join();
+}
+
+solver_thread_pool* create_solver_thread_pool(const size_t number_of_threads) {
+    size_t size = number_of_threads;
+    if (size == 0)
+        size = std::thread::hardware_concurrency();
+
+    if (size == 0) // Couldn't be determined
+        size = 1;
+
+    solver_thread_pool* const pool = new (std::nothrow) solver_thread_pool {};
+    if (pool == NULL)
+        return NULL;
+
+    pool->size = size;
+    pool->queues = new (std::nothrow) worker_queue[size];
+    pool->threads = new (std::nothrow) std::thread[size - 1];
+
+    if (pool->queues == NULL || pool->threads == NULL) {
+        destroy_solver_thread_pool(pool);
+        return NULL;
+    }
+
+    // Worker 0 is the thread that submits a job, it needs no std::thread
+    for (size_t i = 0; i < size - 1; ++ i) {
+        try {
+            pool->threads[i] = std::thread(worker_main, pool, i + 1);
+        } catch (const std::system_error&) {
+            stop_workers(pool, i);
+
+            delete[] pool->threads;
+            delete[] pool->queues;
+            delete pool;
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void destroy_solver_thread_pool(solver_thread_pool* const pool) {
+    if (pool == NULL)
+        return;
+
+    if (pool->threads != NULL && pool->queues != NULL)
+        stop_workers(pool, pool->size - 1);
+
+    delete[] pool->threads;
+    delete[] pool->queues;
+    delete pool;
+}
+
+size_t solver_thread_pool_size(const solver_thread_pool* const pool) {
+    return pool->size;
+}
+
+static int node_of_cpu(const int cpu) {
+#ifdef EQUATION_SOLVER_HAS_LIBNUMA
+    if (numa_available() >= 0) {
+        const int node = numa_node_of_cpu(cpu);
+        return node >= 0 ? node : 0;
+    }
+#endif
+    (void) cpu;
+    return 0;
+}
+
+int pin_solver_thread_pool_workers(solver_thread_pool* const pool) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return -1;
+
+    // Allowed CPUs ordered by node, then by number
+    int cpus[CPU_SETSIZE];
+    size_t number_of_cpus = 0;
+
+    int last_node = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++ cpu)
+        if (CPU_ISSET(cpu, &allowed)) {
+            const int node = node_of_cpu(cpu);
+            last_node = node > last_node ? node : last_node;
+        }
+
+    for (int node = 0; node <= last_node; ++ node)
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++ cpu)
+            if (CPU_ISSET(cpu, &allowed) && node_of_cpu(cpu) == node)
+                cpus[number_of_cpus ++] = cpu;
+
+    if (number_of_cpus == 0)
+        return -1;
+
+    int result = 0;
+
+    for (size_t worker = 0; worker < pool->size; ++ worker) {
+        cpu_set_t pinned;
+        CPU_ZERO(&pinned);
+        CPU_SET(cpus[worker % number_of_cpus], &pinned);
+
+        const pthread_t thread = worker == 0 ? pthread_self()
+                                             : pool->threads[worker - 1].native_handle();
+
+        if (pthread_setaffinity_np(thread, sizeof(pinned), &pinned) != 0)
+            result = -1;
+    }
+
+    return result;
+}
+
+void run_solver_thread_pool_tasks(solver_thread_pool* const pool, const size_t number_of_tasks,
+                                  const pool_task_function function, void* const context) {
+
+    if (number_of_tasks == 0)
+        return;
+
+    std::lock_guard<std::mutex> job_lock(pool->job_mutex);
+
+    // Give every worker an equal contiguous share of the tasks
+    const size_t size = pool->size;
+    for (size_t worker = 0; worker < size; ++ worker) {
+        const uint64_t begin = number_of_tasks * worker / size;
+        const uint64_t end = number_of_tasks * (worker + 1) / size;
+
+        pool->queues[worker].range.store(pack_range(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+
+        pool->function = function;
+        pool->context = context;
+
+        pool->busy_workers = size - 1;
+        ++ pool->job_generation;
+    }
+
+    pool->job_started.notify_all();
+
+    work_on_job(pool, 0);
+
+    std::unique_lock<std::mutex> lock(pool->mutex);
+    pool->job_finished.wait(lock, [&] { return pool->busy_workers == 0; });
+}
+
+solver_thread_pool* get_default_solver_thread_pool(void) {
+    // Intentionally never destroyed, workers just sleep until exit
+    static solver_thread_pool* const pool = create_solver_thread_pool(0);
+    return pool;
+}
@@ -0,0 +1,100 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_THREAD_POOL_H
+#define QUADRATIC_EQUATION_SOLVER_THREAD_POOL_H
+
+#include <cstddef>
+
+/**
+   @brief Persistent pool of worker threads with work stealing
+
+   Threads are started once by #create_solver_thread_pool and sleep between
+   jobs, so a pool should be created once and reused for many batches.
+ */
+struct solver_thread_pool;
+
+/**
+   @brief Function that runs a single task of a job
+
+   @param [in] context      Pointer passed to #run_solver_thread_pool_tasks
+   @param [in] task_index   Index of the task, from 0 to number of tasks - 1
+   @param [in] worker_index Index of the worker running the task, from 0 to
+                            pool size - 1 (0 is the thread that started the job)
+ */
+typedef void (*pool_task_function)(void* const context, const size_t task_index,
+                                   const size_t worker_index);
+
+/**
+   @brief Create pool of @p number_of_threads workers
+
+   @param [in] number_of_threads Number of threads that work on a job, including
+                                 the one that calls #run_solver_thread_pool_tasks.
+                                 0 means one per hardware thread.
+
+   @return New pool, or NULL if threads couldn't be started.
+ */
+solver_thread_pool* create_solver_thread_pool(const size_t number_of_threads);
+
+/**
+   @brief Stop worker threads and free the pool
+
+   @note Passing NULL is allowed and does nothing.
+ */
+void destroy_solver_thread_pool(solver_thread_pool* const pool);
+
+/**
+   @brief Number of threads working on each job, including the calling one
+ */
+size_t solver_thread_pool_size(const solver_thread_pool* const pool);
+
+/**
+   @brief Pin every worker of @p pool to its own CPU, workers next to each other
+   share a NUMA node
+
+   Allowed CPUs of the process are ordered by node, worker i gets CPU i (or
+   CPU i modulo the number of CPUs in a larger pool). Since every job gives
+   worker i the i-th contiguous share of its tasks, memory that a job first
+   touches lands on the node of the worker that keeps working on it, see
+   init_batch_buffers in batch-buffers.h.
+
+   @note Worker 0 is the thread that starts jobs, so the calling thread is
+   pinned as well. Call this from the thread that will run jobs on the pool,
+   and only once: allowed CPUs are read from the calling thread, so a second
+   call would see just the one it was pinned to.
+
+   @note Nodes come from libnuma, every CPU counts as node 0 when the library
+   was built without it.
+
+   @return 0 on success, -1 if a thread couldn't be pinned or the allowed
+   CPUs couldn't be read.
+ */
+int pin_solver_thread_pool_workers(solver_thread_pool* const pool);
+
+/**
+   @brief Run @p number_of_tasks tasks on the pool and wait for them to finish
+
+   Tasks are split evenly between workers up front. A worker that finishes its
+   share steals half of the remaining tasks of another worker, so uneven tasks
+   still keep every thread busy. The calling thread works as worker 0.
+
+   @param [in] pool            Pool to run tasks on
+   @param [in] number_of_tasks Number of tasks, each task index is run exactly once
+   @param [in] function        Function to run for each task
+   @param [in] context         Pointer passed to every @p function call
+
+   @note Jobs from different threads on the same pool are run one after another.
+   Tasks must not start new jobs on the pool they run on.
+
+   @note @p number_of_tasks must be less than 2^32.
+ */
+void run_solver_thread_pool_tasks(solver_thread_pool* const pool, const size_t number_of_tasks,
+                                  const pool_task_function function, void* const context);
+
+/**
+   @brief Process-wide pool with one thread per hardware thread
+
+   Created on first use and lives until the program exits.
+
+   @return Shared pool, or NULL if it couldn't be created.
+ */
+solver_thread_pool* get_default_solver_thread_pool(void);
+
+#endif // QUADRATIC_EQUATION_SOLVER_THREAD_POOL_H
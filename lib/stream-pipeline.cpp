@@ -0,0 +1,294 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string.h>
+#include <stdio.h>
+#include <new>
+#include <atomic>
+#include <system_error>
+#include <thread>
+
+#include "stream-pipeline.h"
+#include "ring-buffer.h"
+#include "coefficient-text-io.h"
+#include "quadratic-equation-batch.h"
+
+static const size_t INPUT_BUFFER_SIZE  = 1 << 20;
+static const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+struct pipeline_block {
+    uint64_t sequence;
+    size_t count;
+
+    double a[PIPELINE_BLOCK_SIZE];
+    double b[PIPELINE_BLOCK_SIZE];
+    double c[PIPELINE_BLOCK_SIZE];
+
+    solution_status status[PIPELINE_BLOCK_SIZE];
+    int number_of_roots[PIPELINE_BLOCK_SIZE];
+    double root[2][PIPELINE_BLOCK_SIZE];
+    int error_code[PIPELINE_BLOCK_SIZE];
+};
+
+// NULL block pushed into a ring means that its producer has finished
+struct stream_pipeline {
+    FILE* input;
+
+    size_t number_of_solvers;
+    size_t number_of_blocks;
+
+    pipeline_block* blocks;
+
+    spsc_ring<pipeline_block*> free_blocks;    // Writer -> parser
+    spsc_ring<pipeline_block*>* solver_queues; // Parser -> each solver
+    mpsc_ring<pipeline_block*> solved_blocks;  // Solvers -> writer
+
+    // Set by the stage that failed, so the parser stops reading
+    std::atomic<bool> has_failed;
+};
+
+static void parse_input(stream_pipeline* const pipeline) {
+    char* const text = (char*) malloc(INPUT_BUFFER_SIZE);
+    if (text == NULL)
+        pipeline->has_failed.store(true, std::memory_order_relaxed);
+
+    size_t filled = 0;
+    bool is_at_end = false;
+
+    pipeline_block* block = NULL;
+    uint64_t sequence = 0;
+
+    while (!pipeline->has_failed.load(std::memory_order_relaxed) && !(is_at_end && filled == 0)) {
+        if (!is_at_end) {
+            filled += fread(text + filled, 1, INPUT_BUFFER_SIZE - filled, pipeline->input);
+
+            if (ferror(pipeline->input)) {
+                pipeline->has_failed.store(true, std::memory_order_relaxed);
+                break;
+            }
+
+            is_at_end = feof(pipeline->input) != 0;
+        }
+
+        size_t offset = 0;
+        while (true) {
+            // A line that doesn't fit into the whole buffer is cut in two
+            const bool is_last_chunk = is_at_end || (offset == 0 && filled == INPUT_BUFFER_SIZE &&
+                                                     memchr(text, '\n', filled) == NULL);
+
+            // Waits while every block is in flight, this is the backpressure
+            if (block == NULL)
+                pop_spsc_ring(&pipeline->free_blocks, &block);
+
+            size_t consumed = 0;
+            const size_t count =
+                parse_coefficient_lines(text + offset, filled - offset, is_last_chunk,
+                                        block->a, block->b, block->c, PIPELINE_BLOCK_SIZE,
+                                        &consumed);
+            offset += consumed;
+
+            if (count == 0)
+                break;
+
+            block->sequence = sequence;
+            block->count = count;
+
+            push_spsc_ring(pipeline->solver_queues + sequence % pipeline->number_of_solvers, block);
+
+            ++ sequence;
+            block = NULL;
+        }
+
+        // Move unfinished line to the front, next read completes it
+        memmove(text, text + offset, filled - offset);
+        filled -= offset;
+    }
+
+    for (size_t i = 0; i < pipeline->number_of_solvers; ++ i)
+        push_spsc_ring(pipeline->solver_queues + i, (pipeline_block*) NULL);
+
+    free(text);
+}
+
+static void solve_blocks(stream_pipeline* const pipeline, const size_t solver) {
+    while (true) {
+        pipeline_block* block = NULL;
+        pop_spsc_ring(pipeline->solver_queues + solver, &block);
+
+        if (block == NULL)
+            break;
+
+        const equation_solution_columns solutions {
+            block->status, block->number_of_roots,
+            { block->root[0], block->root[1] }, block->error_code
+        };
+
+        solve_quadratic_equation_batch(block->a, block->b, block->c, block->count, &solutions);
+
+        push_mpsc_ring(&pipeline->solved_blocks, block);
+    }
+
+    push_mpsc_ring(&pipeline->solved_blocks, (pipeline_block*) NULL);
+}
+
+static void write_block(const pipeline_block* const block, text_output_sink* const sink) {
+    for (size_t i = 0; i < block->count; ++ i) {
+        char* const line = reserve_text_output_sink(sink, SOLUTION_LINE_MAX_LENGTH);
+
+        const double roots[2] = { block->root[0][i], block->root[1][i] };
+        sink->used += format_solution_line(block->status[i], block->number_of_roots[i],
+                                           roots, block->error_code[i], line);
+    }
+}
+
+// Solvers finish blocks out of order, so the writer keeps them by sequence
+// number until all earlier ones are written. Blocks in flight always have
+// consecutive sequence numbers, so sequence % number_of_blocks never collides.
+static void write_output(stream_pipeline* const pipeline, pipeline_block** const pending,
+                         text_output_sink* const sink) {
+
+    const size_t number_of_blocks = pipeline->number_of_blocks;
+
+    uint64_t next_sequence = 0;
+    size_t finished_solvers = 0;
+
+    while (finished_solvers < pipeline->number_of_solvers) {
+        pipeline_block* block = NULL;
+        pop_mpsc_ring(&pipeline->solved_blocks, &block);
+
+        if (block == NULL) {
+            ++ finished_solvers;
+            continue;
+        }
+
+        pending[block->sequence % number_of_blocks] = block;
+
+        while ((block = pending[next_sequence % number_of_blocks]) != NULL) {
+            pending[next_sequence % number_of_blocks] = NULL;
+
+            // After a failure blocks are only drained, so no stage gets stuck
+            if (!sink->has_failed)
+                write_block(block, sink);
+
+            if (sink->has_failed)
+                pipeline->has_failed.store(true, std::memory_order_relaxed);
+
+            push_spsc_ring(&pipeline->free_blocks, block);
+            ++ next_sequence;
+        }
+    }
+}
+
+static size_t default_number_of_solvers(void) {
+    const size_t number_of_threads = std::thread::hardware_concurrency();
+    return number_of_threads > 3 ? number_of_threads - 2 : 1;
+}
+
+static void destroy_stream_pipeline(stream_pipeline* const pipeline) {
+    if (pipeline->solver_queues != NULL)
+        for (size_t i = 0; i < pipeline->number_of_solvers; ++ i)
+            destroy_spsc_ring(pipeline->solver_queues + i);
+
+    destroy_spsc_ring(&pipeline->free_blocks);
+    destroy_mpsc_ring(&pipeline->solved_blocks);
+
+    delete[] pipeline->solver_queues;
+    delete[] pipeline->blocks;
+}
+
+static int init_stream_pipeline(stream_pipeline* const pipeline, FILE* const input,
+                                const size_t number_of_solvers) {
+
+    pipeline->input = input;
+    pipeline->number_of_solvers = number_of_solvers;
+    pipeline->number_of_blocks = number_of_solvers * PIPELINE_BLOCKS_PER_SOLVER;
+    pipeline->has_failed.store(false, std::memory_order_relaxed);
+
+    pipeline->blocks = new (std::nothrow) pipeline_block[pipeline->number_of_blocks];
+    pipeline->solver_queues = new (std::nothrow) spsc_ring<pipeline_block*>[number_of_solvers] {};
+
+    int result = pipeline->blocks != NULL && pipeline->solver_queues != NULL ? 0 : -1;
+
+    // Every ring fits all blocks and the NULL blocks of its producers, so
+    // only the free ring ever makes anyone wait
+    if (init_spsc_ring(&pipeline->free_blocks, pipeline->number_of_blocks) != 0)
+        result = -1;
+    if (init_mpsc_ring(&pipeline->solved_blocks,
+                       pipeline->number_of_blocks + number_of_solvers) != 0)
+        result = -1;
+
+    for (size_t i = 0; pipeline->solver_queues != NULL && i < number_of_solvers; ++ i)
+        if (init_spsc_ring(pipeline->solver_queues + i, pipeline->number_of_blocks + 1) != 0)
+            result = -1;
+
+    if (result == 0)
+        for (size_t i = 0; i < pipeline->number_of_blocks; ++ i)
+            try_push_spsc_ring(&pipeline->free_blocks, pipeline->blocks + i);
+
+    return result;
+}
+
+int run_stream_pipeline(FILE* const input, FILE* const output, size_t number_of_solvers) {
+    if (number_of_solvers == 0)
+        number_of_solvers = default_number_of_solvers();
+
+    stream_pipeline pipeline {};
+    text_output_sink sink {};
+
+    pipeline_block** const pending =
+        new (std::nothrow) pipeline_block*[number_of_solvers * PIPELINE_BLOCKS_PER_SOLVER] {};
+
+    if (init_stream_pipeline(&pipeline, input, number_of_solvers) != 0 || pending == NULL ||
+        init_text_output_sink(&sink, output, OUTPUT_BUFFER_SIZE) != 0) {
+
+        destroy_stream_pipeline(&pipeline);
+        delete[] pending;
+        free(sink.buffer);
+
+        return -1;
+    }
+
+    std::thread* const solvers = new (std::nothrow) std::thread[number_of_solvers];
+    size_t started_solvers = 0;
+
+    std::thread parser;
+    bool is_parser_started = false;
+
+    if (solvers != NULL) {
+        try {
+            for (; started_solvers < number_of_solvers; ++ started_solvers)
+                solvers[started_solvers] = std::thread(solve_blocks, &pipeline, started_solvers);
+
+            parser = std::thread(parse_input, &pipeline);
+            is_parser_started = true;
+        } catch (const std::system_error&) {
+        }
+    }
+
+    int result = 0;
+
+    if (is_parser_started)
+        write_output(&pipeline, pending, &sink);
+    else {
+        // Stop solvers that did start, nothing was parsed yet
+        for (size_t i = 0; i < started_solvers; ++ i)
+            push_spsc_ring(pipeline.solver_queues + i, (pipeline_block*) NULL);
+
+        result = -1;
+    }
+
+    if (is_parser_started)
+        parser.join();
+
+    for (size_t i = 0; i < started_solvers; ++ i)
+        solvers[i].join();
+
+    if (destroy_text_output_sink(&sink) != 0 || pipeline.has_failed.load())
+        result = -1;
+
+    delete[] solvers;
+    delete[] pending;
+    destroy_stream_pipeline(&pipeline);
+
+    return result;
+}
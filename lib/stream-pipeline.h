@@ -0,0 +1,39 @@
+#ifndef QUADRATIC_EQUATION_SOLVER_STREAM_PIPELINE_H
+#define QUADRATIC_EQUATION_SOLVER_STREAM_PIPELINE_H
+
+#include <cstddef>
+#include <stdio.h>
+
+/**
+   @brief Number of equations parsed, solved and formatted as one block
+ */
+const size_t PIPELINE_BLOCK_SIZE = 4096;
+
+/**
+   @brief Number of blocks in flight per solver thread
+
+   Limits memory use: when all blocks are taken, the parser waits for the
+   writer to return one.
+ */
+const size_t PIPELINE_BLOCKS_PER_SOLVER = 4;
+
+/**
+   @brief Solve every "a b c" line of @p input, write one line per equation
+
+   Same output as parsing, solving and formatting everything in turn, but
+   the three stages run at once. A parser thread fills blocks of
+   coefficients and hands them to solver threads round-robin through SPSC
+   rings. Solvers pass solved blocks to the writer (the calling thread)
+   through one MPSC ring. The writer formats blocks in input order and
+   sends them back to the parser through an SPSC ring.
+
+   @param [in] input             File to read "a b c" lines from, see #parse_coefficient_lines
+   @param [in] output            File to write lines of #format_solution_line to
+   @param [in] number_of_solvers Number of solver threads, 0 means one per hardware
+                                 thread left after the parser and the writer
+
+   @return 0 on success, -1 on read, write, allocation or thread creation failure.
+ */
+int run_stream_pipeline(FILE* const input, FILE* const output, size_t number_of_solvers);
+
+#endif // QUADRATIC_EQUATION_SOLVER_STREAM_PIPELINE_H
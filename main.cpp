@@ -1,7 +1,18 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
 #include <cmath>
+#include <atomic>
 
 #include "quadratic-equation-solver.h"
+#include "solution-description.h"
+#include "solver-stats.h"
+#include "solution-aggregate.h"
+#include "stream-mode.h"
+#include "binary-mode.h"
+#include "aggregate-mode.h"
+#include "solver-server.h"
 
 static void print_introductory_message(void) {
     printf("This is quadratic equation solver!\n"
@@ -22,32 +33,210 @@ static double read_coefficient(const char* coefficient_name) {
 }
 
 static void print_solution_description(equation_solution* solution) {
-    int buffer_size =
-        describe_equation_solution(solution, 0, NULL);
+    // Description length is bounded, so one pass into
+    // a fixed-size buffer is enough
+    char description[EQUATION_DESCRIPTION_MAX_LENGTH + 1];
 
-    if (buffer_size < 0) {
-        printf("Error due non C99-compatible standart or "
-               "equation_solution corruption.");
+    if (describe_equation_solution_fast(solution, description) < 0) {
+        printf("Error due equation_solution corruption.");
         return;
     }
 
-    // For null-terminator '\0'
-    buffer_size += 1;
+    printf("%s", description);
+}
 
-    // VLA's are not advised but in this case i know
-    // that description string will not be very long.
+static void print_usage(const char* program_name) {
+    fprintf(stderr,
+            "Usage: %s [--stats]                  solve one equation interactively\n"
+            "       %s [--stats] --stream [file]  solve every \"a b c\" line of file or stdin\n"
+            "       %s [--stats] --binary <coefficients> <solutions>\n"
+            "                                     solve binary coefficient file into solution file\n"
+            "       %s [--stats] --aggregate <coefficients> [<first> <last> <bins>]\n"
+            "                                     print root counts, statistics and histogram\n"
+            "                                     of binary coefficient file, default histogram\n"
+            "                                     is 20 bins over [-100, 100]\n"
+            "       %s [--stats] --serve <socket> [--tcp <port>]\n"
+            "                                     answer requests on Unix socket (and localhost port)\n"
+            "\n"
+            "--stats prints solver branch counters and latency histograms to stderr on exit\n",
+            program_name, program_name, program_name, program_name, program_name);
+}
 
-    // And I also want to show this cool behavior of
-    // of describe_equation_solution that allows you
-    // to get size of buffer before creating it.
-    char description[buffer_size];
+static int run_stream_mode_from_arguments(int argc, char* argv[]) {
+    if (argc > 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
 
-    describe_equation_solution(solution, buffer_size, description);
-    
-    printf("%s", description);
+    FILE* input = stdin;
+    if (argc == 3) {
+        input = fopen(argv[2], "r");
+
+        if (input == NULL) {
+            fprintf(stderr, "Can't open \"%s\"\n", argv[2]);
+            return 1;
+        }
+    }
+
+    int result = run_stream_mode(input, stdout);
+
+    if (input != stdin)
+        fclose(input);
+
+    if (result != 0) {
+        fprintf(stderr, "Stream mode failed due to I/O or memory error\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static int run_binary_mode_from_arguments(int argc, char* argv[]) {
+    if (argc != 4) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    int error = run_binary_mode(argv[2], argv[3]);
+    if (error != 0) {
+        fprintf(stderr, "Binary mode failed with error %d\n", error);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int run_aggregate_mode_from_arguments(int argc, char* argv[]) {
+    if (argc != 3 && argc != 6) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    double first = -100.0, last = 100.0;
+    unsigned long bins = 20;
+
+    if (argc == 6) {
+        char* first_end = NULL;
+        char* last_end = NULL;
+        char* bins_end = NULL;
+
+        first = strtod(argv[3], &first_end);
+        last = strtod(argv[4], &last_end);
+        bins = strtoul(argv[5], &bins_end, 10);
+
+        if (*first_end != '\0' || *last_end != '\0' || *bins_end != '\0') {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Checked before the file is opened, so its errors can't be mistaken for this one
+    solution_aggregate aggregate;
+    if (init_solution_aggregate(&aggregate, first, last, (size_t) bins) != 0) {
+        fprintf(stderr, "Histogram needs finite first < last and 1 to %zu bins\n",
+                AGGREGATE_HISTOGRAM_MAX_BINS);
+        return 1;
+    }
+
+    int error = run_aggregate_mode(argv[2], &aggregate, stdout);
+    if (error != 0) {
+        fprintf(stderr, "Aggregate mode failed with error %d\n", error);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Read by signal handlers, which may come before the server is set or after it's gone
+static std::atomic<solver_server*> running_server { NULL };
+
+static_assert(std::atomic<solver_server*>::is_always_lock_free,
+              "Signal handlers may only use lock-free atomics");
+
+static void stop_running_server(int) {
+    solver_server* const server = running_server.load();
+    if (server != NULL)
+        stop_solver_server(server);
+}
+
+static int run_server_mode_from_arguments(int argc, char* argv[]) {
+    solver_server_config config { NULL, false, 0 };
+
+    if (argc == 3)
+        config.socket_path = argv[2];
+    else if (argc == 5 && strcmp(argv[3], "--tcp") == 0) {
+        char* end = NULL;
+        const unsigned long port = strtoul(argv[4], &end, 10);
+
+        if (*end != '\0' || port > 65535) {
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        config = { argv[2], true, (uint16_t) port };
+    } else {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    solver_server* const server = create_solver_server(&config);
+    if (server == NULL) {
+        fprintf(stderr, "Can't listen on \"%s\"%s\n", argv[2],
+                config.use_tcp ? " or the TCP port" : "");
+        return 1;
+    }
+
+    running_server.store(server);
+    signal(SIGINT, stop_running_server);
+    signal(SIGTERM, stop_running_server);
+
+    const int result = run_solver_server(server);
+
+    // No handler may reach the server once it's destroyed
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    running_server.store(NULL);
+
+    destroy_solver_server(server);
+
+    if (result != 0) {
+        fprintf(stderr, "Server event loop failed\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static void print_stats_on_exit(void) {
+    if (!solver_stats_enabled()) {
+        fprintf(stderr, "Statistics are disabled, rebuild with -DEQUATION_SOLVER_STATS=ON\n");
+        return;
+    }
+
+    solver_stats_snapshot snapshot;
+    take_solver_stats_snapshot(&snapshot);
+
+    print_solver_stats(stderr, &snapshot);
 }
 
-int main(void) {
+static int run_mode(int argc, char* argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "--stream") == 0)
+        return run_stream_mode_from_arguments(argc, argv);
+
+    if (argc >= 2 && strcmp(argv[1], "--binary") == 0)
+        return run_binary_mode_from_arguments(argc, argv);
+
+    if (argc >= 2 && strcmp(argv[1], "--aggregate") == 0)
+        return run_aggregate_mode_from_arguments(argc, argv);
+
+    if (argc >= 2 && strcmp(argv[1], "--serve") == 0)
+        return run_server_mode_from_arguments(argc, argv);
+
+    if (argc >= 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
     print_introductory_message();
 
     double a = read_coefficient("a");
@@ -62,4 +251,19 @@ int main(void) {
     }
 
     print_solution_description(&solution);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "--stats") == 0) {
+        // Drop the flag, so modes see the same arguments as without it
+        argv[1] = argv[0];
+
+        const int result = run_mode(argc - 1, argv + 1);
+        print_stats_on_exit();
+
+        return result;
+    }
+
+    return run_mode(argc, argv);
 }
@@ -0,0 +1,304 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "async-solver.h"
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <thread>
+
+#define ASYNC_TEST_SIZE 12000
+#define ASYNC_TEST_THREADS 4
+
+static double a[ASYNC_TEST_SIZE], b[ASYNC_TEST_SIZE], c[ASYNC_TEST_SIZE];
+static test_solution_columns<ASYNC_TEST_SIZE> expected;
+static size_t expected_failed[ASYNC_TEST_SIZE + 1]; // Illegal equations before index i
+
+static void fill_equations(void) {
+    fill_periodic_coefficients(a, b, c, ASYNC_TEST_SIZE);
+
+    equation_solution_columns columns = expected.columns();
+    solve_quadratic_equation_batch(a, b, c, ASYNC_TEST_SIZE, &columns);
+
+    for (size_t i = 0; i < ASYNC_TEST_SIZE; ++ i)
+        expected_failed[i + 1] = expected_failed[i] + (expected.error_code[i] != 0);
+}
+
+// Submission i covers equations first[i] to first[i + 1]
+struct test_submissions {
+    size_t first[64];
+    size_t count;
+};
+
+// Empty, small, gathered and solved in place submissions
+static test_submissions split_equations(void) {
+    const size_t sizes[] = { 1, 0, 7, 64, 3, ASYNC_GATHER_LIMIT + 1, 250, 0, 1000 };
+
+    test_submissions submissions {};
+    for (size_t size : sizes) {
+        submissions.first[submissions.count + 1] = submissions.first[submissions.count] + size;
+        ++ submissions.count;
+    }
+
+    return submissions;
+}
+
+TEST(submissions_match_batch_solver) {
+    fill_equations();
+    static test_solution_columns<ASYNC_TEST_SIZE> actual;
+
+    async_solver* const solver = create_async_solver(16, NULL);
+    async_completion_queue* const queue = create_async_completion_queue(16);
+    ASSERT_EQUAL((solver != NULL && queue != NULL), true);
+
+    const test_submissions submissions = split_equations();
+
+    async_ticket tickets[64] = {};
+    for (size_t i = 0; i < submissions.count; ++ i) {
+        const size_t first = submissions.first[i];
+        const equation_solution_columns columns = actual.columns(first);
+
+        tickets[i] = submit_async_quadratic_equation_batch(
+            solver, queue, a + first, b + first, c + first,
+            submissions.first[i + 1] - first, &columns, (void*) i);
+
+        ASSERT_EQUAL((tickets[i] != 0), true);
+    }
+
+    for (size_t done = 0; done < submissions.count;) {
+        async_completion completions[4];
+        const size_t count = wait_async_completions(queue, completions, 4);
+        ASSERT_EQUAL((count > 0), true);
+
+        for (size_t j = 0; j < count; ++ j) {
+            const size_t i = (size_t) completions[j].user_data;
+            const size_t first = submissions.first[i], last = submissions.first[i + 1];
+
+            ASSERT_EQUAL((completions[j].ticket == tickets[i]), true);
+            ASSERT_EQUAL((completions[j].failed == expected_failed[last] - expected_failed[first]),
+                         true);
+            ASSERT_EQUAL(have_same_solutions(&actual, first, &expected, first, last - first),
+                         true);
+        }
+
+        done += count;
+    }
+
+    async_completion completion;
+    ASSERT_EQUAL((poll_async_completions(queue, &completion, 1) == 0), true);
+
+    destroy_async_solver(solver);
+    destroy_async_completion_queue(queue);
+}
+
+// Blocks of a thread of many_threads_share_one_solver start at multiples of this
+#define ASYNC_TEST_BLOCK 50
+
+// Wait for completions of blocks, check them
+static size_t drain_blocks(async_completion_queue* const queue,
+                           const test_solution_columns<ASYNC_TEST_SIZE>* const actual,
+                           bool* const is_ok) {
+    async_completion completions[8];
+    const size_t drained = wait_async_completions(queue, completions, 8);
+
+    for (size_t j = 0; j < drained; ++ j) {
+        const size_t first = (size_t) completions[j].user_data;
+        const size_t left = ASYNC_TEST_SIZE - first;
+
+        *is_ok = *is_ok && have_same_solutions(actual, first, &expected, first,
+                                               left < ASYNC_TEST_BLOCK ? left : ASYNC_TEST_BLOCK);
+    }
+
+    *is_ok = *is_ok && drained > 0;
+    return drained;
+}
+
+TEST(many_threads_share_one_solver) {
+    fill_equations();
+    static test_solution_columns<ASYNC_TEST_SIZE> actual;
+
+    // Room for everything the queues of all threads can hold, so a refused
+    // submission always means that the thread's own queue is full
+    async_solver* const solver = create_async_solver(ASYNC_TEST_THREADS * 8, NULL);
+    ASSERT_EQUAL((solver != NULL), true);
+
+    bool is_correct[ASYNC_TEST_THREADS] = {};
+
+    std::thread threads[ASYNC_TEST_THREADS];
+    for (size_t index = 0; index < ASYNC_TEST_THREADS; ++ index)
+        threads[index] = std::thread([&, index] {
+            async_completion_queue* const queue = create_async_completion_queue(8);
+            bool is_ok = queue != NULL;
+            size_t submitted = 0, completed = 0;
+
+            // Every ASYNC_TEST_THREADS-th block, drain when the queue is full
+            size_t first = index * ASYNC_TEST_BLOCK;
+            while (is_ok && first < ASYNC_TEST_SIZE) {
+                const size_t left = ASYNC_TEST_SIZE - first;
+                const equation_solution_columns columns = actual.columns(first);
+
+                if (submit_async_quadratic_equation_batch(
+                        solver, queue, a + first, b + first, c + first,
+                        left < ASYNC_TEST_BLOCK ? left : ASYNC_TEST_BLOCK,
+                        &columns, (void*) first) == 0) {
+                    completed += drain_blocks(queue, &actual, &is_ok);
+                    continue;
+                }
+
+                ++ submitted;
+                first += ASYNC_TEST_THREADS * ASYNC_TEST_BLOCK;
+            }
+
+            while (is_ok && completed < submitted)
+                completed += drain_blocks(queue, &actual, &is_ok);
+
+            is_correct[index] = is_ok;
+            destroy_async_completion_queue(queue);
+        });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    destroy_async_solver(solver);
+
+    for (size_t index = 0; index < ASYNC_TEST_THREADS; ++ index)
+        ASSERT_EQUAL(is_correct[index], true);
+}
+
+TEST(completion_wakes_epoll_loop) {
+    fill_equations();
+    static test_solution_columns<ASYNC_TEST_SIZE> actual;
+
+    async_solver* const solver = create_async_solver(4, NULL);
+    async_completion_queue* const queue = create_async_completion_queue(4);
+    ASSERT_EQUAL((solver != NULL && queue != NULL), true);
+
+    const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.ptr = queue;
+
+    ASSERT_EQUAL(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, async_completion_queue_fd(queue), &event), 0);
+
+    const equation_solution_columns columns = actual.columns();
+    const async_ticket ticket = submit_async_quadratic_equation_batch(solver, queue, a, b, c,
+                                                                      100, &columns, NULL);
+    ASSERT_EQUAL((ticket != 0), true);
+
+    // Wakeups may come with nothing to drain, the loop polls until the completion shows up
+    async_completion completion {};
+    size_t count = 0;
+
+    for (int round = 0; count == 0 && round < 1000; ++ round) {
+        epoll_event ready {};
+        if (epoll_wait(epoll_fd, &ready, 1, 1000) == 1 && ready.data.ptr == queue)
+            count = poll_async_completions(queue, &completion, 1);
+    }
+
+    ASSERT_EQUAL((count == 1 && completion.ticket == ticket), true);
+    ASSERT_EQUAL(have_same_solutions(&actual, 0, &expected, 0, 100), true);
+
+    close(epoll_fd);
+    destroy_async_solver(solver);
+    destroy_async_completion_queue(queue);
+}
+
+TEST(full_queue_refuses_submission) {
+    fill_equations();
+    static test_solution_columns<ASYNC_TEST_SIZE> actual;
+
+    async_solver* const solver = create_async_solver(8, NULL);
+    async_completion_queue* const queue = create_async_completion_queue(2);
+    ASSERT_EQUAL((solver != NULL && queue != NULL), true);
+
+    const equation_solution_columns columns = actual.columns();
+
+    for (int i = 0; i < 2; ++ i) {
+        const async_ticket ticket =
+            submit_async_quadratic_equation_batch(solver, queue, a, b, c, 10, &columns, NULL);
+        ASSERT_EQUAL((ticket != 0), true);
+    }
+
+    // Both slots stay taken until completions are drained
+    const async_ticket refused =
+        submit_async_quadratic_equation_batch(solver, queue, a, b, c, 10, &columns, NULL);
+    ASSERT_EQUAL((refused == 0), true);
+
+    async_completion completions[2];
+    for (size_t done = 0; done < 2;)
+        done += wait_async_completions(queue, completions + done, 2 - done);
+
+    const async_ticket accepted =
+        submit_async_quadratic_equation_batch(solver, queue, a, b, c, 10, &columns, NULL);
+    ASSERT_EQUAL((accepted != 0), true);
+
+    ASSERT_EQUAL((wait_async_completions(queue, completions, 1) == 1), true);
+
+    destroy_async_solver(solver);
+    destroy_async_completion_queue(queue);
+}
+
+#ifdef EQUATION_SOLVER_HAS_COROUTINES
+
+// Coroutine that starts right away and is never awaited itself
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {}
+    };
+};
+
+struct awaiting_test_state {
+    async_solver* solver;
+    async_completion_queue* queue;
+    test_solution_columns<ASYNC_TEST_SIZE>* actual;
+
+    size_t failed;
+    bool is_done;
+};
+
+// Awaits two halves of the equations one after another
+static detached_task solve_in_halves(awaiting_test_state* const state) {
+    const size_t half = ASYNC_TEST_SIZE / 2;
+
+    for (size_t first = 0; first < ASYNC_TEST_SIZE; first += half) {
+        const equation_solution_columns columns = state->actual->columns(first);
+
+        const async_completion completion = co_await async_quadratic_equation_batch(
+            state->solver, state->queue, a + first, b + first, c + first, half, &columns);
+
+        state->failed += completion.failed;
+    }
+
+    state->is_done = true;
+}
+
+TEST(awaited_submissions_resume_in_order) {
+    fill_equations();
+    static test_solution_columns<ASYNC_TEST_SIZE> actual;
+
+    awaiting_test_state awaiting { create_async_solver(4, NULL), create_async_completion_queue(4),
+                                &actual, 0, false };
+    ASSERT_EQUAL((awaiting.solver != NULL && awaiting.queue != NULL), true);
+
+    solve_in_halves(&awaiting);
+
+    pollfd readable { async_completion_queue_fd(awaiting.queue), POLLIN, 0 };
+    for (int round = 0; !awaiting.is_done && round < 1000; ++ round)
+        if (poll(&readable, 1, 1000) == 1)
+            resume_async_awaiters(awaiting.queue);
+
+    ASSERT_EQUAL(awaiting.is_done, true);
+    ASSERT_EQUAL((awaiting.failed == expected_failed[ASYNC_TEST_SIZE]), true);
+    ASSERT_EQUAL(have_same_solutions(&actual, 0, &expected, 0, ASYNC_TEST_SIZE), true);
+
+    destroy_async_solver(awaiting.solver);
+    destroy_async_completion_queue(awaiting.queue);
+}
+
+#endif
+
+TEST_MAIN()
@@ -0,0 +1,108 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "batch-buffers.h"
+
+#include <cstdint>
+#include <cmath>
+
+// Not a multiple of the chunk size, so the last chunk is partial
+#define BUFFERS_TEST_SIZE (PARALLEL_BATCH_CHUNK_SIZE * 5 + 77)
+
+static double a[BUFFERS_TEST_SIZE], b[BUFFERS_TEST_SIZE], c[BUFFERS_TEST_SIZE];
+static test_solution_columns<BUFFERS_TEST_SIZE> expected;
+
+static void fill_equations(void) {
+    fill_periodic_coefficients(a, b, c, BUFFERS_TEST_SIZE);
+
+    equation_solution_columns columns = expected.columns();
+    solve_quadratic_equation_batch(a, b, c, BUFFERS_TEST_SIZE, &columns);
+}
+
+TEST(columns_are_zeroed_and_page_aligned) {
+    for (size_t mode = 0; mode < NUMBER_OF_BUFFER_PAGE_MODES; ++ mode) {
+        batch_buffers buffers {};
+        const int result = init_batch_buffers(&buffers, BUFFERS_TEST_SIZE,
+                                              (buffer_page_mode) mode, NULL);
+
+        // Explicit huge pages are only there when reserved by the administrator
+        if (result != 0 && mode == EXPLICIT_HUGE_PAGES)
+            continue;
+
+        ASSERT_EQUAL(result, 0);
+
+        const size_t page_size = buffer_page_size((buffer_page_mode) mode);
+
+        const void* const columns[] = {
+            buffers.a, buffers.b, buffers.c, buffers.solutions.status,
+            buffers.solutions.number_of_roots, buffers.solutions.root[0],
+            buffers.solutions.root[1], buffers.solutions.error_code
+        };
+
+        for (const void* column : columns)
+            ASSERT_EQUAL(((uintptr_t) column % page_size == 0), true);
+
+        bool is_zero = true;
+        for (size_t i = 0; i < BUFFERS_TEST_SIZE; ++ i)
+            is_zero = is_zero && buffers.a[i] == 0.0 && buffers.c[i] == 0.0 &&
+                buffers.solutions.error_code[i] == 0 && buffers.solutions.root[1][i] == 0.0;
+
+        ASSERT_EQUAL(is_zero, true);
+        destroy_batch_buffers(&buffers);
+    }
+}
+
+TEST(solving_in_buffers_matches_heap_columns) {
+    fill_equations();
+
+    solver_thread_pool* pool = create_solver_thread_pool(3);
+    ASSERT_EQUAL((pool != NULL), true);
+
+    for (size_t mode = 0; mode < NUMBER_OF_BUFFER_PAGE_MODES; ++ mode) {
+        batch_buffers buffers {};
+        const int result = init_batch_buffers(&buffers, BUFFERS_TEST_SIZE,
+                                              (buffer_page_mode) mode, pool);
+
+        // Explicit huge pages are only there when reserved by the administrator
+        if (result != 0 && mode == EXPLICIT_HUGE_PAGES)
+            continue;
+
+        ASSERT_EQUAL(result, 0);
+
+        memcpy(buffers.a, a, sizeof(a));
+        memcpy(buffers.b, b, sizeof(b));
+        memcpy(buffers.c, c, sizeof(c));
+
+        solve_quadratic_equation_batch_parallel(pool, buffers.a, buffers.b, buffers.c,
+                                                buffers.count, &buffers.solutions);
+
+        bool is_same = true;
+        for (size_t i = 0; i < BUFFERS_TEST_SIZE; ++ i)
+            is_same = is_same &&
+                buffers.solutions.status[i] == expected.status[i] &&
+                buffers.solutions.number_of_roots[i] == expected.number_of_roots[i] &&
+                buffers.solutions.error_code[i] == expected.error_code[i] &&
+                is_same_double(buffers.solutions.root[0][i], expected.first_root[i]) &&
+                is_same_double(buffers.solutions.root[1][i], expected.second_root[i]);
+
+        ASSERT_EQUAL(is_same, true);
+        destroy_batch_buffers(&buffers);
+    }
+
+    destroy_solver_thread_pool(pool);
+}
+
+TEST(empty_buffers_map_nothing) {
+    batch_buffers buffers {};
+    ASSERT_EQUAL(init_batch_buffers(&buffers, 0, TRANSPARENT_HUGE_PAGES, NULL), 0);
+    ASSERT_EQUAL((buffers.mapping == NULL && buffers.a == NULL), true);
+
+    destroy_batch_buffers(&buffers);
+}
+
+TEST(mode_names) {
+    ASSERT_EQUAL(strcmp(buffer_page_mode_name(SMALL_PAGES), "small_pages"), 0);
+    ASSERT_EQUAL(strcmp(buffer_page_mode_name(EXPLICIT_HUGE_PAGES), "explicit_huge_pages"), 0);
+    ASSERT_EQUAL((buffer_page_mode_name(NUMBER_OF_BUFFER_PAGE_MODES) == NULL), true);
+}
+
+TEST_MAIN()
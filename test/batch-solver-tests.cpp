@@ -0,0 +1,156 @@
+#include "test-framework.h"
+#include "quadratic-equation-batch.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+#include <cstring>
+
+#define BATCH_CAPACITY 16
+
+// Declares columns named `solutions` with room for BATCH_CAPACITY equations
+#define DECLARE_SOLUTION_COLUMNS()                                                         \
+    solution_status status[BATCH_CAPACITY];                                                \
+    int number_of_roots[BATCH_CAPACITY];                                                   \
+    double first_root[BATCH_CAPACITY], second_root[BATCH_CAPACITY];                        \
+    int error_code[BATCH_CAPACITY];                                                        \
+                                                                                           \
+    equation_solution_columns solutions {                                                  \
+        status, number_of_roots, { first_root, second_root }, error_code                   \
+    }
+
+#define BATCH_ASSERT_MATCHES_SINGLE_SOLVER(a, b, c, count)                                 \
+    do {                                                                                   \
+        DECLARE_SOLUTION_COLUMNS();                                                        \
+        solve_quadratic_equation_batch((a), (b), (c), (count), &solutions);                \
+                                                                                           \
+        for (size_t i = 0; i < (count); ++ i) {                                            \
+            equation_solution solution { FINITE_ROOTS, 0, { 0.0, 0.0 } };                  \
+            int expected_error = solve_quadratic_equation(a[i], b[i], c[i], &solution);    \
+                                                                                           \
+            ASSERT_EQUAL(error_code[i], expected_error);                                   \
+            ASSERT_EQUAL(status[i], solution.status);                                      \
+            ASSERT_EQUAL(number_of_roots[i], solution.number_of_roots);                    \
+            ASSERT_EPSILON_EQUAL(first_root[i], solution.root[0]);                         \
+            ASSERT_EPSILON_EQUAL(second_root[i], solution.root[1]);                        \
+        }                                                                                  \
+    } while(false)
+
+
+TEST(batch_matches_single_equation_solver) {
+    const double a[] = { -5.0,  -7.0, 4.0,  9.0,  0.0, 0.0, 0.0, 1.0, 2.0 };
+    const double b[] = {  5.0,  10.0, 4.0, -7.0, 10.0, 0.0, 0.0, 2.0, 0.0 };
+    const double c[] = {  5.0,  -3.0, 1.0, 16.0, -3.0, 0.0, 3.0, 1.0, -8.0 };
+
+    BATCH_ASSERT_MATCHES_SINGLE_SOLVER(a, b, c, sizeof(a) / sizeof(*a));
+}
+
+TEST(batch_reports_illegal_coefficients) {
+    const double a[] = { NAN,      1.0, 1.0,      INFINITY, 1.0 };
+    const double b[] = { 1.0,      NAN, 1.0,      NAN,      3.0 };
+    const double c[] = { INFINITY, 1.0, INFINITY, 1.0,      2.0 };
+
+    DECLARE_SOLUTION_COLUMNS();
+    size_t failed = solve_quadratic_equation_batch(a, b, c, 5, &solutions);
+
+    ASSERT_EQUAL((int) failed, 4);
+
+    ASSERT_EQUAL(error_code[0], 1);
+    ASSERT_EQUAL(error_code[1], 2);
+    ASSERT_EQUAL(error_code[2], 3);
+    ASSERT_EQUAL(error_code[3], 1);
+    ASSERT_EQUAL(error_code[4], 0);
+
+    ASSERT_EQUAL(number_of_roots[0], 0);
+    ASSERT_EPSILON_EQUAL(first_root[0], 0.0);
+
+    ASSERT_EQUAL(number_of_roots[4], 2);
+    ASSERT_EPSILON_EQUAL(first_root[4], -1.0);
+    ASSERT_EPSILON_EQUAL(second_root[4], -2.0);
+}
+
+TEST(batch_with_near_zero_discriminants) {
+    const double a[] = { 1.0, 1.0,    1.0,     1e-10, 1e-8 };
+    const double b[] = { 2.0, 2.0,    2.0,     1.0,   1e-10 };
+    const double c[] = { 1.0, 1.0001, 0.9999, -1.0,   0.0 };
+
+    BATCH_ASSERT_MATCHES_SINGLE_SOLVER(a, b, c, sizeof(a) / sizeof(*a));
+}
+
+TEST(polishing_never_increases_residual) {
+    // Close roots, roots of very different size and ones that aren't real numbers
+    const double a[] = { 1.0,   1e-3,  3.0,       1.0,  1.0, 0.0,  1.0, 1e300 };
+    const double b[] = { -2.0,  1e5,  -1e-3,      2.0,  1.0, 4.0,  0.0, 1e300 };
+    const double c[] = { 0.999, 1e-3, -1e-7,      1.0,  5.0, 2.0, -2.0, 1e300 };
+
+    const size_t count = sizeof(a) / sizeof(*a);
+
+    DECLARE_SOLUTION_COLUMNS();
+    solve_quadratic_equation_batch(a, b, c, count, &solutions);
+
+    double residual[2][BATCH_CAPACITY];
+    for (size_t i = 0; i < count; ++ i)
+        for (int j = 0; j < 2; ++ j)
+            residual[j][i] = std::fabs((a[i] * solutions.root[j][i] + b[i]) *
+                                       solutions.root[j][i] + c[i]);
+
+    const int roots_before[] = { number_of_roots[3], number_of_roots[5] };
+    const double first_before[] = { first_root[3], first_root[5] };
+
+    polish_quadratic_equation_roots_batch(a, b, c, count, &solutions,
+                                          EQUATION_SOLVER_POLISH_ITERATIONS);
+
+    for (size_t i = 0; i < count; ++ i) {
+        if (number_of_roots[i] != 2)
+            continue;
+
+        for (int j = 0; j < 2; ++ j) {
+            const double polished = std::fabs((a[i] * solutions.root[j][i] + b[i]) *
+                                              solutions.root[j][i] + c[i]);
+
+            // NaN roots stay NaN
+            ASSERT_EQUAL((polished <= residual[j][i] || std::isnan(residual[j][i])), true);
+        }
+    }
+
+    // Single and linear roots are left alone
+    ASSERT_EQUAL(number_of_roots[3], roots_before[0]);
+    ASSERT_EQUAL(memcmp(&first_root[3], &first_before[0], sizeof(double)), 0);
+    ASSERT_EQUAL(number_of_roots[5], roots_before[1]);
+    ASSERT_EQUAL(memcmp(&first_root[5], &first_before[1], sizeof(double)), 0);
+}
+
+TEST(polishing_matches_single_on_every_tier) {
+    double a[BATCH_CAPACITY], b[BATCH_CAPACITY], c[BATCH_CAPACITY];
+
+    // Ill-conditioned equations whose roots move when polished
+    for (size_t i = 0; i < BATCH_CAPACITY; ++ i) {
+        a[i] = 1.0 + (double) i * 0.37;
+        b[i] = i % 2 == 0 ? -2.0 * a[i] : 1e5 + (double) i;
+        c[i] = i % 2 == 0 ? a[i] * (1.0 - 1e-6 * (double) (i + 1)) : 1e-3 * (double) i;
+    }
+
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    for (int tier = SCALAR_KERNEL; tier <= AVX512_KERNEL; ++ tier) {
+        if (force_kernel_tier((kernel_tier) tier) != 0)
+            continue;
+
+        DECLARE_SOLUTION_COLUMNS();
+        solve_quadratic_equation_batch(a, b, c, BATCH_CAPACITY - 1, &solutions);
+        polish_quadratic_equation_roots_batch(a, b, c, BATCH_CAPACITY - 1, &solutions, 3);
+
+        for (size_t i = 0; i < BATCH_CAPACITY - 1; ++ i) {
+            equation_solution solution { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+            solve_quadratic_equation(a[i], b[i], c[i], &solution);
+            polish_quadratic_equation_roots(a[i], b[i], c[i], &solution, 3);
+
+            ASSERT_EQUAL(number_of_roots[i], solution.number_of_roots);
+            ASSERT_EQUAL(memcmp(&first_root[i], &solution.root[0], sizeof(double)), 0);
+            ASSERT_EQUAL(memcmp(&second_root[i], &solution.root[1], sizeof(double)), 0);
+        }
+    }
+
+    force_kernel_tier(active_tier);
+}
+
+TEST_MAIN()
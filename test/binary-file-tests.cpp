@@ -0,0 +1,113 @@
+#include "test-framework.h"
+#include "binary-equation-files.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define BINARY_TEST_SIZE 5
+
+static const double a[BINARY_TEST_SIZE] = { 1.0, 0.0, 0.0, 1.0, NAN };
+static const double b[BINARY_TEST_SIZE] = { 3.0, 2.0, 0.0, 0.0, 1.0 };
+static const double c[BINARY_TEST_SIZE] = { 2.0, 1.0, 0.0, 1.0, 1.0 };
+
+// Unique path for a temporary file, removed by the test that made it
+static void make_temporary_path(char* const path, const char* const name) {
+    snprintf(path, 256, "/tmp/equation-solver-%s-%d.bin", name, (int) getpid());
+}
+
+TEST(coefficient_file_round_trip) {
+    char path[256];
+    make_temporary_path(path, "coefficients");
+
+    ASSERT_EQUAL(write_coefficient_file(path, a, b, c, BINARY_TEST_SIZE), 0);
+
+    coefficient_file_view view {};
+    ASSERT_EQUAL(open_coefficient_file(path, &view), 0);
+    ASSERT_EQUAL((int) view.count, BINARY_TEST_SIZE);
+    ASSERT_EQUAL((int) view.mapping_size, (int) coefficient_file_size(BINARY_TEST_SIZE));
+
+    for (size_t i = 0; i < BINARY_TEST_SIZE - 1; ++ i) {
+        ASSERT_EPSILON_EQUAL(view.a[i], a[i]);
+        ASSERT_EPSILON_EQUAL(view.b[i], b[i]);
+        ASSERT_EPSILON_EQUAL(view.c[i], c[i]);
+    }
+
+    ASSERT_EQUAL(std::isnan(view.a[BINARY_TEST_SIZE - 1]), true);
+
+    close_coefficient_file(&view);
+    remove(path);
+}
+
+TEST(solutions_written_through_mapping_reach_file) {
+    char path[256];
+    make_temporary_path(path, "solutions");
+
+    solution_file_view output {};
+    ASSERT_EQUAL(create_solution_file(path, BINARY_TEST_SIZE, &output), 0);
+
+    const size_t failed = solve_quadratic_equation_batch(a, b, c, BINARY_TEST_SIZE,
+                                                         &output.columns);
+    ASSERT_EQUAL((int) failed, 1);
+    ASSERT_EQUAL(close_solution_file(&output), 0);
+
+    solution_file_view input {};
+    ASSERT_EQUAL(open_solution_file(path, &input), 0);
+    ASSERT_EQUAL((int) input.count, BINARY_TEST_SIZE);
+
+    ASSERT_EQUAL(input.columns.number_of_roots[0], 2);
+    ASSERT_EPSILON_EQUAL(input.columns.root[0][0], -1.0);
+    ASSERT_EPSILON_EQUAL(input.columns.root[1][0], -2.0);
+
+    ASSERT_EQUAL(input.columns.number_of_roots[1], 1);
+    ASSERT_EPSILON_EQUAL(input.columns.root[0][1], -0.5);
+
+    ASSERT_EQUAL(input.columns.status[2], INF_ROOTS);
+    ASSERT_EQUAL(input.columns.number_of_roots[3], 0);
+    ASSERT_EQUAL(input.columns.error_code[4], 1);
+
+    ASSERT_EQUAL(close_solution_file(&input), 0);
+    remove(path);
+}
+
+TEST(wrong_file_kind_and_truncation_are_detected) {
+    char path[256];
+    make_temporary_path(path, "broken");
+
+    ASSERT_EQUAL(write_coefficient_file(path, a, b, c, BINARY_TEST_SIZE), 0);
+
+    solution_file_view solutions {};
+    ASSERT_EQUAL(open_solution_file(path, &solutions), BINARY_FILE_BAD_HEADER);
+
+    ASSERT_EQUAL(truncate(path, (off_t) coefficient_file_size(BINARY_TEST_SIZE) - 1), 0);
+
+    coefficient_file_view coefficients {};
+    ASSERT_EQUAL(open_coefficient_file(path, &coefficients), BINARY_FILE_TRUNCATED);
+
+    remove(path);
+    ASSERT_EQUAL(open_coefficient_file(path, &coefficients), BINARY_FILE_IO_ERROR);
+}
+
+TEST(huge_count_in_header_is_truncation) {
+    char path[256];
+    make_temporary_path(path, "huge-count");
+
+    ASSERT_EQUAL(write_coefficient_file(path, a, b, c, BINARY_TEST_SIZE), 0);
+
+    // 3 * 8 * 2^61 wraps to 0, so the size computed from this count matches the file
+    const uint64_t count = ((uint64_t) 1 << 61) + BINARY_TEST_SIZE;
+
+    const int file = open(path, O_WRONLY);
+    ASSERT_EQUAL((file >= 0), true);
+    ASSERT_EQUAL((pwrite(file, &count, sizeof(count), offsetof(binary_file_header, count)) ==
+                  (ssize_t) sizeof(count)), true);
+    close(file);
+
+    coefficient_file_view coefficients {};
+    ASSERT_EQUAL(open_coefficient_file(path, &coefficients), BINARY_FILE_TRUNCATED);
+
+    remove(path);
+}
+
+TEST_MAIN()
@@ -0,0 +1,151 @@
+#include "test-framework.h"
+#include "quadratic-equation-solver.h"
+#include "quadratic-equation-complex.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+#include <cstdint>
+
+#define COMPLEX_TEST_SIZE 2003
+
+struct complex_test_columns {
+    solution_status status[COMPLEX_TEST_SIZE];
+    int number_of_roots[COMPLEX_TEST_SIZE];
+    double real[2][COMPLEX_TEST_SIZE], imaginary[2][COMPLEX_TEST_SIZE];
+    int error_code[COMPLEX_TEST_SIZE];
+
+    complex_equation_solution_columns columns() {
+        return { status, number_of_roots, { real[0], real[1] },
+                 { imaginary[0], imaginary[1] }, error_code };
+    }
+};
+
+static double a[COMPLEX_TEST_SIZE], b[COMPLEX_TEST_SIZE], c[COMPLEX_TEST_SIZE];
+static complex_test_columns actual;
+
+static bool is_same_double(const double x, const double y) {
+    return memcmp(&x, &y, sizeof(double)) == 0;
+}
+
+// Every class of equation, interleaved so that vector lanes mix them
+static void fill_coefficients(void) {
+    uint64_t state = 13;
+
+    for (size_t i = 0; i < COMPLEX_TEST_SIZE; ++ i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        const double random = (double) (state >> 11) / 9007199254740992.0 * 8.0 - 4.0;
+
+        a[i] = i % 5 == 0 ? 0.0 : random;
+        b[i] = i % 7 == 0 ? 0.0 : random * 2.0 - 1.0;
+        c[i] = i % 11 == 0 ? 0.0 : 1.0 - random;
+
+        if (i % 9 == 0) // Discriminant is exactly zero
+            a[i] = 1.0, b[i] = 2.0, c[i] = 1.0;
+        if (i % 13 == 0) // Purely imaginary roots
+            b[i] = 0.0, c[i] = random * random + 1.0, a[i] = random < 0 ? -1.0 : 1.0;
+        if (i % 31 == 0)
+            b[i] = NAN;
+        if (i % 37 == 0)
+            c[i] = -INFINITY;
+    }
+
+    // Finite coefficients with NaN discriminant
+    a[6] = 1e300, b[6] = 1e300, c[6] = 1e300;
+    a[7] = -1e300, b[7] = 1e300, c[7] = 1e300;
+}
+
+TEST(real_roots_match_solver) {
+    fill_coefficients();
+
+    for (size_t i = 0; i < COMPLEX_TEST_SIZE; ++ i) {
+        equation_solution real_solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+        const int error = solve_quadratic_equation(a[i], b[i], c[i], &real_solution);
+
+        complex_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 }, { 0.0, 0.0 } };
+        ASSERT_EQUAL(solve_quadratic_equation_complex(a[i], b[i], c[i], &solution), error);
+
+        // Only equations without real roots can have complex ones
+        if (error != 0 || (solution.imaginary[0] != 0 && real_solution.number_of_roots == 0))
+            continue;
+
+        ASSERT_EQUAL(solution.status, real_solution.status);
+        ASSERT_EQUAL(solution.number_of_roots, real_solution.number_of_roots);
+        ASSERT_EQUAL(is_same_double(solution.real[0], real_solution.root[0]), true);
+        ASSERT_EQUAL(is_same_double(solution.real[1], real_solution.root[1]), true);
+        ASSERT_EQUAL((solution.imaginary[0] == 0 && solution.imaginary[1] == 0), true);
+    }
+}
+
+TEST(complex_roots_are_conjugate_and_solve_equation) {
+    // x^2 + 2x + 5 == 0 has roots -1 +- 2i
+    complex_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 }, { 0.0, 0.0 } };
+    ASSERT_EQUAL(solve_quadratic_equation_complex(1.0, 2.0, 5.0, &solution), 0);
+
+    ASSERT_EQUAL(solution.status, FINITE_ROOTS);
+    ASSERT_EQUAL(solution.number_of_roots, 2);
+    ASSERT_EPSILON_EQUAL(solution.real[0], -1.0);
+    ASSERT_EPSILON_EQUAL(solution.real[1], -1.0);
+    ASSERT_EPSILON_EQUAL(solution.imaginary[0], 2.0);
+    ASSERT_EPSILON_EQUAL(solution.imaginary[1], -2.0);
+
+    // Residual a z^2 + b z + c of every complex root is close to zero
+    fill_coefficients();
+
+    for (size_t i = 0; i < COMPLEX_TEST_SIZE; ++ i) {
+        if (solve_quadratic_equation_complex(a[i], b[i], c[i], &solution) != 0 ||
+            solution.imaginary[0] == 0)
+            continue;
+
+        ASSERT_EQUAL(is_same_double(solution.real[0], solution.real[1]), true);
+        ASSERT_EQUAL(is_same_double(solution.imaginary[0], - solution.imaginary[1]), true);
+
+        for (int root = 0; root < 2; ++ root) {
+            const double x = solution.real[root], y = solution.imaginary[root];
+
+            const double residual_real = a[i] * (x * x - y * y) + b[i] * x + c[i];
+            const double residual_imaginary = 2 * a[i] * x * y + b[i] * y;
+
+            const double scale = fabs(a[i]) + fabs(b[i]) + fabs(c[i]);
+            ASSERT_EQUAL((fabs(residual_real) <= 1e-12 * scale), true);
+            ASSERT_EQUAL((fabs(residual_imaginary) <= 1e-12 * scale), true);
+        }
+    }
+}
+
+TEST(batch_matches_single_on_every_tier) {
+    fill_coefficients();
+
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    for (int tier = SCALAR_KERNEL; tier <= AVX512_KERNEL; ++ tier) {
+        if (force_kernel_tier((kernel_tier) tier) != 0)
+            continue;
+
+        const complex_equation_solution_columns columns = actual.columns();
+        const size_t failed =
+            solve_quadratic_equation_batch_complex(a, b, c, COMPLEX_TEST_SIZE, &columns);
+
+        size_t expected_failed = 0;
+        for (size_t i = 0; i < COMPLEX_TEST_SIZE; ++ i) {
+            complex_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 }, { 0.0, 0.0 } };
+            const int error = solve_quadratic_equation_complex(a[i], b[i], c[i], &solution);
+            expected_failed += error != 0;
+
+            ASSERT_EQUAL(actual.error_code[i], error);
+            ASSERT_EQUAL(actual.status[i], solution.status);
+            ASSERT_EQUAL(actual.number_of_roots[i], solution.number_of_roots);
+
+            for (int root = 0; root < 2; ++ root) {
+                ASSERT_EQUAL(is_same_double(actual.real[root][i], solution.real[root]), true);
+                ASSERT_EQUAL(is_same_double(actual.imaginary[root][i], solution.imaginary[root]),
+                             true);
+            }
+        }
+
+        ASSERT_EQUAL((failed == expected_failed), true);
+    }
+
+    force_kernel_tier(active_tier);
+}
+
+TEST_MAIN()
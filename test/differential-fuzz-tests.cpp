@@ -0,0 +1,408 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "quadratic-equation-solver.h"
+#include "quadratic-equation-mixed.h"
+#include "quadratic-equation-parallel.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+/*
+   Differential fuzzing. Triples from each generator are solved by every
+   kernel tier, the mixed-precision and the parallel solvers, which must
+   agree with #solve_quadratic_equation, and it must agree with the same
+   solver in long double within a bound derived from the conditioning of
+   the equation.
+
+   Every test runs for FUZZ_SECONDS_ENVIRONMENT_VARIABLE seconds (default
+   FUZZ_DEFAULT_SECONDS) and tests run in parallel, so long runs over
+   hundreds of millions of triples only need the variable raised.
+ */
+
+#define FUZZ_BLOCK_SIZE 4096
+
+static const char* const FUZZ_SECONDS_ENVIRONMENT_VARIABLE = "EQUATION_SOLVER_FUZZ_SECONDS";
+static const char* const FUZZ_SEED_ENVIRONMENT_VARIABLE    = "EQUATION_SOLVER_FUZZ_SEED";
+
+static const double FUZZ_DEFAULT_SECONDS = 0.5;
+
+// Unit roundoff of double
+static const long double ROUNDOFF = 0x1p-53L;
+
+static double a[FUZZ_BLOCK_SIZE], b[FUZZ_BLOCK_SIZE], c[FUZZ_BLOCK_SIZE];
+static test_solution_columns<FUZZ_BLOCK_SIZE> expected, actual;
+
+static void print_triple(const char* const what, const double a, const double b,
+                         const double c) {
+    printf(TEXT_FAILED("%s") " for a = %a, b = %a, c = %a\n", what, a, b, c);
+}
+
+// ============================= Generators =============================
+
+typedef void (*fuzz_generator)(uint64_t* const state, double* const a, double* const b,
+                               double* const c);
+
+// splitmix64
+static uint64_t next_random(uint64_t* const state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15u);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1)
+static double random_unit(uint64_t* const state) {
+    return (double) (next_random(state) >> 11) * 0x1p-53;
+}
+
+// Random sign and mantissa, exponent uniform in [min_exponent, max_exponent]
+static double random_magnitude(uint64_t* const state, const int min_exponent,
+                               const int max_exponent) {
+    const uint64_t bits = next_random(state);
+    const int exponent = min_exponent + (int) (bits % (uint64_t) (max_exponent - min_exponent + 1));
+    const double value = std::ldexp(1.0 + random_unit(state), exponent);
+
+    return bits >> 63 ? -value : value;
+}
+
+static void generate_random(uint64_t* const state, double* const a, double* const b,
+                            double* const c) {
+    const uint64_t zeros = next_random(state);
+
+    *a = zeros % 16 == 0 ? 0.0 : random_magnitude(state, -40, 40);
+    *b = zeros / 16 % 16 == 0 ? 0.0 : random_magnitude(state, -40, 40);
+    *c = zeros / 256 % 16 == 0 ? 0.0 : random_magnitude(state, -40, 40);
+}
+
+// Whole exponent range, so squares overflow and products underflow
+static void generate_wide_range(uint64_t* const state, double* const a, double* const b,
+                                double* const c) {
+    *a = random_magnitude(state, -1074, 1023);
+    *b = random_magnitude(state, -1074, 1023);
+    *c = random_magnitude(state, -1074, 1023);
+}
+
+// Small integers, so discriminants are exact and often zero
+static void generate_integers(uint64_t* const state, double* const a, double* const b,
+                              double* const c) {
+    const uint64_t bits = next_random(state);
+
+    *a = (double) ((int) (bits % 41) - 20);
+    *b = (double) ((int) (bits / 41 % 41) - 20);
+    *c = (double) ((int) (bits / 41 / 41 % 41) - 20);
+}
+
+// Coefficients and discriminants a few ulps or a tiny fraction away from
+// EQUATION_SOLVER_EPSILON, on both sides
+static void generate_near_epsilon(uint64_t* const state, double* const a, double* const b,
+                                  double* const c) {
+    const uint64_t bits = next_random(state);
+    const double near_epsilon =
+        std::ldexp(EQUATION_SOLVER_EPSILON, 0) + (double) ((int) (bits % 9) - 4) *
+        std::ldexp(EQUATION_SOLVER_EPSILON, -52);
+    const double signed_epsilon = bits >> 63 ? -near_epsilon : near_epsilon;
+
+    switch (bits / 9 % 4) {
+    case 0: // a is the tolerance away from zero
+        *a = signed_epsilon;
+        *b = random_magnitude(state, -4, 4);
+        *c = random_magnitude(state, -4, 4);
+        break;
+
+    case 1: // Linear equation with b or c at the tolerance
+        *a = 0.0;
+        *b = bits & 1024 ? signed_epsilon : random_magnitude(state, -4, 4);
+        *c = bits & 1024 ? random_magnitude(state, -4, 4) : signed_epsilon;
+        break;
+
+    default: { // b * b - 4ac is near ±epsilon
+        const double scale = std::ldexp(1.0, -(int) (bits / 36 % 48));
+
+        *a = random_magnitude(state, -2, 2);
+        *c = std::fabs(random_magnitude(state, -2, 2)) * (*a < 0 ? -1.0 : 1.0);
+
+        const double square_b = 4 * *a * *c + signed_epsilon * (1.0 + scale);
+        *b = std::sqrt(square_b < 0 ? 0.0 : square_b) * (bits & 2048 ? -1.0 : 1.0);
+        break;
+    }
+    }
+}
+
+// a (x - r) (x - r (1 + delta)) with tiny delta, so the roots nearly coincide
+static void generate_close_roots(uint64_t* const state, double* const a, double* const b,
+                                 double* const c) {
+    const double root = random_magnitude(state, -20, 20);
+    const double other = root * (1.0 + random_magnitude(state, -52, -10));
+
+    *a = random_magnitude(state, -10, 10);
+    *b = - *a * (root + other);
+    *c = *a * (root * other);
+}
+
+// |b| dwarfs a and c, so one root is tiny and the textbook formula cancels
+static void generate_dominant_b(uint64_t* const state, double* const a, double* const b,
+                                double* const c) {
+    *a = random_magnitude(state, -8, 8);
+    *b = random_magnitude(state, 20, 200);
+    *c = random_magnitude(state, -8, 8);
+}
+
+// Signed zeros, infinities, NaN, subnormals and extremes, mixed with random values
+static void generate_special_values(uint64_t* const state, double* const a, double* const b,
+                                    double* const c) {
+    static const double special_values[] = {
+        0.0, -0.0, 1.0, -1.0, EQUATION_SOLVER_EPSILON, -EQUATION_SOLVER_EPSILON,
+        DBL_MIN, -DBL_MIN, DBL_TRUE_MIN, -DBL_TRUE_MIN, DBL_MAX, -DBL_MAX,
+        1e154, -1e154, 1e-154, 1e308, INFINITY, -INFINITY, NAN, -NAN
+    };
+
+    const size_t number_of_values = sizeof(special_values) / sizeof(special_values[0]);
+
+    double* const coefficients[] = { a, b, c };
+    for (double* const coefficient : coefficients) {
+        const uint64_t bits = next_random(state);
+
+        *coefficient = bits % 3 == 0 ? random_magnitude(state, -60, 60) :
+                       special_values[bits / 3 % number_of_values];
+    }
+}
+
+// ============================== Reference =============================
+
+// Whether `actual` approximates `exact` within relative error `relative`,
+// absolute slack covers results that underflow to subnormals
+static bool is_close(const double actual, const long double exact, const long double relative) {
+    if (is_same_double(actual, (double) exact))
+        return true; // Same infinities and NaNs
+
+    return std::fabs((long double) actual - exact) <=
+           relative * std::fabs(exact) + (long double) DBL_MIN;
+}
+
+// Results of double arithmetic are only close to long double ones if no
+// intermediate overflows or becomes subnormal
+static bool is_in_double_range(const long double value) {
+    return value == 0 || (0x1p-960L <= std::fabs(value) && std::fabs(value) <= DBL_MAX / 16);
+}
+
+/*
+   Compares solution from #solve_quadratic_equation with the long double
+   solver. Discriminant of the double solver is off by 4u (b^2 + |4ac|) at
+   most, so number of roots has to match unless |discriminant| is that
+   close to the tolerance, and roots are off by a relative error of
+   ~u (b^2 + |4ac|) / |discriminant| from the square root and a few u
+   from the rest.
+ */
+static bool matches_reference(const double a, const double b, const double c, const int error,
+                              const equation_solution* const solution, size_t* const checked) {
+
+    basic_equation_solution<long double> reference = { FINITE_ROOTS, 0, { 0, 0 } };
+    const int reference_error =
+        basic_solve_quadratic_equation<long double>(a, b, c, &reference);
+
+    if (error != reference_error) {
+        print_triple("Error code differs from long double", a, b, c);
+        return false;
+    }
+
+    if (error != 0)
+        return true;
+
+    const long double square_b = (long double) b * b;
+    const long double four_ac = 4 * (long double) a * c;
+    const long double scale = square_b + std::fabs(four_ac);
+
+    if (!is_in_double_range(square_b) || !is_in_double_range(four_ac) ||
+        !is_in_double_range(4 * (long double) a))
+        return true;
+
+    const long double discriminant = square_b - four_ac;
+    const long double epsilon = absolute_tolerance<long double>::epsilon;
+
+    const bool is_quadratic = !absolute_tolerance<double>::is_zero(a);
+    if (is_quadratic && std::fabs(std::fabs(discriminant) - epsilon) <= 4 * ROUNDOFF * scale)
+        return true; // Either number of roots is right
+
+    if (solution->status != reference.status ||
+        solution->number_of_roots != reference.number_of_roots) {
+        print_triple("Number of roots differs from long double", a, b, c);
+        return false;
+    }
+
+    const long double relative = !is_quadratic || reference.number_of_roots < 2 ?
+        4 * ROUNDOFF : 8 * ROUNDOFF * (1 + scale / std::fabs(discriminant));
+
+    for (int i = 0; i < reference.number_of_roots; ++ i) {
+        if (std::fabs(reference.root[i]) > DBL_MAX / 16)
+            continue; // Overflows in double
+
+        if (!is_close(solution->root[i], reference.root[i], relative)) {
+            print_triple("Root is too far from long double", a, b, c);
+            printf("Root %d: %a, long double: %La, bound %Lg\n", i, solution->root[i],
+                   reference.root[i], relative);
+            return false;
+        }
+    }
+
+    ++ *checked;
+    return true;
+}
+
+// ================================ Fuzzer ==============================
+
+static bool same_solutions(const size_t count, const char* const solver) {
+    for (size_t i = 0; i < count; ++ i) {
+        if (actual.error_code[i] == expected.error_code[i] &&
+            actual.status[i] == expected.status[i] &&
+            actual.number_of_roots[i] == expected.number_of_roots[i] &&
+            is_same_double(actual.first_root[i], expected.first_root[i]) &&
+            is_same_double(actual.second_root[i], expected.second_root[i]))
+            continue;
+
+        printf(TEXT_FAILED("%s") " differs from single equation solver\n", solver);
+        print_triple("Mismatch", a[i], b[i], c[i]);
+        return false;
+    }
+
+    return true;
+}
+
+// Mixed-precision roots may differ within the tolerance, the rest matches
+static bool close_mixed_solutions(const size_t count) {
+    const long double relative = 2 * MIXED_PRECISION_DEFAULT_TOLERANCE;
+
+    for (size_t i = 0; i < count; ++ i) {
+        if (actual.error_code[i] == expected.error_code[i] &&
+            actual.status[i] == expected.status[i] &&
+            actual.number_of_roots[i] == expected.number_of_roots[i] &&
+            is_close(actual.first_root[i], expected.first_root[i], relative) &&
+            is_close(actual.second_root[i], expected.second_root[i], relative))
+            continue;
+
+        print_triple("Mixed-precision solver is too far", a[i], b[i], c[i]);
+        return false;
+    }
+
+    return true;
+}
+
+static bool check_block(const size_t count, size_t* const checked) {
+    for (size_t i = 0; i < count; ++ i) {
+        equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+        const int error = solve_quadratic_equation(a[i], b[i], c[i], &solution);
+
+        if (!matches_reference(a[i], b[i], c[i], error, &solution, checked))
+            return false;
+
+        expected.status[i] = solution.status;
+        expected.number_of_roots[i] = solution.number_of_roots;
+        expected.first_root[i] = solution.root[0];
+        expected.second_root[i] = solution.root[1];
+        expected.error_code[i] = error;
+    }
+
+    const equation_solution_columns columns = actual.columns();
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    static const char* const tier_names[] = { "Scalar kernel", "SSE2 kernel",
+                                              "AVX2 kernel", "AVX-512 kernel" };
+
+    for (int tier = SCALAR_KERNEL; tier <= AVX512_KERNEL; ++ tier) {
+        if (force_kernel_tier((kernel_tier) tier) != 0)
+            continue;
+
+        solve_quadratic_equation_batch(a, b, c, count, &columns);
+        if (!same_solutions(count, tier_names[tier]))
+            return false;
+    }
+
+    force_kernel_tier(active_tier);
+
+    solve_quadratic_equation_batch_parallel(NULL, a, b, c, count, &columns);
+    if (!same_solutions(count, "Parallel solver"))
+        return false;
+
+    solve_quadratic_equation_batch_mixed(a, b, c, count, &columns,
+                                         MIXED_PRECISION_DEFAULT_TOLERANCE, NULL);
+    return close_mixed_solutions(count);
+}
+
+static double environment_value(const char* const name, const double default_value) {
+    const char* const value = getenv(name);
+    return value != NULL ? atof(value) : default_value;
+}
+
+// Checks blocks from the generator until the time budget runs out
+static bool fuzz(const fuzz_generator generate, const uint64_t seed) {
+    const double seconds = environment_value(FUZZ_SECONDS_ENVIRONMENT_VARIABLE,
+                                             FUZZ_DEFAULT_SECONDS);
+
+    uint64_t state = seed ^ (uint64_t) environment_value(FUZZ_SEED_ENVIRONMENT_VARIABLE, 0);
+
+    const double start = __test_framework_seconds();
+    size_t total = 0, checked = 0;
+
+    do {
+        for (size_t i = 0; i < FUZZ_BLOCK_SIZE; ++ i)
+            generate(&state, a + i, b + i, c + i);
+
+        if (!check_block(FUZZ_BLOCK_SIZE, &checked))
+            return false;
+
+        total += FUZZ_BLOCK_SIZE;
+    } while (__test_framework_seconds() - start < seconds);
+
+    printf(TEXT_INFO("[==> MESSAGE <==]") " %zu triples, %zu compared with long double\n",
+           total, checked);
+    return true;
+}
+
+TEST(random_triples) {
+    const bool passed = fuzz(generate_random, 1);
+    ASSERT_EQUAL(passed, true);
+}
+
+TEST(wide_range_triples) {
+    const bool passed = fuzz(generate_wide_range, 2);
+    ASSERT_EQUAL(passed, true);
+}
+
+TEST(integer_triples) {
+    const bool passed = fuzz(generate_integers, 3);
+    ASSERT_EQUAL(passed, true);
+}
+
+TEST(triples_near_epsilon) {
+    const bool passed = fuzz(generate_near_epsilon, 4);
+    ASSERT_EQUAL(passed, true);
+}
+
+TEST(triples_with_close_roots) {
+    const bool passed = fuzz(generate_close_roots, 5);
+    ASSERT_EQUAL(passed, true);
+}
+
+TEST(triples_with_dominant_b) {
+    const bool passed = fuzz(generate_dominant_b, 6);
+    ASSERT_EQUAL(passed, true);
+}
+
+TEST(triples_with_special_values) {
+    const bool passed = fuzz(generate_special_values, 7);
+    ASSERT_EQUAL(passed, true);
+}
+
+BENCHMARK(fuzzing_block, 100) {
+    static uint64_t state = 1;
+    static size_t checked = 0;
+
+    for (size_t i = 0; i < FUZZ_BLOCK_SIZE; ++ i)
+        generate_random(&state, a + i, b + i, c + i);
+
+    const bool passed = check_block(FUZZ_BLOCK_SIZE, &checked);
+    ASSERT_EQUAL(passed, true);
+}
+
+TEST_MAIN()
@@ -0,0 +1,116 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "equation-sweep.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+#include <cstdint>
+
+#define SWEEP_TEST_MAX_SIZE 4096
+
+static double a[SWEEP_TEST_MAX_SIZE], b[SWEEP_TEST_MAX_SIZE], c[SWEEP_TEST_MAX_SIZE];
+static test_solution_columns<SWEEP_TEST_MAX_SIZE> expected, actual;
+
+// Sweeps in blocks of `capacity` and compares with the batch solver on the
+// materialized grid
+#define SWEEP_ASSERT_MATCHES_BATCH(range_a, range_b, range_c, capacity)                    \
+    do {                                                                                   \
+        equation_sweep sweep;                                                              \
+        ASSERT_EQUAL(init_equation_sweep(&sweep, &(range_a), &(range_b), &(range_c)), 0);  \
+        ASSERT_EQUAL((sweep.size <= SWEEP_TEST_MAX_SIZE), true);                           \
+                                                                                           \
+        for (size_t i = 0; i < sweep.size; ++ i)                                           \
+            get_sweep_coefficients(&sweep, i, a + i, b + i, c + i);                        \
+                                                                                           \
+        equation_solution_columns expected_columns = expected.columns();                   \
+        solve_quadratic_equation_batch(a, b, c, sweep.size, &expected_columns);            \
+                                                                                           \
+        size_t solved = 0;                                                                 \
+        for (;;) {                                                                         \
+            const equation_solution_columns block = actual.columns(solved);                \
+            const size_t size = solve_next_sweep_block(&sweep, &block, (capacity));        \
+            if (size == 0)                                                                 \
+                break;                                                                     \
+                                                                                           \
+            solved += size;                                                                \
+        }                                                                                  \
+                                                                                           \
+        ASSERT_EQUAL((solved == sweep.size), true);                                        \
+                                                                                           \
+        for (size_t i = 0; i < sweep.size; ++ i) {                                         \
+            ASSERT_EQUAL(actual.error_code[i], expected.error_code[i]);                    \
+            ASSERT_EQUAL(actual.status[i], expected.status[i]);                            \
+            ASSERT_EQUAL(actual.number_of_roots[i], expected.number_of_roots[i]);          \
+            ASSERT_EQUAL(is_same_double(actual.first_root[i], expected.first_root[i]),     \
+                         true);                                                            \
+            ASSERT_EQUAL(is_same_double(actual.second_root[i], expected.second_root[i]),   \
+                         true);                                                            \
+        }                                                                                  \
+    } while(false)
+
+TEST(sweep_matches_batch_on_every_tier) {
+    // a and b pass through zero, so there are linear and degenerate rows
+    const coefficient_range range_a = { -2.0, 0.5, 9 };
+    const coefficient_range range_b = { -3.0, 1.5, 5 };
+    const coefficient_range range_c = { -5.0, 0.37, 41 };
+
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    for (int tier = SCALAR_KERNEL; tier <= AVX512_KERNEL; ++ tier) {
+        if (force_kernel_tier((kernel_tier) tier) != 0)
+            continue;
+
+        // Blocks that end in the middle of rows, and one block for everything
+        SWEEP_ASSERT_MATCHES_BATCH(range_a, range_b, range_c, 37);
+        SWEEP_ASSERT_MATCHES_BATCH(range_a, range_b, range_c, 1);
+        SWEEP_ASSERT_MATCHES_BATCH(range_a, range_b, range_c, SWEEP_TEST_MAX_SIZE);
+    }
+
+    force_kernel_tier(active_tier);
+}
+
+TEST(zero_discriminant_is_found) {
+    // c == 1 gives (x + 1)^2
+    const coefficient_range range_a = { 1.0, 0.0, 1 };
+    const coefficient_range range_b = { 2.0, 0.0, 1 };
+    const coefficient_range range_c = { -2.0, 0.5, 9 };
+
+    SWEEP_ASSERT_MATCHES_BATCH(range_a, range_b, range_c, SWEEP_BLOCK_SIZE);
+
+    ASSERT_EQUAL(actual.number_of_roots[6], 1);
+    ASSERT_EPSILON_EQUAL(actual.first_root[6], -1.0);
+}
+
+TEST(non_finite_coefficients_get_error_codes) {
+    // c overflows to infinity in the middle of rows
+    const coefficient_range range_a = { 1.0, 1.0, 3 };
+    const coefficient_range huge_b = { 1e300, 1e300, 2 };
+    const coefficient_range overflowing_c = { 1e308, 1e307, 20 };
+
+    SWEEP_ASSERT_MATCHES_BATCH(range_a, huge_b, overflowing_c, 7);
+
+    // b and then a overflow, and a NaN step makes every a illegal
+    const coefficient_range overflowing_a = { 0.0, 1e308, 3 };
+    const coefficient_range overflowing_b = { 1e308, 1e308, 2 };
+    const coefficient_range nan_a = { 1.0, NAN, 2 };
+    const coefficient_range range_c = { -1.0, 0.25, 9 };
+
+    SWEEP_ASSERT_MATCHES_BATCH(overflowing_a, overflowing_b, range_c, 5);
+    SWEEP_ASSERT_MATCHES_BATCH(nan_a, overflowing_b, range_c, 5);
+}
+
+TEST(empty_and_oversized_grids_are_rejected) {
+    const coefficient_range empty = { 0.0, 1.0, 0 };
+    const coefficient_range single = { 0.0, 1.0, 1 };
+    const coefficient_range huge = { 0.0, 1.0, SIZE_MAX / 2 };
+
+    equation_sweep sweep;
+    ASSERT_EQUAL(init_equation_sweep(&sweep, &single, &empty, &single), -1);
+    ASSERT_EQUAL(init_equation_sweep(&sweep, &huge, &huge, &single), -1);
+    ASSERT_EQUAL(init_equation_sweep(&sweep, &single, &huge, &huge), -1);
+
+    ASSERT_EQUAL(init_equation_sweep(&sweep, &single, &single, &huge), 0);
+    ASSERT_EQUAL((sweep.size == SIZE_MAX / 2), true);
+}
+
+TEST_MAIN()
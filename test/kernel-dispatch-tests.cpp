@@ -0,0 +1,82 @@
+#include "test-framework.h"
+#include "quadratic-equation-batch.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+
+#define SOLVE_BATCH_AND_ASSERT_ROOTS()                                                     \
+    do {                                                                                   \
+        const double a[] = { 1.0, 0.0, 1.0, 1.0, NAN };                                    \
+        const double b[] = { 3.0, 2.0, 2.0, 0.0, 1.0 };                                    \
+        const double c[] = { 2.0, 1.0, 1.0, 1.0, 1.0 };                                    \
+                                                                                           \
+        solution_status status[5];                                                         \
+        int number_of_roots[5], error_code[5];                                             \
+        double first_root[5], second_root[5];                                              \
+                                                                                           \
+        equation_solution_columns solutions {                                              \
+            status, number_of_roots, { first_root, second_root }, error_code               \
+        };                                                                                 \
+                                                                                           \
+        ASSERT_EQUAL((int) solve_quadratic_equation_batch(a, b, c, 5, &solutions), 1);     \
+                                                                                           \
+        ASSERT_EQUAL(number_of_roots[0], 2);                                               \
+        ASSERT_EPSILON_EQUAL(first_root[0], -1.0);                                         \
+        ASSERT_EPSILON_EQUAL(second_root[0], -2.0);                                        \
+                                                                                           \
+        ASSERT_EQUAL(number_of_roots[1], 1);                                               \
+        ASSERT_EPSILON_EQUAL(first_root[1], -0.5);                                         \
+                                                                                           \
+        ASSERT_EQUAL(number_of_roots[2], 1);                                               \
+        ASSERT_EPSILON_EQUAL(first_root[2], -1.0);                                         \
+                                                                                           \
+        ASSERT_EQUAL(number_of_roots[3], 0);                                               \
+        ASSERT_EQUAL(error_code[4], 1);                                                    \
+    } while(false)
+
+
+TEST(detected_tier_is_active_by_default) {
+    // Test runs are not expected to set the override
+    if (getenv(KERNEL_TIER_ENVIRONMENT_VARIABLE) != NULL)
+        return;
+
+    ASSERT_EQUAL(get_active_kernel_tier(), detect_kernel_tier());
+
+#if defined(__x86_64__)
+    ASSERT_TRUE_WITH_EXPECTATION(detect_kernel_tier() >= SSE2_KERNEL, "%d",
+                                 detect_kernel_tier(), SSE2_KERNEL);
+#endif
+}
+
+TEST(every_supported_tier_can_be_forced) {
+    const kernel_tier detected = detect_kernel_tier();
+
+    for (int tier = SCALAR_KERNEL; tier <= detected; ++ tier) {
+        ASSERT_EQUAL(force_kernel_tier((kernel_tier) tier), 0);
+        ASSERT_EQUAL(get_active_kernel_tier(), tier);
+
+        SOLVE_BATCH_AND_ASSERT_ROOTS();
+    }
+
+    ASSERT_EQUAL(force_kernel_tier(detected), 0);
+}
+
+TEST(unsupported_tier_is_rejected) {
+    const kernel_tier active = get_active_kernel_tier();
+
+    ASSERT_EQUAL(force_kernel_tier((kernel_tier) 42), -1);
+    ASSERT_EQUAL(get_active_kernel_tier(), active);
+
+    if (detect_kernel_tier() < AVX512_KERNEL) {
+        ASSERT_EQUAL(force_kernel_tier(AVX512_KERNEL), -1);
+        ASSERT_EQUAL(get_active_kernel_tier(), active);
+    }
+}
+
+TEST(tier_names) {
+    ASSERT_EQUAL(strcmp(kernel_tier_name(SCALAR_KERNEL), "scalar"), 0);
+    ASSERT_EQUAL(strcmp(kernel_tier_name(AVX512_KERNEL), "avx512"), 0);
+    ASSERT_EQUAL((kernel_tier_name((kernel_tier) 42) == NULL), true);
+}
+
+TEST_MAIN()
@@ -0,0 +1,186 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "quadratic-equation-mixed.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+#include <cstdint>
+
+#define MIXED_TEST_SIZE 1000
+
+static double a[MIXED_TEST_SIZE], b[MIXED_TEST_SIZE], c[MIXED_TEST_SIZE];
+static test_solution_columns<MIXED_TEST_SIZE> expected, actual;
+
+static bool is_within_tolerance(const double actual_root, const double expected_root,
+                                const double tolerance) {
+    return std::fabs(actual_root - expected_root) <= tolerance * std::fabs(expected_root);
+}
+
+// Solves a, b, c both ways, number of equations solved again in double goes to `refined`
+#define MIXED_ASSERT_MATCHES_DOUBLE(count, tolerance)                                      \
+    do {                                                                                   \
+        equation_solution_columns expected_columns = expected.columns();                   \
+        equation_solution_columns actual_columns = actual.columns();                       \
+                                                                                           \
+        const size_t expected_failed = solve_quadratic_equation_batch(                     \
+            a, b, c, (count), &expected_columns);                                          \
+        const size_t actual_failed = solve_quadratic_equation_batch_mixed(                 \
+            a, b, c, (count), &actual_columns, (tolerance), &refined);                     \
+                                                                                           \
+        ASSERT_EQUAL((int) actual_failed, (int) expected_failed);                          \
+                                                                                           \
+        for (size_t i = 0; i < (count); ++ i) {                                            \
+            ASSERT_EQUAL(actual.error_code[i], expected.error_code[i]);                    \
+            ASSERT_EQUAL(actual.status[i], expected.status[i]);                            \
+            ASSERT_EQUAL(actual.number_of_roots[i], expected.number_of_roots[i]);          \
+            ASSERT_EQUAL(is_within_tolerance(actual.first_root[i],                         \
+                                             expected.first_root[i], (tolerance)), true);  \
+            ASSERT_EQUAL(is_within_tolerance(actual.second_root[i],                        \
+                                             expected.second_root[i], (tolerance)), true); \
+        }                                                                                  \
+    } while(false)
+
+
+TEST(well_conditioned_equations_stay_in_float) {
+    // Roots of opposite signs, never close to each other
+    for (size_t i = 0; i < MIXED_TEST_SIZE; ++ i) {
+        const double first = (double) (i % 17) + 1.25, second = - (double) (i % 5) - 1.5;
+        const double leading = (double) (i % 3) + 1.0;
+
+        a[i] = leading;
+        b[i] = - leading * (first + second);
+        c[i] = leading * first * second;
+    }
+
+    size_t refined = MIXED_TEST_SIZE;
+    MIXED_ASSERT_MATCHES_DOUBLE(MIXED_TEST_SIZE, MIXED_PRECISION_DEFAULT_TOLERANCE);
+
+    ASSERT_EQUAL((int) refined, 0);
+}
+
+TEST(cancelling_equations_fall_back_to_double) {
+    const double cancelling_a[] = { 1.0,   1.0,    1.0,  1e-8, 0.0, 1e300,  NAN, 1.0      };
+    const double cancelling_b[] = { 1e4,  -2.0,    2.0,  1.0,  1.0, 1.0,    1.0, 1.00005  };
+    const double cancelling_c[] = { 1.0,   0.999,  1.0,  1.0,  1.0, 1.0,    1.0, 2.5e-10  };
+
+    // Roots far apart don't cancel in q / a and c / q, so only close roots,
+    // a double root and illegal floats need double precision
+    const bool stays_in_float[] = { true, false, false, true, true, false, false, true };
+
+    const size_t count = sizeof(cancelling_a) / sizeof(cancelling_a[0]);
+
+    for (size_t i = 0; i < count; ++ i)
+        a[i] = cancelling_a[i], b[i] = cancelling_b[i], c[i] = cancelling_c[i];
+
+    size_t refined = 0;
+    MIXED_ASSERT_MATCHES_DOUBLE(count, MIXED_PRECISION_DEFAULT_TOLERANCE);
+
+    ASSERT_EQUAL((int) refined, 4);
+
+    // Refined equations are bit-identical to the double solver
+    for (size_t i = 0; i < count; ++ i) {
+        if (stays_in_float[i])
+            continue;
+
+        ASSERT_EQUAL(is_same_double(actual.first_root[i], expected.first_root[i]), true);
+        ASSERT_EQUAL(is_same_double(actual.second_root[i], expected.second_root[i]), true);
+    }
+}
+
+TEST(near_epsilon_coefficients_keep_number_of_roots) {
+    // x^2 + bx with b around sqrt(epsilon), so discriminant is around epsilon
+    for (size_t i = 0; i < MIXED_TEST_SIZE; ++ i) {
+        a[i] = 1.0;
+        b[i] = std::sqrt(EQUATION_SOLVER_EPSILON) * (1.0 + ((double) i - 500.0) * 1e-9);
+        c[i] = i % 2 == 0 ? 0.0 : EQUATION_SOLVER_EPSILON * (1.0 + ((double) i - 500.0) * 1e-9);
+    }
+
+    size_t refined = 0;
+    MIXED_ASSERT_MATCHES_DOUBLE(MIXED_TEST_SIZE, MIXED_PRECISION_DEFAULT_TOLERANCE);
+}
+
+TEST(roots_underflowing_to_zero_fall_back_to_double) {
+    // Linear root, -b / 2a and c / q underflow in float, roots of the last
+    // equation are exactly 0 and -2. Repeated, so vector kernel sees them too
+    const double underflowing_a[] = { 0.0,  1e30,  1.0,   1.0 };
+    const double underflowing_b[] = { 1e30, 1e-30, 1e18,  2.0 };
+    const double underflowing_c[] = { 1e-20, 0.0,  1e-30, 0.0 };
+
+    const size_t count = 32;
+
+    for (size_t i = 0; i < count; ++ i)
+        a[i] = underflowing_a[i % 4], b[i] = underflowing_b[i % 4], c[i] = underflowing_c[i % 4];
+
+    size_t refined = 0;
+    MIXED_ASSERT_MATCHES_DOUBLE(count, MIXED_PRECISION_DEFAULT_TOLERANCE);
+
+    ASSERT_EQUAL((int) refined, 24);
+
+    for (size_t i = 0; i < count; ++ i)
+        ASSERT_EQUAL(is_same_double(actual.first_root[i], expected.first_root[i]), true);
+}
+
+TEST(zero_tolerance_solves_everything_in_double) {
+    for (size_t i = 0; i < MIXED_TEST_SIZE; ++ i) {
+        a[i] = (double) (i % 7) - 3.0;
+        b[i] = (double) (i % 11) - 5.0;
+        c[i] = (double) (i % 13) - 6.0;
+    }
+
+    size_t refined = 0;
+    MIXED_ASSERT_MATCHES_DOUBLE(MIXED_TEST_SIZE, 0.0);
+
+    for (size_t i = 0; i < MIXED_TEST_SIZE; ++ i) {
+        if (actual.number_of_roots[i] == 0)
+            continue;
+
+        ASSERT_EQUAL(is_same_double(actual.first_root[i], expected.first_root[i]), true);
+        ASSERT_EQUAL(is_same_double(actual.second_root[i], expected.second_root[i]), true);
+    }
+}
+
+TEST(vector_kernel_flags_same_equations) {
+    uint64_t state = 42;
+
+    // Mix of well-conditioned, cancelling, linear and illegal equations
+    for (size_t i = 0; i < MIXED_TEST_SIZE; ++ i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+
+        const double random = (double) (state >> 11) / 9007199254740992.0 * 20.0 - 10.0;
+
+        a[i] = i % 7 == 0 ? 0.0 : random;
+        b[i] = i % 5 == 0 ? 1e4 : random * 3.0;
+        c[i] = i % 97 == 0 ? INFINITY : 1.0 - random;
+    }
+
+    equation_solution_columns expected_columns = expected.columns();
+    equation_solution_columns actual_columns = actual.columns();
+
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    size_t expected_refined = 0, actual_refined = 0;
+
+    force_kernel_tier(SCALAR_KERNEL);
+    solve_quadratic_equation_batch_mixed(a, b, c, MIXED_TEST_SIZE, &expected_columns,
+                                         MIXED_PRECISION_DEFAULT_TOLERANCE, &expected_refined);
+
+    // Not every machine has a vector kernel to compare with
+    if (force_kernel_tier(AVX2_KERNEL) == 0) {
+        solve_quadratic_equation_batch_mixed(a, b, c, MIXED_TEST_SIZE, &actual_columns,
+                                             MIXED_PRECISION_DEFAULT_TOLERANCE, &actual_refined);
+
+        ASSERT_EQUAL((int) actual_refined, (int) expected_refined);
+
+        for (size_t i = 0; i < MIXED_TEST_SIZE; ++ i) {
+            ASSERT_EQUAL(actual.error_code[i], expected.error_code[i]);
+            ASSERT_EQUAL(actual.status[i], expected.status[i]);
+            ASSERT_EQUAL(actual.number_of_roots[i], expected.number_of_roots[i]);
+            ASSERT_EQUAL(is_same_double(actual.first_root[i], expected.first_root[i]), true);
+            ASSERT_EQUAL(is_same_double(actual.second_root[i], expected.second_root[i]), true);
+        }
+    }
+
+    force_kernel_tier(active_tier);
+}
+
+TEST_MAIN()
@@ -0,0 +1,113 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "quadratic-equation-parallel.h"
+
+#include <atomic>
+#include <cmath>
+#include <sched.h>
+
+// Not a multiple of the chunk size, so the last chunk is partial
+#define PARALLEL_TEST_SIZE (PARALLEL_BATCH_CHUNK_SIZE * 20 + 123)
+
+static double a[PARALLEL_TEST_SIZE], b[PARALLEL_TEST_SIZE], c[PARALLEL_TEST_SIZE];
+static test_solution_columns<PARALLEL_TEST_SIZE> expected, actual;
+
+#define PARALLEL_ASSERT_MATCHES_SERIAL(pool)                                               \
+    do {                                                                                   \
+        fill_periodic_coefficients(a, b, c, PARALLEL_TEST_SIZE);                           \
+                                                                                           \
+        equation_solution_columns expected_columns = expected.columns();                   \
+        equation_solution_columns actual_columns = actual.columns();                       \
+                                                                                           \
+        const size_t expected_failed = solve_quadratic_equation_batch(                     \
+            a, b, c, PARALLEL_TEST_SIZE, &expected_columns);                               \
+        const size_t actual_failed = solve_quadratic_equation_batch_parallel(              \
+            (pool), a, b, c, PARALLEL_TEST_SIZE, &actual_columns);                         \
+                                                                                           \
+        ASSERT_EQUAL((int) actual_failed, (int) expected_failed);                          \
+                                                                                           \
+        for (size_t i = 0; i < PARALLEL_TEST_SIZE; ++ i) {                                 \
+            ASSERT_EQUAL(actual.error_code[i], expected.error_code[i]);                    \
+            ASSERT_EQUAL(actual.status[i], expected.status[i]);                            \
+            ASSERT_EQUAL(actual.number_of_roots[i], expected.number_of_roots[i]);          \
+            ASSERT_EPSILON_EQUAL(actual.first_root[i], expected.first_root[i]);            \
+            ASSERT_EPSILON_EQUAL(actual.second_root[i], expected.second_root[i]);          \
+        }                                                                                  \
+    } while(false)
+
+
+static void count_task(void* const context, const size_t task_index, const size_t) {
+    std::atomic<int>* const counters = (std::atomic<int>*) context;
+    counters[task_index].fetch_add(1);
+}
+
+TEST(every_task_runs_exactly_once) {
+    solver_thread_pool* pool = create_solver_thread_pool(4);
+    ASSERT_EQUAL((pool != NULL), true);
+    ASSERT_EQUAL((int) solver_thread_pool_size(pool), 4);
+
+    static std::atomic<int> counters[1000];
+
+    // Same pool is reused for jobs of different sizes
+    for (size_t tasks = 1; tasks <= 1000; tasks += 111) {
+        for (std::atomic<int>& counter: counters)
+            counter.store(0);
+
+        run_solver_thread_pool_tasks(pool, tasks, count_task, counters);
+
+        for (size_t i = 0; i < 1000; ++ i)
+            ASSERT_EQUAL(counters[i].load(), (i < tasks ? 1 : 0));
+    }
+
+    destroy_solver_thread_pool(pool);
+}
+
+TEST(parallel_batch_matches_serial_batch) {
+    solver_thread_pool* pool = create_solver_thread_pool(3);
+    ASSERT_EQUAL((pool != NULL), true);
+
+    PARALLEL_ASSERT_MATCHES_SERIAL(pool);
+    PARALLEL_ASSERT_MATCHES_SERIAL(pool);
+
+    destroy_solver_thread_pool(pool);
+}
+
+TEST(single_thread_pool_solves_everything) {
+    solver_thread_pool* pool = create_solver_thread_pool(1);
+    ASSERT_EQUAL((pool != NULL), true);
+
+    PARALLEL_ASSERT_MATCHES_SERIAL(pool);
+
+    destroy_solver_thread_pool(pool);
+}
+
+// Counts workers that found themselves allowed on more than one CPU
+static void check_pinned_task(void* const context, const size_t, const size_t) {
+    std::atomic<int>* const unpinned = (std::atomic<int>*) context;
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) != 1)
+        unpinned->fetch_add(1);
+}
+
+TEST(pinned_workers_run_on_one_cpu) {
+    solver_thread_pool* pool = create_solver_thread_pool(3);
+    ASSERT_EQUAL((pool != NULL), true);
+    ASSERT_EQUAL(pin_solver_thread_pool_workers(pool), 0);
+
+    static std::atomic<int> unpinned { 0 };
+    run_solver_thread_pool_tasks(pool, 300, check_pinned_task, &unpinned);
+    ASSERT_EQUAL(unpinned.load(), 0);
+
+    PARALLEL_ASSERT_MATCHES_SERIAL(pool);
+
+    destroy_solver_thread_pool(pool);
+}
+
+TEST(default_pool_is_used_for_null) {
+    PARALLEL_ASSERT_MATCHES_SERIAL(NULL);
+}
+
+TEST_MAIN()
@@ -0,0 +1,101 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "quadratic-equation-partition.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+#include <cstdint>
+
+// Not a multiple of the chunk size, so the last chunk is partial
+#define PARTITION_TEST_SIZE (PARTITION_CHUNK_SIZE * 3 + 77)
+
+static double a[PARTITION_TEST_SIZE], b[PARTITION_TEST_SIZE], c[PARTITION_TEST_SIZE];
+static test_solution_columns<PARTITION_TEST_SIZE> expected, actual;
+
+// Runs of every class, interleaved with single equations of other classes
+static void fill_mixed_classes(void) {
+    uint64_t state = 7;
+
+    for (size_t i = 0; i < PARTITION_TEST_SIZE; ++ i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        const double random = (double) (state >> 11) / 9007199254740992.0 * 8.0 - 4.0;
+
+        const size_t run = (i / 37) % 5;
+
+        a[i] = run == 0 || run == 1 ? 0.0 : random;
+        b[i] = run == 1 ? 0.0 : random * 2.0;
+        c[i] = run == 1 && i % 2 == 0 ? 0.0 : 1.0 - random;
+
+        if (i % 101 == 0)
+            b[i] = NAN;
+        if (run == 4)
+            a[i] = INFINITY;
+        if (i % 13 == 0) // Discriminant is exactly zero
+            a[i] = 1.0, b[i] = 2.0, c[i] = 1.0;
+    }
+
+    // Finite coefficients with NaN discriminant
+    a[5] = 1e300, b[5] = 1e300, c[5] = 1e300;
+}
+
+#define PARTITIONED_ASSERT_MATCHES_BATCH()                                                 \
+    do {                                                                                   \
+        equation_solution_columns expected_columns = expected.columns();                   \
+        equation_solution_columns actual_columns = actual.columns();                       \
+                                                                                           \
+        const size_t expected_failed = solve_quadratic_equation_batch(                     \
+            a, b, c, PARTITION_TEST_SIZE, &expected_columns);                              \
+        const size_t actual_failed = solve_quadratic_equation_batch_partitioned(           \
+            a, b, c, PARTITION_TEST_SIZE, &actual_columns);                                \
+                                                                                           \
+        ASSERT_EQUAL((int) actual_failed, (int) expected_failed);                          \
+                                                                                           \
+        for (size_t i = 0; i < PARTITION_TEST_SIZE; ++ i) {                                \
+            ASSERT_EQUAL(actual.error_code[i], expected.error_code[i]);                    \
+            ASSERT_EQUAL(actual.status[i], expected.status[i]);                            \
+            ASSERT_EQUAL(actual.number_of_roots[i], expected.number_of_roots[i]);          \
+            ASSERT_EQUAL(is_same_double(actual.first_root[i], expected.first_root[i]),     \
+                         true);                                                            \
+            ASSERT_EQUAL(is_same_double(actual.second_root[i], expected.second_root[i]),   \
+                         true);                                                            \
+        }                                                                                  \
+    } while(false)
+
+
+TEST(equations_are_classified_like_solver_sees_them) {
+    ASSERT_EQUAL(classify_equation(1.0, 2.0, 3.0), QUADRATIC_EQUATION);
+    ASSERT_EQUAL(classify_equation(1e-10, 2.0, 3.0), LINEAR_EQUATION);
+    ASSERT_EQUAL(classify_equation(0.0, 1e-10, 3.0), DEGENERATE_EQUATION);
+    ASSERT_EQUAL(classify_equation(0.0, 0.0, 0.0), DEGENERATE_EQUATION);
+    ASSERT_EQUAL(classify_equation(0.0, 0.0, NAN), INVALID_EQUATION);
+    ASSERT_EQUAL(classify_equation(-INFINITY, 1.0, 1.0), INVALID_EQUATION);
+}
+
+TEST(partitioned_batch_matches_batch_on_every_tier) {
+    fill_mixed_classes();
+
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    for (int tier = SCALAR_KERNEL; tier <= AVX512_KERNEL; ++ tier) {
+        if (force_kernel_tier((kernel_tier) tier) != 0)
+            continue;
+
+        PARTITIONED_ASSERT_MATCHES_BATCH();
+    }
+
+    force_kernel_tier(active_tier);
+}
+
+TEST(single_class_batches) {
+    for (size_t i = 0; i < PARTITION_TEST_SIZE; ++ i)
+        a[i] = 0.0, b[i] = (double) i + 1.0, c[i] = 3.0;
+
+    PARTITIONED_ASSERT_MATCHES_BATCH();
+
+    for (size_t i = 0; i < PARTITION_TEST_SIZE; ++ i)
+        a[i] = 1.0, b[i] = (double) i, c[i] = -1.0;
+
+    PARTITIONED_ASSERT_MATCHES_BATCH();
+}
+
+TEST_MAIN()
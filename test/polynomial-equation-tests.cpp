@@ -0,0 +1,262 @@
+#include "test-framework.h"
+#include "quadratic-equation-solver.h"
+#include "polynomial-equation-solver.h"
+
+#include <cmath>
+#include <cstdint>
+
+#define POLYNOMIAL_TEST_SIZE 2003
+
+struct quartic_test_columns {
+    solution_status status[POLYNOMIAL_TEST_SIZE];
+    int number_of_roots[POLYNOMIAL_TEST_SIZE];
+    double root[4][POLYNOMIAL_TEST_SIZE];
+    int error_code[POLYNOMIAL_TEST_SIZE];
+
+    cubic_equation_solution_columns cubic_columns() {
+        return { status, number_of_roots, { root[0], root[1], root[2] }, error_code };
+    }
+
+    quartic_equation_solution_columns quartic_columns() {
+        return { status, number_of_roots, { root[0], root[1], root[2], root[3] }, error_code };
+    }
+};
+
+static double a[POLYNOMIAL_TEST_SIZE], b[POLYNOMIAL_TEST_SIZE], c[POLYNOMIAL_TEST_SIZE],
+              d[POLYNOMIAL_TEST_SIZE], e[POLYNOMIAL_TEST_SIZE];
+static quartic_test_columns actual;
+
+static bool is_same_double(const double x, const double y) {
+    return memcmp(&x, &y, sizeof(double)) == 0;
+}
+
+// Roots in ascending order, each within 1e-9 of the expected one
+template <int max_number_of_roots>
+static bool has_roots(const basic_equation_solution<double, max_number_of_roots>* const solution,
+                      const int number_of_roots, const double* const roots) {
+
+    if (solution->status != FINITE_ROOTS || solution->number_of_roots != number_of_roots)
+        return false;
+
+    for (int i = 0; i < number_of_roots; ++ i)
+        if (!(std::fabs(solution->root[i] - roots[i]) <= 1e-9))
+            return false;
+
+    return true;
+}
+
+// Every class of equation, interleaved
+static void fill_coefficients(void) {
+    uint64_t state = 17;
+
+    for (size_t i = 0; i < POLYNOMIAL_TEST_SIZE; ++ i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        const double random = (double) (state >> 11) / 9007199254740992.0 * 8.0 - 4.0;
+
+        a[i] = i % 5 == 0 ? 0.0 : random;
+        b[i] = i % 7 == 0 ? 0.0 : random * 2.0 - 1.0;
+        c[i] = i % 11 == 0 ? 0.0 : 1.0 - random;
+        d[i] = i % 3 == 0 ? 0.0 : random * random - 2.0;
+        e[i] = i % 13 == 0 ? 0.0 : 0.5 - random;
+
+        if (i % 25 == 0) // Leading zeros reduce the degree twice
+            b[i] = 0.0;
+        if (i % 31 == 0)
+            c[i] = NAN;
+        if (i % 37 == 0)
+            e[i] = -INFINITY;
+    }
+}
+
+TEST(cubic_with_three_roots) {
+    cubic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0 } };
+
+    // (x - 1)(x - 2)(x - 3), then with negative a
+    const double roots[] = { 1.0, 2.0, 3.0 };
+
+    ASSERT_EQUAL(solve_cubic_equation(1.0, -6.0, 11.0, -6.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 3, roots), true);
+
+    ASSERT_EQUAL(solve_cubic_equation(-2.0, 12.0, -22.0, 12.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 3, roots), true);
+}
+
+TEST(cubic_with_one_root) {
+    cubic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0 } };
+
+    // (x + 1)(x^2 - x + 2) and x^3 - 8
+    const double minus_one[] = { -1.0 }, two[] = { 2.0 };
+
+    ASSERT_EQUAL(solve_cubic_equation(1.0, 0.0, 1.0, 2.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 1, minus_one), true);
+
+    ASSERT_EQUAL(solve_cubic_equation(1.0, 0.0, 0.0, -8.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 1, two), true);
+}
+
+TEST(cubic_with_multiple_roots) {
+    cubic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0 } };
+
+    // (x - 1)^2 (x + 2) and (x - 2)^3
+    const double double_root[] = { -2.0, 1.0 }, triple_root[] = { 2.0 };
+
+    ASSERT_EQUAL(solve_cubic_equation(1.0, 0.0, -3.0, 2.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 2, double_root), true);
+
+    ASSERT_EQUAL(solve_cubic_equation(1.0, -6.0, 12.0, -8.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 1, triple_root), true);
+}
+
+TEST(cubic_with_close_roots) {
+    cubic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0 } };
+
+    // (x - 0.01)(x - 0.02)(x - 0.03) has discriminant below epsilon, x^3 + x
+    // has q == 0 and no other real roots
+    const double close_roots[] = { 0.01, 0.02, 0.03 }, zero_root[] = { 0.0 };
+
+    ASSERT_EQUAL(solve_cubic_equation(1.0, -0.06, 0.0011, -0.000006, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 3, close_roots), true);
+
+    ASSERT_EQUAL(solve_cubic_equation(1.0, 0.0, 1.0, 0.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 1, zero_root), true);
+}
+
+TEST(quartic_with_four_roots) {
+    quartic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0, 0.0 } };
+
+    // (x - 1)(x - 2)(x - 3)(x - 4), and x^4 - 5x^2 + 4 which has no odd terms
+    const double roots[] = { 1.0, 2.0, 3.0, 4.0 }, symmetric_roots[] = { -2.0, -1.0, 1.0, 2.0 };
+
+    ASSERT_EQUAL(solve_quartic_equation(1.0, -10.0, 35.0, -50.0, 24.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 4, roots), true);
+
+    ASSERT_EQUAL(solve_quartic_equation(1.0, 0.0, -5.0, 0.0, 4.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 4, symmetric_roots), true);
+}
+
+TEST(quartic_with_fewer_roots) {
+    quartic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0, 0.0 } };
+
+    // (x^2 + 1)(x - 1)(x - 2), (x - 1)^2 (x + 1)^2 and x^4 + 1
+    const double two_roots[] = { 1.0, 2.0 }, double_roots[] = { -1.0, 1.0 };
+
+    ASSERT_EQUAL(solve_quartic_equation(1.0, -3.0, 3.0, -3.0, 2.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 2, two_roots), true);
+
+    ASSERT_EQUAL(solve_quartic_equation(1.0, 0.0, -2.0, 0.0, 1.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 2, double_roots), true);
+
+    ASSERT_EQUAL(solve_quartic_equation(1.0, 0.0, 0.0, 0.0, 1.0, &solution), 0);
+    ASSERT_EQUAL(solution.number_of_roots, 0);
+}
+
+TEST(zero_leading_coefficients_reduce_degree) {
+    quartic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0, 0.0 } };
+
+    // x^2 - 3x + 2, in ascending order unlike the quadratic solver
+    const double quadratic_roots[] = { 1.0, 2.0 }, linear_root[] = { -0.5 };
+
+    ASSERT_EQUAL(solve_quartic_equation(0.0, 0.0, 1.0, -3.0, 2.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 2, quadratic_roots), true);
+
+    ASSERT_EQUAL(solve_quartic_equation(0.0, 0.0, 0.0, 2.0, 1.0, &solution), 0);
+    ASSERT_EQUAL(has_roots(&solution, 1, linear_root), true);
+
+    ASSERT_EQUAL(solve_quartic_equation(0.0, 0.0, 0.0, 0.0, 0.0, &solution), 0);
+    ASSERT_EQUAL(solution.status, INF_ROOTS);
+
+    cubic_equation_solution cubic = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0 } };
+
+    ASSERT_EQUAL(solve_cubic_equation(0.0, 0.0, 0.0, 1.0, &cubic), 0);
+    ASSERT_EQUAL(cubic.status, FINITE_ROOTS);
+    ASSERT_EQUAL(cubic.number_of_roots, 0);
+}
+
+TEST(illegal_coefficients_are_numbered) {
+    quartic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0, 0.0 } };
+    cubic_equation_solution cubic = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0 } };
+
+    for (int i = 0; i < 5; ++ i) {
+        double coefficients[] = { 1.0, 1.0, 1.0, 1.0, 1.0 };
+        coefficients[i] = i % 2 == 0 ? NAN : INFINITY;
+
+        ASSERT_EQUAL(solve_quartic_equation(coefficients[0], coefficients[1], coefficients[2],
+                                            coefficients[3], coefficients[4], &solution), i + 1);
+
+        if (i < 4)
+            ASSERT_EQUAL(solve_cubic_equation(coefficients[0], coefficients[1], coefficients[2],
+                                              coefficients[3], &cubic), i + 1);
+    }
+}
+
+TEST(roots_have_small_residuals) {
+    fill_coefficients();
+
+    for (size_t i = 0; i < POLYNOMIAL_TEST_SIZE; ++ i) {
+        quartic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0, 0.0 } };
+        if (solve_quartic_equation(a[i], b[i], c[i], d[i], e[i], &solution) != 0)
+            continue;
+
+        for (int j = 0; j < solution.number_of_roots; ++ j) {
+            const double x = solution.root[j];
+
+            // Relative to the largest term, so big roots aren't held to absolute errors
+            const double residual = (((a[i] * x + b[i]) * x + c[i]) * x + d[i]) * x + e[i];
+            const double scale = std::fabs(a[i] * x * x * x * x) + std::fabs(b[i] * x * x * x) +
+                                 std::fabs(c[i] * x * x) + std::fabs(d[i] * x) + std::fabs(e[i]);
+
+            ASSERT_EQUAL((std::fabs(residual) <= 1e-6 * scale + 1e-9), true);
+
+            if (j > 0)
+                ASSERT_EQUAL((solution.root[j - 1] < x), true);
+        }
+    }
+}
+
+TEST(batches_match_single_equation_solvers) {
+    fill_coefficients();
+
+    cubic_equation_solution_columns cubic_columns = actual.cubic_columns();
+    const size_t cubic_failed =
+        solve_cubic_equation_batch(a, b, c, d, POLYNOMIAL_TEST_SIZE, &cubic_columns);
+
+    size_t expected_failed = 0;
+    for (size_t i = 0; i < POLYNOMIAL_TEST_SIZE; ++ i) {
+        cubic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0 } };
+        const int error = solve_cubic_equation(a[i], b[i], c[i], d[i], &solution);
+
+        ASSERT_EQUAL(actual.error_code[i], error);
+        ASSERT_EQUAL(actual.status[i], solution.status);
+        ASSERT_EQUAL(actual.number_of_roots[i], solution.number_of_roots);
+
+        for (int j = 0; j < 3; ++ j)
+            ASSERT_EQUAL(is_same_double(actual.root[j][i], solution.root[j]), true);
+
+        expected_failed += error != 0;
+    }
+
+    ASSERT_EQUAL((cubic_failed == expected_failed), true);
+
+    quartic_equation_solution_columns quartic_columns = actual.quartic_columns();
+    const size_t quartic_failed =
+        solve_quartic_equation_batch(a, b, c, d, e, POLYNOMIAL_TEST_SIZE, &quartic_columns);
+
+    expected_failed = 0;
+    for (size_t i = 0; i < POLYNOMIAL_TEST_SIZE; ++ i) {
+        quartic_equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0, 0.0, 0.0 } };
+        const int error = solve_quartic_equation(a[i], b[i], c[i], d[i], e[i], &solution);
+
+        ASSERT_EQUAL(actual.error_code[i], error);
+        ASSERT_EQUAL(actual.status[i], solution.status);
+        ASSERT_EQUAL(actual.number_of_roots[i], solution.number_of_roots);
+
+        for (int j = 0; j < 4; ++ j)
+            ASSERT_EQUAL(is_same_double(actual.root[j][i], solution.root[j]), true);
+
+        expected_failed += error != 0;
+    }
+
+    ASSERT_EQUAL((quartic_failed == expected_failed), true);
+}
+
+TEST_MAIN()
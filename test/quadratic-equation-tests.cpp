@@ -60,6 +60,21 @@ TEST(quadratic_equation_with_two_rational_roots) {
                                         /* Second root */ 1.0);
 }
 
+TEST(quadratic_equation_with_dominant_b) {
+    // Roots are about -1e-8 and -1e8, -b + sqrt(d) would cancel almost completely
+    for (double sign = -1.0; sign <= 1.0; sign += 2.0) {
+        equation_solution solution;
+        ASSERT_EQUAL(solve_quadratic_equation(1.0, sign * 1e8, 1.0, &solution), 0);
+        ASSERT_EQUAL(solution.number_of_roots, 2);
+
+        const double small_root = sign > 0 ? solution.root[0] : solution.root[1];
+        const double large_root = sign > 0 ? solution.root[1] : solution.root[0];
+
+        ASSERT_EQUAL((std::fabs(small_root + sign * 1e-8) <= 1e-23), true);
+        ASSERT_EQUAL((std::fabs(large_root + sign * 1e8) <= 1e-7), true);
+    }
+}
+
 TEST(quadratic_equation_with_one_rational_root) {
     QUADRATIC_EQUATION_ASSERT_ONE_ROOT(/* a */ 4.0, /* b */ 4.0, /* c */ 1.0,
                                        /* Root */ - 0.5);
@@ -0,0 +1,189 @@
+#include "test-framework.h"
+#include "quadratic-equation-queries.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+#include <cstdint>
+
+#define QUERY_TEST_SIZE 2003
+
+static double a[QUERY_TEST_SIZE], b[QUERY_TEST_SIZE], c[QUERY_TEST_SIZE];
+
+static solution_status status[QUERY_TEST_SIZE];
+static int number_of_roots[QUERY_TEST_SIZE], error_code[QUERY_TEST_SIZE];
+static double root[QUERY_TEST_SIZE];
+static bool has_root[QUERY_TEST_SIZE];
+
+static const double INTERVAL_LO = -1.0, INTERVAL_HI = 2.0;
+
+static bool is_same_double(const double x, const double y) {
+    return memcmp(&x, &y, sizeof(double)) == 0;
+}
+
+// Every class of equation, interleaved so that vector lanes mix them
+static void fill_coefficients(void) {
+    uint64_t state = 11;
+
+    for (size_t i = 0; i < QUERY_TEST_SIZE; ++ i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        const double random = (double) (state >> 11) / 9007199254740992.0 * 8.0 - 4.0;
+
+        a[i] = i % 5 == 0 ? 0.0 : random;
+        b[i] = i % 7 == 0 ? 0.0 : random * 2.0 - 1.0;
+        c[i] = i % 11 == 0 ? 0.0 : 1.0 - random;
+
+        if (i % 9 == 0) // Discriminant is exactly zero
+            a[i] = 1.0, b[i] = 2.0, c[i] = 1.0;
+        if (i % 31 == 0)
+            b[i] = NAN;
+        if (i % 37 == 0)
+            c[i] = -INFINITY;
+        if (i % 41 == 0)
+            a[i] = -random, b[i] = 0.0, c[i] = random; // Roots -1 and 1, a < 0
+    }
+
+    // Finite coefficients with NaN discriminant
+    a[6] = 1e300, b[6] = 1e300, c[6] = 1e300;
+    a[7] = -1e300, b[7] = 1e300, c[7] = 1e300;
+}
+
+static double expected_root(const equation_solution* const solution, const double a,
+                            const root_choice choice) {
+    if (solution->number_of_roots < 2)
+        return solution->root[0];
+
+    // First root is the larger one when a is positive
+    return (a > 0) == (choice == LARGEST_ROOT) ? solution->root[0] : solution->root[1];
+}
+
+static bool expected_has_root(const equation_solution* const solution) {
+    if (solution->status == INF_ROOTS)
+        return true;
+
+    for (int i = 0; i < solution->number_of_roots; ++ i)
+        if (INTERVAL_LO <= solution->root[i] && solution->root[i] <= INTERVAL_HI)
+            return true;
+
+    return false;
+}
+
+#define QUERY_ASSERT_MATCHES_SOLVER()                                                      \
+    do {                                                                                   \
+        const root_count_columns counts = { status, number_of_roots, error_code };         \
+                                                                                           \
+        for (int choice = SMALLEST_ROOT; choice <= LARGEST_ROOT; ++ choice) {              \
+            count_quadratic_equation_roots_batch(a, b, c, QUERY_TEST_SIZE, &counts);       \
+                                                                                           \
+            for (size_t i = 0; i < QUERY_TEST_SIZE; ++ i) {                                \
+                equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };            \
+                const int error = solve_quadratic_equation(a[i], b[i], c[i], &solution);   \
+                                                                                           \
+                ASSERT_EQUAL(error_code[i], error);                                        \
+                ASSERT_EQUAL(status[i], solution.status);                                  \
+                ASSERT_EQUAL(number_of_roots[i], solution.number_of_roots);                \
+            }                                                                              \
+                                                                                           \
+            find_quadratic_equation_root_batch(a, b, c, QUERY_TEST_SIZE,                   \
+                                               (root_choice) choice, &counts, root);       \
+                                                                                           \
+            for (size_t i = 0; i < QUERY_TEST_SIZE; ++ i) {                                \
+                equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };            \
+                const int error = solve_quadratic_equation(a[i], b[i], c[i], &solution);   \
+                                                                                           \
+                ASSERT_EQUAL(error_code[i], error);                                        \
+                ASSERT_EQUAL(number_of_roots[i], solution.number_of_roots);                \
+                ASSERT_EQUAL(is_same_double(root[i],                                       \
+                    expected_root(&solution, a[i], (root_choice) choice)), true);          \
+            }                                                                              \
+        }                                                                                  \
+                                                                                           \
+        const size_t found = has_quadratic_equation_root_in_batch(                         \
+            a, b, c, QUERY_TEST_SIZE, INTERVAL_LO, INTERVAL_HI, has_root);                 \
+                                                                                           \
+        size_t expected_found = 0;                                                         \
+        for (size_t i = 0; i < QUERY_TEST_SIZE; ++ i) {                                    \
+            equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };                \
+            const bool expected = solve_quadratic_equation(a[i], b[i], c[i], &solution) == 0 \
+                && expected_has_root(&solution);                                           \
+                                                                                           \
+            ASSERT_EQUAL(has_root[i], expected);                                           \
+            expected_found += expected;                                                    \
+        }                                                                                  \
+                                                                                           \
+        ASSERT_EQUAL((found == expected_found), true);                                     \
+    } while(false)
+
+
+TEST(batch_queries_match_solver_on_every_tier) {
+    fill_coefficients();
+
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    for (int tier = SCALAR_KERNEL; tier <= AVX512_KERNEL; ++ tier) {
+        if (force_kernel_tier((kernel_tier) tier) != 0)
+            continue;
+
+        QUERY_ASSERT_MATCHES_SOLVER();
+    }
+
+    force_kernel_tier(active_tier);
+}
+
+TEST(single_queries_match_solver) {
+    fill_coefficients();
+
+    for (size_t i = 0; i < QUERY_TEST_SIZE; ++ i) {
+        equation_solution solution = { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+        const int error = solve_quadratic_equation(a[i], b[i], c[i], &solution);
+
+        solution_status single_status = FINITE_ROOTS;
+        int single_number_of_roots = 0;
+
+        ASSERT_EQUAL(count_quadratic_equation_roots(a[i], b[i], c[i], &single_status,
+                                                    &single_number_of_roots), error);
+        if (error != 0)
+            continue;
+
+        ASSERT_EQUAL(single_status, solution.status);
+        ASSERT_EQUAL(single_number_of_roots, solution.number_of_roots);
+
+        double single_root = 0;
+        ASSERT_EQUAL(find_quadratic_equation_root(a[i], b[i], c[i], LARGEST_ROOT, &single_status,
+                                                  &single_number_of_roots, &single_root), 0);
+        ASSERT_EQUAL(is_same_double(single_root,
+                                    expected_root(&solution, a[i], LARGEST_ROOT)), true);
+
+        bool single_has_root = false;
+        ASSERT_EQUAL(has_quadratic_equation_root_in(a[i], b[i], c[i], INTERVAL_LO, INTERVAL_HI,
+                                                    &single_has_root), 0);
+        ASSERT_EQUAL(single_has_root, expected_has_root(&solution));
+    }
+}
+
+TEST(roots_are_ordered) {
+    solution_status single_status = FINITE_ROOTS;
+    int single_number_of_roots = 0;
+    double smallest = 0, largest = 0;
+
+    // (x - 1)(x - 3) with both signs of a
+    for (double sign = -1.0; sign <= 1.0; sign += 2.0) {
+        find_quadratic_equation_root(sign, -4.0 * sign, 3.0 * sign, SMALLEST_ROOT,
+                                     &single_status, &single_number_of_roots, &smallest);
+        find_quadratic_equation_root(sign, -4.0 * sign, 3.0 * sign, LARGEST_ROOT,
+                                     &single_status, &single_number_of_roots, &largest);
+
+        ASSERT_EQUAL(single_number_of_roots, 2);
+        ASSERT_EPSILON_EQUAL(smallest, 1.0);
+        ASSERT_EPSILON_EQUAL(largest, 3.0);
+    }
+
+    // Infinite roots are in every non-empty interval only
+    bool single_has_root = false;
+    has_quadratic_equation_root_in(0.0, 0.0, 0.0, 5.0, 6.0, &single_has_root);
+    ASSERT_EQUAL(single_has_root, true);
+
+    has_quadratic_equation_root_in(0.0, 0.0, 0.0, 6.0, 5.0, &single_has_root);
+    ASSERT_EQUAL(single_has_root, false);
+}
+
+TEST_MAIN()
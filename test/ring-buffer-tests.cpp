@@ -0,0 +1,90 @@
+#include "test-framework.h"
+#include "ring-buffer.h"
+
+#include <cstdint>
+#include <thread>
+
+#define RING_TEST_VALUES 200000
+#define RING_TEST_PRODUCERS 4
+
+TEST(capacity_is_rounded_up) {
+    spsc_ring<int> ring {};
+    ASSERT_EQUAL(init_spsc_ring(&ring, 5), 0);
+
+    int pushed = 0;
+    while (try_push_spsc_ring(&ring, pushed))
+        ++ pushed;
+
+    ASSERT_EQUAL(pushed, 8);
+
+    int value = -1;
+    ASSERT_EQUAL(try_pop_spsc_ring(&ring, &value), true);
+    ASSERT_EQUAL(value, 0);
+
+    // Freed slot can be taken again
+    ASSERT_EQUAL(try_push_spsc_ring(&ring, 8), true);
+    ASSERT_EQUAL(try_push_spsc_ring(&ring, 9), false);
+
+    destroy_spsc_ring(&ring);
+}
+
+TEST(spsc_ring_keeps_order_across_threads) {
+    spsc_ring<uint32_t> ring {};
+    ASSERT_EQUAL(init_spsc_ring(&ring, 16), 0);
+
+    std::thread producer([&ring] {
+        for (uint32_t i = 0; i < RING_TEST_VALUES; ++ i)
+            push_spsc_ring(&ring, i);
+    });
+
+    bool is_in_order = true;
+    for (uint32_t i = 0; i < RING_TEST_VALUES; ++ i) {
+        uint32_t value = 0;
+        pop_spsc_ring(&ring, &value);
+
+        is_in_order = is_in_order && value == i;
+    }
+
+    producer.join();
+    ASSERT_EQUAL(is_in_order, true);
+
+    destroy_spsc_ring(&ring);
+}
+
+TEST(mpsc_ring_delivers_every_value_once) {
+    mpsc_ring<uint32_t> ring {};
+    ASSERT_EQUAL(init_mpsc_ring(&ring, 16), 0);
+
+    std::thread producers[RING_TEST_PRODUCERS];
+    for (uint32_t producer = 0; producer < RING_TEST_PRODUCERS; ++ producer)
+        producers[producer] = std::thread([&ring, producer] {
+            for (uint32_t i = producer; i < RING_TEST_VALUES; i += RING_TEST_PRODUCERS)
+                push_mpsc_ring(&ring, i);
+        });
+
+    // Values of each producer must come in the order it pushed them
+    uint32_t next[RING_TEST_PRODUCERS] = {};
+    for (uint32_t producer = 0; producer < RING_TEST_PRODUCERS; ++ producer)
+        next[producer] = producer;
+
+    bool is_in_order = true;
+    for (uint32_t i = 0; i < RING_TEST_VALUES; ++ i) {
+        uint32_t value = 0;
+        pop_mpsc_ring(&ring, &value);
+
+        is_in_order = is_in_order && value == next[value % RING_TEST_PRODUCERS];
+        next[value % RING_TEST_PRODUCERS] += RING_TEST_PRODUCERS;
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+
+    ASSERT_EQUAL(is_in_order, true);
+
+    uint32_t value = 0;
+    ASSERT_EQUAL(try_pop_mpsc_ring(&ring, &value), false);
+
+    destroy_mpsc_ring(&ring);
+}
+
+TEST_MAIN()
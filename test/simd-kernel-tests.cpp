@@ -0,0 +1,124 @@
+#include "test-framework.h"
+#include "quadratic-equation-kernels.h"
+
+#include <cmath>
+
+// Odd, so every kernel also goes through its tail handling
+#define KERNEL_TEST_SIZE 1027
+
+struct kernel_test_columns {
+    double a[KERNEL_TEST_SIZE], b[KERNEL_TEST_SIZE], c[KERNEL_TEST_SIZE];
+
+    solution_status status[KERNEL_TEST_SIZE];
+    int number_of_roots[KERNEL_TEST_SIZE];
+    double first_root[KERNEL_TEST_SIZE], second_root[KERNEL_TEST_SIZE];
+    int error_code[KERNEL_TEST_SIZE];
+
+    size_t failed;
+};
+
+static kernel_test_columns expected_columns, actual_columns;
+
+// Deterministic mix of quadratic, linear, degenerate and illegal equations
+static void fill_mixed_coefficients(kernel_test_columns* const columns) {
+    unsigned state = 12345;
+    const double special[] = { 0.0, -0.0, 1e-10, 1.0, -2.0, NAN, INFINITY, -INFINITY };
+
+    for (size_t i = 0; i < KERNEL_TEST_SIZE; ++ i) {
+        double* const coefficients[] = { columns->a + i, columns->b + i, columns->c + i };
+
+        for (double* coefficient: coefficients) {
+            state = state * 1103515245u + 12345u;
+            const unsigned value = (state >> 8) & 0xffff;
+
+            if (value % 4 == 0)
+                *coefficient = special[(value / 4) % 8];
+            else
+                *coefficient = ((double) value - 32768.0) / 1024.0;
+        }
+    }
+}
+
+static void run_kernel(const batch_kernel kernel, kernel_test_columns* const columns) {
+    equation_solution_columns solutions {
+        columns->status, columns->number_of_roots,
+        { columns->first_root, columns->second_root }, columns->error_code
+    };
+
+    columns->failed = kernel(columns->a, columns->b, columns->c, KERNEL_TEST_SIZE, &solutions);
+}
+
+static bool same_double(const double x, const double y) {
+    return (std::isnan(x) && std::isnan(y)) || memcmp(&x, &y, sizeof(double)) == 0;
+}
+
+#define KERNEL_ASSERT_MATCHES_SCALAR(kernel)                                               \
+    do {                                                                                   \
+        fill_mixed_coefficients(&expected_columns);                                        \
+        fill_mixed_coefficients(&actual_columns);                                          \
+                                                                                           \
+        run_kernel(solve_quadratic_equation_batch_scalar, &expected_columns);              \
+        run_kernel((kernel), &actual_columns);                                             \
+                                                                                           \
+        ASSERT_EQUAL((int) actual_columns.failed, (int) expected_columns.failed);          \
+                                                                                           \
+        for (size_t i = 0; i < KERNEL_TEST_SIZE; ++ i) {                                   \
+            ASSERT_EQUAL(actual_columns.error_code[i], expected_columns.error_code[i]);    \
+            ASSERT_EQUAL(actual_columns.status[i], expected_columns.status[i]);            \
+            ASSERT_EQUAL(actual_columns.number_of_roots[i],                                \
+                         expected_columns.number_of_roots[i]);                             \
+                                                                                           \
+            ASSERT_TRUE_WITH_EXPECTATION(                                                  \
+                same_double(actual_columns.first_root[i], expected_columns.first_root[i]), \
+                "%lf", actual_columns.first_root[i], expected_columns.first_root[i]);      \
+                                                                                           \
+            ASSERT_TRUE_WITH_EXPECTATION(                                                  \
+                same_double(actual_columns.second_root[i],                                 \
+                            expected_columns.second_root[i]),                              \
+                "%lf", actual_columns.second_root[i], expected_columns.second_root[i]);    \
+        }                                                                                  \
+    } while(false)
+
+
+TEST(scalar_kernel_matches_single_equation_solver) {
+    fill_mixed_coefficients(&expected_columns);
+    run_kernel(solve_quadratic_equation_batch_scalar, &expected_columns);
+
+    for (size_t i = 0; i < KERNEL_TEST_SIZE; ++ i) {
+        equation_solution solution { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+        const int error = solve_quadratic_equation(expected_columns.a[i], expected_columns.b[i],
+                                                   expected_columns.c[i], &solution);
+
+        ASSERT_EQUAL(expected_columns.error_code[i], error);
+        if (error != 0)
+            continue;
+
+        ASSERT_EQUAL(expected_columns.status[i], solution.status);
+        ASSERT_EQUAL(expected_columns.number_of_roots[i], solution.number_of_roots);
+        ASSERT_TRUE_WITH_EXPECTATION(same_double(expected_columns.first_root[i], solution.root[0]),
+                                     "%lf", expected_columns.first_root[i], solution.root[0]);
+        ASSERT_TRUE_WITH_EXPECTATION(same_double(expected_columns.second_root[i], solution.root[1]),
+                                     "%lf", expected_columns.second_root[i], solution.root[1]);
+    }
+}
+
+TEST(sse2_kernel_matches_scalar_kernel) {
+    KERNEL_ASSERT_MATCHES_SCALAR(solve_quadratic_equation_batch_sse2);
+}
+
+TEST(avx2_kernel_matches_scalar_kernel) {
+    if (!__builtin_cpu_supports("avx2"))
+        return;
+
+    KERNEL_ASSERT_MATCHES_SCALAR(solve_quadratic_equation_batch_avx2);
+}
+
+TEST(avx512_kernel_matches_scalar_kernel) {
+    if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512dq") ||
+        !__builtin_cpu_supports("avx512vl"))
+        return;
+
+    KERNEL_ASSERT_MATCHES_SCALAR(solve_quadratic_equation_batch_avx512);
+}
+
+TEST_MAIN()
@@ -0,0 +1,266 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "solution-aggregate.h"
+#include "quadratic-equation-dispatch.h"
+
+#include <cmath>
+#include <cstdint>
+
+// Several parallel chunks and a partial last block
+#define AGGREGATE_TEST_SIZE 20011
+
+static double a[AGGREGATE_TEST_SIZE], b[AGGREGATE_TEST_SIZE], c[AGGREGATE_TEST_SIZE];
+static test_solution_columns<AGGREGATE_TEST_SIZE> solutions;
+
+// Every class of equation, interleaved, with roots both inside and outside
+// [-10, 10], b of 1e300 makes one of the roots overflow
+static void fill_coefficients(void) {
+    uint64_t state = 7;
+
+    for (size_t i = 0; i < AGGREGATE_TEST_SIZE; ++ i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        const double random = (double) (state >> 11) / 9007199254740992.0 * 40.0 - 20.0;
+
+        a[i] = i % 7 == 0 ? 0.0 : random;
+        b[i] = i % 11 == 0 ? 0.0 : i % 103 == 0 ? 1e300 : random * 3.0 - 5.0;
+        c[i] = i % 13 == 0 ? 0.0 : i % 101 == 0 ? NAN : 10.0 - random;
+    }
+}
+
+static bool have_same_totals(const solution_aggregate* const x,
+                             const solution_aggregate* const y) {
+
+    if (x->equations != y->equations || x->roots != y->roots ||
+        x->non_finite_roots != y->non_finite_roots)
+        return false;
+
+    for (size_t i = 0; i < 3; ++ i)
+        if (x->illegal[i] != y->illegal[i])
+            return false;
+
+    for (size_t status = 0; status < 2; ++ status)
+        for (size_t roots = 0; roots < 3; ++ roots)
+            if (x->counts[status][roots] != y->counts[status][roots])
+                return false;
+
+    if (!is_same_double(x->min_root, y->min_root) || !is_same_double(x->max_root, y->max_root))
+        return false;
+
+    if (x->below_histogram != y->below_histogram || x->above_histogram != y->above_histogram)
+        return false;
+
+    for (size_t i = 0; i < AGGREGATE_HISTOGRAM_MAX_BINS; ++ i)
+        if (x->histogram[i] != y->histogram[i])
+            return false;
+
+    const double x_mean = get_aggregate_mean_root(x), y_mean = get_aggregate_mean_root(y);
+    return std::fabs(x_mean - y_mean) <= 1e-12 * std::fabs(y_mean);
+}
+
+
+TEST(known_equations_are_counted) {
+    // Roots 1 and 2, no roots, single root 1, every x, linear root 2,
+    // illegal a, illegal c, roots -12 and 12
+    const double known_a[] = { 1.0,  1.0, 1.0,  0.0, 0.0,  NAN, 1.0,      1.0   };
+    const double known_b[] = { -3.0, 0.0, -2.0, 0.0, 2.0,  1.0, 1.0,      0.0   };
+    const double known_c[] = { 2.0,  1.0, 1.0,  0.0, -4.0, 1.0, INFINITY, -144.0 };
+
+    const size_t count = sizeof(known_a) / sizeof(known_a[0]);
+
+    solution_aggregate aggregate;
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, 0.0, 4.0, 4), 0);
+
+    const size_t failed = aggregate_quadratic_equation_batch(&aggregate, known_a, known_b,
+                                                             known_c, count);
+    ASSERT_EQUAL((int) failed, 2);
+
+    ASSERT_EQUAL((int) aggregate.equations, (int) count);
+    ASSERT_EQUAL((int) aggregate.illegal[0], 1);
+    ASSERT_EQUAL((int) aggregate.illegal[1], 0);
+    ASSERT_EQUAL((int) aggregate.illegal[2], 1);
+
+    ASSERT_EQUAL((int) aggregate.counts[FINITE_ROOTS][0], 1);
+    ASSERT_EQUAL((int) aggregate.counts[FINITE_ROOTS][1], 2);
+    ASSERT_EQUAL((int) aggregate.counts[FINITE_ROOTS][2], 2);
+    ASSERT_EQUAL((int) aggregate.counts[INF_ROOTS][0], 1);
+
+    ASSERT_EQUAL((int) aggregate.roots, 6);
+    ASSERT_EQUAL((aggregate.min_root == -12.0), true);
+    ASSERT_EQUAL((aggregate.max_root == 12.0), true);
+    ASSERT_EQUAL((get_aggregate_mean_root(&aggregate) == 1.0), true);
+
+    ASSERT_EQUAL((int) aggregate.below_histogram, 1);
+    ASSERT_EQUAL((int) aggregate.above_histogram, 1);
+    ASSERT_EQUAL((int) aggregate.histogram[0], 0);
+    ASSERT_EQUAL((int) aggregate.histogram[1], 2);
+    ASSERT_EQUAL((int) aggregate.histogram[2], 2);
+    ASSERT_EQUAL((int) aggregate.histogram[3], 0);
+}
+
+TEST(histogram_edges_go_to_inner_bins) {
+    // x^2 - 4 == 0 has roots -2 and 2, the edges of the histogram
+    const double edge_a = 1.0, edge_b = 0.0, edge_c = -4.0;
+
+    solution_aggregate aggregate;
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, -2.0, 2.0, 8), 0);
+
+    aggregate_quadratic_equation_batch(&aggregate, &edge_a, &edge_b, &edge_c, 1);
+
+    ASSERT_EQUAL((int) aggregate.below_histogram, 0);
+    ASSERT_EQUAL((int) aggregate.above_histogram, 0);
+    ASSERT_EQUAL((int) aggregate.histogram[0], 1);
+    ASSERT_EQUAL((int) aggregate.histogram[7], 1);
+}
+
+TEST(empty_aggregate_has_no_mean) {
+    solution_aggregate aggregate;
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, -1.0, 1.0, 1), 0);
+
+    ASSERT_EQUAL((int) aggregate.equations, 0);
+    ASSERT_EQUAL(std::isnan(get_aggregate_mean_root(&aggregate)), true);
+}
+
+TEST(bad_histograms_are_rejected) {
+    solution_aggregate aggregate;
+
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, 1.0, 1.0, 4), -1);
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, 2.0, 1.0, 4), -1);
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, NAN, 1.0, 4), -1);
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, 0.0, INFINITY, 4), -1);
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, 0.0, 1.0, 0), -1);
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, 0.0, 1.0, AGGREGATE_HISTOGRAM_MAX_BINS + 1),
+                 -1);
+    ASSERT_EQUAL(init_solution_aggregate(&aggregate, 0.0, 1.0, AGGREGATE_HISTOGRAM_MAX_BINS), 0);
+
+    solution_aggregate other;
+    ASSERT_EQUAL(init_solution_aggregate(&other, 0.0, 1.0, 8), 0);
+
+    ASSERT_EQUAL(merge_solution_aggregates(&aggregate, &other), -1);
+}
+
+TEST(streaming_matches_materialized_solutions) {
+    fill_coefficients();
+
+    equation_solution_columns columns = solutions.columns();
+    const size_t expected_failed =
+        solve_quadratic_equation_batch(a, b, c, AGGREGATE_TEST_SIZE, &columns);
+
+    solution_aggregate expected;
+    init_solution_aggregate(&expected, -10.0, 10.0, 20);
+    aggregate_equation_solutions(&expected, &columns, AGGREGATE_TEST_SIZE);
+
+    solution_aggregate actual;
+    init_solution_aggregate(&actual, -10.0, 10.0, 20);
+
+    const size_t actual_failed =
+        aggregate_quadratic_equation_batch(&actual, a, b, c, AGGREGATE_TEST_SIZE);
+
+    ASSERT_EQUAL((int) actual_failed, (int) expected_failed);
+    ASSERT_EQUAL(have_same_totals(&actual, &expected), true);
+
+    // Every equation and every finite root is counted exactly once
+    uint64_t equations = actual.illegal[0] + actual.illegal[1] + actual.illegal[2];
+    uint64_t roots_in_histogram = actual.below_histogram + actual.above_histogram;
+
+    for (size_t status = 0; status < 2; ++ status)
+        for (size_t roots = 0; roots < 3; ++ roots)
+            equations += actual.counts[status][roots];
+
+    for (size_t i = 0; i < actual.histogram_bins; ++ i)
+        roots_in_histogram += actual.histogram[i];
+
+    ASSERT_EQUAL((int) equations, AGGREGATE_TEST_SIZE);
+    ASSERT_EQUAL((int) roots_in_histogram, (int) actual.roots);
+}
+
+TEST(merged_halves_match_whole_batch) {
+    fill_coefficients();
+
+    const size_t half = AGGREGATE_TEST_SIZE / 2;
+
+    solution_aggregate whole, first_half, second_half;
+    init_solution_aggregate(&whole, -10.0, 10.0, 20);
+    init_solution_aggregate(&first_half, -10.0, 10.0, 20);
+    init_solution_aggregate(&second_half, -10.0, 10.0, 20);
+
+    aggregate_quadratic_equation_batch(&whole, a, b, c, AGGREGATE_TEST_SIZE);
+    aggregate_quadratic_equation_batch(&first_half, a, b, c, half);
+    aggregate_quadratic_equation_batch(&second_half, a + half, b + half, c + half,
+                                       AGGREGATE_TEST_SIZE - half);
+
+    ASSERT_EQUAL(merge_solution_aggregates(&first_half, &second_half), 0);
+    ASSERT_EQUAL(have_same_totals(&first_half, &whole), true);
+}
+
+TEST(parallel_aggregate_matches_serial) {
+    fill_coefficients();
+
+    solution_aggregate expected;
+    init_solution_aggregate(&expected, -10.0, 10.0, 20);
+
+    const size_t expected_failed =
+        aggregate_quadratic_equation_batch(&expected, a, b, c, AGGREGATE_TEST_SIZE);
+
+    const size_t thread_counts[] = { 1, 3 };
+
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++ i) {
+        solver_thread_pool* pool = create_solver_thread_pool(thread_counts[i]);
+        ASSERT_EQUAL((pool != NULL), true);
+
+        solution_aggregate actual;
+        init_solution_aggregate(&actual, -10.0, 10.0, 20);
+
+        const size_t actual_failed = aggregate_quadratic_equation_batch_parallel(
+            pool, &actual, a, b, c, AGGREGATE_TEST_SIZE);
+
+        ASSERT_EQUAL((int) actual_failed, (int) expected_failed);
+        ASSERT_EQUAL(have_same_totals(&actual, &expected), true);
+
+        destroy_solver_thread_pool(pool);
+    }
+}
+
+TEST(every_kernel_tier_counts_the_same) {
+    fill_coefficients();
+
+    const kernel_tier active_tier = get_active_kernel_tier();
+
+    force_kernel_tier(SCALAR_KERNEL);
+
+    solution_aggregate expected;
+    init_solution_aggregate(&expected, -10.0, 10.0, 20);
+    aggregate_quadratic_equation_batch(&expected, a, b, c, AGGREGATE_TEST_SIZE);
+
+    ASSERT_EQUAL((expected.non_finite_roots > 0), true);
+
+    for (int tier = SSE2_KERNEL; tier <= AVX512_KERNEL; ++ tier) {
+        // Not every machine has every tier
+        if (force_kernel_tier((kernel_tier) tier) != 0)
+            continue;
+
+        solution_aggregate actual;
+        init_solution_aggregate(&actual, -10.0, 10.0, 20);
+        aggregate_quadratic_equation_batch(&actual, a, b, c, AGGREGATE_TEST_SIZE);
+
+        ASSERT_EQUAL(have_same_totals(&actual, &expected), true);
+    }
+
+    force_kernel_tier(active_tier);
+}
+
+BENCHMARK(aggregate_batch, 100) {
+    static bool is_filled = false;
+
+    if (!is_filled) {
+        fill_coefficients();
+        is_filled = true;
+    }
+
+    solution_aggregate aggregate;
+    init_solution_aggregate(&aggregate, -10.0, 10.0, 20);
+
+    aggregate_quadratic_equation_batch(&aggregate, a, b, c, AGGREGATE_TEST_SIZE);
+    BENCHMARK_KEEP(aggregate.roots);
+}
+
+TEST_MAIN()
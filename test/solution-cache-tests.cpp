@@ -0,0 +1,176 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "solution-cache.h"
+#include "quadratic-equation-parallel.h"
+
+#include <cmath>
+
+// Coefficients repeat with period 7 * 11 * 13, so most lookups are hits
+#define CACHE_TEST_SIZE (PARALLEL_BATCH_CHUNK_SIZE * 5 + 77)
+
+static double a[CACHE_TEST_SIZE], b[CACHE_TEST_SIZE], c[CACHE_TEST_SIZE];
+static test_solution_columns<CACHE_TEST_SIZE> expected, actual;
+
+static bool is_same_solution(const equation_solution* const x, const equation_solution* const y) {
+    return x->status == y->status && x->number_of_roots == y->number_of_roots &&
+        is_same_double(x->root[0], y->root[0]) && is_same_double(x->root[1], y->root[1]);
+}
+
+#define CACHE_ASSERT_COLUMNS_MATCH()                                                       \
+    ASSERT_EQUAL(have_same_solutions(&actual, 0, &expected, 0, CACHE_TEST_SIZE), true)
+
+
+TEST(cached_solution_matches_solver) {
+    solution_cache* cache = create_solution_cache(64);
+    ASSERT_EQUAL((cache != NULL), true);
+    ASSERT_EQUAL((int) solution_cache_capacity(cache), 64);
+
+    const double triples[][3] = {
+        { 1.0, -3.0, 2.0 }, { 1.0, 2.0, 1.0 }, { 1.0, 0.0, 1.0 },
+        { 0.0, 2.0, 1.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 }
+    };
+
+    for (int pass = 0; pass < 2; ++ pass)
+        for (const auto& triple: triples) {
+            equation_solution solution = {}, cached = {};
+
+            ASSERT_EQUAL(solve_quadratic_equation(triple[0], triple[1], triple[2], &solution), 0);
+            ASSERT_EQUAL(solve_quadratic_equation_cached(cache, triple[0], triple[1], triple[2],
+                                                         &cached), 0);
+
+            ASSERT_EQUAL(is_same_solution(&cached, &solution), true);
+        }
+
+    const solution_cache_stats stats = get_solution_cache_stats(cache);
+    ASSERT_EQUAL((int) stats.misses, 6);
+    ASSERT_EQUAL((int) stats.hits, 6);
+    ASSERT_EQUAL((int) stats.evictions, 0);
+
+    clear_solution_cache(cache);
+    ASSERT_EQUAL((int) get_solution_cache_stats(cache).hits, 0);
+
+    destroy_solution_cache(cache);
+}
+
+TEST(illegal_equations_are_not_cached) {
+    solution_cache* cache = create_solution_cache(16);
+    ASSERT_EQUAL((cache != NULL), true);
+
+    equation_solution solution = {};
+    for (int pass = 0; pass < 3; ++ pass) {
+        ASSERT_EQUAL(solve_quadratic_equation_cached(cache, NAN, 1.0, 1.0, &solution), 1);
+        ASSERT_EQUAL(solve_quadratic_equation_cached(cache, 1.0, 1.0, INFINITY, &solution), 3);
+    }
+
+    const solution_cache_stats stats = get_solution_cache_stats(cache);
+    ASSERT_EQUAL((int) stats.misses, 6);
+    ASSERT_EQUAL((int) stats.hits, 0);
+
+    destroy_solution_cache(cache);
+}
+
+TEST(keys_are_compared_bit_by_bit) {
+    solution_cache* cache = create_solution_cache(16);
+    ASSERT_EQUAL((cache != NULL), true);
+
+    equation_solution solution = {};
+    solve_quadratic_equation_cached(cache, 1.0, 0.0, -4.0, &solution);
+    solve_quadratic_equation_cached(cache, 1.0, -0.0, -4.0, &solution);
+
+    ASSERT_EQUAL((int) get_solution_cache_stats(cache).misses, 2);
+
+    destroy_solution_cache(cache);
+}
+
+TEST(clock_evicts_only_unreferenced_entries) {
+    // Smallest cache is a single probe window, so every key competes for it
+    solution_cache* cache = create_solution_cache(1);
+    ASSERT_EQUAL((cache != NULL), true);
+    ASSERT_EQUAL((int) solution_cache_capacity(cache), (int) SOLUTION_CACHE_PROBE_LENGTH);
+
+    equation_solution solution = {};
+    for (size_t i = 0; i < SOLUTION_CACHE_PROBE_LENGTH; ++ i)
+        solve_quadratic_equation_cached(cache, 1.0, (double) i, -1.0, &solution);
+
+    // Every key but the last one is used again
+    for (size_t i = 0; i + 1 < SOLUTION_CACHE_PROBE_LENGTH; ++ i)
+        solve_quadratic_equation_cached(cache, 1.0, (double) i, -1.0, &solution);
+
+    solve_quadratic_equation_cached(cache, 1.0, 100.0, -1.0, &solution);
+
+    solution_cache_stats stats = get_solution_cache_stats(cache);
+    ASSERT_EQUAL((int) stats.evictions, 1);
+
+    for (size_t i = 0; i + 1 < SOLUTION_CACHE_PROBE_LENGTH; ++ i)
+        solve_quadratic_equation_cached(cache, 1.0, (double) i, -1.0, &solution);
+
+    const uint64_t hits = get_solution_cache_stats(cache).hits;
+    ASSERT_EQUAL((hits == stats.hits + SOLUTION_CACHE_PROBE_LENGTH - 1), true);
+
+    destroy_solution_cache(cache);
+}
+
+TEST(cached_batch_matches_batch) {
+    fill_periodic_coefficients(a, b, c, CACHE_TEST_SIZE);
+
+    solution_cache* cache = create_solution_cache(4096);
+    ASSERT_EQUAL((cache != NULL), true);
+
+    equation_solution_columns expected_columns = expected.columns();
+    equation_solution_columns actual_columns = actual.columns();
+
+    const size_t expected_failed = solve_quadratic_equation_batch(a, b, c, CACHE_TEST_SIZE,
+                                                                  &expected_columns);
+
+    for (int pass = 0; pass < 2; ++ pass) {
+        const size_t actual_failed = solve_quadratic_equation_batch_cached(
+            cache, a, b, c, CACHE_TEST_SIZE, &actual_columns);
+
+        ASSERT_EQUAL((int) actual_failed, (int) expected_failed);
+        CACHE_ASSERT_COLUMNS_MATCH();
+    }
+
+    const solution_cache_stats stats = get_solution_cache_stats(cache);
+    ASSERT_EQUAL((int) (stats.hits + stats.misses), (int) (2 * CACHE_TEST_SIZE));
+    ASSERT_EQUAL((stats.hits > stats.misses), true);
+
+    destroy_solution_cache(cache);
+}
+
+TEST(sharded_cache_matches_batch_in_parallel) {
+    fill_periodic_coefficients(a, b, c, CACHE_TEST_SIZE);
+
+    solver_thread_pool* pool = create_solver_thread_pool(3);
+    ASSERT_EQUAL((pool != NULL), true);
+
+    sharded_solution_cache* cache = create_sharded_solution_cache(4096, 5);
+    ASSERT_EQUAL((cache != NULL), true);
+    ASSERT_EQUAL((int) sharded_solution_cache_shards(cache), 8);
+
+    equation_solution_columns expected_columns = expected.columns();
+    equation_solution_columns actual_columns = actual.columns();
+
+    const size_t expected_failed = solve_quadratic_equation_batch(a, b, c, CACHE_TEST_SIZE,
+                                                                  &expected_columns);
+
+    for (int pass = 0; pass < 2; ++ pass) {
+        const size_t actual_failed = solve_quadratic_equation_batch_parallel_cached(
+            pool, cache, a, b, c, CACHE_TEST_SIZE, &actual_columns);
+
+        ASSERT_EQUAL((int) actual_failed, (int) expected_failed);
+        CACHE_ASSERT_COLUMNS_MATCH();
+    }
+
+    solution_cache_stats stats = get_sharded_solution_cache_stats(cache);
+    ASSERT_EQUAL((int) (stats.hits + stats.misses), (int) (2 * CACHE_TEST_SIZE));
+    ASSERT_EQUAL((stats.hits > stats.misses), true);
+
+    clear_sharded_solution_cache(cache);
+    stats = get_sharded_solution_cache_stats(cache);
+    ASSERT_EQUAL((int) (stats.hits + stats.misses + stats.evictions), 0);
+
+    destroy_sharded_solution_cache(cache);
+    destroy_solver_thread_pool(pool);
+}
+
+TEST_MAIN()
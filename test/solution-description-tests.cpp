@@ -0,0 +1,87 @@
+#include "test-framework.h"
+#include "solution-description.h"
+
+#include <cmath>
+
+#define ASSERT_STRING_EQUAL(actual, expected)                                              \
+    ASSERT_TRUE_WITH_EXPECTATION(strcmp((actual), (expected)) == 0, "%s", actual, expected)
+
+#define DESCRIPTION_ASSERT(solution, expected_description)                                 \
+    do {                                                                                   \
+        char buffer[EQUATION_DESCRIPTION_MAX_LENGTH + 1];                                  \
+        const int written = describe_equation_solution_fast(&(solution), buffer);          \
+                                                                                           \
+        ASSERT_EQUAL(written, (int) strlen(expected_description));                         \
+        ASSERT_STRING_EQUAL(buffer, (expected_description));                               \
+    } while(false)
+
+
+TEST(fast_description_of_every_status) {
+    equation_solution two_roots { FINITE_ROOTS, 2, { 0.5, -3.0 } };
+    DESCRIPTION_ASSERT(two_roots, "Equation has 2 roots: 0.5, -3");
+
+    equation_solution one_root { FINITE_ROOTS, 1, { 0.1, 0.0 } };
+    DESCRIPTION_ASSERT(one_root, "Equation has 1 roots: 0.1");
+
+    equation_solution no_roots { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+    DESCRIPTION_ASSERT(no_roots, "Equation has no solution");
+
+    equation_solution infinite { INF_ROOTS, 0, { 0.0, 0.0 } };
+    DESCRIPTION_ASSERT(infinite, "This equation has infinite number of roots");
+}
+
+TEST(longest_description_fits_into_bound) {
+    equation_solution longest { FINITE_ROOTS, 2,
+                                { -2.2250738585072014e-308, -1.2345678901234567e-300 } };
+
+    char buffer[EQUATION_DESCRIPTION_MAX_LENGTH + 1];
+    const int written = describe_equation_solution_fast(&longest, buffer);
+
+    ASSERT_EQUAL(written, (int) EQUATION_DESCRIPTION_MAX_LENGTH);
+
+    // Shortest form reads back exactly
+    const double parsed_root = strtod(buffer + strlen("Equation has 2 roots: "), NULL);
+    ASSERT_EQUAL((parsed_root == longest.root[0]), true);
+}
+
+TEST(corrupted_solutions_are_rejected) {
+    equation_solution bad_status { (solution_status) 42, 0, { 0.0, 0.0 } };
+    equation_solution bad_roots { FINITE_ROOTS, 3, { 0.0, 0.0 } };
+
+    char buffer[EQUATION_DESCRIPTION_MAX_LENGTH + 1];
+    ASSERT_EQUAL(describe_equation_solution_fast(&bad_status, buffer), CORRUPTED_SOLUTION);
+    ASSERT_EQUAL(describe_equation_solution_fast(&bad_roots, buffer), CORRUPTED_SOLUTION);
+}
+
+TEST(batch_descriptions_share_one_arena) {
+    const double a[] = { 1.0, 0.0, 1.0, NAN };
+    const double b[] = { 3.0, 0.0, 0.0, 1.0 };
+    const double c[] = { 2.0, 0.0, 1.0, 1.0 };
+
+    solution_status status[4];
+    int number_of_roots[4], error_code[4];
+    double first_root[4], second_root[4];
+
+    equation_solution_columns solutions {
+        status, number_of_roots, { first_root, second_root }, error_code
+    };
+
+    solve_quadratic_equation_batch(a, b, c, 4, &solutions);
+
+    char arena[4 * (EQUATION_DESCRIPTION_MAX_LENGTH + 1)];
+    size_t offsets[5];
+
+    ASSERT_EQUAL((int) description_arena_size(4), (int) sizeof(arena));
+
+    const long used = describe_equation_solutions_batch(&solutions, 4, arena, offsets);
+    ASSERT_EQUAL((int) used, (int) offsets[4]);
+
+    ASSERT_STRING_EQUAL(arena + offsets[0], "Equation has 2 roots: -1, -2");
+    ASSERT_STRING_EQUAL(arena + offsets[1], "This equation has infinite number of roots");
+    ASSERT_STRING_EQUAL(arena + offsets[2], "Equation has no solution");
+    ASSERT_STRING_EQUAL(arena + offsets[3], "Illegal value for argument 1");
+
+    ASSERT_EQUAL((int) (offsets[1] - offsets[0] - 1), (int) strlen(arena + offsets[0]));
+}
+
+TEST_MAIN()
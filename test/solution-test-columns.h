@@ -0,0 +1,63 @@
+#ifndef EQUATION_SOLVER_SOLUTION_TEST_COLUMNS_H
+#define EQUATION_SOLVER_SOLUTION_TEST_COLUMNS_H
+
+#include <cstddef>
+#include <cmath>
+#include <string.h>
+
+#include "quadratic-equation-batch.h"
+
+// Output columns of `size` equations, large ones should be static
+template <size_t size>
+struct test_solution_columns {
+    solution_status status[size];
+    int number_of_roots[size];
+    double first_root[size], second_root[size];
+    int error_code[size];
+
+    // Columns starting at equation `first`
+    equation_solution_columns columns(const size_t first = 0) {
+        return { status + first, number_of_roots + first,
+                 { first_root + first, second_root + first }, error_code + first };
+    }
+};
+
+// Compares bits, so NaN matches only the same NaN and 0.0 doesn't match -0.0
+static inline bool is_same_double(const double x, const double y) {
+    return memcmp(&x, &y, sizeof(double)) == 0;
+}
+
+// Whether `count` solutions of `actual` from `actual_first` are identical to
+// the ones of `expected` from `expected_first`
+template <size_t actual_size, size_t expected_size>
+bool have_same_solutions(const test_solution_columns<actual_size>* const actual,
+                         const size_t actual_first,
+                         const test_solution_columns<expected_size>* const expected,
+                         const size_t expected_first, const size_t count) {
+
+    for (size_t i = 0; i < count; ++ i) {
+        const size_t x = actual_first + i, y = expected_first + i;
+
+        if (actual->status[x] != expected->status[y] ||
+            actual->number_of_roots[x] != expected->number_of_roots[y] ||
+            actual->error_code[x] != expected->error_code[y] ||
+            !is_same_double(actual->first_root[x], expected->first_root[y]) ||
+            !is_same_double(actual->second_root[x], expected->second_root[y]))
+            return false;
+    }
+
+    return true;
+}
+
+// Two roots, one root, no roots, linear and infinite roots cases repeat
+// with period 7 * 11 * 13, every 1000th c starting from the first is NaN
+static inline void fill_periodic_coefficients(double* const a, double* const b,
+                                              double* const c, const size_t count) {
+    for (size_t i = 0; i < count; ++ i) {
+        a[i] = (double) (i % 7) - 3.0;
+        b[i] = (double) (i % 11) - 5.0;
+        c[i] = i % 1000 == 0 ? NAN : (double) (i % 13) - 6.0;
+    }
+}
+
+#endif // EQUATION_SOLVER_SOLUTION_TEST_COLUMNS_H
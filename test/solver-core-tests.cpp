@@ -0,0 +1,124 @@
+#include "test-framework.h"
+#include "quadratic-equation-batch.h"
+
+#include <cmath>
+
+#define CORE_TEST_SIZE 64
+
+// Solved entirely by the compiler
+constexpr basic_equation_solution<double> solve_at_compile_time(const double a, const double b,
+                                                                const double c) {
+    basic_equation_solution<double> solution { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+    basic_solve_quadratic_equation(a, b, c, &solution);
+    return solution;
+}
+
+constexpr basic_equation_solution<double> two_roots = solve_at_compile_time(1.0, -3.0, 2.0);
+static_assert(two_roots.number_of_roots == 2, "x^2 - 3x + 2 has two roots");
+static_assert(two_roots.root[0] == 2.0 && two_roots.root[1] == 1.0, "roots are 2 and 1");
+
+constexpr basic_equation_solution<double> infinite = solve_at_compile_time(0.0, 0.0, 0.0);
+static_assert(infinite.status == INF_ROOTS, "0 == 0 has infinitely many roots");
+
+constexpr double irrational_root = solve_at_compile_time(1.0, 0.0, -2.0).root[0];
+static_assert(irrational_root * irrational_root - 2.0 < 1e-15 &&
+              irrational_root * irrational_root - 2.0 > -1e-15, "root is sqrt(2)");
+
+
+// Treats everything below one thousandth as zero
+struct coarse_tolerance {
+    static constexpr bool is_zero(const double value) {
+        return std::fabs(value) <= 1e-3;
+    }
+};
+
+
+TEST(float_and_long_double_solvers) {
+    basic_equation_solution<float> float_solution { FINITE_ROOTS, 0, { 0.0f, 0.0f } };
+    ASSERT_EQUAL(basic_solve_quadratic_equation(2.0f, -2.0f, -12.0f, &float_solution), 0);
+
+    ASSERT_EQUAL(float_solution.number_of_roots, 2);
+    ASSERT_EPSILON_EQUAL(float_solution.root[0], 3.0);
+    ASSERT_EPSILON_EQUAL(float_solution.root[1], -2.0);
+
+    basic_equation_solution<long double> long_solution { FINITE_ROOTS, 0, { 0.0L, 0.0L } };
+    ASSERT_EQUAL(basic_solve_quadratic_equation(1.0L, 2.0L, 1.0L, &long_solution), 0);
+
+    ASSERT_EQUAL(long_solution.number_of_roots, 1);
+    ASSERT_EPSILON_EQUAL((double) long_solution.root[0], -1.0);
+
+    // Errors are reported the same way for every type
+    ASSERT_EQUAL(basic_solve_quadratic_equation(1.0f, INFINITY, 1.0f, &float_solution), 2);
+    ASSERT_EQUAL(basic_solve_linear_equation(1.0L, (long double) NAN, &long_solution), 2);
+}
+
+TEST(custom_tolerance_policy) {
+    basic_equation_solution<double> solution { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+
+    // Discriminant 1e-4 is two roots by default...
+    basic_solve_quadratic_equation(1.0, 0.0, -2.5e-5, &solution);
+    ASSERT_EQUAL(solution.number_of_roots, 2);
+
+    // ...and a single one with a coarser tolerance
+    basic_solve_quadratic_equation<double, coarse_tolerance>(1.0, 0.0, -2.5e-5, &solution);
+    ASSERT_EQUAL(solution.number_of_roots, 1);
+
+    basic_solve_quadratic_equation<double, coarse_tolerance>(1e-4, 1.0, 0.0, &solution);
+    ASSERT_EQUAL(solution.number_of_roots, 1);
+    ASSERT_EPSILON_EQUAL(solution.root[0], 0.0);
+}
+
+TEST(wrappers_match_templates) {
+    equation_solution wrapper { FINITE_ROOTS, 0, { 0.0, 0.0 } };
+    ASSERT_EQUAL(solve_quadratic_equation(1.0, -3.0, 2.0, &wrapper), 0);
+
+    ASSERT_EQUAL(wrapper.number_of_roots, two_roots.number_of_roots);
+    ASSERT_EPSILON_EQUAL(wrapper.root[0], two_roots.root[0]);
+    ASSERT_EPSILON_EQUAL(wrapper.root[1], two_roots.root[1]);
+}
+
+TEST(float_batch_matches_double_batch) {
+    float a[CORE_TEST_SIZE], b[CORE_TEST_SIZE], c[CORE_TEST_SIZE];
+    double double_a[CORE_TEST_SIZE], double_b[CORE_TEST_SIZE], double_c[CORE_TEST_SIZE];
+
+    for (size_t i = 0; i < CORE_TEST_SIZE; ++ i) {
+        // Small integers are exact in both types
+        a[i] = (float) ((int) (i % 5) - 2);
+        b[i] = (float) ((int) (i % 7) - 3);
+        c[i] = i == 13 ? NAN : (float) ((int) (i % 3) - 1);
+
+        double_a[i] = a[i], double_b[i] = b[i], double_c[i] = c[i];
+    }
+
+    solution_status float_status[CORE_TEST_SIZE], double_status[CORE_TEST_SIZE];
+    int float_roots[CORE_TEST_SIZE], double_roots[CORE_TEST_SIZE];
+    int float_error[CORE_TEST_SIZE], double_error[CORE_TEST_SIZE];
+    float float_first[CORE_TEST_SIZE], float_second[CORE_TEST_SIZE];
+    double double_first[CORE_TEST_SIZE], double_second[CORE_TEST_SIZE];
+
+    float_equation_solution_columns float_solutions {
+        float_status, float_roots, { float_first, float_second }, float_error
+    };
+
+    equation_solution_columns double_solutions {
+        double_status, double_roots, { double_first, double_second }, double_error
+    };
+
+    const size_t float_failed = solve_quadratic_equation_batch_float(
+        a, b, c, CORE_TEST_SIZE, &float_solutions);
+    const size_t double_failed = solve_quadratic_equation_batch(
+        double_a, double_b, double_c, CORE_TEST_SIZE, &double_solutions);
+
+    ASSERT_EQUAL((int) float_failed, (int) double_failed);
+
+    for (size_t i = 0; i < CORE_TEST_SIZE; ++ i) {
+        ASSERT_EQUAL(float_error[i], double_error[i]);
+        ASSERT_EQUAL(float_status[i], double_status[i]);
+        ASSERT_EQUAL(float_roots[i], double_roots[i]);
+
+        ASSERT_EQUAL((std::fabs(float_first[i] - double_first[i]) <= 1e-6), true);
+        ASSERT_EQUAL((std::fabs(float_second[i] - double_second[i]) <= 1e-6), true);
+    }
+}
+
+TEST_MAIN()
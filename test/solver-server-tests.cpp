@@ -0,0 +1,149 @@
+#include "test-framework.h"
+#include "solution-test-columns.h"
+#include "solver-server.h"
+#include "solver-client.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+
+#define SERVER_TEST_SIZE 1000
+#define SERVER_TEST_CLIENTS 4
+
+static double a[SERVER_TEST_SIZE], b[SERVER_TEST_SIZE], c[SERVER_TEST_SIZE];
+static test_solution_columns<SERVER_TEST_SIZE> expected;
+
+static void fill_equations(void) {
+    fill_periodic_coefficients(a, b, c, SERVER_TEST_SIZE);
+
+    equation_solution_columns columns = expected.columns();
+    solve_quadratic_equation_batch(a, b, c, SERVER_TEST_SIZE, &columns);
+}
+
+// Starts server on a fresh socket and on a free TCP port, stops it on destruction
+struct running_test_server {
+    char socket_path[108];
+    solver_server* server;
+    std::thread thread;
+
+    running_test_server() : socket_path(), server(NULL), thread() {
+        snprintf(socket_path, sizeof(socket_path), "/tmp/equation-solver-%d.sock", (int) getpid());
+
+        const solver_server_config config { socket_path, true, 0 };
+        server = create_solver_server(&config);
+
+        if (server != NULL)
+            thread = std::thread(run_solver_server, server);
+    }
+
+    ~running_test_server() {
+        if (server == NULL)
+            return;
+
+        stop_solver_server(server);
+        thread.join();
+        destroy_solver_server(server);
+    }
+};
+
+TEST(remote_batch_matches_local_batch) {
+    fill_equations();
+    running_test_server running;
+    ASSERT_EQUAL((running.server != NULL), true);
+
+    static test_solution_columns<SERVER_TEST_SIZE> actual;
+    equation_solution_columns columns = actual.columns();
+
+    solver_client* const client = connect_solver_client(running.socket_path);
+    ASSERT_EQUAL((client != NULL), true);
+    ASSERT_EQUAL(solve_quadratic_equation_remote(client, a, b, c, SERVER_TEST_SIZE, &columns), 0);
+    ASSERT_EQUAL(have_same_solutions(&actual, 0, &expected, 0, SERVER_TEST_SIZE), true);
+    disconnect_solver_client(client);
+
+    solver_client* const tcp_client = connect_solver_client_tcp(solver_server_tcp_port(running.server));
+    ASSERT_EQUAL((tcp_client != NULL), true);
+    ASSERT_EQUAL(solve_quadratic_equation_remote(tcp_client, a, b, c, 1, &columns), 0);
+    ASSERT_EQUAL(have_same_solutions(&actual, 0, &expected, 0, 1), true);
+    disconnect_solver_client(tcp_client);
+}
+
+TEST(pipelined_requests_of_many_clients) {
+    fill_equations();
+    running_test_server running;
+    ASSERT_EQUAL((running.server != NULL), true);
+
+    static test_solution_columns<SERVER_TEST_SIZE> results[SERVER_TEST_CLIENTS];
+    bool is_correct[SERVER_TEST_CLIENTS] = {};
+
+    std::thread clients[SERVER_TEST_CLIENTS];
+    for (size_t index = 0; index < SERVER_TEST_CLIENTS; ++ index)
+        clients[index] = std::thread([&, index] {
+            solver_client* const client = connect_solver_client(running.socket_path);
+            equation_solution_columns columns = results[index].columns();
+
+            // Small requests of different sizes, all sent before any is received
+            bool is_ok = client != NULL;
+            size_t first = 0;
+            for (size_t size = 1; is_ok && first + size <= SERVER_TEST_SIZE; first += size ++)
+                is_ok = send_solver_request(client, first, a + first, b + first, c + first,
+                                            size) == 0;
+
+            first = 0;
+            for (size_t size = 1; is_ok && first + size <= SERVER_TEST_SIZE; first += size ++) {
+                uint64_t id = 0;
+                size_t count = 0;
+
+                is_ok = receive_solver_response(client, &id, &columns, SERVER_TEST_SIZE,
+                                                &count) == 0 &&
+                    id == first && count == size &&
+                    have_same_solutions(results + index, 0, &expected, first, size);
+            }
+
+            is_correct[index] = is_ok;
+            disconnect_solver_client(client);
+        });
+
+    for (std::thread& client : clients)
+        client.join();
+
+    for (size_t index = 0; index < SERVER_TEST_CLIENTS; ++ index)
+        ASSERT_EQUAL(is_correct[index], true);
+}
+
+TEST(malformed_request_closes_connection) {
+    running_test_server running;
+    ASSERT_EQUAL((running.server != NULL), true);
+
+    solver_client* const client = connect_solver_client(running.socket_path);
+    ASSERT_EQUAL((client != NULL), true);
+
+    // Too many equations
+    static test_solution_columns<SERVER_TEST_SIZE> actual;
+    equation_solution_columns columns = actual.columns();
+
+    ASSERT_EQUAL(send_solver_request(client, 0, a, b, c, SOLVER_PROTOCOL_MAX_EQUATIONS + 1), -1);
+
+    // Wrong magic, sent through a plain socket
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, running.socket_path);
+
+    ASSERT_EQUAL(connect(fd, (const sockaddr*) &address, sizeof(address)), 0);
+
+    const solver_request_header header = { 0x12345678, 1, 0 };
+    ASSERT_EQUAL((int) send(fd, &header, sizeof(header), 0), (int) sizeof(header));
+
+    char byte = 0;
+    ASSERT_EQUAL((int) recv(fd, &byte, 1, 0), 0); // Server closed the connection
+    close(fd);
+
+    // Other connections keep working
+    ASSERT_EQUAL(solve_quadratic_equation_remote(client, a, b, c, 10, &columns), 0);
+    disconnect_solver_client(client);
+}
+
+TEST_MAIN()
@@ -0,0 +1,114 @@
+#include "test-framework.h"
+#include "solver-stats.h"
+#include "quadratic-equation-solver.h"
+#include "quadratic-equation-dispatch.h"
+#include "quadratic-equation-batch.h"
+#include "solution-description.h"
+
+#include <cmath>
+#include <thread>
+
+static void solve_one_of_each_branch(void) {
+    equation_solution solution;
+
+    solve_quadratic_equation(1.0, -3.0, 2.0, &solution);      // Two roots
+    solve_quadratic_equation(1.0, 2.0, 1.0, &solution);       // One root
+    solve_quadratic_equation(1.0, 0.0, 1.0, &solution);       // No roots
+    solve_quadratic_equation(0.0, 2.0, 1.0, &solution);       // Linear
+    solve_quadratic_equation(0.0, 0.0, 0.0, &solution);       // Linear, INF_ROOTS
+    solve_quadratic_equation(NAN, 1.0, 1.0, &solution);       // Illegal a
+    solve_quadratic_equation(1.0, INFINITY, 1.0, &solution);  // Illegal b
+    solve_quadratic_equation(1.0, 1.0, NAN, &solution);       // Illegal c
+}
+
+TEST(every_branch_is_counted) {
+    // Tester links the library built with EQUATION_SOLVER_STATS
+    ASSERT_EQUAL(solver_stats_enabled(), true);
+
+    reset_solver_stats();
+    solve_one_of_each_branch();
+
+    solver_stats_snapshot snapshot;
+    take_solver_stats_snapshot(&snapshot);
+
+    ASSERT_EQUAL((snapshot.counters[STATS_TWO_ROOTS] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_ONE_ROOT] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_NO_ROOTS] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_LINEAR_FALLBACK] == 2u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_INF_ROOTS] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_ILLEGAL_A] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_ILLEGAL_B] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_ILLEGAL_C] == 1u), true);
+}
+
+TEST(finished_threads_are_still_counted) {
+    reset_solver_stats();
+
+    std::thread first(solve_one_of_each_branch), second(solve_one_of_each_branch);
+    first.join();
+    second.join();
+
+    solve_one_of_each_branch();
+
+    solver_stats_snapshot snapshot;
+    take_solver_stats_snapshot(&snapshot);
+
+    ASSERT_EQUAL((snapshot.counters[STATS_TWO_ROOTS] == 3u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_LINEAR_FALLBACK] == 6u), true);
+
+    reset_solver_stats();
+    take_solver_stats_snapshot(&snapshot);
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_COUNTERS; ++ i)
+        ASSERT_EQUAL((snapshot.counters[i] == 0), true);
+}
+
+TEST(batch_outcomes_are_counted) {
+    double a[] = { 1.0,  1.0, 0.0, NAN };
+    double b[] = { -3.0, 0.0, 2.0, 1.0 };
+    double c[] = { 2.0,  1.0, 1.0, 1.0 };
+
+    solution_status status[4];
+    int number_of_roots[4], error_code[4];
+    double first_root[4], second_root[4];
+
+    const equation_solution_columns columns = {
+        status, number_of_roots, { first_root, second_root }, error_code
+    };
+
+    reset_solver_stats();
+    solve_quadratic_equation_batch(a, b, c, 4, &columns);
+
+    solver_stats_snapshot snapshot;
+    take_solver_stats_snapshot(&snapshot);
+
+    ASSERT_EQUAL((snapshot.counters[STATS_TWO_ROOTS] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_NO_ROOTS] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_LINEAR_FALLBACK] == 1u), true);
+    ASSERT_EQUAL((snapshot.counters[STATS_ILLEGAL_A] == 1u), true);
+}
+
+TEST(latency_is_sampled) {
+    reset_solver_stats();
+
+    equation_solution solution;
+    char description[EQUATION_DESCRIPTION_MAX_LENGTH + 1];
+
+    for (uint32_t i = 0; i < STATS_SAMPLING_PERIOD * 10; ++ i) {
+        solve_quadratic_equation(1.0, (double) i, -1.0, &solution);
+        describe_equation_solution_fast(&solution, description);
+    }
+
+    solver_stats_snapshot snapshot;
+    take_solver_stats_snapshot(&snapshot);
+
+    for (size_t i = 0; i < NUMBER_OF_STATS_HISTOGRAMS; ++ i) {
+        uint64_t samples = 0;
+        for (size_t bucket = 0; bucket < STATS_HISTOGRAM_BUCKETS; ++ bucket)
+            samples += snapshot.histograms[i][bucket];
+
+        ASSERT_EQUAL((samples == 10u), true);
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,123 @@
+#include "test-framework.h"
+#include "stream-pipeline.h"
+#include "coefficient-text-io.h"
+
+#include <stdio.h>
+#include <cstdint>
+
+// Several input buffers and many blocks, last block is partial
+#define PIPELINE_TEST_LINES 70001
+
+// Writes test input to @p input and the output it must give to @p expected
+static void write_test_files(FILE* const input, FILE* const expected) {
+    uint64_t state = 3;
+
+    for (size_t i = 0; i < PIPELINE_TEST_LINES; ++ i) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+
+        const double a = i % 7 == 0 ? 0.0 : (double) (int) (state >> 40) / 1000.0 - 8000.0;
+        const double b = (double) (int) ((state >> 20) & 0xfffff) / 100.0 - 5000.0;
+        const double c = i % 11 == 0 ? 0.0 : (double) (int) (state & 0xfffff) / 10.0 - 50000.0;
+
+        if (i % 1000 == 0)
+            fprintf(input, "# comment\n\n");
+
+        if (i % 997 == 0) {
+            fprintf(input, "%g abc %g\n", a, c);
+            fprintf(expected, "error 2\n");
+            continue;
+        }
+
+        fprintf(input, "%.17g %.17g %.17g\n", a, b, c);
+
+        equation_solution solution {};
+        const int error_code = solve_quadratic_equation(a, b, c, &solution);
+
+        char line[SOLUTION_LINE_MAX_LENGTH];
+        const size_t length = format_solution_line(solution.status, solution.number_of_roots,
+                                                   solution.root, error_code, line);
+        fwrite(line, 1, length, expected);
+    }
+
+    rewind(input);
+    rewind(expected);
+}
+
+static bool is_same_file(FILE* const actual, FILE* const expected) {
+    rewind(actual);
+
+    int actual_symbol = 0, expected_symbol = 0;
+    do {
+        actual_symbol = fgetc(actual);
+        expected_symbol = fgetc(expected);
+
+        if (actual_symbol != expected_symbol)
+            return false;
+    } while (actual_symbol != EOF);
+
+    return true;
+}
+
+TEST(output_is_in_input_order) {
+    for (size_t number_of_solvers = 1; number_of_solvers <= 5; number_of_solvers += 2) {
+        FILE* const input = tmpfile();
+        FILE* const expected = tmpfile();
+        FILE* const actual = tmpfile();
+
+        write_test_files(input, expected);
+
+        ASSERT_EQUAL(run_stream_pipeline(input, actual, number_of_solvers), 0);
+        ASSERT_EQUAL(is_same_file(actual, expected), true);
+
+        fclose(input);
+        fclose(expected);
+        fclose(actual);
+    }
+}
+
+TEST(empty_input_gives_empty_output) {
+    FILE* const input = tmpfile();
+    FILE* const actual = tmpfile();
+
+    ASSERT_EQUAL(run_stream_pipeline(input, actual, 0), 0);
+    ASSERT_EQUAL((int) ftell(actual), 0);
+
+    fclose(input);
+    fclose(actual);
+}
+
+TEST(last_line_without_newline) {
+    FILE* const input = tmpfile();
+    FILE* const actual = tmpfile();
+
+    fputs("1 -3 2\n0 0 0", input);
+    rewind(input);
+
+    ASSERT_EQUAL(run_stream_pipeline(input, actual, 2), 0);
+
+    char text[64] = {};
+    rewind(actual);
+    fread(text, 1, sizeof(text) - 1, actual);
+
+    ASSERT_EQUAL(strcmp(text, "2 2 1\ninf\n"), 0);
+
+    fclose(input);
+    fclose(actual);
+}
+
+TEST(write_failure_is_reported) {
+    FILE* const input = tmpfile();
+    for (size_t i = 0; i < PIPELINE_TEST_LINES; ++ i)
+        fputs("1 -3 2\n", input);
+    rewind(input);
+
+    // Stream opened for reading only, every write fails
+    FILE* const output = fopen("/dev/null", "r");
+
+    ASSERT_EQUAL(run_stream_pipeline(input, output, 2), -1);
+
+    fclose(input);
+    fclose(output);
+}
+
+TEST_MAIN()
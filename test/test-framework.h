@@ -3,7 +3,13 @@
 #include <cstdlib>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
 #include <math.h>
+#include <time.h>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 struct __test_framework_entry {
     const char* test_name;
@@ -11,6 +17,9 @@ struct __test_framework_entry {
     int line_number;
 
     void (*test_function) ();
+
+    size_t iterations; // == 0 --> test
+                       //  > 0 --> benchmark, timed over that many calls
 };
 
 struct __test_framework_state {
@@ -80,7 +89,7 @@ static inline void __test_framework_get_test_name_with_spaces(const char* const
                                                               char* const new_name) {
 
     const size_t length = strlen(name); 
-    for (int i = 0; i < length; ++ i) {
+    for (size_t i = 0; i < length; ++ i) {
         char symbol = name[i];
 
         if (symbol == '_')
@@ -145,21 +154,276 @@ static inline void __test_framework_get_test_name_with_spaces(const char* const
     TEST_FRAMEWORK_INITIALIZER(name) {                                                       \
         __test_framework_entry entry {                                                       \
             #name, __FILE__, __LINE__,                                                       \
-            &__test_framework_test_##name                                                    \
+            &__test_framework_test_##name, 0                                                 \
         };                                                                                   \
         __test_framework_add_test_entry(entry);                                              \
     }                                                                                        \
     void __test_framework_test_##name(void)                                                  \
 
-static inline void __test_framework_entry_print_testing_stats(size_t failed_tests) {
-        size_t num_of_tests = __test_framework_current_state.used;
+// Body is one iteration. Benchmarks run once, as tests, unless the tester
+// is started with --benchmark, then they run alone, one at a time, and
+// report average time of an iteration
+#define BENCHMARK(name, iterations)                                                          \
+    void __test_framework_benchmark_##name(void);                                            \
+    TEST_FRAMEWORK_INITIALIZER(name) {                                                       \
+        __test_framework_entry entry {                                                       \
+            #name, __FILE__, __LINE__,                                                       \
+            &__test_framework_benchmark_##name, (iterations)                                 \
+        };                                                                                   \
+        __test_framework_add_test_entry(entry);                                              \
+    }                                                                                        \
+    void __test_framework_benchmark_##name(void)                                             \
+
+// Keeps the compiler from throwing away computation of a benchmark
+#define BENCHMARK_KEEP(value) asm volatile("" : : "g"(value) : "memory")
+
+
+static inline double __test_framework_seconds() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double) now.tv_sec + (double) now.tv_nsec * 1e-9;
+}
+
+// Runs test in the current process, returns its status
+static inline int __test_framework_run_entry(__test_framework_entry* const entry,
+                                             const bool benchmark) {
+
+    __test_framework_state *state = &__test_framework_current_state;
+
+    state->running_test = entry; /* Mark test running */
+    state->status = 0;
+
+    if (entry->iterations == 0 || !benchmark) {
+        entry->test_function();
+        return state->status;
+    }
+
+    entry->test_function(); // Warm up caches and branch predictor
+
+    const double start = __test_framework_seconds();
+
+    size_t done = 0;
+    for (; done < entry->iterations && state->status >= 0; ++ done)
+        entry->test_function();
+
+    const double elapsed = __test_framework_seconds() - start;
+
+    if (state->status >= 0)
+        printf(TEXT_INFO("[==> BENCHMARK <==]") " %s: " TEXT_INFO("%.2lf ns") " per iteration, "
+               "%zu iterations\n", entry->test_name, elapsed * 1e9 / (double) done, done);
+
+    return state->status;
+}
+
+// Prints result of a finished test, returns whether it passed
+static inline bool __test_framework_report(const __test_framework_entry* const entry,
+                                           const int status, const int signal,
+                                           const double seconds) {
+
+    char name_with_spaces[strlen(entry->test_name) + 1];
+    __test_framework_get_test_name_with_spaces(entry->test_name, name_with_spaces);
+
+    const double milliseconds = seconds * 1e3;
 
+    if (signal != 0) {
+        printf(TEXT_FAILED("[==> FAILED! <==] Test \"%s\" crashed with signal %d") "\n",
+               name_with_spaces, signal);
+        return false;
+    }
+
+    if (status < 0) {
+        printf("Failed after " TEXT_INFO("%.3lf ms") "\n", milliseconds);
+        return false;
+    }
+
+    // Benchmarks don't have to assert anything
+    if (status > 0 || entry->iterations > 0)
+        printf(TEXT_PASSED("[==> PASSED! <==] Test \"%s\"") " " TEXT_INFO("%.3lf ms") "\n",
+               name_with_spaces, milliseconds);
+    else
+        printf(TEXT_WARNING("[==> WARNING <==] Test \"%s\" asserts nothing") " "
+               TEXT_INFO("%.3lf ms") "\n", name_with_spaces, milliseconds);
+
+    return true;
+}
+
+// Test running in a child process, its output comes through a pipe and
+// is printed at once when the test finishes, so outputs don't interleave
+struct __test_framework_job {
+    __test_framework_entry *entry;
+
+    pid_t pid;
+    int output;
+    double start;
+
+    char *buffer;
+    size_t length;
+    size_t capacity;
+};
+
+static inline bool __test_framework_start_job(__test_framework_entry* const entry,
+                                              const bool benchmark,
+                                              __test_framework_job* const job) {
+    int pipe_ends[2];
+    if (pipe(pipe_ends) != 0)
+        return false;
+
+    fflush(stdout); // Otherwise child would print parent's buffered output again
+
+    const double start = __test_framework_seconds();
+    const pid_t pid = fork();
+
+    if (pid < 0) {
+        close(pipe_ends[0]);
+        close(pipe_ends[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        close(pipe_ends[0]);
+        dup2(pipe_ends[1], STDOUT_FILENO);
+        dup2(pipe_ends[1], STDERR_FILENO);
+        close(pipe_ends[1]);
+
+        // Keep what was printed before a crash. glibc ignores line buffering
+        // of a stream that was already used unless it's given a buffer
+        static char line_buffer[BUFSIZ];
+        setvbuf(stdout, line_buffer, _IOLBF, sizeof(line_buffer));
+
+        const int status = __test_framework_run_entry(entry, benchmark);
+
+        fflush(stdout);
+        _exit(status < 0 ? 1 : status == 0 ? 2 : 0);
+    }
+
+    close(pipe_ends[1]);
+
+    *job = { entry, pid, pipe_ends[0], start, NULL, 0, 0 };
+    return true;
+}
+
+// Returns false once child closed its output
+static inline bool __test_framework_read_job_output(__test_framework_job* const job) {
+    if (job->length == job->capacity) {
+        const size_t capacity = job->capacity == 0 ? 4096 : job->capacity * 2;
+
+        char* const new_buffer = (char*) realloc(job->buffer, capacity);
+        if (new_buffer == NULL)
+            return false;
+
+        job->buffer = new_buffer;
+        job->capacity = capacity;
+    }
+
+    const ssize_t got = read(job->output, job->buffer + job->length,
+                             job->capacity - job->length);
+    if (got < 0)
+        return errno == EINTR;
+
+    job->length += (size_t) got;
+    return got > 0;
+}
+
+// Waits for child, prints its output and result, returns whether it passed
+static inline bool __test_framework_finish_job(__test_framework_job* const job) {
+    close(job->output);
+
+    int wait_status = 0;
+    while (waitpid(job->pid, &wait_status, 0) < 0 && errno == EINTR)
+        ;
+
+    const double seconds = __test_framework_seconds() - job->start;
+
+    fwrite(job->buffer, 1, job->length, stdout);
+    free(job->buffer);
+
+    if (WIFSIGNALED(wait_status))
+        return __test_framework_report(job->entry, -1, WTERMSIG(wait_status), seconds);
+
+    const int exit_code = WIFEXITED(wait_status) ? WEXITSTATUS(wait_status) : 1;
+    return __test_framework_report(job->entry, exit_code == 0 ? 1 : exit_code == 2 ? 0 : -1,
+                                   0, seconds);
+}
+
+// Runs every test with up to `jobs` of them at a time, returns number of failed ones
+static inline size_t __test_framework_run_tests(const bool benchmark, const size_t jobs) {
+    __test_framework_state *state = &__test_framework_current_state;
+
+    __test_framework_job *running = (__test_framework_job*)
+        malloc(jobs * sizeof(__test_framework_job));
+    pollfd *outputs = (pollfd*) malloc(jobs * sizeof(pollfd));
+
+    size_t failed_tests = 0, next = 0, active = 0;
+
+    while (next < state->used || active > 0) {
+        for (; active < jobs && next < state->used; ++ next) {
+            __test_framework_entry* entry = state->tests + next;
+
+            if (benchmark && entry->iterations == 0)
+                continue;
+
+            if (running != NULL && outputs != NULL &&
+                __test_framework_start_job(entry, benchmark, running + active)) {
+                ++ active;
+                continue;
+            }
+
+            // No child process, run it here
+            const double start = __test_framework_seconds();
+            const int status = __test_framework_run_entry(entry, benchmark);
+
+            failed_tests += !__test_framework_report(entry, status, 0,
+                                                     __test_framework_seconds() - start);
+        }
+
+        if (active == 0)
+            continue;
+
+        for (size_t i = 0; i < active; ++ i)
+            outputs[i] = { running[i].output, POLLIN, 0 };
+
+        if (poll(outputs, active, -1) < 0)
+            continue;
+
+        // Backwards, so the job moved into a finished one's place is already checked
+        for (size_t i = active; i -- > 0; ) {
+            if (outputs[i].revents == 0 || __test_framework_read_job_output(running + i))
+                continue;
+
+            failed_tests += !__test_framework_finish_job(running + i);
+            running[i] = running[-- active];
+        }
+    }
+
+    free(outputs);
+    free(running);
+
+    return failed_tests;
+}
+
+// --jobs N, then TEST_FRAMEWORK_JOBS, then number of online processors
+static inline size_t __test_framework_number_of_jobs(const int argc, char** const argv) {
+    const char* jobs = getenv("TEST_FRAMEWORK_JOBS");
+
+    for (int i = 1; i + 1 < argc; ++ i)
+        if (strcmp(argv[i], "--jobs") == 0 || strcmp(argv[i], "-j") == 0)
+            jobs = argv[i + 1];
+
+    const long number_of_jobs = jobs != NULL ? atol(jobs) : sysconf(_SC_NPROCESSORS_ONLN);
+    return number_of_jobs > 0 ? (size_t) number_of_jobs : 1;
+}
+
+static inline void __test_framework_entry_print_testing_stats(size_t num_of_tests,
+                                                              size_t failed_tests,
+                                                              double seconds, size_t jobs) {
         const size_t passed_tests = num_of_tests - failed_tests;
 
         printf(TEXT_INFO("[==>  STATS  <==]") " ");
 
         const size_t graph_length = 20;
-        const size_t failed_graph_length = failed_tests * graph_length / num_of_tests;
+        const size_t failed_graph_length =
+            num_of_tests == 0 ? 0 : failed_tests * graph_length / num_of_tests;
 
         for (size_t i = 0; i < failed_graph_length; ++ i)
             printf(TEXT_FAILED("-"));
@@ -177,40 +441,39 @@ static inline void __test_framework_entry_print_testing_stats(size_t failed_test
 
         printf("Passed tests: " TEXT_PASSED("%zu") " " TEXT_INFO("%.0lf%%") "\n",
                passed_tests, passed_percent);
+
+        printf("   Wall time: " TEXT_INFO("%.3lf s") " with %zu jobs\n", seconds, jobs);
+}
+
+static inline int __test_framework_main(const int argc, char** const argv) {
+    __test_framework_state *state = &__test_framework_current_state;
+
+    bool benchmark = false;
+    for (int i = 1; i < argc; ++ i)
+        benchmark = benchmark || strcmp(argv[i], "--benchmark") == 0;
+
+    size_t num_of_tests = 0;
+    for (size_t i = 0; i < state->used; ++ i)
+        num_of_tests += !benchmark || state->tests[i].iterations > 0;
+
+    // Benchmarks would disturb each other's timings
+    size_t jobs = benchmark ? 1 : __test_framework_number_of_jobs(argc, argv);
+    jobs = num_of_tests != 0 && jobs > num_of_tests ? num_of_tests : jobs;
+
+    printf(TEXT_INFO("[==> MESSAGE <==] Running %zu %s") "\n", num_of_tests,
+           benchmark ? "benchmarks" : "tests");
+
+    const double start = __test_framework_seconds();
+    const size_t failed_tests = __test_framework_run_tests(benchmark, jobs);
+
+    __test_framework_entry_print_testing_stats(num_of_tests, failed_tests,
+                                               __test_framework_seconds() - start, jobs);
+
+    __test_framework_free_test_list();
+    return failed_tests == 0 ? 0 : 1;
 }
 
 #define TEST_MAIN()                                                                          \
-    int main(void) {                                                                         \
-        __test_framework_state *state = &__test_framework_current_state;                     \
-        printf(TEXT_INFO("[==> MESSAGE <==] Running %zu tests") "\n", state->used);          \
-                                                                                             \
-        int failed_tests = 0;                                                                \
-        for (int i = 0; i < state->used; ++ i) {                                             \
-            __test_framework_entry* entry = state->tests + i;                                \
-                                                                                             \
-            state->running_test = entry; /* Mark test running */                             \
-            entry->test_function();      /* Run test */                                      \
-                                                                                             \
-            const char* test_name = entry->test_name;                                        \
-                                                                                             \
-            char name_with_spaces[strlen(test_name) + 1];                                    \
-            __test_framework_get_test_name_with_spaces(test_name, name_with_spaces);         \
-                                                                                             \
-            if (state->status > 0)                                                           \
-                printf(TEXT_PASSED("[==> PASSED! <==] Test \"%s\"") "\n", name_with_spaces); \
-                                                                                             \
-            if (state->status == 0)                                                          \
-                printf(TEXT_WARNING("[==> WARNING <==] Test \"%s\" asserts nothing") "\n",   \
-                       name_with_spaces);                                                    \
-                                                                                             \
-            if (state->status < 0)                                                           \
-                ++ failed_tests;                                                             \
-                                                                                             \
-            state->status = 0;                                                               \
-        }                                                                                    \
-                                                                                             \
-        __test_framework_entry_print_testing_stats(failed_tests);                            \
-                                                                                             \
-        __test_framework_free_test_list();                                                   \
-        return 0;                                                                 \
+    int main(int argc, char** argv) {                                                        \
+        return __test_framework_main(argc, argv);                                            \
     }
@@ -0,0 +1,101 @@
+#include "test-framework.h"
+#include "coefficient-text-io.h"
+
+#include <cmath>
+
+#define PARSE_CAPACITY 8
+
+#define ASSERT_STRING_EQUAL(actual, expected)                                              \
+    ASSERT_TRUE_WITH_EXPECTATION(strcmp((actual), (expected)) == 0, "%s", actual, expected)
+
+TEST(parse_lines_with_different_separators) {
+    const char text[] = "1 2 3\n"
+                        "  -4.5,\t+6e2 , 7\r\n"
+                        "\n"
+                        "# comment line\n"
+                        "0 0 0\n";
+
+    double a[PARSE_CAPACITY], b[PARSE_CAPACITY], c[PARSE_CAPACITY];
+    size_t consumed = 0;
+
+    const size_t parsed = parse_coefficient_lines(text, strlen(text), true, a, b, c,
+                                                  PARSE_CAPACITY, &consumed);
+
+    ASSERT_EQUAL((int) parsed, 3);
+    ASSERT_EQUAL((int) consumed, (int) strlen(text));
+
+    ASSERT_EPSILON_EQUAL(a[0], 1.0);
+    ASSERT_EPSILON_EQUAL(b[0], 2.0);
+    ASSERT_EPSILON_EQUAL(c[0], 3.0);
+
+    ASSERT_EPSILON_EQUAL(a[1], -4.5);
+    ASSERT_EPSILON_EQUAL(b[1], 600.0);
+    ASSERT_EPSILON_EQUAL(c[1], 7.0);
+
+    ASSERT_EPSILON_EQUAL(a[2], 0.0);
+}
+
+TEST(illegal_and_missing_coefficients_become_nan) {
+    const char text[] = "1 abc 3\n"
+                        "1.5x 2\n";
+
+    double a[PARSE_CAPACITY], b[PARSE_CAPACITY], c[PARSE_CAPACITY];
+    size_t consumed = 0;
+
+    const size_t parsed = parse_coefficient_lines(text, strlen(text), true, a, b, c,
+                                                  PARSE_CAPACITY, &consumed);
+    ASSERT_EQUAL((int) parsed, 2);
+
+    ASSERT_EPSILON_EQUAL(a[0], 1.0);
+    ASSERT_EQUAL(std::isnan(b[0]), true);
+    ASSERT_EPSILON_EQUAL(c[0], 3.0);
+
+    ASSERT_EQUAL(std::isnan(a[1]), true);
+    ASSERT_EPSILON_EQUAL(b[1], 2.0);
+    ASSERT_EQUAL(std::isnan(c[1]), true);
+}
+
+TEST(unfinished_line_is_left_for_next_chunk) {
+    const char text[] = "1 2 3\n4 5";
+
+    double a[PARSE_CAPACITY], b[PARSE_CAPACITY], c[PARSE_CAPACITY];
+    size_t consumed = 0;
+
+    size_t parsed = parse_coefficient_lines(text, strlen(text), false, a, b, c,
+                                            PARSE_CAPACITY, &consumed);
+    ASSERT_EQUAL((int) parsed, 1);
+    ASSERT_EQUAL((int) consumed, 6);
+
+    // Capacity limits number of parsed lines too
+    parsed = parse_coefficient_lines("1 1 1\n2 2 2\n", 12, true, a, b, c, 1, &consumed);
+    ASSERT_EQUAL((int) parsed, 1);
+    ASSERT_EQUAL((int) consumed, 6);
+}
+
+TEST(format_solution_lines) {
+    char buffer[SOLUTION_LINE_MAX_LENGTH + 1];
+    const double roots[2] = { -0.1, 2.0 };
+
+    size_t written = format_solution_line(FINITE_ROOTS, 2, roots, 0, buffer);
+    buffer[written] = '\0';
+    ASSERT_STRING_EQUAL(buffer, "2 -0.1 2\n");
+
+    written = format_solution_line(FINITE_ROOTS, 0, roots, 0, buffer);
+    buffer[written] = '\0';
+    ASSERT_STRING_EQUAL(buffer, "0\n");
+
+    written = format_solution_line(INF_ROOTS, 0, roots, 0, buffer);
+    buffer[written] = '\0';
+    ASSERT_STRING_EQUAL(buffer, "inf\n");
+
+    written = format_solution_line(FINITE_ROOTS, 0, roots, 3, buffer);
+    buffer[written] = '\0';
+    ASSERT_STRING_EQUAL(buffer, "error 3\n");
+
+    // Longest possible roots still fit
+    const double long_roots[2] = { -1.2345678901234567e-308, -2.2250738585072014e-308 };
+    written = format_solution_line(FINITE_ROOTS, 2, long_roots, 0, buffer);
+    ASSERT_EQUAL((written <= SOLUTION_LINE_MAX_LENGTH), true);
+}
+
+TEST_MAIN()
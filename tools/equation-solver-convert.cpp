@@ -0,0 +1,219 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string.h>
+#include <stdio.h>
+#include <charconv>
+
+#include "binary-equation-files.h"
+#include "coefficient-text-io.h"
+
+static const size_t INPUT_BUFFER_SIZE  = 1 << 20;
+static const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+// Growable coefficient columns
+struct coefficient_columns {
+    double* a;
+    double* b;
+    double* c;
+
+    size_t count;
+    size_t capacity;
+};
+
+static bool reserve_columns(coefficient_columns* const columns, const size_t capacity) {
+    if (capacity <= columns->capacity)
+        return true;
+
+    double** const column_pointers[] = { &columns->a, &columns->b, &columns->c };
+    for (double** column: column_pointers) {
+        double* const grown = (double*) realloc(*column, capacity * sizeof(double));
+        if (grown == NULL)
+            return false;
+
+        *column = grown;
+    }
+
+    columns->capacity = capacity;
+    return true;
+}
+
+static void free_columns(coefficient_columns* const columns) {
+    free(columns->a);
+    free(columns->b);
+    free(columns->c);
+}
+
+static FILE* open_text_file(const char* const path, const char* const mode) {
+    if (strcmp(path, "-") == 0)
+        return mode[0] == 'r' ? stdin : stdout;
+
+    return fopen(path, mode);
+}
+
+static void close_text_file(FILE* const file) {
+    if (file != stdin && file != stdout)
+        fclose(file);
+}
+
+static int convert_text_to_binary(const char* const input_path, const char* const output_path) {
+    FILE* const input = open_text_file(input_path, "r");
+    if (input == NULL) {
+        fprintf(stderr, "Can't open \"%s\"\n", input_path);
+        return 1;
+    }
+
+    char* const text = (char*) malloc(INPUT_BUFFER_SIZE);
+    coefficient_columns columns {};
+
+    bool is_ok = text != NULL;
+    size_t filled = 0;
+    bool is_at_end = false;
+
+    while (is_ok && !(is_at_end && filled == 0)) {
+        filled += fread(text + filled, 1, INPUT_BUFFER_SIZE - filled, input);
+        is_at_end = feof(input) || ferror(input);
+
+        // Every line gives at most one triple
+        is_ok = reserve_columns(&columns, columns.count + filled / 2 + 1);
+        if (!is_ok)
+            break;
+
+        // A line that doesn't fit into the whole buffer is cut in two
+        const bool is_last_chunk = is_at_end || (filled == INPUT_BUFFER_SIZE &&
+                                                 memchr(text, '\n', filled) == NULL);
+
+        size_t consumed = 0;
+        columns.count += parse_coefficient_lines(text, filled, is_last_chunk,
+                                                 columns.a + columns.count,
+                                                 columns.b + columns.count,
+                                                 columns.c + columns.count,
+                                                 columns.capacity - columns.count, &consumed);
+
+        memmove(text, text + consumed, filled - consumed);
+        filled -= consumed;
+    }
+
+    if (ferror(input))
+        is_ok = false;
+
+    close_text_file(input);
+    free(text);
+
+    if (is_ok)
+        is_ok = write_coefficient_file(output_path, columns.a, columns.b, columns.c,
+                                       columns.count) == 0;
+
+    free_columns(&columns);
+
+    if (!is_ok) {
+        fprintf(stderr, "Conversion to binary failed\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static void write_coefficient_lines(const coefficient_file_view* const view,
+                                    text_output_sink* const sink) {
+
+    // Three shortest doubles, separators and newline
+    const size_t max_line_length = 3 * 25 + 3;
+
+    for (uint64_t i = 0; i < view->count; ++ i) {
+        char* current = reserve_text_output_sink(sink, max_line_length);
+        char* const line = current;
+
+        const double coefficients[] = { view->a[i], view->b[i], view->c[i] };
+        for (size_t j = 0; j < 3; ++ j) {
+            current = std::to_chars(current, line + max_line_length, coefficients[j]).ptr;
+            *current ++ = j == 2 ? '\n' : ' ';
+        }
+
+        sink->used += (size_t) (current - line);
+    }
+}
+
+static void write_solution_lines(const solution_file_view* const view,
+                                 text_output_sink* const sink) {
+
+    const equation_solution_columns* const columns = &view->columns;
+
+    for (uint64_t i = 0; i < view->count; ++ i) {
+        char* const line = reserve_text_output_sink(sink, SOLUTION_LINE_MAX_LENGTH);
+
+        const double roots[2] = { columns->root[0][i], columns->root[1][i] };
+        sink->used += format_solution_line(columns->status[i], columns->number_of_roots[i],
+                                           roots, columns->error_code[i], line);
+    }
+}
+
+static int convert_binary_to_text(const char* const input_path, const char* const output_path) {
+    coefficient_file_view coefficients {};
+    solution_file_view solutions {};
+
+    // Kind of the file is told by its magic
+    int error = open_coefficient_file(input_path, &coefficients);
+    const bool has_coefficients = error == 0;
+
+    if (error == BINARY_FILE_BAD_HEADER)
+        error = open_solution_file(input_path, &solutions);
+
+    if (error != 0) {
+        fprintf(stderr, "Can't read binary file \"%s\" (error %d)\n", input_path, error);
+        return 1;
+    }
+
+    FILE* const output = open_text_file(output_path, "w");
+
+    text_output_sink sink {};
+    bool is_ok = output != NULL && init_text_output_sink(&sink, output, OUTPUT_BUFFER_SIZE) == 0;
+
+    if (is_ok) {
+        if (has_coefficients)
+            write_coefficient_lines(&coefficients, &sink);
+        else
+            write_solution_lines(&solutions, &sink);
+
+        is_ok = destroy_text_output_sink(&sink) == 0;
+    }
+
+    if (output != NULL)
+        close_text_file(output);
+
+    if (has_coefficients)
+        close_coefficient_file(&coefficients);
+    else if (close_solution_file(&solutions) != 0)
+        is_ok = false;
+
+    if (!is_ok) {
+        fprintf(stderr, "Conversion to text failed\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static void print_usage(const char* const program_name) {
+    fprintf(stderr,
+            "Usage: %s to-binary <text coefficients> <binary coefficients>\n"
+            "       %s to-text   <binary coefficients or solutions> <text>\n"
+            "Text paths can be \"-\" for stdin or stdout.\n",
+            program_name, program_name);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "to-binary") == 0)
+        return convert_text_to_binary(argv[2], argv[3]);
+
+    if (strcmp(argv[1], "to-text") == 0)
+        return convert_binary_to_text(argv[2], argv[3]);
+
+    print_usage(argv[0]);
+    return 1;
+}
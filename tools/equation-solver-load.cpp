@@ -0,0 +1,289 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string.h>
+#include <stdio.h>
+#include <new>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <thread>
+
+#include "solver-client.h"
+
+// Load generator for the solver daemon: every client keeps a fixed number
+// of requests in flight on its own connection and records latency of each
+// request from send to receive. A client sends on one thread and receives
+// on another, or the server, which stops reading from connections with
+// megabytes of unreceived responses, and the client would wait on each other.
+
+struct load_options {
+    const char* socket_path; // NULL means TCP
+    uint16_t tcp_port;
+
+    size_t clients;
+    size_t requests;  // Per client
+    size_t equations; // Per request
+    size_t depth;     // Requests in flight per client
+};
+
+struct client_result {
+    double* latencies; // Seconds, one per request
+    bool has_failed;
+};
+
+static uint64_t now_in_nanoseconds(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void fill_coefficients(double* const a, double* const b, double* const c,
+                              const size_t count, uint64_t seed) {
+    for (size_t i = 0; i < count; ++ i) {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        const double random = (double) (seed >> 11) / 9007199254740992.0 * 20.0 - 10.0;
+
+        a[i] = random;
+        b[i] = random * 3.0 - 1.0;
+        c[i] = 1.0 - random;
+    }
+}
+
+// Shared by the sending and the receiving thread of one client
+struct client_progress {
+    std::atomic<size_t> sent;     // Requests sent so far
+    std::atomic<size_t> received; // Responses received so far
+    std::atomic<bool> is_stopped; // Either thread failed, the other one gives up
+};
+
+static void stop_client(client_progress* const progress) {
+    progress->is_stopped.store(true);
+
+    // A waiting thread wakes only when the counter changes. Both threads
+    // return once stopped, so nobody reads the changed counters
+    progress->sent.fetch_add(1);
+    progress->received.fetch_add(1);
+
+    progress->sent.notify_all();
+    progress->received.notify_all();
+}
+
+static void receive_responses(const load_options* const options, solver_client* const client,
+                              const equation_solution_columns* const solutions,
+                              uint64_t* const received_at, client_progress* const progress) {
+
+    for (size_t received = 0; received < options->requests; ++ received) {
+        // Wait for the request to be sent, a response to it then surely comes
+        size_t sent = progress->sent.load();
+        while (sent == received && !progress->is_stopped.load()) {
+            progress->sent.wait(sent);
+            sent = progress->sent.load();
+        }
+
+        if (progress->is_stopped.load())
+            return;
+
+        uint64_t id = 0;
+        size_t count = 0;
+
+        if (receive_solver_response(client, &id, solutions, options->equations, &count) != 0 ||
+            id != received || count != options->equations) {
+
+            stop_client(progress);
+            return;
+        }
+
+        received_at[received] = now_in_nanoseconds();
+
+        progress->received.store(received + 1);
+        progress->received.notify_one();
+    }
+}
+
+static void send_requests(const load_options* const options, solver_client* const client,
+                          const double* const a, const double* const b, const double* const c,
+                          uint64_t* const sent_at, client_progress* const progress) {
+
+    for (size_t sent = 0; sent < options->requests; ++ sent) {
+        // Keep at most depth requests in flight
+        size_t received = progress->received.load();
+        while (sent - received >= options->depth && !progress->is_stopped.load()) {
+            progress->received.wait(received);
+            received = progress->received.load();
+        }
+
+        if (progress->is_stopped.load())
+            return;
+
+        sent_at[sent] = now_in_nanoseconds();
+
+        if (send_solver_request(client, sent, a, b, c, options->equations) != 0) {
+            stop_client(progress);
+            return;
+        }
+
+        progress->sent.store(sent + 1);
+        progress->sent.notify_one();
+    }
+}
+
+static void run_client(const load_options* const options, const size_t index,
+                       client_result* const result) {
+
+    const size_t equations = options->equations;
+
+    double* const coefficients = (double*) malloc(3 * equations * sizeof(double));
+    double* const roots = (double*) malloc(2 * equations * sizeof(double));
+    int* const integers = (int*) malloc(2 * equations * sizeof(int));
+    solution_status* const status = (solution_status*) malloc(equations * sizeof(solution_status));
+    uint64_t* const sent_at = (uint64_t*) malloc(options->requests * sizeof(uint64_t));
+    uint64_t* const received_at = (uint64_t*) malloc(options->requests * sizeof(uint64_t));
+
+    solver_client* const client = options->socket_path != NULL
+        ? connect_solver_client(options->socket_path)
+        : connect_solver_client_tcp(options->tcp_port);
+
+    result->has_failed = coefficients == NULL || roots == NULL || integers == NULL ||
+        status == NULL || sent_at == NULL || received_at == NULL || client == NULL;
+
+    if (!result->has_failed) {
+        double* const a = coefficients;
+        double* const b = coefficients + equations;
+        double* const c = coefficients + 2 * equations;
+
+        fill_coefficients(a, b, c, equations, index + 1);
+
+        const equation_solution_columns solutions {
+            status, integers, { roots, roots + equations }, integers + equations
+        };
+
+        client_progress progress {};
+
+        try {
+            std::thread receiver(receive_responses, options, client, &solutions, received_at,
+                                 &progress);
+
+            send_requests(options, client, a, b, c, sent_at, &progress);
+            receiver.join();
+        } catch (const std::system_error&) {
+            progress.is_stopped.store(true);
+        }
+
+        result->has_failed = progress.is_stopped.load();
+
+        // Joined receiver, both arrays are complete
+        for (size_t i = 0; i < options->requests && !result->has_failed; ++ i)
+            result->latencies[i] = (double) (received_at[i] - sent_at[i]) * 1e-9;
+    }
+
+    disconnect_solver_client(client);
+
+    free(coefficients);
+    free(roots);
+    free(integers);
+    free(status);
+    free(sent_at);
+    free(received_at);
+}
+
+static bool parse_options(int argc, char* argv[], load_options* const options) {
+    *options = { NULL, 0, 1, 10000, 64, 1 };
+
+    bool has_endpoint = false;
+
+    for (int i = 1; i < argc; ++ i) {
+        const bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--socket") == 0 && has_value) {
+            options->socket_path = argv[++ i];
+            has_endpoint = true;
+        } else if (strcmp(argv[i], "--tcp") == 0 && has_value) {
+            options->tcp_port = (uint16_t) strtoul(argv[++ i], NULL, 10);
+            has_endpoint = true;
+        } else if (strcmp(argv[i], "--clients") == 0 && has_value)
+            options->clients = (size_t) strtoull(argv[++ i], NULL, 10);
+        else if (strcmp(argv[i], "--requests") == 0 && has_value)
+            options->requests = (size_t) strtoull(argv[++ i], NULL, 10);
+        else if (strcmp(argv[i], "--equations") == 0 && has_value)
+            options->equations = (size_t) strtoull(argv[++ i], NULL, 10);
+        else if (strcmp(argv[i], "--depth") == 0 && has_value)
+            options->depth = (size_t) strtoull(argv[++ i], NULL, 10);
+        else
+            return false;
+    }
+
+    return has_endpoint && options->clients > 0 && options->requests > 0 &&
+        options->equations > 0 && options->equations <= SOLVER_PROTOCOL_MAX_EQUATIONS &&
+        options->depth > 0;
+}
+
+static double percentile(const double* const sorted, const size_t count, const double fraction) {
+    const size_t index = (size_t) (fraction * (double) (count - 1) + 0.5);
+    return sorted[index];
+}
+
+int main(int argc, char* argv[]) {
+    load_options options {};
+    if (!parse_options(argc, argv, &options)) {
+        fprintf(stderr, "Usage: %s --socket path | --tcp port [--clients N] [--requests N]\n"
+                        "       %*s [--equations per request] [--depth requests in flight]\n",
+                argv[0], (int) strlen(argv[0]), "");
+        return 1;
+    }
+
+    const size_t total_requests = options.clients * options.requests;
+
+    double* const latencies = (double*) malloc(total_requests * sizeof(double));
+    client_result* const results = (client_result*) calloc(options.clients, sizeof(client_result));
+    std::thread* const threads = new (std::nothrow) std::thread[options.clients];
+
+    if (latencies == NULL || results == NULL || threads == NULL) {
+        fprintf(stderr, "Can't allocate %zu requests\n", total_requests);
+        return 1;
+    }
+
+    const uint64_t start = now_in_nanoseconds();
+
+    size_t started = 0;
+    try {
+        for (; started < options.clients; ++ started) {
+            results[started].latencies = latencies + started * options.requests;
+            threads[started] = std::thread(run_client, &options, started, results + started);
+        }
+    } catch (const std::system_error&) {
+        fprintf(stderr, "Started only %zu client threads\n", started);
+    }
+
+    bool has_failed = started != options.clients;
+    for (size_t i = 0; i < started; ++ i) {
+        threads[i].join();
+        has_failed = has_failed || results[i].has_failed;
+    }
+
+    const double seconds = (double) (now_in_nanoseconds() - start) * 1e-9;
+
+    if (has_failed) {
+        fprintf(stderr, "Some requests failed, is the server running?\n");
+        return 1;
+    }
+
+    std::sort(latencies, latencies + total_requests);
+
+    printf("%zu clients, %zu requests of %zu equations, depth %zu\n",
+           options.clients, total_requests, options.equations, options.depth);
+    printf("throughput: %.0f requests/s, %.0f equations/s\n",
+           (double) total_requests / seconds,
+           (double) (total_requests * options.equations) / seconds);
+    printf("latency us: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+           percentile(latencies, total_requests, 0.50) * 1e6,
+           percentile(latencies, total_requests, 0.90) * 1e6,
+           percentile(latencies, total_requests, 0.99) * 1e6,
+           latencies[total_requests - 1] * 1e6);
+
+    delete[] threads;
+    free(results);
+    free(latencies);
+
+    return 0;
+}